@@ -1124,6 +1124,20 @@ void grpc_tls_credentials_options_set_certificate_verifier(
 GRPCAPI void grpc_tls_credentials_options_set_check_call_host(
     grpc_tls_credentials_options* options, int check_call_host);
 
+/**
+ * EXPERIMENTAL API - Subject to change
+ *
+ * Sets the maximum number of successful custom verification results to cache.
+ * When a peer presents a certificate chain that was already verified for the
+ * same target name, the cached result is used instead of invoking the
+ * certificate verifier again. Cached results are reused until the peer's leaf
+ * certificate expires, for at most an hour, and are dropped whenever the root
+ * certificates are updated.
+ * The default is 0, which disables the cache.
+ */
+GRPCAPI void grpc_tls_credentials_options_set_verification_result_cache_size(
+    grpc_tls_credentials_options* options, size_t max_entries);
+
 /**
  * EXPERIMENTAL API - Subject to change
  *
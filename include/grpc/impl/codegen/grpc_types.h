@@ -231,6 +231,33 @@ typedef struct {
 /** How much data are we willing to queue up per stream if
     GRPC_WRITE_BUFFER_HINT is set? This is an upper bound */
 #define GRPC_ARG_HTTP2_WRITE_BUFFER_SIZE "grpc.http2.write_buffer_size"
+/** If set to non zero, writes are not started as soon as the transport becomes
+    writable but once the current execution context has drained, so that
+    streams fed from other combiners in the same poll cycle can add their
+    frames to the same write. Each connection still issues its own endpoint
+    write; this only makes those writes fewer and larger.
+    Defaults to 0 (disabled). */
+#define GRPC_ARG_HTTP2_BATCH_WRITES "grpc.experimental.http2_batch_writes"
+/** If set to a positive value, writes triggered by new streams, messages and
+    metadata are held back ("corked") for up to this many microseconds, so
+    that the frames of several streams go out in one endpoint write. The hold
+    ends early once GRPC_ARG_HTTP2_WRITE_CORK_BYTES of message data are
+    pending, or as soon as any other frame (ping, settings, window update,
+    reset, ...) needs to be sent. It is also capped to a quarter of the
+    connection's round trip time, when BDP probing has measured it. Holds
+    shorter than a millisecond last until the current execution context has
+    drained. Int valued, defaults to 0 (disabled). */
+#define GRPC_ARG_HTTP2_WRITE_CORK_US "grpc.experimental.http2_write_cork_us"
+/** Amount of pending message data, in bytes, that releases a corked write
+    early (see GRPC_ARG_HTTP2_WRITE_CORK_US). Defaults to 16384. */
+#define GRPC_ARG_HTTP2_WRITE_CORK_BYTES \
+  "grpc.experimental.http2_write_cork_bytes"
+/** Which header fields the HPACK encoder inserts into the peer's dynamic table.
+    String valued: "popularity" (the default) indexes fields that the
+    popularity filter considers hot; "adaptive" learns which fields save the
+    most bytes on this connection, and keeps those indexed. */
+#define GRPC_ARG_HTTP2_HPACK_INDEXING_POLICY \
+  "grpc.experimental.http2_hpack_indexing_policy"
 /** Should we allow receipt of true-binary data on http2 connections?
     Defaults to on (1) */
 #define GRPC_ARG_HTTP2_ENABLE_TRUE_BINARY "grpc.http2.true_binary"
@@ -279,6 +306,12 @@ typedef struct {
     grpc_ssl_session_cache*). (use grpc_ssl_session_cache_arg_vtable() to fetch
     an appropriate pointer arg vtable) */
 #define GRPC_SSL_SESSION_CACHE_ARG "grpc.ssl_session_cache"
+/** If non-zero (the default), SSL and TLS channels that do not set
+    \a GRPC_SSL_SESSION_CACHE_ARG share a process-wide session cache, so that
+    reconnects to the same server with the same credentials can resume their
+    previous TLS session. Set to zero to disable session resumption for such
+    channels. Int valued. */
+#define GRPC_ARG_SSL_DEFAULT_SESSION_CACHE "grpc.ssl_default_session_cache"
 /** If non-zero, it will determine the maximum frame size used by TSI's frame
  *  protector.
  *
@@ -287,6 +320,32 @@ typedef struct {
  *        can break old binaries that don't support larger than 1MiB frame
  *        size. */
 #define GRPC_ARG_TSI_MAX_FRAME_SIZE "grpc.tsi.max_frame_size"
+/** If non-zero, hand TLS record protection over to the kernel (Linux kTLS)
+ *  once the handshake completes, so that the TCP endpoint reads and writes
+ *  plaintext and no user space encryption or staging copies are needed. Only
+ *  used when the session, the endpoint and the kernel all support it (TLS 1.2
+ *  with AES-GCM on a TCP socket, BoringSSL, and the kernel "tls" module);
+ *  otherwise records are protected in user space as usual. Not used on
+ *  endpoints with GRPC_ARG_TCP_TX_ZEROCOPY_ENABLED, as kTLS sockets do not
+ *  accept MSG_ZEROCOPY. Defaults to 0. */
+#define GRPC_ARG_TLS_KERNEL_OFFLOAD "grpc.experimental.tls_kernel_offload"
+/** If non-zero, protect records with the zero-copy frame protector of TSI
+ *  implementations that offer one besides their regular frame protector
+ *  (currently SSL with OpenSSL 1.1.0+ or BoringSSL). It exchanges slices with
+ *  the endpoint instead of copying through staging buffers. For SSL, each
+ *  protected byte is still copied once in each direction, between the slices
+ *  and the SSL record buffer. Implementations that only offer one kind of
+ *  protector are unaffected. Defaults to 0. */
+#define GRPC_ARG_TSI_ZERO_COPY_FRAME_PROTECTOR \
+  "grpc.experimental.tsi_zero_copy_frame_protector"
+/** If non-zero, run the steps of synchronous TSI handshakers (such as the
+ *  SSL/TLS one, which signs and verifies certificates) on a process-wide
+ *  handshake thread pool instead of the I/O thread that received the
+ *  handshake bytes. The number of steps queued on the pool is bounded; once
+ *  it is reached, further steps run inline until the pool catches up.
+ *  Defaults to 0. */
+#define GRPC_ARG_SECURITY_HANDSHAKE_OFFLOAD \
+  "grpc.experimental.security_handshake_offload"
 /** Maximum metadata size, in bytes. Note this limit applies to the max sum of
     all metadata key-value entries in a batch of headers. */
 #define GRPC_ARG_MAX_METADATA_SIZE "grpc.max_metadata_size"
@@ -349,6 +408,26 @@ typedef struct {
    issued by the tcp_write(). By default, this is set to 4. */
 #define GRPC_ARG_TCP_TX_ZEROCOPY_MAX_SIMULT_SENDS \
   "grpc.experimental.tcp_tx_zerocopy_max_simultaneous_sends"
+/* TCP RX Zerocopy enable state: zero is disabled, non-zero is enabled. When
+   enabled (and supported by the kernel, linux >= 4.18), large reads are served
+   by mapping the socket's receive queue pages into the slices handed to the
+   transport (TCP_ZEROCOPY_RECEIVE) instead of copying them. By default, it is
+   disabled. */
+#define GRPC_ARG_TCP_RX_ZEROCOPY_ENABLED \
+  "grpc.experimental.tcp_rx_zerocopy_enabled"
+/* TCP RX Zerocopy threshold: only map the receive queue if at least this many
+   bytes are pending on the socket; smaller reads are copied. By default, this
+   is set to 64KB. */
+#define GRPC_ARG_TCP_RX_ZEROCOPY_BYTES_THRESHOLD \
+  "grpc.experimental.tcp_rx_zerocopy_bytes_threshold"
+/* Maximum number of idle receive buffers kept per TCP endpoint for reuse.
+   Read slices up to 64KB are then carved from a per-endpoint pool, sized from
+   the observed read sizes, and their memory is recycled into the pool once
+   the last reference to them is dropped instead of being freed. Idle buffers
+   are released when the resource quota comes under memory pressure. If 0 (the
+   default), every read allocates a fresh slice. */
+#define GRPC_ARG_TCP_READ_BUFFER_POOL_SIZE \
+  "grpc.experimental.tcp_read_buffer_pool_size"
 /* Timeout in milliseconds to use for calls to the grpclb load balancer.
    If 0 or unset, the balancer calls will have no deadline. */
 #define GRPC_ARG_GRPCLB_CALL_TIMEOUT_MS "grpc.grpclb_call_timeout_ms"
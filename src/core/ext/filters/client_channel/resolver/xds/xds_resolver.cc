@@ -273,6 +273,8 @@ class XdsResolver : public Resolver {
 
     RefCountedPtr<XdsResolver> resolver_;
     RouteTable route_table_;
+    // Path matchers of route_table_, for finding the route of a call.
+    StringMatcherSet route_path_matchers_;
     std::map<absl::string_view, RefCountedPtr<ClusterState>> clusters_;
     std::vector<const grpc_channel_filter*> filters_;
   };
@@ -410,6 +412,8 @@ XdsResolver::XdsConfigSelector::XdsConfigSelector(
       }
     }
   }
+  route_path_matchers_ =
+      XdsRouting::CreatePathMatcherSet(RouteListIterator(&route_table_));
   // Populate filter list.
   for (const auto& http_filter :
        resolver_->current_listener_.http_connection_manager.http_filters) {
@@ -567,8 +571,8 @@ absl::optional<uint64_t> HeaderHashHelper(
 ConfigSelector::CallConfig XdsResolver::XdsConfigSelector::GetCallConfig(
     GetCallConfigArgs args) {
   auto route_index = XdsRouting::GetRouteForRequest(
-      RouteListIterator(&route_table_), StringViewFromSlice(*args.path),
-      args.initial_metadata);
+      RouteListIterator(&route_table_), route_path_matchers_,
+      StringViewFromSlice(*args.path), args.initial_metadata);
   if (!route_index.has_value()) {
     return CallConfig();
   }
@@ -107,6 +107,9 @@ static void write_action_begin_locked(void* t, grpc_error_handle error);
 static void write_action(void* t, grpc_error_handle error);
 static void write_action_end(void* t, grpc_error_handle error);
 static void write_action_end_locked(void* t, grpc_error_handle error);
+static void uncork_write_locked(grpc_chttp2_transport* t);
+static void write_cork_timer_fired(void* t, grpc_error_handle error);
+static void write_cork_timer_fired_locked(void* t, grpc_error_handle error);
 
 static void read_action(void* t, grpc_error_handle error);
 static void read_action_locked(void* t, grpc_error_handle error);
@@ -304,6 +307,32 @@ static bool read_channel_args(grpc_chttp2_transport* t,
                            GRPC_ARG_HTTP2_WRITE_BUFFER_SIZE)) {
       t->write_buffer_size = static_cast<uint32_t>(grpc_channel_arg_get_integer(
           &channel_args->args[i], {0, 0, MAX_WRITE_BUFFER_SIZE}));
+    } else if (0 == strcmp(channel_args->args[i].key,
+                           GRPC_ARG_HTTP2_BATCH_WRITES)) {
+      t->batch_writes =
+          grpc_channel_arg_get_bool(&channel_args->args[i], false);
+    } else if (0 == strcmp(channel_args->args[i].key,
+                           GRPC_ARG_HTTP2_WRITE_CORK_US)) {
+      t->write_cork_us = grpc_channel_arg_get_integer(&channel_args->args[i],
+                                                      {0, 0, INT_MAX});
+    } else if (0 == strcmp(channel_args->args[i].key,
+                           GRPC_ARG_HTTP2_WRITE_CORK_BYTES)) {
+      t->write_cork_bytes =
+          static_cast<uint32_t>(grpc_channel_arg_get_integer(
+              &channel_args->args[i], {16384, 0, INT_MAX}));
+    } else if (0 == strcmp(channel_args->args[i].key,
+                           GRPC_ARG_HTTP2_HPACK_INDEXING_POLICY)) {
+      const char* policy = grpc_channel_arg_get_string(&channel_args->args[i]);
+      if (policy == nullptr || 0 == strcmp(policy, "popularity")) {
+        t->hpack_compressor.SetIndexingPolicy(
+            grpc_core::HPackIndexingPolicy::Mode::kPopularity);
+      } else if (0 == strcmp(policy, "adaptive")) {
+        t->hpack_compressor.SetIndexingPolicy(
+            grpc_core::HPackIndexingPolicy::Mode::kAdaptive);
+      } else {
+        gpr_log(GPR_ERROR, "%s: unknown policy '%s', ignoring",
+                GRPC_ARG_HTTP2_HPACK_INDEXING_POLICY, policy);
+      }
     } else if (0 ==
                strcmp(channel_args->args[i].key, GRPC_ARG_HTTP2_BDP_PROBE)) {
       enable_bdp = grpc_channel_arg_get_bool(&channel_args->args[i], true);
@@ -393,6 +422,8 @@ static bool read_channel_args(grpc_chttp2_transport* t,
             absl::StrFormat("%s %s", get_vtable()->name, t->peer_string),
             grpc_core::channelz::SocketNode::Security::GetFromChannelArgs(
                 channel_args));
+    t->hpack_compressor.set_channelz_stats(
+        t->channelz_socket->header_compression_stats());
   }
   return enable_bdp;
 }
@@ -564,6 +595,10 @@ static void close_transport_locked(grpc_chttp2_transport* t,
       error = grpc_error_set_int(error, GRPC_ERROR_INT_GRPC_STATUS,
                                  GRPC_STATUS_UNAVAILABLE);
     }
+    if (t->write_corked) {
+      // Don't keep the close waiting for the cork timer.
+      uncork_write_locked(t);
+    }
     if (t->write_state != GRPC_CHTTP2_WRITE_STATE_IDLE) {
       if (t->close_transport_on_writes_finished == GRPC_ERROR_NONE) {
         t->close_transport_on_writes_finished =
@@ -584,6 +619,9 @@ static void close_transport_locked(grpc_chttp2_transport* t,
     if (t->have_next_bdp_ping_timer) {
       grpc_timer_cancel(&t->next_bdp_ping_timer);
     }
+    if (t->write_cork_timer_armed) {
+      grpc_timer_cancel(&t->write_cork_timer);
+    }
     switch (t->keepalive_state) {
       case GRPC_CHTTP2_KEEPALIVE_STATE_WAITING:
         grpc_timer_cancel(&t->keepalive_ping_timer);
@@ -881,10 +919,100 @@ static void inc_initiate_write_reason(
   }
 }
 
+// Writes carrying stream data may be corked; anything else (control frames,
+// flow control updates, resets) should go out straight away.
+static bool write_reason_is_corkable(grpc_chttp2_initiate_write_reason reason) {
+  switch (reason) {
+    case GRPC_CHTTP2_INITIATE_WRITE_START_NEW_STREAM:
+    case GRPC_CHTTP2_INITIATE_WRITE_SEND_MESSAGE:
+    case GRPC_CHTTP2_INITIATE_WRITE_SEND_INITIAL_METADATA:
+    case GRPC_CHTTP2_INITIATE_WRITE_SEND_TRAILING_METADATA:
+      return true;
+    default:
+      return false;
+  }
+}
+
+static void schedule_write_action_begin_locked(grpc_chttp2_transport* t) {
+  if (t->batch_writes) {
+    grpc_chttp2_add_to_write_batch(t);
+  } else {
+    t->combiner->FinallyRun(&t->write_action_begin_locked, GRPC_ERROR_NONE);
+  }
+}
+
+// Hold back a write that is about to begin, so that more streams can add
+// their frames to it. Returns false if the write should begin now.
+static bool maybe_cork_write_locked(grpc_chttp2_transport* t,
+                                    grpc_chttp2_initiate_write_reason reason) {
+  if (t->write_cork_us == 0 || !write_reason_is_corkable(reason) ||
+      t->corked_bytes >= t->write_cork_bytes) {
+    return false;
+  }
+  int64_t cork_us = t->write_cork_us;
+  // Don't add more than a fraction of the round trip time to the latency.
+  grpc_core::BdpEstimator* bdp_est = t->flow_control->bdp_estimator();
+  if (bdp_est != nullptr && bdp_est->EstimateRtt() > 0) {
+    cork_us = std::min(
+        cork_us, static_cast<int64_t>(bdp_est->EstimateRtt() * 1e6 / 4));
+  }
+  if (cork_us < GPR_US_PER_MS) {
+    // Below timer resolution: hold the write until the exec_ctx has drained.
+    grpc_chttp2_add_to_write_batch(t);
+    return true;
+  }
+  t->write_corked = true;
+  // A timer left over from an earlier cork that was released early fires no
+  // later than a new one would, so it is reused rather than re-armed.
+  if (!t->write_cork_timer_armed) {
+    t->write_cork_timer_armed = true;
+    GRPC_CHTTP2_REF_TRANSPORT(t, "write_cork_timer");
+    GRPC_CLOSURE_INIT(&t->write_cork_timer_fired, write_cork_timer_fired, t,
+                      grpc_schedule_on_exec_ctx);
+    grpc_timer_init(&t->write_cork_timer,
+                    grpc_core::ExecCtx::Get()->Now() + cork_us / GPR_US_PER_MS,
+                    &t->write_cork_timer_fired);
+  }
+  return true;
+}
+
+static void uncork_write_locked(grpc_chttp2_transport* t) {
+  GPR_ASSERT(t->write_corked);
+  t->write_corked = false;
+  schedule_write_action_begin_locked(t);
+}
+
+static void write_cork_timer_fired(void* tp, grpc_error_handle error) {
+  grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(tp);
+  t->combiner->Run(GRPC_CLOSURE_INIT(&t->write_cork_timer_fired,
+                                     write_cork_timer_fired_locked, t, nullptr),
+                   GRPC_ERROR_REF(error));
+}
+
+static void write_cork_timer_fired_locked(void* tp,
+                                          grpc_error_handle /*error*/) {
+  grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(tp);
+  t->write_cork_timer_armed = false;
+  if (t->write_corked) {
+    uncork_write_locked(t);
+  }
+  GRPC_CHTTP2_UNREF_TRANSPORT(t, "write_cork_timer");
+}
+
 void grpc_chttp2_initiate_write(grpc_chttp2_transport* t,
                                 grpc_chttp2_initiate_write_reason reason) {
   GPR_TIMER_SCOPE("grpc_chttp2_initiate_write", 0);
 
+  if (t->write_corked) {
+    // The write has not begun yet, so it will pick up whatever is being
+    // queued now: only decide whether to keep holding it.
+    if (!write_reason_is_corkable(reason) ||
+        t->corked_bytes >= t->write_cork_bytes) {
+      uncork_write_locked(t);
+    }
+    return;
+  }
+
   switch (t->write_state) {
     case GRPC_CHTTP2_WRITE_STATE_IDLE:
       inc_initiate_write_reason(reason);
@@ -907,10 +1035,19 @@ void grpc_chttp2_initiate_write(grpc_chttp2_transport* t,
       // Also, 'write_action_begin_locked' only gathers the bytes into outbuf.
       // It does not call the endpoint to write the bytes. That is done by the
       // 'write_action' (which is scheduled by 'write_action_begin_locked')
-      t->combiner->FinallyRun(
-          GRPC_CLOSURE_INIT(&t->write_action_begin_locked,
-                            write_action_begin_locked, t, nullptr),
-          GRPC_ERROR_NONE);
+      //
+      // With batch_writes, gathering is deferred further: until every closure
+      // and combiner queued on the current exec_ctx has run. All the
+      // transports that became writable during that flush (typically one poll
+      // cycle) then begin their writes back to back.
+      //
+      // With write_cork_us, it may be held back for longer still, so that the
+      // frames of other streams join it.
+      GRPC_CLOSURE_INIT(&t->write_action_begin_locked,
+                        write_action_begin_locked, t, nullptr);
+      if (!maybe_cork_write_locked(t, reason)) {
+        schedule_write_action_begin_locked(t);
+      }
       break;
     case GRPC_CHTTP2_WRITE_STATE_WRITING:
       set_write_state(t, GRPC_CHTTP2_WRITE_STATE_WRITING_WITH_MORE,
@@ -942,6 +1079,8 @@ static void write_action_begin_locked(void* gt,
   GPR_TIMER_SCOPE("write_action_begin_locked", 0);
   grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(gt);
   GPR_ASSERT(t->write_state != GRPC_CHTTP2_WRITE_STATE_IDLE);
+  GPR_ASSERT(!t->write_corked);
+  t->corked_bytes = 0;
   grpc_chttp2_begin_write_result r;
   if (t->closed_with_error != GRPC_ERROR_NONE) {
     r.writing = false;
@@ -1274,6 +1413,7 @@ static void add_fetched_slice_locked(grpc_chttp2_transport* t,
                                      grpc_chttp2_stream* s) {
   s->fetched_send_message_length +=
       static_cast<uint32_t> GRPC_SLICE_LENGTH(s->fetching_slice);
+  t->corked_bytes += static_cast<uint32_t> GRPC_SLICE_LENGTH(s->fetching_slice);
   grpc_slice_buffer_add(&s->flow_controlled_buffer, s->fetching_slice);
   maybe_become_writable_due_to_send_msg(t, s);
 }
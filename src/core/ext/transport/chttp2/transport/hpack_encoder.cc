@@ -176,7 +176,8 @@ void HPackCompressor::AddElemWithIndex(grpc_mdelem elem, uint32_t new_index,
 
 void HPackCompressor::AddElem(grpc_mdelem elem, size_t elem_size,
                               uint32_t elem_hash, uint32_t key_hash) {
-  uint32_t new_index = table_.AllocateIndex(elem_size);
+  uint32_t new_index =
+      table_.AllocateIndex(elem_size, HPackIndexingPolicy::Bucket(elem_hash));
   if (new_index != 0) {
     AddElemWithIndex(elem, new_index, elem_hash, key_hash);
   }
@@ -192,6 +193,9 @@ void HPackCompressor::AddKey(grpc_mdelem elem, size_t elem_size,
 
 void HPackCompressor::Framer::EmitIndexed(uint32_t elem_index) {
   GRPC_STATS_INC_HPACK_SEND_INDEXED();
+  if (elem_index > hpack_constants::kLastStaticEntry) {
+    compressor_->table_hits_++;
+  }
   VarintWriter<1> w(elem_index);
   w.Write(0x80, AddTiny(w.length()));
 }
@@ -493,6 +497,11 @@ void HPackCompressor::Framer::EncodeDynamic(grpc_mdelem elem) {
     EmitLitHdrWithStringKeyNotIdx(elem);
     return;
   }
+  const size_t decoder_space_usage =
+      MetadataSizeInHPackTable(elem, use_true_binary_metadata_);
+  const bool decoder_space_available =
+      decoder_space_usage < kMaxDecoderSpaceUsage;
+  HPackIndexingPolicy& policy = compressor_->indexing_policy_;
   /* Interned metadata => maybe already indexed. */
   uint32_t elem_hash = 0;
   if (elem_interned) {
@@ -502,27 +511,35 @@ void HPackCompressor::Framer::EncodeDynamic(grpc_mdelem elem) {
             ? reinterpret_cast<InternedMetadata*>(GRPC_MDELEM_DATA(elem))
                   ->hash()
             : reinterpret_cast<StaticMetadata*>(GRPC_MDELEM_DATA(elem))->hash();
-    bool can_add_to_hashtable =
-        compressor_->filter_elems_.AddElement(elem_hash % kNumFilterValues);
+    const uint8_t bucket = HPackIndexingPolicy::Bucket(elem_hash);
+    const bool popular = policy.Observe(bucket, decoder_space_usage);
     /* is this elem currently in the decoders table? */
     auto indices_key =
         compressor_->elem_index_.Lookup(KeyElem(elem, elem_hash));
     if (indices_key.has_value() &&
         compressor_->table_.ConvertableToDynamicIndex(*indices_key)) {
-      EmitIndexed(compressor_->table_.DynamicIndex(*indices_key));
+      if (!policy.ShouldRefresh(bucket, decoder_space_usage, *indices_key,
+                                compressor_->table_)) {
+        EmitIndexed(compressor_->table_.DynamicIndex(*indices_key));
+        return;
+      }
+      // About to be evicted, but still valuable: insert it again, naming the
+      // old entry.
+      EmitLitHdrIncIdx(compressor_->table_.DynamicIndex(*indices_key), elem);
+      compressor_->AddElem(elem, decoder_space_usage, elem_hash,
+                           elem_key.refcount->Hash(elem_key));
       return;
     }
     /* Didn't hit either cuckoo index, so no emit. */
-    if (!can_add_to_hashtable) elem_hash = 0;
+    if (!decoder_space_available ||
+        !policy.ShouldIndex(popular, bucket, decoder_space_usage,
+                            compressor_->table_)) {
+      elem_hash = 0;
+    }
   }
 
   /* should this elem be in the table? */
-  const size_t decoder_space_usage =
-      MetadataSizeInHPackTable(elem, use_true_binary_metadata_);
-  const bool decoder_space_available =
-      decoder_space_usage < kMaxDecoderSpaceUsage;
-  const bool should_add_elem =
-      elem_interned && decoder_space_available && elem_hash != 0;
+  const bool should_add_elem = elem_interned && elem_hash != 0;
   /* no hits for the elem... maybe there's a key? */
   const uint32_t key_hash = elem_key.refcount->Hash(elem_key);
   auto indices_key =
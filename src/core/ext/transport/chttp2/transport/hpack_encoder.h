@@ -29,7 +29,8 @@
 #include "src/core/ext/transport/chttp2/transport/frame.h"
 #include "src/core/ext/transport/chttp2/transport/hpack_encoder_index.h"
 #include "src/core/ext/transport/chttp2/transport/hpack_encoder_table.h"
-#include "src/core/ext/transport/chttp2/transport/popularity_count.h"
+#include "src/core/ext/transport/chttp2/transport/hpack_indexing_policy.h"
+#include "src/core/lib/channel/channelz.h"
 #include "src/core/lib/transport/metadata.h"
 #include "src/core/lib/transport/metadata_batch.h"
 #include "src/core/lib/transport/transport.h"
@@ -55,6 +56,16 @@ class HPackCompressor {
     return table_.test_only_table_size();
   }
 
+  void SetIndexingPolicy(HPackIndexingPolicy::Mode mode) {
+    indexing_policy_.set_mode(mode);
+  }
+  // Add to these counters after each header set (costs an extra pass over
+  // the header set). They must outlive the compressor.
+  void set_channelz_stats(
+      channelz::SocketNode::HeaderCompressionStats* channelz_stats) {
+    channelz_stats_ = channelz_stats;
+  }
+
   struct EncodeHeaderOptions {
     uint32_t stream_id;
     bool is_end_of_stream;
@@ -66,8 +77,22 @@ class HPackCompressor {
   template <typename HeaderSet>
   void EncodeHeaders(const EncodeHeaderOptions& options,
                      const HeaderSet& headers, grpc_slice_buffer* output) {
-    Framer framer(options, this, output);
-    headers.Encode(&framer);
+    const size_t output_length_at_start = output->length;
+    {
+      Framer framer(options, this, output);
+      headers.Encode(&framer);
+    }
+    if (channelz_stats_ != nullptr) {
+      channelz_stats_->uncompressed_bytes.fetch_add(headers.TransportSize(),
+                                                    std::memory_order_relaxed);
+      channelz_stats_->compressed_bytes.fetch_add(
+          output->length - output_length_at_start, std::memory_order_relaxed);
+      channelz_stats_->table_hits.store(table_hits_, std::memory_order_relaxed);
+      channelz_stats_->table_insertions.store(table_.insertions(),
+                                              std::memory_order_relaxed);
+      channelz_stats_->table_evictions.store(table_.evictions(),
+                                             std::memory_order_relaxed);
+    }
   }
 
   class Framer {
@@ -194,12 +219,12 @@ class HPackCompressor {
   bool advertise_table_size_change_ = false;
   HPackEncoderTable table_;
 
-  // filter tables for elems: this tables provides an approximate
-  // popularity count for particular hashes, and are used to determine whether
-  // a new literal should be added to the compression table or not.
-  // They track a single integer that counts how often a particular value has
-  // been seen. When that count reaches max (255), all values are halved.
-  PopularityCount<kNumFilterValues> filter_elems_;
+  // decides whether a new literal should be added to the compression table
+  // or not (see HPackIndexingPolicy)
+  HPackIndexingPolicy indexing_policy_;
+  // fields emitted as a reference to the dynamic table
+  uint64_t table_hits_ = 0;
+  channelz::SocketNode::HeaderCompressionStats* channelz_stats_ = nullptr;
 
   class KeyElem {
    public:
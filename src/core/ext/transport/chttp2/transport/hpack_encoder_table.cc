@@ -20,7 +20,9 @@
 
 namespace grpc_core {
 
-uint32_t HPackEncoderTable::AllocateIndex(size_t element_size) {
+constexpr uint8_t HPackEncoderTable::kUntagged;
+
+uint32_t HPackEncoderTable::AllocateIndex(size_t element_size, uint8_t tag) {
   uint32_t new_index = tail_remote_index_ + table_elems_ + 1;
   GPR_DEBUG_ASSERT(element_size < 65536);
 
@@ -40,8 +42,10 @@ uint32_t HPackEncoderTable::AllocateIndex(size_t element_size) {
   GPR_ASSERT(table_elems_ < elem_size_.size());
   elem_size_[new_index % elem_size_.size()] =
       static_cast<uint16_t>(element_size);
+  elem_tag_[new_index % elem_tag_.size()] = tag;
   table_size_ += element_size;
   table_elems_++;
+  insertions_++;
 
   return new_index;
 }
@@ -71,16 +75,20 @@ void HPackEncoderTable::EvictOne() {
   GPR_ASSERT(table_size_ >= removing_size);
   table_size_ -= removing_size;
   table_elems_--;
+  evictions_++;
 }
 
 void HPackEncoderTable::Rebuild(uint32_t capacity) {
   decltype(elem_size_) new_elem_size(capacity);
+  decltype(elem_tag_) new_elem_tag(capacity, kUntagged);
   GPR_ASSERT(table_elems_ <= capacity);
   for (uint32_t i = 0; i < table_elems_; i++) {
     uint32_t ofs = tail_remote_index_ + i + 1;
     new_elem_size[ofs % capacity] = elem_size_[ofs % elem_size_.size()];
+    new_elem_tag[ofs % capacity] = elem_tag_[ofs % elem_tag_.size()];
   }
   elem_size_.swap(new_elem_size);
+  elem_tag_.swap(new_elem_tag);
 }
 
 }  // namespace grpc_core
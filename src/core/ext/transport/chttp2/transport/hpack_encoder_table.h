@@ -27,12 +27,17 @@ namespace grpc_core {
 // sizes.
 class HPackEncoderTable {
  public:
-  HPackEncoderTable() : elem_size_(hpack_constants::kInitialTableEntries) {}
+  // Tag of entries that carry no indexing policy information.
+  static constexpr uint8_t kUntagged = 0xff;
+
+  HPackEncoderTable()
+      : elem_size_(hpack_constants::kInitialTableEntries),
+        elem_tag_(hpack_constants::kInitialTableEntries, kUntagged) {}
 
   // Reserve space in table for the new element, evict entries if needed.
   // Return the new index of the element. Return 0 to indicate not adding to
-  // table.
-  uint32_t AllocateIndex(size_t element_size);
+  // table. The tag is stored alongside the element for the indexing policy.
+  uint32_t AllocateIndex(size_t element_size, uint8_t tag = kUntagged);
   // Set the maximum table size. Return true if it changed.
   bool SetMaxSize(uint32_t max_table_size);
   // Get the current max table size
@@ -49,6 +54,29 @@ class HPackEncoderTable {
   bool ConvertableToDynamicIndex(uint32_t index) const {
     return index > tail_remote_index_;
   }
+  // Check if an element is among the oldest quarter of the table, and so will
+  // be evicted soon
+  bool IsNearEviction(uint32_t index) const {
+    return index - tail_remote_index_ <= (table_elems_ + 3) / 4;
+  }
+
+  // Call f(tag, size) for each element (oldest first) that allocating an
+  // element of element_size would evict.
+  template <typename F>
+  void ForEachEvictedBy(size_t element_size, F f) const {
+    size_t table_size = table_size_;
+    for (uint32_t i = 1; i <= table_elems_ &&
+                         table_size + element_size > max_table_size_;
+         i++) {
+      const size_t slot = (tail_remote_index_ + i) % elem_size_.size();
+      f(elem_tag_[slot], elem_size_[slot]);
+      table_size -= elem_size_[slot];
+    }
+  }
+
+  // Number of elements ever inserted into / evicted from the table
+  uint64_t insertions() const { return insertions_; }
+  uint64_t evictions() const { return evictions_; }
 
  private:
   void EvictOne();
@@ -59,9 +87,14 @@ class HPackEncoderTable {
   uint32_t max_table_size_ = hpack_constants::kInitialTableSize;
   uint32_t table_elems_ = 0;
   uint32_t table_size_ = 0;
+  uint64_t insertions_ = 0;
+  uint64_t evictions_ = 0;
   // The size of each element in the HPACK table.
   absl::InlinedVector<uint16_t, hpack_constants::kInitialTableEntries>
       elem_size_;
+  // The tag of each element in the HPACK table.
+  absl::InlinedVector<uint8_t, hpack_constants::kInitialTableEntries>
+      elem_tag_;
 };
 
 }  // namespace grpc_core
@@ -0,0 +1,127 @@
+// Copyright 2021 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_CORE_EXT_TRANSPORT_CHTTP2_TRANSPORT_HPACK_INDEXING_POLICY_H
+#define GRPC_CORE_EXT_TRANSPORT_CHTTP2_TRANSPORT_HPACK_INDEXING_POLICY_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "src/core/ext/transport/chttp2/transport/hpack_constants.h"
+#include "src/core/ext/transport/chttp2/transport/hpack_encoder_table.h"
+#include "src/core/ext/transport/chttp2/transport/popularity_count.h"
+
+namespace grpc_core {
+
+// Decides which literal header fields the encoder asks the peer to insert into
+// its dynamic table.
+//
+// The decoder always evicts the oldest entries first, so the encoder cannot
+// choose what gets evicted. Instead, in adaptive mode, it chooses what gets
+// inserted: it learns how many bytes indexing each (hashed) element has saved
+// on this connection, declines insertions that would evict entries worth more
+// than the newcomer, and re-inserts valuable entries that are about to fall
+// off the end of the table.
+class HPackIndexingPolicy {
+ public:
+  enum class Mode {
+    // Index an element once the popularity filter considers it hot.
+    kPopularity,
+    // Index (and keep indexed) by estimated byte savings.
+    kAdaptive,
+  };
+
+  // Number of buckets that element hashes are folded into.
+  static constexpr uint8_t kNumBuckets = 64;
+
+  static uint8_t Bucket(uint32_t hash) { return hash % kNumBuckets; }
+
+  Mode mode() const { return mode_; }
+  void set_mode(Mode mode) { mode_ = mode; }
+
+  // Record that an element in the given bucket, with the given table size,
+  // is being encoded. Returns true if the element seems popular.
+  bool Observe(uint8_t bucket, size_t element_size) {
+    if (mode_ == Mode::kAdaptive) {
+      savings_[bucket] += Gain(element_size);
+      total_savings_ += Gain(element_size);
+      if (total_savings_ > kDecayThreshold) Decay();
+    }
+    return popularity_.AddElement(bucket);
+  }
+
+  // Should an element that is not in the table be inserted? popular is the
+  // result of the preceding Observe() call.
+  bool ShouldIndex(bool popular, uint8_t bucket, size_t element_size,
+                   const HPackEncoderTable& table) const {
+    if (mode_ == Mode::kPopularity) return popular;
+    const uint32_t gain = Gain(element_size);
+    // Everything observed so far came from this occurrence: most likely a
+    // unique value (request id, timestamp), which would never be referenced.
+    if (savings_[bucket] <= gain) return false;
+    uint64_t cost = 0;
+    table.ForEachEvictedBy(element_size, [this, &cost](uint8_t tag,
+                                                       uint16_t size) {
+      // Entries we don't track (paths, authorities, ...) are assumed to be
+      // worth as much as an element seen twice.
+      cost += tag == HPackEncoderTable::kUntagged ? 2 * Gain(size)
+                                                  : savings_[tag];
+    });
+    return savings_[bucket] - gain > cost;
+  }
+
+  // Should an element that is in the table at index be inserted again, to
+  // stop it being evicted?
+  bool ShouldRefresh(uint8_t bucket, size_t element_size, uint32_t index,
+                     const HPackEncoderTable& table) const {
+    if (mode_ == Mode::kPopularity) return false;
+    // Resending the literal costs about one use worth of savings: only do so
+    // for elements that are referenced often.
+    return table.IsNearEviction(index) &&
+           savings_[bucket] >= kRefreshUses * Gain(element_size);
+  }
+
+ private:
+  // Halve all savings once this many bytes have been accounted, so that the
+  // estimates track recent traffic.
+  static constexpr uint32_t kDecayThreshold = 64 * 1024;
+  static constexpr uint32_t kRefreshUses = 4;
+
+  // Bytes saved by referencing an element instead of sending it as a literal
+  // (the index itself costs about a byte).
+  static uint32_t Gain(size_t element_size) {
+    return element_size > hpack_constants::kEntryOverhead + 1
+               ? element_size - hpack_constants::kEntryOverhead - 1
+               : 0;
+  }
+
+  void Decay() {
+    total_savings_ = 0;
+    for (int i = 0; i < kNumBuckets; i++) {
+      savings_[i] /= 2;
+      total_savings_ += savings_[i];
+    }
+  }
+
+  Mode mode_ = Mode::kPopularity;
+  PopularityCount<kNumBuckets> popularity_;
+  uint32_t total_savings_ = 0;
+  uint32_t savings_[kNumBuckets] = {};
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_EXT_TRANSPORT_CHTTP2_TRANSPORT_HPACK_INDEXING_POLICY_H
@@ -52,379 +52,421 @@ namespace grpc_core {
 
 TraceFlag grpc_trace_chttp2_hpack_parser(false, "chttp2_hpack_parser");
 
-/* state table for huffman decoding: given a state, gives an index/16 into
-   next_sub_tbl. Taking that index and adding the value of the nibble being
-   considered returns the next state.
-
-   generated by gen_hpack_tables.c */
-static const uint8_t next_tbl[256] = {
-    0,  1,  2,  3,  4,  1,  2, 5,  6,  1, 7,  8,  1,  3,  3,  9,  10, 11, 1,  1,
-    1,  12, 1,  2,  13, 1,  1, 1,  1,  1, 1,  1,  1,  1,  1,  1,  1,  1,  1,  2,
-    14, 1,  15, 16, 1,  17, 1, 15, 2,  7, 3,  18, 19, 1,  1,  1,  1,  20, 1,  1,
-    1,  1,  1,  1,  1,  1,  1, 1,  15, 2, 2,  7,  21, 1,  22, 1,  1,  1,  1,  1,
-    1,  1,  1,  15, 2,  2,  2, 2,  2,  2, 23, 24, 25, 1,  1,  1,  1,  2,  2,  2,
-    26, 3,  3,  27, 10, 28, 1, 1,  1,  1, 1,  1,  2,  3,  29, 10, 30, 1,  1,  1,
-    1,  1,  1,  1,  1,  1,  1, 1,  1,  1, 1,  31, 1,  1,  1,  1,  1,  1,  1,  2,
-    2,  2,  2,  2,  2,  2,  2, 32, 1,  1, 15, 33, 1,  34, 35, 9,  36, 1,  1,  1,
-    1,  1,  1,  1,  37, 1,  1, 1,  1,  1, 1,  2,  2,  2,  2,  2,  2,  2,  26, 9,
-    38, 1,  1,  1,  1,  1,  1, 1,  15, 2, 2,  2,  2,  26, 3,  3,  39, 1,  1,  1,
-    1,  1,  1,  1,  1,  1,  1, 1,  2,  2, 2,  2,  2,  2,  7,  3,  3,  3,  40, 2,
-    41, 1,  1,  1,  42, 43, 1, 1,  44, 1, 1,  1,  1,  15, 2,  2,  2,  2,  2,  2,
-    3,  3,  3,  45, 46, 1,  1, 2,  2,  2, 35, 3,  3,  18, 47, 2,
+/* huffman decoding table, indexed by the next 11 bits of input: each entry
+   packs the (up to two) symbols whose codes fit entirely in those bits -
+   bits 0-7 and 8-15 are the symbols, bits 16-19 the length of the first
+   code, bits 20-23 the combined length of both codes and bits 24-25 the
+   number of symbols. Entries with no symbols start a code that is longer than
+   11 bits, which is resolved with the huff_long_* tables below.
+
+   generated by gen_hpack_tables.cc */
+static const uint32_t huff_lookup_tbl[2048] = {
+    0x2a53030, 0x2a53030, 0x2a53130, 0x2a53130, 0x2a53230, 0x2a53230, 0x2a56130,
+    0x2a56130, 0x2a56330, 0x2a56330, 0x2a56530, 0x2a56530, 0x2a56930, 0x2a56930,
+    0x2a56f30, 0x2a56f30, 0x2a57330, 0x2a57330, 0x2a57430, 0x2a57430, 0x2b52030,
+    0x2b52530, 0x2b52d30, 0x2b52e30, 0x2b52f30, 0x2b53330, 0x2b53430, 0x2b53530,
+    0x2b53630, 0x2b53730, 0x2b53830, 0x2b53930, 0x2b53d30, 0x2b54130, 0x2b55f30,
+    0x2b56230, 0x2b56430, 0x2b56630, 0x2b56730, 0x2b56830, 0x2b56c30, 0x2b56d30,
+    0x2b56e30, 0x2b57030, 0x2b57230, 0x2b57530, 0x1550030, 0x1550030, 0x1550030,
+    0x1550030, 0x1550030, 0x1550030, 0x1550030, 0x1550030, 0x1550030, 0x1550030,
+    0x1550030, 0x1550030, 0x1550030, 0x1550030, 0x1550030, 0x1550030, 0x1550030,
+    0x1550030, 0x2a53031, 0x2a53031, 0x2a53131, 0x2a53131, 0x2a53231, 0x2a53231,
+    0x2a56131, 0x2a56131, 0x2a56331, 0x2a56331, 0x2a56531, 0x2a56531, 0x2a56931,
+    0x2a56931, 0x2a56f31, 0x2a56f31, 0x2a57331, 0x2a57331, 0x2a57431, 0x2a57431,
+    0x2b52031, 0x2b52531, 0x2b52d31, 0x2b52e31, 0x2b52f31, 0x2b53331, 0x2b53431,
+    0x2b53531, 0x2b53631, 0x2b53731, 0x2b53831, 0x2b53931, 0x2b53d31, 0x2b54131,
+    0x2b55f31, 0x2b56231, 0x2b56431, 0x2b56631, 0x2b56731, 0x2b56831, 0x2b56c31,
+    0x2b56d31, 0x2b56e31, 0x2b57031, 0x2b57231, 0x2b57531, 0x1550031, 0x1550031,
+    0x1550031, 0x1550031, 0x1550031, 0x1550031, 0x1550031, 0x1550031, 0x1550031,
+    0x1550031, 0x1550031, 0x1550031, 0x1550031, 0x1550031, 0x1550031, 0x1550031,
+    0x1550031, 0x1550031, 0x2a53032, 0x2a53032, 0x2a53132, 0x2a53132, 0x2a53232,
+    0x2a53232, 0x2a56132, 0x2a56132, 0x2a56332, 0x2a56332, 0x2a56532, 0x2a56532,
+    0x2a56932, 0x2a56932, 0x2a56f32, 0x2a56f32, 0x2a57332, 0x2a57332, 0x2a57432,
+    0x2a57432, 0x2b52032, 0x2b52532, 0x2b52d32, 0x2b52e32, 0x2b52f32, 0x2b53332,
+    0x2b53432, 0x2b53532, 0x2b53632, 0x2b53732, 0x2b53832, 0x2b53932, 0x2b53d32,
+    0x2b54132, 0x2b55f32, 0x2b56232, 0x2b56432, 0x2b56632, 0x2b56732, 0x2b56832,
+    0x2b56c32, 0x2b56d32, 0x2b56e32, 0x2b57032, 0x2b57232, 0x2b57532, 0x1550032,
+    0x1550032, 0x1550032, 0x1550032, 0x1550032, 0x1550032, 0x1550032, 0x1550032,
+    0x1550032, 0x1550032, 0x1550032, 0x1550032, 0x1550032, 0x1550032, 0x1550032,
+    0x1550032, 0x1550032, 0x1550032, 0x2a53061, 0x2a53061, 0x2a53161, 0x2a53161,
+    0x2a53261, 0x2a53261, 0x2a56161, 0x2a56161, 0x2a56361, 0x2a56361, 0x2a56561,
+    0x2a56561, 0x2a56961, 0x2a56961, 0x2a56f61, 0x2a56f61, 0x2a57361, 0x2a57361,
+    0x2a57461, 0x2a57461, 0x2b52061, 0x2b52561, 0x2b52d61, 0x2b52e61, 0x2b52f61,
+    0x2b53361, 0x2b53461, 0x2b53561, 0x2b53661, 0x2b53761, 0x2b53861, 0x2b53961,
+    0x2b53d61, 0x2b54161, 0x2b55f61, 0x2b56261, 0x2b56461, 0x2b56661, 0x2b56761,
+    0x2b56861, 0x2b56c61, 0x2b56d61, 0x2b56e61, 0x2b57061, 0x2b57261, 0x2b57561,
+    0x1550061, 0x1550061, 0x1550061, 0x1550061, 0x1550061, 0x1550061, 0x1550061,
+    0x1550061, 0x1550061, 0x1550061, 0x1550061, 0x1550061, 0x1550061, 0x1550061,
+    0x1550061, 0x1550061, 0x1550061, 0x1550061, 0x2a53063, 0x2a53063, 0x2a53163,
+    0x2a53163, 0x2a53263, 0x2a53263, 0x2a56163, 0x2a56163, 0x2a56363, 0x2a56363,
+    0x2a56563, 0x2a56563, 0x2a56963, 0x2a56963, 0x2a56f63, 0x2a56f63, 0x2a57363,
+    0x2a57363, 0x2a57463, 0x2a57463, 0x2b52063, 0x2b52563, 0x2b52d63, 0x2b52e63,
+    0x2b52f63, 0x2b53363, 0x2b53463, 0x2b53563, 0x2b53663, 0x2b53763, 0x2b53863,
+    0x2b53963, 0x2b53d63, 0x2b54163, 0x2b55f63, 0x2b56263, 0x2b56463, 0x2b56663,
+    0x2b56763, 0x2b56863, 0x2b56c63, 0x2b56d63, 0x2b56e63, 0x2b57063, 0x2b57263,
+    0x2b57563, 0x1550063, 0x1550063, 0x1550063, 0x1550063, 0x1550063, 0x1550063,
+    0x1550063, 0x1550063, 0x1550063, 0x1550063, 0x1550063, 0x1550063, 0x1550063,
+    0x1550063, 0x1550063, 0x1550063, 0x1550063, 0x1550063, 0x2a53065, 0x2a53065,
+    0x2a53165, 0x2a53165, 0x2a53265, 0x2a53265, 0x2a56165, 0x2a56165, 0x2a56365,
+    0x2a56365, 0x2a56565, 0x2a56565, 0x2a56965, 0x2a56965, 0x2a56f65, 0x2a56f65,
+    0x2a57365, 0x2a57365, 0x2a57465, 0x2a57465, 0x2b52065, 0x2b52565, 0x2b52d65,
+    0x2b52e65, 0x2b52f65, 0x2b53365, 0x2b53465, 0x2b53565, 0x2b53665, 0x2b53765,
+    0x2b53865, 0x2b53965, 0x2b53d65, 0x2b54165, 0x2b55f65, 0x2b56265, 0x2b56465,
+    0x2b56665, 0x2b56765, 0x2b56865, 0x2b56c65, 0x2b56d65, 0x2b56e65, 0x2b57065,
+    0x2b57265, 0x2b57565, 0x1550065, 0x1550065, 0x1550065, 0x1550065, 0x1550065,
+    0x1550065, 0x1550065, 0x1550065, 0x1550065, 0x1550065, 0x1550065, 0x1550065,
+    0x1550065, 0x1550065, 0x1550065, 0x1550065, 0x1550065, 0x1550065, 0x2a53069,
+    0x2a53069, 0x2a53169, 0x2a53169, 0x2a53269, 0x2a53269, 0x2a56169, 0x2a56169,
+    0x2a56369, 0x2a56369, 0x2a56569, 0x2a56569, 0x2a56969, 0x2a56969, 0x2a56f69,
+    0x2a56f69, 0x2a57369, 0x2a57369, 0x2a57469, 0x2a57469, 0x2b52069, 0x2b52569,
+    0x2b52d69, 0x2b52e69, 0x2b52f69, 0x2b53369, 0x2b53469, 0x2b53569, 0x2b53669,
+    0x2b53769, 0x2b53869, 0x2b53969, 0x2b53d69, 0x2b54169, 0x2b55f69, 0x2b56269,
+    0x2b56469, 0x2b56669, 0x2b56769, 0x2b56869, 0x2b56c69, 0x2b56d69, 0x2b56e69,
+    0x2b57069, 0x2b57269, 0x2b57569, 0x1550069, 0x1550069, 0x1550069, 0x1550069,
+    0x1550069, 0x1550069, 0x1550069, 0x1550069, 0x1550069, 0x1550069, 0x1550069,
+    0x1550069, 0x1550069, 0x1550069, 0x1550069, 0x1550069, 0x1550069, 0x1550069,
+    0x2a5306f, 0x2a5306f, 0x2a5316f, 0x2a5316f, 0x2a5326f, 0x2a5326f, 0x2a5616f,
+    0x2a5616f, 0x2a5636f, 0x2a5636f, 0x2a5656f, 0x2a5656f, 0x2a5696f, 0x2a5696f,
+    0x2a56f6f, 0x2a56f6f, 0x2a5736f, 0x2a5736f, 0x2a5746f, 0x2a5746f, 0x2b5206f,
+    0x2b5256f, 0x2b52d6f, 0x2b52e6f, 0x2b52f6f, 0x2b5336f, 0x2b5346f, 0x2b5356f,
+    0x2b5366f, 0x2b5376f, 0x2b5386f, 0x2b5396f, 0x2b53d6f, 0x2b5416f, 0x2b55f6f,
+    0x2b5626f, 0x2b5646f, 0x2b5666f, 0x2b5676f, 0x2b5686f, 0x2b56c6f, 0x2b56d6f,
+    0x2b56e6f, 0x2b5706f, 0x2b5726f, 0x2b5756f, 0x155006f, 0x155006f, 0x155006f,
+    0x155006f, 0x155006f, 0x155006f, 0x155006f, 0x155006f, 0x155006f, 0x155006f,
+    0x155006f, 0x155006f, 0x155006f, 0x155006f, 0x155006f, 0x155006f, 0x155006f,
+    0x155006f, 0x2a53073, 0x2a53073, 0x2a53173, 0x2a53173, 0x2a53273, 0x2a53273,
+    0x2a56173, 0x2a56173, 0x2a56373, 0x2a56373, 0x2a56573, 0x2a56573, 0x2a56973,
+    0x2a56973, 0x2a56f73, 0x2a56f73, 0x2a57373, 0x2a57373, 0x2a57473, 0x2a57473,
+    0x2b52073, 0x2b52573, 0x2b52d73, 0x2b52e73, 0x2b52f73, 0x2b53373, 0x2b53473,
+    0x2b53573, 0x2b53673, 0x2b53773, 0x2b53873, 0x2b53973, 0x2b53d73, 0x2b54173,
+    0x2b55f73, 0x2b56273, 0x2b56473, 0x2b56673, 0x2b56773, 0x2b56873, 0x2b56c73,
+    0x2b56d73, 0x2b56e73, 0x2b57073, 0x2b57273, 0x2b57573, 0x1550073, 0x1550073,
+    0x1550073, 0x1550073, 0x1550073, 0x1550073, 0x1550073, 0x1550073, 0x1550073,
+    0x1550073, 0x1550073, 0x1550073, 0x1550073, 0x1550073, 0x1550073, 0x1550073,
+    0x1550073, 0x1550073, 0x2a53074, 0x2a53074, 0x2a53174, 0x2a53174, 0x2a53274,
+    0x2a53274, 0x2a56174, 0x2a56174, 0x2a56374, 0x2a56374, 0x2a56574, 0x2a56574,
+    0x2a56974, 0x2a56974, 0x2a56f74, 0x2a56f74, 0x2a57374, 0x2a57374, 0x2a57474,
+    0x2a57474, 0x2b52074, 0x2b52574, 0x2b52d74, 0x2b52e74, 0x2b52f74, 0x2b53374,
+    0x2b53474, 0x2b53574, 0x2b53674, 0x2b53774, 0x2b53874, 0x2b53974, 0x2b53d74,
+    0x2b54174, 0x2b55f74, 0x2b56274, 0x2b56474, 0x2b56674, 0x2b56774, 0x2b56874,
+    0x2b56c74, 0x2b56d74, 0x2b56e74, 0x2b57074, 0x2b57274, 0x2b57574, 0x1550074,
+    0x1550074, 0x1550074, 0x1550074, 0x1550074, 0x1550074, 0x1550074, 0x1550074,
+    0x1550074, 0x1550074, 0x1550074, 0x1550074, 0x1550074, 0x1550074, 0x1550074,
+    0x1550074, 0x1550074, 0x1550074, 0x2b63020, 0x2b63120, 0x2b63220, 0x2b66120,
+    0x2b66320, 0x2b66520, 0x2b66920, 0x2b66f20, 0x2b67320, 0x2b67420, 0x1660020,
+    0x1660020, 0x1660020, 0x1660020, 0x1660020, 0x1660020, 0x1660020, 0x1660020,
+    0x1660020, 0x1660020, 0x1660020, 0x1660020, 0x1660020, 0x1660020, 0x1660020,
+    0x1660020, 0x1660020, 0x1660020, 0x1660020, 0x1660020, 0x1660020, 0x1660020,
+    0x2b63025, 0x2b63125, 0x2b63225, 0x2b66125, 0x2b66325, 0x2b66525, 0x2b66925,
+    0x2b66f25, 0x2b67325, 0x2b67425, 0x1660025, 0x1660025, 0x1660025, 0x1660025,
+    0x1660025, 0x1660025, 0x1660025, 0x1660025, 0x1660025, 0x1660025, 0x1660025,
+    0x1660025, 0x1660025, 0x1660025, 0x1660025, 0x1660025, 0x1660025, 0x1660025,
+    0x1660025, 0x1660025, 0x1660025, 0x1660025, 0x2b6302d, 0x2b6312d, 0x2b6322d,
+    0x2b6612d, 0x2b6632d, 0x2b6652d, 0x2b6692d, 0x2b66f2d, 0x2b6732d, 0x2b6742d,
+    0x166002d, 0x166002d, 0x166002d, 0x166002d, 0x166002d, 0x166002d, 0x166002d,
+    0x166002d, 0x166002d, 0x166002d, 0x166002d, 0x166002d, 0x166002d, 0x166002d,
+    0x166002d, 0x166002d, 0x166002d, 0x166002d, 0x166002d, 0x166002d, 0x166002d,
+    0x166002d, 0x2b6302e, 0x2b6312e, 0x2b6322e, 0x2b6612e, 0x2b6632e, 0x2b6652e,
+    0x2b6692e, 0x2b66f2e, 0x2b6732e, 0x2b6742e, 0x166002e, 0x166002e, 0x166002e,
+    0x166002e, 0x166002e, 0x166002e, 0x166002e, 0x166002e, 0x166002e, 0x166002e,
+    0x166002e, 0x166002e, 0x166002e, 0x166002e, 0x166002e, 0x166002e, 0x166002e,
+    0x166002e, 0x166002e, 0x166002e, 0x166002e, 0x166002e, 0x2b6302f, 0x2b6312f,
+    0x2b6322f, 0x2b6612f, 0x2b6632f, 0x2b6652f, 0x2b6692f, 0x2b66f2f, 0x2b6732f,
+    0x2b6742f, 0x166002f, 0x166002f, 0x166002f, 0x166002f, 0x166002f, 0x166002f,
+    0x166002f, 0x166002f, 0x166002f, 0x166002f, 0x166002f, 0x166002f, 0x166002f,
+    0x166002f, 0x166002f, 0x166002f, 0x166002f, 0x166002f, 0x166002f, 0x166002f,
+    0x166002f, 0x166002f, 0x2b63033, 0x2b63133, 0x2b63233, 0x2b66133, 0x2b66333,
+    0x2b66533, 0x2b66933, 0x2b66f33, 0x2b67333, 0x2b67433, 0x1660033, 0x1660033,
+    0x1660033, 0x1660033, 0x1660033, 0x1660033, 0x1660033, 0x1660033, 0x1660033,
+    0x1660033, 0x1660033, 0x1660033, 0x1660033, 0x1660033, 0x1660033, 0x1660033,
+    0x1660033, 0x1660033, 0x1660033, 0x1660033, 0x1660033, 0x1660033, 0x2b63034,
+    0x2b63134, 0x2b63234, 0x2b66134, 0x2b66334, 0x2b66534, 0x2b66934, 0x2b66f34,
+    0x2b67334, 0x2b67434, 0x1660034, 0x1660034, 0x1660034, 0x1660034, 0x1660034,
+    0x1660034, 0x1660034, 0x1660034, 0x1660034, 0x1660034, 0x1660034, 0x1660034,
+    0x1660034, 0x1660034, 0x1660034, 0x1660034, 0x1660034, 0x1660034, 0x1660034,
+    0x1660034, 0x1660034, 0x1660034, 0x2b63035, 0x2b63135, 0x2b63235, 0x2b66135,
+    0x2b66335, 0x2b66535, 0x2b66935, 0x2b66f35, 0x2b67335, 0x2b67435, 0x1660035,
+    0x1660035, 0x1660035, 0x1660035, 0x1660035, 0x1660035, 0x1660035, 0x1660035,
+    0x1660035, 0x1660035, 0x1660035, 0x1660035, 0x1660035, 0x1660035, 0x1660035,
+    0x1660035, 0x1660035, 0x1660035, 0x1660035, 0x1660035, 0x1660035, 0x1660035,
+    0x2b63036, 0x2b63136, 0x2b63236, 0x2b66136, 0x2b66336, 0x2b66536, 0x2b66936,
+    0x2b66f36, 0x2b67336, 0x2b67436, 0x1660036, 0x1660036, 0x1660036, 0x1660036,
+    0x1660036, 0x1660036, 0x1660036, 0x1660036, 0x1660036, 0x1660036, 0x1660036,
+    0x1660036, 0x1660036, 0x1660036, 0x1660036, 0x1660036, 0x1660036, 0x1660036,
+    0x1660036, 0x1660036, 0x1660036, 0x1660036, 0x2b63037, 0x2b63137, 0x2b63237,
+    0x2b66137, 0x2b66337, 0x2b66537, 0x2b66937, 0x2b66f37, 0x2b67337, 0x2b67437,
+    0x1660037, 0x1660037, 0x1660037, 0x1660037, 0x1660037, 0x1660037, 0x1660037,
+    0x1660037, 0x1660037, 0x1660037, 0x1660037, 0x1660037, 0x1660037, 0x1660037,
+    0x1660037, 0x1660037, 0x1660037, 0x1660037, 0x1660037, 0x1660037, 0x1660037,
+    0x1660037, 0x2b63038, 0x2b63138, 0x2b63238, 0x2b66138, 0x2b66338, 0x2b66538,
+    0x2b66938, 0x2b66f38, 0x2b67338, 0x2b67438, 0x1660038, 0x1660038, 0x1660038,
+    0x1660038, 0x1660038, 0x1660038, 0x1660038, 0x1660038, 0x1660038, 0x1660038,
+    0x1660038, 0x1660038, 0x1660038, 0x1660038, 0x1660038, 0x1660038, 0x1660038,
+    0x1660038, 0x1660038, 0x1660038, 0x1660038, 0x1660038, 0x2b63039, 0x2b63139,
+    0x2b63239, 0x2b66139, 0x2b66339, 0x2b66539, 0x2b66939, 0x2b66f39, 0x2b67339,
+    0x2b67439, 0x1660039, 0x1660039, 0x1660039, 0x1660039, 0x1660039, 0x1660039,
+    0x1660039, 0x1660039, 0x1660039, 0x1660039, 0x1660039, 0x1660039, 0x1660039,
+    0x1660039, 0x1660039, 0x1660039, 0x1660039, 0x1660039, 0x1660039, 0x1660039,
+    0x1660039, 0x1660039, 0x2b6303d, 0x2b6313d, 0x2b6323d, 0x2b6613d, 0x2b6633d,
+    0x2b6653d, 0x2b6693d, 0x2b66f3d, 0x2b6733d, 0x2b6743d, 0x166003d, 0x166003d,
+    0x166003d, 0x166003d, 0x166003d, 0x166003d, 0x166003d, 0x166003d, 0x166003d,
+    0x166003d, 0x166003d, 0x166003d, 0x166003d, 0x166003d, 0x166003d, 0x166003d,
+    0x166003d, 0x166003d, 0x166003d, 0x166003d, 0x166003d, 0x166003d, 0x2b63041,
+    0x2b63141, 0x2b63241, 0x2b66141, 0x2b66341, 0x2b66541, 0x2b66941, 0x2b66f41,
+    0x2b67341, 0x2b67441, 0x1660041, 0x1660041, 0x1660041, 0x1660041, 0x1660041,
+    0x1660041, 0x1660041, 0x1660041, 0x1660041, 0x1660041, 0x1660041, 0x1660041,
+    0x1660041, 0x1660041, 0x1660041, 0x1660041, 0x1660041, 0x1660041, 0x1660041,
+    0x1660041, 0x1660041, 0x1660041, 0x2b6305f, 0x2b6315f, 0x2b6325f, 0x2b6615f,
+    0x2b6635f, 0x2b6655f, 0x2b6695f, 0x2b66f5f, 0x2b6735f, 0x2b6745f, 0x166005f,
+    0x166005f, 0x166005f, 0x166005f, 0x166005f, 0x166005f, 0x166005f, 0x166005f,
+    0x166005f, 0x166005f, 0x166005f, 0x166005f, 0x166005f, 0x166005f, 0x166005f,
+    0x166005f, 0x166005f, 0x166005f, 0x166005f, 0x166005f, 0x166005f, 0x166005f,
+    0x2b63062, 0x2b63162, 0x2b63262, 0x2b66162, 0x2b66362, 0x2b66562, 0x2b66962,
+    0x2b66f62, 0x2b67362, 0x2b67462, 0x1660062, 0x1660062, 0x1660062, 0x1660062,
+    0x1660062, 0x1660062, 0x1660062, 0x1660062, 0x1660062, 0x1660062, 0x1660062,
+    0x1660062, 0x1660062, 0x1660062, 0x1660062, 0x1660062, 0x1660062, 0x1660062,
+    0x1660062, 0x1660062, 0x1660062, 0x1660062, 0x2b63064, 0x2b63164, 0x2b63264,
+    0x2b66164, 0x2b66364, 0x2b66564, 0x2b66964, 0x2b66f64, 0x2b67364, 0x2b67464,
+    0x1660064, 0x1660064, 0x1660064, 0x1660064, 0x1660064, 0x1660064, 0x1660064,
+    0x1660064, 0x1660064, 0x1660064, 0x1660064, 0x1660064, 0x1660064, 0x1660064,
+    0x1660064, 0x1660064, 0x1660064, 0x1660064, 0x1660064, 0x1660064, 0x1660064,
+    0x1660064, 0x2b63066, 0x2b63166, 0x2b63266, 0x2b66166, 0x2b66366, 0x2b66566,
+    0x2b66966, 0x2b66f66, 0x2b67366, 0x2b67466, 0x1660066, 0x1660066, 0x1660066,
+    0x1660066, 0x1660066, 0x1660066, 0x1660066, 0x1660066, 0x1660066, 0x1660066,
+    0x1660066, 0x1660066, 0x1660066, 0x1660066, 0x1660066, 0x1660066, 0x1660066,
+    0x1660066, 0x1660066, 0x1660066, 0x1660066, 0x1660066, 0x2b63067, 0x2b63167,
+    0x2b63267, 0x2b66167, 0x2b66367, 0x2b66567, 0x2b66967, 0x2b66f67, 0x2b67367,
+    0x2b67467, 0x1660067, 0x1660067, 0x1660067, 0x1660067, 0x1660067, 0x1660067,
+    0x1660067, 0x1660067, 0x1660067, 0x1660067, 0x1660067, 0x1660067, 0x1660067,
+    0x1660067, 0x1660067, 0x1660067, 0x1660067, 0x1660067, 0x1660067, 0x1660067,
+    0x1660067, 0x1660067, 0x2b63068, 0x2b63168, 0x2b63268, 0x2b66168, 0x2b66368,
+    0x2b66568, 0x2b66968, 0x2b66f68, 0x2b67368, 0x2b67468, 0x1660068, 0x1660068,
+    0x1660068, 0x1660068, 0x1660068, 0x1660068, 0x1660068, 0x1660068, 0x1660068,
+    0x1660068, 0x1660068, 0x1660068, 0x1660068, 0x1660068, 0x1660068, 0x1660068,
+    0x1660068, 0x1660068, 0x1660068, 0x1660068, 0x1660068, 0x1660068, 0x2b6306c,
+    0x2b6316c, 0x2b6326c, 0x2b6616c, 0x2b6636c, 0x2b6656c, 0x2b6696c, 0x2b66f6c,
+    0x2b6736c, 0x2b6746c, 0x166006c, 0x166006c, 0x166006c, 0x166006c, 0x166006c,
+    0x166006c, 0x166006c, 0x166006c, 0x166006c, 0x166006c, 0x166006c, 0x166006c,
+    0x166006c, 0x166006c, 0x166006c, 0x166006c, 0x166006c, 0x166006c, 0x166006c,
+    0x166006c, 0x166006c, 0x166006c, 0x2b6306d, 0x2b6316d, 0x2b6326d, 0x2b6616d,
+    0x2b6636d, 0x2b6656d, 0x2b6696d, 0x2b66f6d, 0x2b6736d, 0x2b6746d, 0x166006d,
+    0x166006d, 0x166006d, 0x166006d, 0x166006d, 0x166006d, 0x166006d, 0x166006d,
+    0x166006d, 0x166006d, 0x166006d, 0x166006d, 0x166006d, 0x166006d, 0x166006d,
+    0x166006d, 0x166006d, 0x166006d, 0x166006d, 0x166006d, 0x166006d, 0x166006d,
+    0x2b6306e, 0x2b6316e, 0x2b6326e, 0x2b6616e, 0x2b6636e, 0x2b6656e, 0x2b6696e,
+    0x2b66f6e, 0x2b6736e, 0x2b6746e, 0x166006e, 0x166006e, 0x166006e, 0x166006e,
+    0x166006e, 0x166006e, 0x166006e, 0x166006e, 0x166006e, 0x166006e, 0x166006e,
+    0x166006e, 0x166006e, 0x166006e, 0x166006e, 0x166006e, 0x166006e, 0x166006e,
+    0x166006e, 0x166006e, 0x166006e, 0x166006e, 0x2b63070, 0x2b63170, 0x2b63270,
+    0x2b66170, 0x2b66370, 0x2b66570, 0x2b66970, 0x2b66f70, 0x2b67370, 0x2b67470,
+    0x1660070, 0x1660070, 0x1660070, 0x1660070, 0x1660070, 0x1660070, 0x1660070,
+    0x1660070, 0x1660070, 0x1660070, 0x1660070, 0x1660070, 0x1660070, 0x1660070,
+    0x1660070, 0x1660070, 0x1660070, 0x1660070, 0x1660070, 0x1660070, 0x1660070,
+    0x1660070, 0x2b63072, 0x2b63172, 0x2b63272, 0x2b66172, 0x2b66372, 0x2b66572,
+    0x2b66972, 0x2b66f72, 0x2b67372, 0x2b67472, 0x1660072, 0x1660072, 0x1660072,
+    0x1660072, 0x1660072, 0x1660072, 0x1660072, 0x1660072, 0x1660072, 0x1660072,
+    0x1660072, 0x1660072, 0x1660072, 0x1660072, 0x1660072, 0x1660072, 0x1660072,
+    0x1660072, 0x1660072, 0x1660072, 0x1660072, 0x1660072, 0x2b63075, 0x2b63175,
+    0x2b63275, 0x2b66175, 0x2b66375, 0x2b66575, 0x2b66975, 0x2b66f75, 0x2b67375,
+    0x2b67475, 0x1660075, 0x1660075, 0x1660075, 0x1660075, 0x1660075, 0x1660075,
+    0x1660075, 0x1660075, 0x1660075, 0x1660075, 0x1660075, 0x1660075, 0x1660075,
+    0x1660075, 0x1660075, 0x1660075, 0x1660075, 0x1660075, 0x1660075, 0x1660075,
+    0x1660075, 0x1660075, 0x177003a, 0x177003a, 0x177003a, 0x177003a, 0x177003a,
+    0x177003a, 0x177003a, 0x177003a, 0x177003a, 0x177003a, 0x177003a, 0x177003a,
+    0x177003a, 0x177003a, 0x177003a, 0x177003a, 0x1770042, 0x1770042, 0x1770042,
+    0x1770042, 0x1770042, 0x1770042, 0x1770042, 0x1770042, 0x1770042, 0x1770042,
+    0x1770042, 0x1770042, 0x1770042, 0x1770042, 0x1770042, 0x1770042, 0x1770043,
+    0x1770043, 0x1770043, 0x1770043, 0x1770043, 0x1770043, 0x1770043, 0x1770043,
+    0x1770043, 0x1770043, 0x1770043, 0x1770043, 0x1770043, 0x1770043, 0x1770043,
+    0x1770043, 0x1770044, 0x1770044, 0x1770044, 0x1770044, 0x1770044, 0x1770044,
+    0x1770044, 0x1770044, 0x1770044, 0x1770044, 0x1770044, 0x1770044, 0x1770044,
+    0x1770044, 0x1770044, 0x1770044, 0x1770045, 0x1770045, 0x1770045, 0x1770045,
+    0x1770045, 0x1770045, 0x1770045, 0x1770045, 0x1770045, 0x1770045, 0x1770045,
+    0x1770045, 0x1770045, 0x1770045, 0x1770045, 0x1770045, 0x1770046, 0x1770046,
+    0x1770046, 0x1770046, 0x1770046, 0x1770046, 0x1770046, 0x1770046, 0x1770046,
+    0x1770046, 0x1770046, 0x1770046, 0x1770046, 0x1770046, 0x1770046, 0x1770046,
+    0x1770047, 0x1770047, 0x1770047, 0x1770047, 0x1770047, 0x1770047, 0x1770047,
+    0x1770047, 0x1770047, 0x1770047, 0x1770047, 0x1770047, 0x1770047, 0x1770047,
+    0x1770047, 0x1770047, 0x1770048, 0x1770048, 0x1770048, 0x1770048, 0x1770048,
+    0x1770048, 0x1770048, 0x1770048, 0x1770048, 0x1770048, 0x1770048, 0x1770048,
+    0x1770048, 0x1770048, 0x1770048, 0x1770048, 0x1770049, 0x1770049, 0x1770049,
+    0x1770049, 0x1770049, 0x1770049, 0x1770049, 0x1770049, 0x1770049, 0x1770049,
+    0x1770049, 0x1770049, 0x1770049, 0x1770049, 0x1770049, 0x1770049, 0x177004a,
+    0x177004a, 0x177004a, 0x177004a, 0x177004a, 0x177004a, 0x177004a, 0x177004a,
+    0x177004a, 0x177004a, 0x177004a, 0x177004a, 0x177004a, 0x177004a, 0x177004a,
+    0x177004a, 0x177004b, 0x177004b, 0x177004b, 0x177004b, 0x177004b, 0x177004b,
+    0x177004b, 0x177004b, 0x177004b, 0x177004b, 0x177004b, 0x177004b, 0x177004b,
+    0x177004b, 0x177004b, 0x177004b, 0x177004c, 0x177004c, 0x177004c, 0x177004c,
+    0x177004c, 0x177004c, 0x177004c, 0x177004c, 0x177004c, 0x177004c, 0x177004c,
+    0x177004c, 0x177004c, 0x177004c, 0x177004c, 0x177004c, 0x177004d, 0x177004d,
+    0x177004d, 0x177004d, 0x177004d, 0x177004d, 0x177004d, 0x177004d, 0x177004d,
+    0x177004d, 0x177004d, 0x177004d, 0x177004d, 0x177004d, 0x177004d, 0x177004d,
+    0x177004e, 0x177004e, 0x177004e, 0x177004e, 0x177004e, 0x177004e, 0x177004e,
+    0x177004e, 0x177004e, 0x177004e, 0x177004e, 0x177004e, 0x177004e, 0x177004e,
+    0x177004e, 0x177004e, 0x177004f, 0x177004f, 0x177004f, 0x177004f, 0x177004f,
+    0x177004f, 0x177004f, 0x177004f, 0x177004f, 0x177004f, 0x177004f, 0x177004f,
+    0x177004f, 0x177004f, 0x177004f, 0x177004f, 0x1770050, 0x1770050, 0x1770050,
+    0x1770050, 0x1770050, 0x1770050, 0x1770050, 0x1770050, 0x1770050, 0x1770050,
+    0x1770050, 0x1770050, 0x1770050, 0x1770050, 0x1770050, 0x1770050, 0x1770051,
+    0x1770051, 0x1770051, 0x1770051, 0x1770051, 0x1770051, 0x1770051, 0x1770051,
+    0x1770051, 0x1770051, 0x1770051, 0x1770051, 0x1770051, 0x1770051, 0x1770051,
+    0x1770051, 0x1770052, 0x1770052, 0x1770052, 0x1770052, 0x1770052, 0x1770052,
+    0x1770052, 0x1770052, 0x1770052, 0x1770052, 0x1770052, 0x1770052, 0x1770052,
+    0x1770052, 0x1770052, 0x1770052, 0x1770053, 0x1770053, 0x1770053, 0x1770053,
+    0x1770053, 0x1770053, 0x1770053, 0x1770053, 0x1770053, 0x1770053, 0x1770053,
+    0x1770053, 0x1770053, 0x1770053, 0x1770053, 0x1770053, 0x1770054, 0x1770054,
+    0x1770054, 0x1770054, 0x1770054, 0x1770054, 0x1770054, 0x1770054, 0x1770054,
+    0x1770054, 0x1770054, 0x1770054, 0x1770054, 0x1770054, 0x1770054, 0x1770054,
+    0x1770055, 0x1770055, 0x1770055, 0x1770055, 0x1770055, 0x1770055, 0x1770055,
+    0x1770055, 0x1770055, 0x1770055, 0x1770055, 0x1770055, 0x1770055, 0x1770055,
+    0x1770055, 0x1770055, 0x1770056, 0x1770056, 0x1770056, 0x1770056, 0x1770056,
+    0x1770056, 0x1770056, 0x1770056, 0x1770056, 0x1770056, 0x1770056, 0x1770056,
+    0x1770056, 0x1770056, 0x1770056, 0x1770056, 0x1770057, 0x1770057, 0x1770057,
+    0x1770057, 0x1770057, 0x1770057, 0x1770057, 0x1770057, 0x1770057, 0x1770057,
+    0x1770057, 0x1770057, 0x1770057, 0x1770057, 0x1770057, 0x1770057, 0x1770059,
+    0x1770059, 0x1770059, 0x1770059, 0x1770059, 0x1770059, 0x1770059, 0x1770059,
+    0x1770059, 0x1770059, 0x1770059, 0x1770059, 0x1770059, 0x1770059, 0x1770059,
+    0x1770059, 0x177006a, 0x177006a, 0x177006a, 0x177006a, 0x177006a, 0x177006a,
+    0x177006a, 0x177006a, 0x177006a, 0x177006a, 0x177006a, 0x177006a, 0x177006a,
+    0x177006a, 0x177006a, 0x177006a, 0x177006b, 0x177006b, 0x177006b, 0x177006b,
+    0x177006b, 0x177006b, 0x177006b, 0x177006b, 0x177006b, 0x177006b, 0x177006b,
+    0x177006b, 0x177006b, 0x177006b, 0x177006b, 0x177006b, 0x1770071, 0x1770071,
+    0x1770071, 0x1770071, 0x1770071, 0x1770071, 0x1770071, 0x1770071, 0x1770071,
+    0x1770071, 0x1770071, 0x1770071, 0x1770071, 0x1770071, 0x1770071, 0x1770071,
+    0x1770076, 0x1770076, 0x1770076, 0x1770076, 0x1770076, 0x1770076, 0x1770076,
+    0x1770076, 0x1770076, 0x1770076, 0x1770076, 0x1770076, 0x1770076, 0x1770076,
+    0x1770076, 0x1770076, 0x1770077, 0x1770077, 0x1770077, 0x1770077, 0x1770077,
+    0x1770077, 0x1770077, 0x1770077, 0x1770077, 0x1770077, 0x1770077, 0x1770077,
+    0x1770077, 0x1770077, 0x1770077, 0x1770077, 0x1770078, 0x1770078, 0x1770078,
+    0x1770078, 0x1770078, 0x1770078, 0x1770078, 0x1770078, 0x1770078, 0x1770078,
+    0x1770078, 0x1770078, 0x1770078, 0x1770078, 0x1770078, 0x1770078, 0x1770079,
+    0x1770079, 0x1770079, 0x1770079, 0x1770079, 0x1770079, 0x1770079, 0x1770079,
+    0x1770079, 0x1770079, 0x1770079, 0x1770079, 0x1770079, 0x1770079, 0x1770079,
+    0x1770079, 0x177007a, 0x177007a, 0x177007a, 0x177007a, 0x177007a, 0x177007a,
+    0x177007a, 0x177007a, 0x177007a, 0x177007a, 0x177007a, 0x177007a, 0x177007a,
+    0x177007a, 0x177007a, 0x177007a, 0x1880026, 0x1880026, 0x1880026, 0x1880026,
+    0x1880026, 0x1880026, 0x1880026, 0x1880026, 0x188002a, 0x188002a, 0x188002a,
+    0x188002a, 0x188002a, 0x188002a, 0x188002a, 0x188002a, 0x188002c, 0x188002c,
+    0x188002c, 0x188002c, 0x188002c, 0x188002c, 0x188002c, 0x188002c, 0x188003b,
+    0x188003b, 0x188003b, 0x188003b, 0x188003b, 0x188003b, 0x188003b, 0x188003b,
+    0x1880058, 0x1880058, 0x1880058, 0x1880058, 0x1880058, 0x1880058, 0x1880058,
+    0x1880058, 0x188005a, 0x188005a, 0x188005a, 0x188005a, 0x188005a, 0x188005a,
+    0x188005a, 0x188005a, 0x1aa0021, 0x1aa0021, 0x1aa0022, 0x1aa0022, 0x1aa0028,
+    0x1aa0028, 0x1aa0029, 0x1aa0029, 0x1aa003f, 0x1aa003f, 0x1bb0027, 0x1bb002b,
+    0x1bb007c, 0x0,       0x0,       0x0,
 };
 
-/* next state, based upon current state and the current nibble: see above.
-   generated by gen_hpack_tables.c */
-static const int16_t next_sub_tbl[48 * 16] = {
-    1,   204, 205, 206, 207, 208, 209, 210, 211, 212, 213, 214, 215, 216, 217,
-    218, 2,   6,   10,  13,  14,  15,  16,  17,  2,   6,   10,  13,  14,  15,
-    16,  17,  3,   7,   11,  24,  3,   7,   11,  24,  3,   7,   11,  24,  3,
-    7,   11,  24,  4,   8,   4,   8,   4,   8,   4,   8,   4,   8,   4,   8,
-    4,   8,   4,   8,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   5,
-    199, 200, 201, 202, 203, 4,   8,   4,   8,   0,   0,   0,   0,   0,   0,
-    0,   0,   0,   0,   0,   0,   9,   133, 134, 135, 136, 137, 138, 139, 140,
-    141, 142, 143, 144, 145, 146, 147, 3,   7,   11,  24,  3,   7,   11,  24,
-    4,   8,   4,   8,   4,   8,   4,   8,   0,   0,   0,   0,   0,   0,   0,
-    0,   0,   0,   0,   0,   0,   0,   12,  132, 4,   8,   4,   8,   4,   8,
-    4,   8,   4,   8,   4,   8,   0,   0,   0,   0,   0,   0,   0,   0,   0,
-    0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
-    0,   0,   0,   0,   0,   0,   0,   0,   18,  19,  20,  21,  4,   8,   4,
-    8,   4,   8,   4,   8,   4,   8,   0,   0,   0,   22,  23,  91,  25,  26,
-    27,  28,  29,  30,  31,  32,  33,  34,  35,  36,  37,  38,  39,  40,  3,
-    7,   11,  24,  3,   7,   11,  24,  0,   0,   0,   0,   0,   41,  42,  43,
-    2,   6,   10,  13,  14,  15,  16,  17,  3,   7,   11,  24,  3,   7,   11,
-    24,  4,   8,   4,   8,   4,   8,   4,   8,   4,   8,   4,   8,   0,   0,
-    44,  45,  2,   6,   10,  13,  14,  15,  16,  17,  46,  47,  48,  49,  50,
-    51,  52,  57,  4,   8,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
-    0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
-    0,   53,  54,  55,  56,  58,  59,  60,  61,  62,  63,  64,  65,  66,  67,
-    68,  69,  70,  71,  72,  74,  0,   0,   0,   0,   0,   0,   0,   0,   0,
-    0,   0,   0,   0,   0,   0,   73,  75,  76,  77,  78,  79,  80,  81,  82,
-    83,  84,  85,  86,  87,  88,  89,  90,  3,   7,   11,  24,  3,   7,   11,
-    24,  3,   7,   11,  24,  0,   0,   0,   0,   3,   7,   11,  24,  3,   7,
-    11,  24,  4,   8,   4,   8,   0,   0,   0,   92,  0,   0,   0,   93,  94,
-    95,  96,  97,  98,  99,  100, 101, 102, 103, 104, 105, 3,   7,   11,  24,
-    4,   8,   4,   8,   4,   8,   4,   8,   4,   8,   4,   8,   4,   8,   4,
-    8,   4,   8,   4,   8,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
-    0,   0,   0,   106, 107, 108, 109, 110, 111, 112, 113, 114, 115, 116, 4,
-    8,   4,   8,   4,   8,   4,   8,   4,   8,   4,   8,   4,   8,   0,   0,
-    0,   117, 118, 119, 120, 121, 122, 123, 124, 125, 126, 127, 128, 129, 130,
-    131, 2,   6,   10,  13,  14,  15,  16,  17,  4,   8,   4,   8,   4,   8,
-    4,   8,   4,   8,   4,   8,   4,   8,   4,   8,   4,   8,   4,   8,   148,
-    149, 150, 151, 3,   7,   11,  24,  4,   8,   4,   8,   0,   0,   0,   0,
-    0,   0,   152, 153, 3,   7,   11,  24,  3,   7,   11,  24,  3,   7,   11,
-    24,  154, 155, 156, 164, 3,   7,   11,  24,  3,   7,   11,  24,  3,   7,
-    11,  24,  4,   8,   4,   8,   0,   0,   0,   0,   0,   0,   0,   0,   0,
-    157, 158, 159, 160, 161, 162, 163, 165, 166, 167, 168, 169, 170, 171, 172,
-    173, 174, 175, 176, 177, 178, 179, 180, 181, 182, 183, 184, 185, 186, 187,
-    188, 189, 190, 191, 192, 193, 194, 195, 196, 4,   8,   4,   8,   4,   8,
-    4,   8,   4,   8,   4,   8,   4,   8,   197, 198, 4,   8,   4,   8,   4,
-    8,   4,   8,   0,   0,   0,   0,   0,   0,   219, 220, 3,   7,   11,  24,
-    4,   8,   4,   8,   4,   8,   0,   0,   221, 222, 223, 224, 3,   7,   11,
-    24,  3,   7,   11,  24,  4,   8,   4,   8,   4,   8,   225, 228, 4,   8,
-    4,   8,   4,   8,   0,   0,   0,   0,   0,   0,   0,   0,   226, 227, 229,
-    230, 231, 232, 233, 234, 235, 236, 237, 238, 239, 240, 241, 242, 243, 244,
-    4,   8,   4,   8,   4,   8,   4,   8,   4,   8,   0,   0,   0,   0,   0,
-    0,   0,   0,   0,   0,   0,   0,   245, 246, 247, 248, 249, 250, 251, 252,
-    253, 254, 0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
-    0,   0,   255,
+/* symbols (including EOS, 256) whose codes are longer than 11 bits, ordered
+   by code: the hpack code is canonical, so the codes of a given length are
+   consecutive.
+
+   generated by gen_hpack_tables.cc */
+static const int16_t huff_long_syms[175] = {
+    35,  62,  0,   36,  64,  91,  93,  126, 94,  125, 60,  96,  123, 92,  195,
+    208, 128, 130, 131, 162, 184, 194, 224, 226, 153, 161, 167, 172, 176, 177,
+    179, 209, 216, 217, 227, 229, 230, 129, 132, 133, 134, 136, 146, 154, 156,
+    160, 163, 164, 169, 170, 173, 178, 181, 185, 186, 187, 189, 190, 196, 198,
+    228, 232, 233, 1,   135, 137, 138, 139, 140, 141, 143, 147, 149, 150, 151,
+    152, 155, 157, 158, 165, 166, 168, 174, 175, 180, 182, 183, 188, 191, 197,
+    231, 239, 9,   142, 144, 145, 148, 159, 171, 206, 215, 225, 236, 237, 199,
+    207, 234, 235, 192, 193, 200, 201, 202, 205, 210, 213, 218, 219, 238, 240,
+    242, 243, 255, 203, 204, 211, 212, 214, 221, 222, 223, 241, 244, 245, 246,
+    247, 248, 250, 251, 252, 253, 254, 2,   3,   4,   5,   6,   7,   8,   11,
+    12,  14,  15,  16,  17,  18,  19,  20,  21,  23,  24,  25,  26,  27,  28,
+    29,  30,  31,  127, 220, 249, 10,  13,  22,  256,
 };
 
-/* emission table: indexed like next_tbl, ultimately gives the byte to be
-   emitted, or -1 for no byte, or 256 for end of stream
-
-   generated by gen_hpack_tables.c */
-static const uint16_t emit_tbl[256] = {
-    0,   1,   2,   3,   4,   5,   6,   7,   0,   8,   9,   10,  11,  12,  13,
-    14,  15,  16,  17,  18,  19,  20,  21,  22,  0,   23,  24,  25,  26,  27,
-    28,  29,  30,  31,  32,  33,  34,  35,  36,  37,  38,  39,  40,  41,  42,
-    43,  44,  45,  46,  47,  48,  49,  50,  51,  52,  53,  54,  0,   55,  56,
-    57,  58,  59,  60,  61,  62,  63,  64,  65,  66,  67,  68,  69,  70,  0,
-    71,  72,  73,  74,  75,  76,  77,  78,  79,  80,  81,  82,  83,  84,  85,
-    86,  87,  88,  89,  90,  91,  92,  93,  94,  95,  96,  97,  98,  99,  100,
-    101, 102, 103, 104, 105, 106, 107, 108, 109, 110, 111, 112, 113, 114, 115,
-    116, 117, 118, 119, 120, 121, 122, 123, 124, 125, 126, 127, 128, 129, 130,
-    131, 132, 133, 134, 135, 136, 137, 138, 139, 140, 141, 142, 143, 144, 145,
-    146, 147, 148, 149, 150, 151, 152, 153, 154, 155, 156, 157, 158, 159, 0,
-    160, 161, 162, 163, 164, 165, 166, 167, 168, 169, 170, 171, 172, 173, 174,
-    0,   175, 176, 177, 178, 179, 180, 181, 182, 183, 184, 185, 186, 187, 188,
-    189, 190, 191, 192, 193, 194, 195, 196, 197, 198, 199, 200, 201, 202, 203,
-    204, 205, 206, 207, 208, 209, 210, 211, 212, 213, 214, 215, 216, 217, 218,
-    219, 220, 221, 0,   222, 223, 224, 225, 226, 227, 228, 229, 230, 231, 232,
-    233, 234, 235, 236, 237, 238, 239, 240, 241, 242, 243, 244, 245, 246, 247,
-    248,
+/* for each code length: one past the last code of that length, left aligned
+   in 32 bits (the entry for the longest length is never consulted)
+
+   generated by gen_hpack_tables.cc */
+static const uint32_t huff_long_limit[31] = {
+    0x0,        0x0,        0x0,        0x0,        0x0,        0x50000000,
+    0xb8000000, 0xf8000000, 0xfe000000, 0xfe000000, 0xff400000, 0xffa00000,
+    0xffc00000, 0xfff00000, 0xfff80000, 0xfffe0000, 0xfffe0000, 0xfffe0000,
+    0xfffe0000, 0xfffe6000, 0xfffee000, 0xffff4800, 0xffffb000, 0xffffea00,
+    0xfffff600, 0xfffff800, 0xfffffbc0, 0xfffffe20, 0xfffffff0, 0xfffffff0,
+    0xffffffff,
 };
 
-/* generated by gen_hpack_tables.c */
-static const int16_t emit_sub_tbl[249 * 16] = {
-    -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,
-    -1,  48,  48,  48,  48,  48,  48,  48,  48,  49,  49,  49,  49,  49,  49,
-    49,  49,  48,  48,  48,  48,  49,  49,  49,  49,  50,  50,  50,  50,  97,
-    97,  97,  97,  48,  48,  49,  49,  50,  50,  97,  97,  99,  99,  101, 101,
-    105, 105, 111, 111, 48,  49,  50,  97,  99,  101, 105, 111, 115, 116, -1,
-    -1,  -1,  -1,  -1,  -1,  32,  32,  32,  32,  32,  32,  32,  32,  37,  37,
-    37,  37,  37,  37,  37,  37,  99,  99,  99,  99,  101, 101, 101, 101, 105,
-    105, 105, 105, 111, 111, 111, 111, 115, 115, 116, 116, 32,  37,  45,  46,
-    47,  51,  52,  53,  54,  55,  56,  57,  61,  61,  61,  61,  61,  61,  61,
-    61,  65,  65,  65,  65,  65,  65,  65,  65,  115, 115, 115, 115, 116, 116,
-    116, 116, 32,  32,  37,  37,  45,  45,  46,  46,  61,  65,  95,  98,  100,
-    102, 103, 104, 108, 109, 110, 112, 114, 117, -1,  -1,  58,  58,  58,  58,
-    58,  58,  58,  58,  66,  66,  66,  66,  66,  66,  66,  66,  47,  47,  51,
-    51,  52,  52,  53,  53,  54,  54,  55,  55,  56,  56,  57,  57,  61,  61,
-    65,  65,  95,  95,  98,  98,  100, 100, 102, 102, 103, 103, 104, 104, 108,
-    108, 109, 109, 110, 110, 112, 112, 114, 114, 117, 117, 58,  66,  67,  68,
-    69,  70,  71,  72,  73,  74,  75,  76,  77,  78,  79,  80,  81,  82,  83,
-    84,  85,  86,  87,  89,  106, 107, 113, 118, 119, 120, 121, 122, -1,  -1,
-    -1,  -1,  38,  38,  38,  38,  38,  38,  38,  38,  42,  42,  42,  42,  42,
-    42,  42,  42,  44,  44,  44,  44,  44,  44,  44,  44,  59,  59,  59,  59,
-    59,  59,  59,  59,  88,  88,  88,  88,  88,  88,  88,  88,  90,  90,  90,
-    90,  90,  90,  90,  90,  33,  33,  34,  34,  40,  40,  41,  41,  63,  63,
-    39,  43,  124, -1,  -1,  -1,  35,  35,  35,  35,  35,  35,  35,  35,  62,
-    62,  62,  62,  62,  62,  62,  62,  0,   0,   0,   0,   36,  36,  36,  36,
-    64,  64,  64,  64,  91,  91,  91,  91,  69,  69,  69,  69,  69,  69,  69,
-    69,  70,  70,  70,  70,  70,  70,  70,  70,  71,  71,  71,  71,  71,  71,
-    71,  71,  72,  72,  72,  72,  72,  72,  72,  72,  73,  73,  73,  73,  73,
-    73,  73,  73,  74,  74,  74,  74,  74,  74,  74,  74,  75,  75,  75,  75,
-    75,  75,  75,  75,  76,  76,  76,  76,  76,  76,  76,  76,  77,  77,  77,
-    77,  77,  77,  77,  77,  78,  78,  78,  78,  78,  78,  78,  78,  79,  79,
-    79,  79,  79,  79,  79,  79,  80,  80,  80,  80,  80,  80,  80,  80,  81,
-    81,  81,  81,  81,  81,  81,  81,  82,  82,  82,  82,  82,  82,  82,  82,
-    83,  83,  83,  83,  83,  83,  83,  83,  84,  84,  84,  84,  84,  84,  84,
-    84,  85,  85,  85,  85,  85,  85,  85,  85,  86,  86,  86,  86,  86,  86,
-    86,  86,  87,  87,  87,  87,  87,  87,  87,  87,  89,  89,  89,  89,  89,
-    89,  89,  89,  106, 106, 106, 106, 106, 106, 106, 106, 107, 107, 107, 107,
-    107, 107, 107, 107, 113, 113, 113, 113, 113, 113, 113, 113, 118, 118, 118,
-    118, 118, 118, 118, 118, 119, 119, 119, 119, 119, 119, 119, 119, 120, 120,
-    120, 120, 120, 120, 120, 120, 121, 121, 121, 121, 121, 121, 121, 121, 122,
-    122, 122, 122, 122, 122, 122, 122, 38,  38,  38,  38,  42,  42,  42,  42,
-    44,  44,  44,  44,  59,  59,  59,  59,  88,  88,  88,  88,  90,  90,  90,
-    90,  33,  34,  40,  41,  63,  -1,  -1,  -1,  39,  39,  39,  39,  39,  39,
-    39,  39,  43,  43,  43,  43,  43,  43,  43,  43,  124, 124, 124, 124, 124,
-    124, 124, 124, 35,  35,  35,  35,  62,  62,  62,  62,  0,   0,   36,  36,
-    64,  64,  91,  91,  93,  93,  126, 126, 94,  125, -1,  -1,  60,  60,  60,
-    60,  60,  60,  60,  60,  96,  96,  96,  96,  96,  96,  96,  96,  123, 123,
-    123, 123, 123, 123, 123, 123, -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  92,
-    92,  92,  92,  92,  92,  92,  92,  195, 195, 195, 195, 195, 195, 195, 195,
-    208, 208, 208, 208, 208, 208, 208, 208, 128, 128, 128, 128, 130, 130, 130,
-    130, 131, 131, 131, 131, 162, 162, 162, 162, 184, 184, 184, 184, 194, 194,
-    194, 194, 224, 224, 224, 224, 226, 226, 226, 226, 153, 153, 161, 161, 167,
-    167, 172, 172, 176, 176, 177, 177, 179, 179, 209, 209, 216, 216, 217, 217,
-    227, 227, 229, 229, 230, 230, 129, 132, 133, 134, 136, 146, 154, 156, 160,
-    163, 164, 169, 170, 173, 178, 181, 185, 186, 187, 189, 190, 196, 198, 228,
-    232, 233, -1,  -1,  -1,  -1,  1,   1,   1,   1,   1,   1,   1,   1,   135,
-    135, 135, 135, 135, 135, 135, 135, 137, 137, 137, 137, 137, 137, 137, 137,
-    138, 138, 138, 138, 138, 138, 138, 138, 139, 139, 139, 139, 139, 139, 139,
-    139, 140, 140, 140, 140, 140, 140, 140, 140, 141, 141, 141, 141, 141, 141,
-    141, 141, 143, 143, 143, 143, 143, 143, 143, 143, 147, 147, 147, 147, 147,
-    147, 147, 147, 149, 149, 149, 149, 149, 149, 149, 149, 150, 150, 150, 150,
-    150, 150, 150, 150, 151, 151, 151, 151, 151, 151, 151, 151, 152, 152, 152,
-    152, 152, 152, 152, 152, 155, 155, 155, 155, 155, 155, 155, 155, 157, 157,
-    157, 157, 157, 157, 157, 157, 158, 158, 158, 158, 158, 158, 158, 158, 165,
-    165, 165, 165, 165, 165, 165, 165, 166, 166, 166, 166, 166, 166, 166, 166,
-    168, 168, 168, 168, 168, 168, 168, 168, 174, 174, 174, 174, 174, 174, 174,
-    174, 175, 175, 175, 175, 175, 175, 175, 175, 180, 180, 180, 180, 180, 180,
-    180, 180, 182, 182, 182, 182, 182, 182, 182, 182, 183, 183, 183, 183, 183,
-    183, 183, 183, 188, 188, 188, 188, 188, 188, 188, 188, 191, 191, 191, 191,
-    191, 191, 191, 191, 197, 197, 197, 197, 197, 197, 197, 197, 231, 231, 231,
-    231, 231, 231, 231, 231, 239, 239, 239, 239, 239, 239, 239, 239, 9,   9,
-    9,   9,   142, 142, 142, 142, 144, 144, 144, 144, 145, 145, 145, 145, 148,
-    148, 148, 148, 159, 159, 159, 159, 171, 171, 171, 171, 206, 206, 206, 206,
-    215, 215, 215, 215, 225, 225, 225, 225, 236, 236, 236, 236, 237, 237, 237,
-    237, 199, 199, 207, 207, 234, 234, 235, 235, 192, 193, 200, 201, 202, 205,
-    210, 213, 218, 219, 238, 240, 242, 243, 255, -1,  203, 203, 203, 203, 203,
-    203, 203, 203, 204, 204, 204, 204, 204, 204, 204, 204, 211, 211, 211, 211,
-    211, 211, 211, 211, 212, 212, 212, 212, 212, 212, 212, 212, 214, 214, 214,
-    214, 214, 214, 214, 214, 221, 221, 221, 221, 221, 221, 221, 221, 222, 222,
-    222, 222, 222, 222, 222, 222, 223, 223, 223, 223, 223, 223, 223, 223, 241,
-    241, 241, 241, 241, 241, 241, 241, 244, 244, 244, 244, 244, 244, 244, 244,
-    245, 245, 245, 245, 245, 245, 245, 245, 246, 246, 246, 246, 246, 246, 246,
-    246, 247, 247, 247, 247, 247, 247, 247, 247, 248, 248, 248, 248, 248, 248,
-    248, 248, 250, 250, 250, 250, 250, 250, 250, 250, 251, 251, 251, 251, 251,
-    251, 251, 251, 252, 252, 252, 252, 252, 252, 252, 252, 253, 253, 253, 253,
-    253, 253, 253, 253, 254, 254, 254, 254, 254, 254, 254, 254, 2,   2,   2,
-    2,   3,   3,   3,   3,   4,   4,   4,   4,   5,   5,   5,   5,   6,   6,
-    6,   6,   7,   7,   7,   7,   8,   8,   8,   8,   11,  11,  11,  11,  12,
-    12,  12,  12,  14,  14,  14,  14,  15,  15,  15,  15,  16,  16,  16,  16,
-    17,  17,  17,  17,  18,  18,  18,  18,  19,  19,  19,  19,  20,  20,  20,
-    20,  21,  21,  21,  21,  23,  23,  23,  23,  24,  24,  24,  24,  25,  25,
-    25,  25,  26,  26,  26,  26,  27,  27,  27,  27,  28,  28,  28,  28,  29,
-    29,  29,  29,  30,  30,  30,  30,  31,  31,  31,  31,  127, 127, 127, 127,
-    220, 220, 220, 220, 249, 249, 249, 249, 10,  13,  22,  256, 93,  93,  93,
-    93,  126, 126, 126, 126, 94,  94,  125, 125, 60,  96,  123, -1,  92,  195,
-    208, -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  128,
-    128, 128, 128, 128, 128, 128, 128, 130, 130, 130, 130, 130, 130, 130, 130,
-    131, 131, 131, 131, 131, 131, 131, 131, 162, 162, 162, 162, 162, 162, 162,
-    162, 184, 184, 184, 184, 184, 184, 184, 184, 194, 194, 194, 194, 194, 194,
-    194, 194, 224, 224, 224, 224, 224, 224, 224, 224, 226, 226, 226, 226, 226,
-    226, 226, 226, 153, 153, 153, 153, 161, 161, 161, 161, 167, 167, 167, 167,
-    172, 172, 172, 172, 176, 176, 176, 176, 177, 177, 177, 177, 179, 179, 179,
-    179, 209, 209, 209, 209, 216, 216, 216, 216, 217, 217, 217, 217, 227, 227,
-    227, 227, 229, 229, 229, 229, 230, 230, 230, 230, 129, 129, 132, 132, 133,
-    133, 134, 134, 136, 136, 146, 146, 154, 154, 156, 156, 160, 160, 163, 163,
-    164, 164, 169, 169, 170, 170, 173, 173, 178, 178, 181, 181, 185, 185, 186,
-    186, 187, 187, 189, 189, 190, 190, 196, 196, 198, 198, 228, 228, 232, 232,
-    233, 233, 1,   135, 137, 138, 139, 140, 141, 143, 147, 149, 150, 151, 152,
-    155, 157, 158, 165, 166, 168, 174, 175, 180, 182, 183, 188, 191, 197, 231,
-    239, -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  9,   9,   9,
-    9,   9,   9,   9,   9,   142, 142, 142, 142, 142, 142, 142, 142, 144, 144,
-    144, 144, 144, 144, 144, 144, 145, 145, 145, 145, 145, 145, 145, 145, 148,
-    148, 148, 148, 148, 148, 148, 148, 159, 159, 159, 159, 159, 159, 159, 159,
-    171, 171, 171, 171, 171, 171, 171, 171, 206, 206, 206, 206, 206, 206, 206,
-    206, 215, 215, 215, 215, 215, 215, 215, 215, 225, 225, 225, 225, 225, 225,
-    225, 225, 236, 236, 236, 236, 236, 236, 236, 236, 237, 237, 237, 237, 237,
-    237, 237, 237, 199, 199, 199, 199, 207, 207, 207, 207, 234, 234, 234, 234,
-    235, 235, 235, 235, 192, 192, 193, 193, 200, 200, 201, 201, 202, 202, 205,
-    205, 210, 210, 213, 213, 218, 218, 219, 219, 238, 238, 240, 240, 242, 242,
-    243, 243, 255, 255, 203, 204, 211, 212, 214, 221, 222, 223, 241, 244, 245,
-    246, 247, 248, 250, 251, 252, 253, 254, -1,  -1,  -1,  -1,  -1,  -1,  -1,
-    -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  2,   2,   2,   2,   2,   2,   2,
-    2,   3,   3,   3,   3,   3,   3,   3,   3,   4,   4,   4,   4,   4,   4,
-    4,   4,   5,   5,   5,   5,   5,   5,   5,   5,   6,   6,   6,   6,   6,
-    6,   6,   6,   7,   7,   7,   7,   7,   7,   7,   7,   8,   8,   8,   8,
-    8,   8,   8,   8,   11,  11,  11,  11,  11,  11,  11,  11,  12,  12,  12,
-    12,  12,  12,  12,  12,  14,  14,  14,  14,  14,  14,  14,  14,  15,  15,
-    15,  15,  15,  15,  15,  15,  16,  16,  16,  16,  16,  16,  16,  16,  17,
-    17,  17,  17,  17,  17,  17,  17,  18,  18,  18,  18,  18,  18,  18,  18,
-    19,  19,  19,  19,  19,  19,  19,  19,  20,  20,  20,  20,  20,  20,  20,
-    20,  21,  21,  21,  21,  21,  21,  21,  21,  23,  23,  23,  23,  23,  23,
-    23,  23,  24,  24,  24,  24,  24,  24,  24,  24,  25,  25,  25,  25,  25,
-    25,  25,  25,  26,  26,  26,  26,  26,  26,  26,  26,  27,  27,  27,  27,
-    27,  27,  27,  27,  28,  28,  28,  28,  28,  28,  28,  28,  29,  29,  29,
-    29,  29,  29,  29,  29,  30,  30,  30,  30,  30,  30,  30,  30,  31,  31,
-    31,  31,  31,  31,  31,  31,  127, 127, 127, 127, 127, 127, 127, 127, 220,
-    220, 220, 220, 220, 220, 220, 220, 249, 249, 249, 249, 249, 249, 249, 249,
-    10,  10,  13,  13,  22,  22,  256, 256, 67,  67,  67,  67,  67,  67,  67,
-    67,  68,  68,  68,  68,  68,  68,  68,  68,  95,  95,  95,  95,  95,  95,
-    95,  95,  98,  98,  98,  98,  98,  98,  98,  98,  100, 100, 100, 100, 100,
-    100, 100, 100, 102, 102, 102, 102, 102, 102, 102, 102, 103, 103, 103, 103,
-    103, 103, 103, 103, 104, 104, 104, 104, 104, 104, 104, 104, 108, 108, 108,
-    108, 108, 108, 108, 108, 109, 109, 109, 109, 109, 109, 109, 109, 110, 110,
-    110, 110, 110, 110, 110, 110, 112, 112, 112, 112, 112, 112, 112, 112, 114,
-    114, 114, 114, 114, 114, 114, 114, 117, 117, 117, 117, 117, 117, 117, 117,
-    58,  58,  58,  58,  66,  66,  66,  66,  67,  67,  67,  67,  68,  68,  68,
-    68,  69,  69,  69,  69,  70,  70,  70,  70,  71,  71,  71,  71,  72,  72,
-    72,  72,  73,  73,  73,  73,  74,  74,  74,  74,  75,  75,  75,  75,  76,
-    76,  76,  76,  77,  77,  77,  77,  78,  78,  78,  78,  79,  79,  79,  79,
-    80,  80,  80,  80,  81,  81,  81,  81,  82,  82,  82,  82,  83,  83,  83,
-    83,  84,  84,  84,  84,  85,  85,  85,  85,  86,  86,  86,  86,  87,  87,
-    87,  87,  89,  89,  89,  89,  106, 106, 106, 106, 107, 107, 107, 107, 113,
-    113, 113, 113, 118, 118, 118, 118, 119, 119, 119, 119, 120, 120, 120, 120,
-    121, 121, 121, 121, 122, 122, 122, 122, 38,  38,  42,  42,  44,  44,  59,
-    59,  88,  88,  90,  90,  -1,  -1,  -1,  -1,  33,  33,  33,  33,  33,  33,
-    33,  33,  34,  34,  34,  34,  34,  34,  34,  34,  40,  40,  40,  40,  40,
-    40,  40,  40,  41,  41,  41,  41,  41,  41,  41,  41,  63,  63,  63,  63,
-    63,  63,  63,  63,  39,  39,  39,  39,  43,  43,  43,  43,  124, 124, 124,
-    124, 35,  35,  62,  62,  0,   36,  64,  91,  93,  126, -1,  -1,  94,  94,
-    94,  94,  94,  94,  94,  94,  125, 125, 125, 125, 125, 125, 125, 125, 60,
-    60,  60,  60,  96,  96,  96,  96,  123, 123, 123, 123, -1,  -1,  -1,  -1,
-    92,  92,  92,  92,  195, 195, 195, 195, 208, 208, 208, 208, 128, 128, 130,
-    130, 131, 131, 162, 162, 184, 184, 194, 194, 224, 224, 226, 226, 153, 161,
-    167, 172, 176, 177, 179, 209, 216, 217, 227, 229, 230, -1,  -1,  -1,  -1,
-    -1,  -1,  -1,  129, 129, 129, 129, 129, 129, 129, 129, 132, 132, 132, 132,
-    132, 132, 132, 132, 133, 133, 133, 133, 133, 133, 133, 133, 134, 134, 134,
-    134, 134, 134, 134, 134, 136, 136, 136, 136, 136, 136, 136, 136, 146, 146,
-    146, 146, 146, 146, 146, 146, 154, 154, 154, 154, 154, 154, 154, 154, 156,
-    156, 156, 156, 156, 156, 156, 156, 160, 160, 160, 160, 160, 160, 160, 160,
-    163, 163, 163, 163, 163, 163, 163, 163, 164, 164, 164, 164, 164, 164, 164,
-    164, 169, 169, 169, 169, 169, 169, 169, 169, 170, 170, 170, 170, 170, 170,
-    170, 170, 173, 173, 173, 173, 173, 173, 173, 173, 178, 178, 178, 178, 178,
-    178, 178, 178, 181, 181, 181, 181, 181, 181, 181, 181, 185, 185, 185, 185,
-    185, 185, 185, 185, 186, 186, 186, 186, 186, 186, 186, 186, 187, 187, 187,
-    187, 187, 187, 187, 187, 189, 189, 189, 189, 189, 189, 189, 189, 190, 190,
-    190, 190, 190, 190, 190, 190, 196, 196, 196, 196, 196, 196, 196, 196, 198,
-    198, 198, 198, 198, 198, 198, 198, 228, 228, 228, 228, 228, 228, 228, 228,
-    232, 232, 232, 232, 232, 232, 232, 232, 233, 233, 233, 233, 233, 233, 233,
-    233, 1,   1,   1,   1,   135, 135, 135, 135, 137, 137, 137, 137, 138, 138,
-    138, 138, 139, 139, 139, 139, 140, 140, 140, 140, 141, 141, 141, 141, 143,
-    143, 143, 143, 147, 147, 147, 147, 149, 149, 149, 149, 150, 150, 150, 150,
-    151, 151, 151, 151, 152, 152, 152, 152, 155, 155, 155, 155, 157, 157, 157,
-    157, 158, 158, 158, 158, 165, 165, 165, 165, 166, 166, 166, 166, 168, 168,
-    168, 168, 174, 174, 174, 174, 175, 175, 175, 175, 180, 180, 180, 180, 182,
-    182, 182, 182, 183, 183, 183, 183, 188, 188, 188, 188, 191, 191, 191, 191,
-    197, 197, 197, 197, 231, 231, 231, 231, 239, 239, 239, 239, 9,   9,   142,
-    142, 144, 144, 145, 145, 148, 148, 159, 159, 171, 171, 206, 206, 215, 215,
-    225, 225, 236, 236, 237, 237, 199, 207, 234, 235, 192, 192, 192, 192, 192,
-    192, 192, 192, 193, 193, 193, 193, 193, 193, 193, 193, 200, 200, 200, 200,
-    200, 200, 200, 200, 201, 201, 201, 201, 201, 201, 201, 201, 202, 202, 202,
-    202, 202, 202, 202, 202, 205, 205, 205, 205, 205, 205, 205, 205, 210, 210,
-    210, 210, 210, 210, 210, 210, 213, 213, 213, 213, 213, 213, 213, 213, 218,
-    218, 218, 218, 218, 218, 218, 218, 219, 219, 219, 219, 219, 219, 219, 219,
-    238, 238, 238, 238, 238, 238, 238, 238, 240, 240, 240, 240, 240, 240, 240,
-    240, 242, 242, 242, 242, 242, 242, 242, 242, 243, 243, 243, 243, 243, 243,
-    243, 243, 255, 255, 255, 255, 255, 255, 255, 255, 203, 203, 203, 203, 204,
-    204, 204, 204, 211, 211, 211, 211, 212, 212, 212, 212, 214, 214, 214, 214,
-    221, 221, 221, 221, 222, 222, 222, 222, 223, 223, 223, 223, 241, 241, 241,
-    241, 244, 244, 244, 244, 245, 245, 245, 245, 246, 246, 246, 246, 247, 247,
-    247, 247, 248, 248, 248, 248, 250, 250, 250, 250, 251, 251, 251, 251, 252,
-    252, 252, 252, 253, 253, 253, 253, 254, 254, 254, 254, 2,   2,   3,   3,
-    4,   4,   5,   5,   6,   6,   7,   7,   8,   8,   11,  11,  12,  12,  14,
-    14,  15,  15,  16,  16,  17,  17,  18,  18,  19,  19,  20,  20,  21,  21,
-    23,  23,  24,  24,  25,  25,  26,  26,  27,  27,  28,  28,  29,  29,  30,
-    30,  31,  31,  127, 127, 220, 220, 249, 249, -1,  -1,  10,  10,  10,  10,
-    10,  10,  10,  10,  13,  13,  13,  13,  13,  13,  13,  13,  22,  22,  22,
-    22,  22,  22,  22,  22,  256, 256, 256, 256, 256, 256, 256, 256, 45,  45,
-    45,  45,  45,  45,  45,  45,  46,  46,  46,  46,  46,  46,  46,  46,  47,
-    47,  47,  47,  47,  47,  47,  47,  51,  51,  51,  51,  51,  51,  51,  51,
-    52,  52,  52,  52,  52,  52,  52,  52,  53,  53,  53,  53,  53,  53,  53,
-    53,  54,  54,  54,  54,  54,  54,  54,  54,  55,  55,  55,  55,  55,  55,
-    55,  55,  56,  56,  56,  56,  56,  56,  56,  56,  57,  57,  57,  57,  57,
-    57,  57,  57,  50,  50,  50,  50,  50,  50,  50,  50,  97,  97,  97,  97,
-    97,  97,  97,  97,  99,  99,  99,  99,  99,  99,  99,  99,  101, 101, 101,
-    101, 101, 101, 101, 101, 105, 105, 105, 105, 105, 105, 105, 105, 111, 111,
-    111, 111, 111, 111, 111, 111, 115, 115, 115, 115, 115, 115, 115, 115, 116,
-    116, 116, 116, 116, 116, 116, 116, 32,  32,  32,  32,  37,  37,  37,  37,
-    45,  45,  45,  45,  46,  46,  46,  46,  47,  47,  47,  47,  51,  51,  51,
-    51,  52,  52,  52,  52,  53,  53,  53,  53,  54,  54,  54,  54,  55,  55,
-    55,  55,  56,  56,  56,  56,  57,  57,  57,  57,  61,  61,  61,  61,  65,
-    65,  65,  65,  95,  95,  95,  95,  98,  98,  98,  98,  100, 100, 100, 100,
-    102, 102, 102, 102, 103, 103, 103, 103, 104, 104, 104, 104, 108, 108, 108,
-    108, 109, 109, 109, 109, 110, 110, 110, 110, 112, 112, 112, 112, 114, 114,
-    114, 114, 117, 117, 117, 117, 58,  58,  66,  66,  67,  67,  68,  68,  69,
-    69,  70,  70,  71,  71,  72,  72,  73,  73,  74,  74,  75,  75,  76,  76,
-    77,  77,  78,  78,  79,  79,  80,  80,  81,  81,  82,  82,  83,  83,  84,
-    84,  85,  85,  86,  86,  87,  87,  89,  89,  106, 106, 107, 107, 113, 113,
-    118, 118, 119, 119, 120, 120, 121, 121, 122, 122, 38,  42,  44,  59,  88,
-    90,  -1,  -1,  33,  33,  33,  33,  34,  34,  34,  34,  40,  40,  40,  40,
-    41,  41,  41,  41,  63,  63,  63,  63,  39,  39,  43,  43,  124, 124, 35,
-    62,  -1,  -1,  -1,  -1,  0,   0,   0,   0,   0,   0,   0,   0,   36,  36,
-    36,  36,  36,  36,  36,  36,  64,  64,  64,  64,  64,  64,  64,  64,  91,
-    91,  91,  91,  91,  91,  91,  91,  93,  93,  93,  93,  93,  93,  93,  93,
-    126, 126, 126, 126, 126, 126, 126, 126, 94,  94,  94,  94,  125, 125, 125,
-    125, 60,  60,  96,  96,  123, 123, -1,  -1,  92,  92,  195, 195, 208, 208,
-    128, 130, 131, 162, 184, 194, 224, 226, -1,  -1,  153, 153, 153, 153, 153,
-    153, 153, 153, 161, 161, 161, 161, 161, 161, 161, 161, 167, 167, 167, 167,
-    167, 167, 167, 167, 172, 172, 172, 172, 172, 172, 172, 172, 176, 176, 176,
-    176, 176, 176, 176, 176, 177, 177, 177, 177, 177, 177, 177, 177, 179, 179,
-    179, 179, 179, 179, 179, 179, 209, 209, 209, 209, 209, 209, 209, 209, 216,
-    216, 216, 216, 216, 216, 216, 216, 217, 217, 217, 217, 217, 217, 217, 217,
-    227, 227, 227, 227, 227, 227, 227, 227, 229, 229, 229, 229, 229, 229, 229,
-    229, 230, 230, 230, 230, 230, 230, 230, 230, 129, 129, 129, 129, 132, 132,
-    132, 132, 133, 133, 133, 133, 134, 134, 134, 134, 136, 136, 136, 136, 146,
-    146, 146, 146, 154, 154, 154, 154, 156, 156, 156, 156, 160, 160, 160, 160,
-    163, 163, 163, 163, 164, 164, 164, 164, 169, 169, 169, 169, 170, 170, 170,
-    170, 173, 173, 173, 173, 178, 178, 178, 178, 181, 181, 181, 181, 185, 185,
-    185, 185, 186, 186, 186, 186, 187, 187, 187, 187, 189, 189, 189, 189, 190,
-    190, 190, 190, 196, 196, 196, 196, 198, 198, 198, 198, 228, 228, 228, 228,
-    232, 232, 232, 232, 233, 233, 233, 233, 1,   1,   135, 135, 137, 137, 138,
-    138, 139, 139, 140, 140, 141, 141, 143, 143, 147, 147, 149, 149, 150, 150,
-    151, 151, 152, 152, 155, 155, 157, 157, 158, 158, 165, 165, 166, 166, 168,
-    168, 174, 174, 175, 175, 180, 180, 182, 182, 183, 183, 188, 188, 191, 191,
-    197, 197, 231, 231, 239, 239, 9,   142, 144, 145, 148, 159, 171, 206, 215,
-    225, 236, 237, -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  199, 199,
-    199, 199, 199, 199, 199, 199, 207, 207, 207, 207, 207, 207, 207, 207, 234,
-    234, 234, 234, 234, 234, 234, 234, 235, 235, 235, 235, 235, 235, 235, 235,
-    192, 192, 192, 192, 193, 193, 193, 193, 200, 200, 200, 200, 201, 201, 201,
-    201, 202, 202, 202, 202, 205, 205, 205, 205, 210, 210, 210, 210, 213, 213,
-    213, 213, 218, 218, 218, 218, 219, 219, 219, 219, 238, 238, 238, 238, 240,
-    240, 240, 240, 242, 242, 242, 242, 243, 243, 243, 243, 255, 255, 255, 255,
-    203, 203, 204, 204, 211, 211, 212, 212, 214, 214, 221, 221, 222, 222, 223,
-    223, 241, 241, 244, 244, 245, 245, 246, 246, 247, 247, 248, 248, 250, 250,
-    251, 251, 252, 252, 253, 253, 254, 254, 2,   3,   4,   5,   6,   7,   8,
-    11,  12,  14,  15,  16,  17,  18,  19,  20,  21,  23,  24,  25,  26,  27,
-    28,  29,  30,  31,  127, 220, 249, -1,  10,  10,  10,  10,  13,  13,  13,
-    13,  22,  22,  22,  22,  256, 256, 256, 256,
+/* for each code length: the first code of that length
+
+   generated by gen_hpack_tables.cc */
+static const uint32_t huff_long_first[31] = {
+    0x0,        0x0,        0x0,        0x0,        0x0,        0x0,
+    0x14,       0x5c,       0xf8,       0x0,        0x3f8,      0x7fa,
+    0xffa,      0x1ff8,     0x3ffc,     0x7ffc,     0x0,        0x0,
+    0x0,        0x7fff0,    0xfffe6,    0x1fffdc,   0x3fffd2,   0x7fffd8,
+    0xffffea,   0x1ffffec,  0x3ffffe0,  0x7ffffde,  0xfffffe2,  0x0,
+    0x3ffffffc,
 };
 
+/* for each code length: the index of its first symbol in huff_long_syms
+
+   generated by gen_hpack_tables.cc */
+static const uint8_t huff_long_offset[31] = {
+    0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   2,   8,
+    10,  13,  13,  13,  13,  16,  24,  37,  63,  92,  104, 108, 123, 142, 171,
+    171,
+};
+
+/* number of input bits resolved by one huff_lookup_tbl lookup */
+static constexpr int kHuffLookupBits = 11;
+/* length of the longest (EOS) huffman code */
+static constexpr int kHuffMaxCodeLength = 30;
+
+/* Decode the huffman coded bytes [p, end), calling output(uint8_t) for each
+   decoded byte. Input is accumulated in a left aligned 64 bit buffer so that
+   each step resolves up to kHuffLookupBits bits (one or two symbols) with a
+   single table lookup. Trailing padding and an embedded EOS are skipped. */
+template <typename Out>
+static void HuffDecode(const uint8_t* p, const uint8_t* end, Out output) {
+  uint64_t buffer = 0;
+  // Number of valid bits at the top of buffer.
+  int bits = 0;
+  for (;;) {
+    while (bits <= 56 && p != end) {
+      buffer |= static_cast<uint64_t>(*p++) << (56 - bits);
+      bits += 8;
+    }
+    if (bits == 0) return;
+    const uint32_t entry = huff_lookup_tbl[buffer >> (64 - kHuffLookupBits)];
+    const uint32_t nsyms = entry >> 24;
+    if (nsyms == 2) {
+      const int length = (entry >> 20) & 0xf;
+      if (length <= bits) {
+        output(static_cast<uint8_t>(entry));
+        output(static_cast<uint8_t>(entry >> 8));
+        buffer <<= length;
+        bits -= length;
+        continue;
+      }
+    }
+    if (nsyms != 0) {
+      const int length = (entry >> 16) & 0xf;
+      // Anything shorter than a code is padding.
+      if (length > bits) return;
+      output(static_cast<uint8_t>(entry));
+      buffer <<= length;
+      bits -= length;
+      continue;
+    }
+    // A code longer than kHuffLookupBits.
+    const uint32_t peek = static_cast<uint32_t>(buffer >> 32);
+    int length = kHuffLookupBits + 1;
+    while (length < kHuffMaxCodeLength && peek >= huff_long_limit[length]) {
+      length++;
+    }
+    if (length > bits) return;
+    const int16_t sym =
+        huff_long_syms[huff_long_offset[length] + (peek >> (32 - length)) -
+                       huff_long_first[length]];
+    if (sym < 256) output(static_cast<uint8_t>(sym));
+    buffer <<= length;
+    bits -= length;
+  }
+}
+
 namespace {
 // The alphabet used for base64 encoding binary metadata.
 constexpr char kBase64Alphabet[] =
@@ -771,35 +813,18 @@ class HPackParser::String {
   template <typename Out>
   static bool ParseHuff(Input* input, uint32_t length, Out output) {
     GRPC_STATS_INC_HPACK_RECV_HUFFMAN();
-    int16_t state = 0;
-    // Parse one half byte... we leverage some lookup tables to keep the logic
-    // here really simple.
-    auto nibble = [&output, &state](uint8_t nibble) {
-      int16_t emit = emit_sub_tbl[16 * emit_tbl[state] + nibble];
-      int16_t next = next_sub_tbl[16 * next_tbl[state] + nibble];
-      if (emit != -1) {
-        if (emit >= 0 && emit < 256) {
-          output(static_cast<uint8_t>(emit));
-        } else {
-          assert(emit == 256);
-        }
-      }
-      state = next;
-    };
     // If there's insufficient bytes remaining, return now.
     if (input->remaining() < length) {
       return input->UnexpectedEOF(false);
     }
-    // Grab the byte range, and iterate through it.
+    // Grab the byte range, and decode it.
     const uint8_t* p = input->cur_ptr();
     input->Advance(length);
-    for (uint32_t i = 0; i < length; i++) {
-      nibble(p[i] >> 4);
-      nibble(p[i] & 0xf);
-    }
+    HuffDecode(p, p + length, output);
     return true;
   }
 
+
   // Parse some uncompressed string bytes.
   static absl::optional<String> ParseUncompressed(Input* input,
                                                   uint32_t length) {
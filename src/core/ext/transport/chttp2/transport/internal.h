@@ -357,6 +357,28 @@ struct grpc_chttp2_transport {
   /** how much data are we willing to buffer when the WRITE_BUFFER_HINT is set?
    */
   uint32_t write_buffer_size = grpc_core::chttp2::kDefaultWindow;
+  /** should writes be deferred until the current exec_ctx has drained, so
+      that they are issued together with the writes of other transports? */
+  bool batch_writes = false;
+  /** is this transport queued in a per-flush write batch? (see
+      grpc_chttp2_add_to_write_batch) */
+  bool in_write_batch = false;
+  /** next transport in that write batch */
+  grpc_chttp2_transport* write_batch_next = nullptr;
+  /** longest time (in microseconds) a write may be held back so that frames
+      of several streams are coalesced; 0 disables corking */
+  int write_cork_us = 0;
+  /** pending message bytes that release a corked write early */
+  uint32_t write_cork_bytes = 16384;
+  /** is a write being held back? write_state is already WRITING, but
+      write_action_begin_locked has not been scheduled */
+  bool write_corked = false;
+  /** message bytes queued since the last write began */
+  uint32_t corked_bytes = 0;
+  /** is write_cork_timer pending? */
+  bool write_cork_timer_armed = false;
+  grpc_timer write_cork_timer;
+  grpc_closure write_cork_timer_fired;
 
   /** Set to a grpc_error object if a goaway frame is received. By default, set
    * to GRPC_ERROR_NONE */
@@ -702,6 +724,10 @@ struct grpc_chttp2_begin_write_result {
 grpc_chttp2_begin_write_result grpc_chttp2_begin_write(
     grpc_chttp2_transport* t);
 void grpc_chttp2_end_write(grpc_chttp2_transport* t, grpc_error_handle error);
+/** Queue t->write_action_begin_locked to be run on t->combiner once the
+    current exec_ctx has drained. Must be called at most once per write:
+    t must not already be in a batch. */
+void grpc_chttp2_add_to_write_batch(grpc_chttp2_transport* t);
 
 /** Process one slice of incoming data; return 1 if the connection is still
     viable after reading, or 0 if the connection should be torn down */
@@ -37,6 +37,9 @@
 
 using grpc_core::HPackParser;
 
+/* Size of an HTTP/2 frame header: length (3), type, flags, stream id (4) */
+static constexpr size_t kFrameHeaderSize = 9;
+
 static grpc_error_handle init_frame_parser(grpc_chttp2_transport* t);
 static grpc_error_handle init_header_frame_parser(grpc_chttp2_transport* t,
                                                   int is_continuation);
@@ -110,6 +113,23 @@ grpc_error_handle grpc_chttp2_perform_read(grpc_chttp2_transport* t,
       ABSL_FALLTHROUGH_INTENDED;
     case GRPC_DTS_FH_0:
       GPR_DEBUG_ASSERT(cur < end);
+      if (static_cast<size_t>(end - cur) >= kFrameHeaderSize) {
+        /* Fast path: the whole frame header is in this slice, decode it in one
+           step. The byte-wise states below only handle headers that are split
+           across slices. */
+        t->incoming_frame_size = (static_cast<uint32_t>(cur[0]) << 16) |
+                                 (static_cast<uint32_t>(cur[1]) << 8) |
+                                 static_cast<uint32_t>(cur[2]);
+        t->incoming_frame_type = cur[3];
+        t->incoming_frame_flags = cur[4];
+        t->incoming_stream_id = ((static_cast<uint32_t>(cur[5]) & 0x7f) << 24) |
+                                (static_cast<uint32_t>(cur[6]) << 16) |
+                                (static_cast<uint32_t>(cur[7]) << 8) |
+                                static_cast<uint32_t>(cur[8]);
+        /* leave cur on the last header byte, as GRPC_DTS_FH_8 does */
+        cur += kFrameHeaderSize - 1;
+        goto dts_fh_done;
+      }
       t->incoming_frame_size = (static_cast<uint32_t>(*cur)) << 16;
       if (++cur == end) {
         t->deframe_state = GRPC_DTS_FH_1;
@@ -175,6 +195,7 @@ grpc_error_handle grpc_chttp2_perform_read(grpc_chttp2_transport* t,
     case GRPC_DTS_FH_8:
       GPR_DEBUG_ASSERT(cur < end);
       t->incoming_stream_id |= (static_cast<uint32_t>(*cur));
+    dts_fh_done:
       t->deframe_state = GRPC_DTS_FRAME;
       err = init_frame_parser(t);
       if (err != GRPC_ERROR_NONE) {
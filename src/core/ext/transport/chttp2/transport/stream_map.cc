@@ -20,158 +20,190 @@
 
 #include "src/core/ext/transport/chttp2/transport/stream_map.h"
 
-#include <string.h>
+#include <stdlib.h>
+
+#include "absl/random/random.h"
 
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
+static void rehash(grpc_chttp2_stream_map* map, size_t capacity);
+
 void grpc_chttp2_stream_map_init(grpc_chttp2_stream_map* map,
                                  size_t initial_capacity) {
   GPR_DEBUG_ASSERT(initial_capacity > 1);
-  map->keys =
-      static_cast<uint32_t*>(gpr_malloc(sizeof(uint32_t) * initial_capacity));
-  map->values =
-      static_cast<void**>(gpr_malloc(sizeof(void*) * initial_capacity));
+  size_t capacity = 2;
+  while (capacity < initial_capacity) capacity *= 2;
+  map->slots = nullptr;
   map->count = 0;
-  map->free = 0;
-  map->capacity = initial_capacity;
+  map->capacity = 0;
+  map->min_capacity = capacity;
+  /* any odd multiplier gives a valid multiplicative hash */
+  absl::BitGen bitgen;
+  map->hash_multiplier = absl::Uniform<uint32_t>(bitgen) | 1;
+  rehash(map, capacity);
+  map->ordered = static_cast<grpc_chttp2_stream_map_entry*>(
+      gpr_malloc(sizeof(grpc_chttp2_stream_map_entry) * initial_capacity));
+  map->ordered_count = 0;
+  map->ordered_capacity = initial_capacity;
 }
 
 void grpc_chttp2_stream_map_destroy(grpc_chttp2_stream_map* map) {
-  gpr_free(map->keys);
-  gpr_free(map->values);
+  gpr_free(map->slots);
+  gpr_free(map->ordered);
 }
 
-static size_t compact(uint32_t* keys, void** values, size_t count) {
-  size_t i, out;
+static size_t home_slot(const grpc_chttp2_stream_map* map, uint32_t key) {
+  return (key * map->hash_multiplier) >> map->hash_shift;
+}
 
-  for (i = 0, out = 0; i < count; i++) {
-    if (values[i]) {
-      keys[out] = keys[i];
-      values[out] = values[i];
-      out++;
-    }
+static void rehash(grpc_chttp2_stream_map* map, size_t capacity) {
+  grpc_chttp2_stream_map_slot* old_slots = map->slots;
+  size_t old_capacity = map->capacity;
+  size_t mask = capacity - 1;
+  map->slots = static_cast<grpc_chttp2_stream_map_slot*>(
+      gpr_zalloc(sizeof(grpc_chttp2_stream_map_slot) * capacity));
+  map->capacity = capacity;
+  map->hash_shift = 32;
+  for (size_t c = capacity; c > 1; c /= 2) map->hash_shift--;
+  for (size_t i = 0; i < old_capacity; i++) {
+    if (old_slots[i].value == nullptr) continue;
+    size_t j = home_slot(map, old_slots[i].key);
+    while (map->slots[j].value != nullptr) j = (j + 1) & mask;
+    map->slots[j] = old_slots[i];
   }
+  gpr_free(old_slots);
+}
 
-  return out;
+/* drop deleted entries from the ordered array, and point the slots of the
+   remaining ones at their new index */
+static void compact_ordered(grpc_chttp2_stream_map* map) {
+  uint32_t* new_index = static_cast<uint32_t*>(
+      gpr_malloc(sizeof(uint32_t) * map->ordered_count));
+  size_t out = 0;
+  for (size_t i = 0; i < map->ordered_count; i++) {
+    if (map->ordered[i].value != nullptr) {
+      new_index[i] = static_cast<uint32_t>(out);
+      map->ordered[out++] = map->ordered[i];
+    }
+  }
+  map->ordered_count = out;
+  for (size_t i = 0; i < map->capacity; i++) {
+    if (map->slots[i].value == nullptr) continue;
+    map->slots[i].ordered_index = new_index[map->slots[i].ordered_index];
+  }
+  gpr_free(new_index);
 }
 
 void grpc_chttp2_stream_map_add(grpc_chttp2_stream_map* map, uint32_t key,
                                 void* value) {
-  size_t count = map->count;
-  size_t capacity = map->capacity;
-  uint32_t* keys = map->keys;
-  void** values = map->values;
-
-  // The first assertion ensures that the table is monotonically increasing.
-  GPR_ASSERT(count == 0 || keys[count - 1] < key);
+  // Keys must be added in increasing order, which keeps the ordered array
+  // sorted.
+  GPR_ASSERT(map->ordered_count == 0 ||
+             map->ordered[map->ordered_count - 1].key < key);
   GPR_DEBUG_ASSERT(value);
-  // Asserting that the key is not already in the map can be a debug assertion.
-  // Why: we're already checking that the map elements are monotonically
-  // increasing. If we re-add a key, i.e. if the key is already present, then
-  // either it is the most recently added key in the map (in which case the
-  // first assertion fails due to key == last_key) or there is a more recently
-  // added (larger) key at the end of the map: in which case the first assertion
-  // still fails due to key < last_key.
-  GPR_DEBUG_ASSERT(grpc_chttp2_stream_map_find(map, key) == nullptr);
-
-  if (count == capacity) {
-    if (map->free > capacity / 4) {
-      count = compact(keys, values, count);
-      map->free = 0;
+  if (map->ordered_count == map->ordered_capacity) {
+    if (map->ordered_count - map->count > map->ordered_capacity / 4) {
+      compact_ordered(map);
     } else {
-      /* resize when less than 25% of the table is free, because compaction
+      /* resize when less than 25% of the array is deleted, because compaction
          won't help much */
-      map->capacity = capacity = 2 * capacity;
-      map->keys = keys = static_cast<uint32_t*>(
-          gpr_realloc(keys, capacity * sizeof(uint32_t)));
-      map->values = values =
-          static_cast<void**>(gpr_realloc(values, capacity * sizeof(void*)));
+      map->ordered_capacity *= 2;
+      map->ordered = static_cast<grpc_chttp2_stream_map_entry*>(
+          gpr_realloc(map->ordered, sizeof(grpc_chttp2_stream_map_entry) *
+                                        map->ordered_capacity));
     }
   }
-
-  keys[count] = key;
-  values[count] = value;
-  map->count = count + 1;
+  size_t ordered_index = map->ordered_count++;
+  map->ordered[ordered_index].key = key;
+  map->ordered[ordered_index].value = value;
+  /* keep the table at most three quarters full */
+  if (4 * (map->count + 1) > 3 * map->capacity) {
+    rehash(map, 2 * map->capacity);
+  }
+  size_t mask = map->capacity - 1;
+  size_t i = home_slot(map, key);
+  while (map->slots[i].value != nullptr) {
+    // Re-adding a key would corrupt the transport: it must be a new stream.
+    GPR_ASSERT(map->slots[i].key != key);
+    i = (i + 1) & mask;
+  }
+  map->slots[i].key = key;
+  map->slots[i].ordered_index = static_cast<uint32_t>(ordered_index);
+  map->slots[i].value = value;
+  map->count++;
 }
 
-template <bool strict_find>
-static void** find(grpc_chttp2_stream_map* map, uint32_t key) {
-  size_t min_idx = 0;
-  size_t max_idx = map->count;
-  size_t mid_idx;
-  uint32_t* keys = map->keys;
-  void** values = map->values;
-  uint32_t mid_key;
-
-  GPR_DEBUG_ASSERT(!strict_find || max_idx > 0);
-  if (!strict_find && max_idx == 0) return nullptr;
-
-  while (min_idx < max_idx) {
-    /* find the midpoint, avoiding overflow */
-    mid_idx = min_idx + ((max_idx - min_idx) / 2);
-    mid_key = keys[mid_idx];
-
-    if (mid_key < key) {
-      min_idx = mid_idx + 1;
-    } else if (mid_key > key) {
-      max_idx = mid_idx;
-    } else /* mid_key == key */
-    {
-      return &values[mid_idx];
-    }
+static grpc_chttp2_stream_map_slot* find(grpc_chttp2_stream_map* map,
+                                         uint32_t key) {
+  size_t mask = map->capacity - 1;
+  for (size_t i = home_slot(map, key); map->slots[i].value != nullptr;
+       i = (i + 1) & mask) {
+    if (map->slots[i].key == key) return &map->slots[i];
   }
-
-  GPR_DEBUG_ASSERT(!strict_find);
   return nullptr;
 }
 
 void* grpc_chttp2_stream_map_delete(grpc_chttp2_stream_map* map, uint32_t key) {
-  void** pvalue = find<true>(map, key);
-  GPR_DEBUG_ASSERT(pvalue != nullptr);
-  void* out = *pvalue;
-  GPR_DEBUG_ASSERT(out != nullptr);
-  *pvalue = nullptr;
-  map->free++;
-  /* recognize complete emptyness and ensure we can skip
-     defragmentation later */
-  if (map->free == map->count) {
-    map->free = map->count = 0;
+  grpc_chttp2_stream_map_slot* slot = find(map, key);
+  GPR_DEBUG_ASSERT(slot != nullptr);
+  if (slot == nullptr) return nullptr;
+  void* out = slot->value;
+  map->ordered[slot->ordered_index].value = nullptr;
+  /* shift back any following entries that probed past this slot, so that no
+     tombstone is needed */
+  size_t mask = map->capacity - 1;
+  size_t hole = static_cast<size_t>(slot - map->slots);
+  for (size_t i = (hole + 1) & mask; map->slots[i].value != nullptr;
+       i = (i + 1) & mask) {
+    size_t home = home_slot(map, map->slots[i].key);
+    if (((i - home) & mask) >= ((i - hole) & mask)) {
+      map->slots[hole] = map->slots[i];
+      hole = i;
+    }
+  }
+  map->slots[hole].value = nullptr;
+  map->count--;
+  /* recognize complete emptiness, so that the ordered array needs no
+     compaction later */
+  if (map->count == 0) map->ordered_count = 0;
+  /* give memory back after a burst of streams has completed */
+  if (map->capacity > map->min_capacity && 8 * map->count < map->capacity) {
+    rehash(map, map->capacity / 2);
   }
   GPR_DEBUG_ASSERT(grpc_chttp2_stream_map_find(map, key) == nullptr);
   return out;
 }
 
 void* grpc_chttp2_stream_map_find(grpc_chttp2_stream_map* map, uint32_t key) {
-  void** pvalue = find<false>(map, key);
-  return pvalue != nullptr ? *pvalue : nullptr;
+  grpc_chttp2_stream_map_slot* slot = find(map, key);
+  return slot != nullptr ? slot->value : nullptr;
 }
 
 size_t grpc_chttp2_stream_map_size(grpc_chttp2_stream_map* map) {
-  return map->count - map->free;
+  return map->count;
 }
 
 void* grpc_chttp2_stream_map_rand(grpc_chttp2_stream_map* map) {
-  if (map->count == map->free) {
+  if (map->count == 0) {
     return nullptr;
   }
-  if (map->free != 0) {
-    map->count = compact(map->keys, map->values, map->count);
-    map->free = 0;
-    GPR_ASSERT(map->count > 0);
-  }
-  return map->values[(static_cast<size_t>(rand())) % map->count];
+  size_t mask = map->capacity - 1;
+  size_t i = static_cast<size_t>(rand()) & mask;
+  while (map->slots[i].value == nullptr) i = (i + 1) & mask;
+  return map->slots[i].value;
 }
 
 void grpc_chttp2_stream_map_for_each(grpc_chttp2_stream_map* map,
                                      void (*f)(void* user_data, uint32_t key,
                                                void* value),
                                      void* user_data) {
-  size_t i;
-
-  for (i = 0; i < map->count; i++) {
-    if (map->values[i]) {
-      f(user_data, map->keys[i], map->values[i]);
+  /* f may delete entries, which clears their value but leaves the ordered
+     array in place. Once f has deleted the last entry, the array is reset and
+     the loop ends */
+  for (size_t i = 0; i < map->ordered_count; i++) {
+    if (map->ordered[i].value != nullptr) {
+      f(user_data, map->ordered[i].key, map->ordered[i].value);
     }
   }
 }
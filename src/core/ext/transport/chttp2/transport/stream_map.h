@@ -25,23 +25,48 @@
 
 /* Data structure to map a uint32_t to a data object (represented by a void*)
 
-   Represented as a sorted array of keys, and a corresponding array of values.
-   Lookups are performed with binary search.
-   Adds are restricted to strictly higher keys than previously seen (this is
-   guaranteed by http2). */
+   Represented as an open addressing hash table with linear probing: keys and
+   values are stored together so that a lookup usually touches a single cache
+   line. The table is kept at most three quarters full, and deletions shift
+   later entries back rather than leaving tombstones, so lookups stay O(1)
+   without any periodic compaction.
+   Keys are hashed with a per-map multiplier drawn from a randomly seeded
+   generator, so that a peer choosing stream ids cannot predict collisions.
+   Keys must be added in increasing order. Entries are also appended to an
+   ordered array, which for_each walks in place. Each slot records where its
+   entry is in that array, so that deleting an entry just clears its value
+   there. Cleared entries stay until the array fills up, and are then
+   compacted away. */
+struct grpc_chttp2_stream_map_slot {
+  uint32_t key;
+  /* index of the entry in grpc_chttp2_stream_map::ordered */
+  uint32_t ordered_index;
+  /* nullptr for an empty slot */
+  void* value;
+};
+struct grpc_chttp2_stream_map_entry {
+  uint32_t key;
+  /* nullptr once deleted */
+  void* value;
+};
 struct grpc_chttp2_stream_map {
-  uint32_t* keys;
-  void** values;
+  grpc_chttp2_stream_map_slot* slots;
   size_t count;
-  size_t free;
+  /* always a power of two */
   size_t capacity;
+  size_t min_capacity;
+  uint32_t hash_multiplier;
+  uint32_t hash_shift;
+  /* every entry added and not yet compacted away, in increasing key order */
+  grpc_chttp2_stream_map_entry* ordered;
+  size_t ordered_count;
+  size_t ordered_capacity;
 };
 void grpc_chttp2_stream_map_init(grpc_chttp2_stream_map* map,
                                  size_t initial_capacity);
 void grpc_chttp2_stream_map_destroy(grpc_chttp2_stream_map* map);
 
-/* Add a new key: given http2 semantics, new keys must always be greater than
-   existing keys - this is asserted */
+/* Add a new key: the key must be larger than any key added before */
 void grpc_chttp2_stream_map_add(grpc_chttp2_stream_map* map, uint32_t key,
                                 void* value);
 
@@ -58,7 +83,9 @@ void* grpc_chttp2_stream_map_rand(grpc_chttp2_stream_map* map);
 /* How many (populated) entries are in the stream map? */
 size_t grpc_chttp2_stream_map_size(grpc_chttp2_stream_map* map);
 
-/* Callback on each stream */
+/* Callback on each stream, in increasing key order. f may delete entries
+   (including the current one), but not add any: deleted entries are not
+   visited. */
 void grpc_chttp2_stream_map_for_each(grpc_chttp2_stream_map* map,
                                      void (*f)(void* user_data, uint32_t key,
                                                void* value),
@@ -27,10 +27,68 @@
 #include "src/core/ext/transport/chttp2/transport/internal.h"
 #include "src/core/lib/compression/stream_compression.h"
 #include "src/core/lib/debug/stats.h"
+#include "src/core/lib/gpr/tls.h"
 #include "src/core/lib/profiling/timers.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/transport/http2_errors.h"
 
+namespace {
+// Transports that initiated a write while the owning exec_ctx was flushing.
+// Batches nest the same way exec_ctxs do: an inner exec_ctx always drains
+// (and so flushes its batch) before control returns to the outer one.
+struct WriteBatch {
+  WriteBatch(grpc_core::ExecCtx* exec_ctx, WriteBatch* prev)
+      : exec_ctx(exec_ctx), prev(prev) {}
+  grpc_core::ExecCtx* const exec_ctx;
+  WriteBatch* const prev;
+  grpc_chttp2_transport* head = nullptr;
+  grpc_chttp2_transport* tail = nullptr;
+  grpc_closure on_drained;
+};
+
+GPR_THREAD_LOCAL(WriteBatch*) g_write_batch;
+}  // namespace
+
+static void flush_write_batch(void* arg, grpc_error_handle /*error*/) {
+  WriteBatch* batch = static_cast<WriteBatch*>(arg);
+  GPR_ASSERT(g_write_batch == batch);
+  g_write_batch = batch->prev;
+  int writes = 0;
+  grpc_chttp2_transport* t = batch->head;
+  while (t != nullptr) {
+    grpc_chttp2_transport* next = t->write_batch_next;
+    t->write_batch_next = nullptr;
+    t->in_write_batch = false;
+    t->combiner->Run(&t->write_action_begin_locked, GRPC_ERROR_NONE);
+    ++writes;
+    t = next;
+  }
+  GRPC_STATS_INC_HTTP2_WRITES_PER_FLUSH(writes);
+  delete batch;
+}
+
+void grpc_chttp2_add_to_write_batch(grpc_chttp2_transport* t) {
+  grpc_core::ExecCtx* exec_ctx = grpc_core::ExecCtx::Get();
+  WriteBatch* batch = g_write_batch;
+  if (batch == nullptr || batch->exec_ctx != exec_ctx) {
+    batch = new WriteBatch(exec_ctx, batch);
+    g_write_batch = batch;
+    exec_ctx->RunWhenDrained(
+        GRPC_CLOSURE_INIT(&batch->on_drained, flush_write_batch, batch,
+                          nullptr),
+        GRPC_ERROR_NONE);
+  }
+  // write_action_begin_locked can only be queued on the combiner once.
+  GPR_ASSERT(!t->in_write_batch);
+  t->in_write_batch = true;
+  if (batch->head == nullptr) {
+    batch->head = t;
+  } else {
+    batch->tail->write_batch_next = t;
+  }
+  batch->tail = t;
+}
+
 static void add_to_write_list(grpc_chttp2_write_cb** list,
                               grpc_chttp2_write_cb* cb) {
   cb->next = *list;
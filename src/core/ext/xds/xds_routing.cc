@@ -159,6 +159,36 @@ absl::optional<size_t> XdsRouting::GetRouteForRequest(
   return absl::nullopt;
 }
 
+StringMatcherSet XdsRouting::CreatePathMatcherSet(
+    const RouteListIterator& route_list_iterator) {
+  StringMatcherSet path_matchers;
+  for (size_t i = 0; i < route_list_iterator.Size(); ++i) {
+    path_matchers.Add(route_list_iterator.GetMatchersForRoute(i).path_matcher);
+  }
+  path_matchers.Compile();
+  return path_matchers;
+}
+
+absl::optional<size_t> XdsRouting::GetRouteForRequest(
+    const RouteListIterator& route_list_iterator,
+    const StringMatcherSet& path_matchers, absl::string_view path,
+    grpc_metadata_batch* initial_metadata) {
+  GPR_DEBUG_ASSERT(path_matchers.size() == route_list_iterator.Size());
+  // Most requests take the first route whose path matches, so look for the
+  // next candidate only when headers or fraction rule one out.
+  for (absl::optional<size_t> i = path_matchers.FirstMatch(path);
+       i.has_value(); i = path_matchers.FirstMatch(path, *i + 1)) {
+    const XdsRouteConfigResource::Route::Matchers& matchers =
+        route_list_iterator.GetMatchersForRoute(*i);
+    if (HeadersMatch(matchers.header_matchers, initial_metadata) &&
+        (!matchers.fraction_per_million.has_value() ||
+         UnderFraction(*matchers.fraction_per_million))) {
+      return *i;
+    }
+  }
+  return absl::nullopt;
+}
+
 bool XdsRouting::IsValidDomainPattern(absl::string_view domain_pattern) {
   return DomainPatternMatchType(domain_pattern) != INVALID_MATCH;
 }
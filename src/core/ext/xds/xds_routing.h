@@ -66,6 +66,19 @@ class XdsRouting {
       const RouteListIterator& route_list_iterator, absl::string_view path,
       grpc_metadata_batch* initial_metadata);
 
+  // Returns the path matchers of the routes in route_list_iterator as a
+  // single set, to be built once per route table.
+  static StringMatcherSet CreatePathMatcherSet(
+      const RouteListIterator& route_list_iterator);
+
+  // Same as above, but finds the routes whose path matcher matches in a
+  // single scan of the path. path_matchers must have been created by
+  // CreatePathMatcherSet() for the same routes.
+  static absl::optional<size_t> GetRouteForRequest(
+      const RouteListIterator& route_list_iterator,
+      const StringMatcherSet& path_matchers, absl::string_view path,
+      grpc_metadata_batch* initial_metadata);
+
   // Returns true if \a domain_pattern is a valid domain pattern, false
   // otherwise.
   static bool IsValidDomainPattern(absl::string_view domain_pattern);
@@ -287,6 +287,8 @@ class XdsServerConfigFetcher::ListenerWatcher::FilterChainMatchManager::
 
     std::vector<std::string> domains;
     std::vector<Route> routes;
+    // Path matchers of routes, for finding the route of a call.
+    StringMatcherSet path_matchers;
   };
 
   class VirtualHostListIterator : public XdsRouting::VirtualHostListIterator {
@@ -1089,6 +1091,8 @@ XdsServerConfigFetcher::ListenerWatcher::FilterChainMatchManager::
       }
       grpc_channel_args_destroy(result.args);
     }
+    virtual_host.path_matchers = XdsRouting::CreatePathMatcherSet(
+        VirtualHost::RouteListIterator(&virtual_host.routes));
   }
   return config_selector;
 }
@@ -1122,7 +1126,8 @@ ServerConfigSelector::CallConfig XdsServerConfigFetcher::ListenerWatcher::
   }
   auto& virtual_host = virtual_hosts_[vhost_index.value()];
   auto route_index = XdsRouting::GetRouteForRequest(
-      VirtualHost::RouteListIterator(&virtual_host.routes), path, metadata);
+      VirtualHost::RouteListIterator(&virtual_host.routes),
+      virtual_host.path_matchers, path, metadata);
   if (route_index.has_value()) {
     auto& route = virtual_host.routes[route_index.value()];
     // Found the matching route
@@ -27,6 +27,7 @@
 #include <atomic>
 
 #include "absl/strings/escaping.h"
+#include "absl/strings/str_format.h"
 #include "absl/strings/strip.h"
 
 #include <grpc/grpc.h>
@@ -554,6 +555,35 @@ Json SocketNode::RenderJson() {
   if (keepalives_sent != 0) {
     data["keepAlivesSent"] = std::to_string(keepalives_sent);
   }
+  // The channelz SocketData message has no field for header compression:
+  // report it as socket options.
+  const HeaderCompressionStats& hcs = header_compression_stats_;
+  int64_t header_uncompressed_bytes =
+      hcs.uncompressed_bytes.load(std::memory_order_relaxed);
+  if (header_uncompressed_bytes != 0) {
+    int64_t header_compressed_bytes =
+        hcs.compressed_bytes.load(std::memory_order_relaxed);
+    double ratio = static_cast<double>(header_compressed_bytes) /
+                   header_uncompressed_bytes;
+    auto option = [](const char* name, std::string value) {
+      return Json::Object{{"name", name}, {"value", std::move(value)}};
+    };
+    data["option"] = Json::Array{
+        option("header_uncompressed_bytes",
+               std::to_string(header_uncompressed_bytes)),
+        option("header_compressed_bytes",
+               std::to_string(header_compressed_bytes)),
+        option("header_compression_ratio", absl::StrFormat("%.3f", ratio)),
+        option("header_table_hits",
+               std::to_string(hcs.table_hits.load(std::memory_order_relaxed))),
+        option("header_table_insertions",
+               std::to_string(
+                   hcs.table_insertions.load(std::memory_order_relaxed))),
+        option("header_table_evictions",
+               std::to_string(
+                   hcs.table_evictions.load(std::memory_order_relaxed))),
+    };
+  }
   // Create and fill the parent object.
   Json::Object object = {
       {"ref",
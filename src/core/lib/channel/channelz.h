@@ -321,6 +321,23 @@ class SocketNode : public BaseNode {
     keepalives_sent_.fetch_add(1, std::memory_order_relaxed);
   }
 
+  // Cumulative header compression statistics. The transport updates them as
+  // it encodes headers, and they are only read when rendering the socket.
+  struct HeaderCompressionStats {
+    // HPACK size (name + value + 32 bytes per field) of all encoded headers
+    std::atomic<int64_t> uncompressed_bytes{0};
+    // Bytes emitted, including frame headers
+    std::atomic<int64_t> compressed_bytes{0};
+    // Fields emitted as a reference to the dynamic table
+    std::atomic<int64_t> table_hits{0};
+    // Fields inserted into / evicted from the dynamic table
+    std::atomic<int64_t> table_insertions{0};
+    std::atomic<int64_t> table_evictions{0};
+  };
+  HeaderCompressionStats* header_compression_stats() {
+    return &header_compression_stats_;
+  }
+
   const std::string& remote() { return remote_; }
 
  private:
@@ -330,6 +347,7 @@ class SocketNode : public BaseNode {
   std::atomic<int64_t> messages_sent_{0};
   std::atomic<int64_t> messages_received_{0};
   std::atomic<int64_t> keepalives_sent_{0};
+  HeaderCompressionStats header_compression_stats_;
   std::atomic<gpr_cycle_counter> last_local_stream_created_cycle_{0};
   std::atomic<gpr_cycle_counter> last_remote_stream_created_cycle_{0};
   std::atomic<gpr_cycle_counter> last_message_sent_cycle_{0};
@@ -48,6 +48,10 @@ const char* grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT] = {
     "syscall_read",
     "tcp_backup_pollers_created",
     "tcp_backup_poller_polls",
+    "tcp_rx_zerocopy_bytes",
+    "tcp_rx_copied_bytes",
+    "tcp_read_buffer_pool_allocs",
+    "tcp_read_buffer_pool_reuses",
     "http2_op_batches",
     "http2_op_cancel",
     "http2_op_send_initial_metadata",
@@ -125,6 +129,12 @@ const char* grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT] = {
     "cq_ev_queue_trylock_failures",
     "cq_ev_queue_trylock_successes",
     "cq_ev_queue_transient_pop_failures",
+    "tls_handshakes_full",
+    "tls_handshakes_resumed",
+    "call_creds_token_cache_hits",
+    "call_creds_token_cache_misses",
+    "call_creds_token_prefetches",
+    "security_handshake_offloaded_steps",
 };
 const char* grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
     "Number of client side calls created by this process",
@@ -157,6 +167,12 @@ const char* grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
     "Number of read syscalls (or equivalent - eg recvmsg) made by this process",
     "Number of times a backup poller has been created (this can be expensive)",
     "Number of polls performed on the backup poller",
+    "Number of bytes received through TCP_ZEROCOPY_RECEIVE page mappings",
+    "Number of bytes received by copying on endpoints with receive zerocopy "
+    "enabled",
+    "Number of read buffers allocated for an endpoint's read buffer pool",
+    "Number of reads served from a recycled buffer in an endpoint's read "
+    "buffer pool",
     "Number of batches received by HTTP2 transport",
     "Number of cancelations received by HTTP2 transport",
     "Number of batches containing send initial metadata",
@@ -252,6 +268,16 @@ const char* grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
     "queue.",
     "Number of times NULL was popped out of completion queue's event queue "
     "even though the event queue was not empty",
+    "Number of client TLS handshakes that did a full handshake because no "
+    "cached session could be resumed",
+    "Number of client TLS handshakes that resumed a cached session",
+    "Number of call credential token requests served from a cached token",
+    "Number of call credential token requests that had to wait for a new token "
+    "to be fetched or signed",
+    "Number of background token refreshes started before the cached token "
+    "reached its refresh threshold",
+    "Number of security handshaker steps run on the handshake offload thread "
+    "pool rather than on the thread that read the handshake bytes",
 };
 const char* grpc_stats_histogram_name[GRPC_STATS_HISTOGRAM_COUNT] = {
     "call_initial_size",
@@ -266,7 +292,13 @@ const char* grpc_stats_histogram_name[GRPC_STATS_HISTOGRAM_COUNT] = {
     "http2_send_message_per_write",
     "http2_send_trailing_metadata_per_write",
     "http2_send_flowctl_per_write",
+    "http2_writes_per_flush",
     "server_cqs_checked",
+    "security_handshake_latency_us",
+    "combiner_queue_depth",
+    "combiner_ownership_time_us",
+    "work_serializer_queue_depth",
+    "work_serializer_ownership_time_us",
 };
 const char* grpc_stats_histogram_doc[GRPC_STATS_HISTOGRAM_COUNT] = {
     "Initial size of the grpc_call arena created at call start",
@@ -281,9 +313,22 @@ const char* grpc_stats_histogram_doc[GRPC_STATS_HISTOGRAM_COUNT] = {
     "Number of streams whose payload was written per TCP write",
     "Number of streams terminated per TCP write",
     "Number of flow control updates written per TCP write",
+    "Number of transports that began a write per batched exec_ctx flush",
     // NOLINTNEXTLINE(bugprone-suspicious-missing-comma)
     "How many completion queues were checked looking for a CQ that had "
     "requested the incoming call",
+    "Time in microseconds from the start of a security handshake to its "
+    "successful completion",
+    "Number of items run by the owner of a combiner lock before releasing it, "
+    "if it ran more than one",
+    "Time in microseconds from the owner of a combiner lock finishing its "
+    "first item to releasing the lock, if more items were queued behind it; "
+    "sampled for one in 16 such ownerships",
+    "Number of callbacks queued behind the owner of a work serializer that it "
+    "ran before giving up ownership, if there were any",
+    "Time in microseconds from the owner of a work serializer starting the "
+    "first callback queued behind it to giving up ownership; sampled for one "
+    "in 16 such ownerships",
 };
 const int grpc_stats_table_0[65] = {
     0,      1,      2,      3,      4,     5,     7,     9,     11,    14,
@@ -352,6 +397,15 @@ const uint8_t grpc_stats_table_7[102] = {
     42, 42, 43, 44, 44, 45, 46, 46, 47, 48, 48, 49, 49, 50, 50, 51, 51};
 const int grpc_stats_table_8[9] = {0, 1, 2, 4, 7, 13, 23, 39, 64};
 const uint8_t grpc_stats_table_9[9] = {0, 0, 1, 2, 2, 3, 4, 4, 5};
+const int grpc_stats_table_10[33] = {
+    0,   1,   2,   3,   4,   5,   7,   9,   11,  14,  17,  21,  26,
+    32,  39,  47,  57,  69,  83,  100, 120, 144, 173, 207, 248, 297,
+    355, 424, 506, 604, 721, 860, 1024};
+const uint8_t grpc_stats_table_11[60] = {
+    0,  0,  0,  1,  1,  1,  2,  2,  3,  3,  3,  4,  4,  5,  5,
+    6,  6,  6,  7,  7,  7,  8,  9,  9,  10, 10, 10, 11, 11, 12,
+    12, 13, 13, 14, 14, 14, 15, 15, 16, 17, 17, 18, 18, 18, 19,
+    19, 20, 20, 21, 21, 22, 22, 23, 23, 24, 24, 25, 25, 26, 26};
 void grpc_stats_inc_call_initial_size(int value) {
   value = grpc_core::Clamp(value, 0, 262144);
   if (value < 6) {
@@ -640,6 +694,31 @@ void grpc_stats_inc_http2_send_flowctl_per_write(int value) {
       GRPC_STATS_HISTOGRAM_HTTP2_SEND_FLOWCTL_PER_WRITE,
       grpc_stats_histo_find_bucket_slow(value, grpc_stats_table_6, 64));
 }
+void grpc_stats_inc_http2_writes_per_flush(int value) {
+  value = grpc_core::Clamp(value, 0, 1024);
+  if (value < 13) {
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_HTTP2_WRITES_PER_FLUSH,
+                             value);
+    return;
+  }
+  union {
+    double dbl;
+    uint64_t uint;
+  } _val, _bkt;
+  _val.dbl = value;
+  if (_val.uint < 4637863191261478912ull) {
+    int bucket =
+        grpc_stats_table_7[((_val.uint - 4623507967449235456ull) >> 48)] + 13;
+    _bkt.dbl = grpc_stats_table_6[bucket];
+    bucket -= (_val.uint < _bkt.uint);
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_HTTP2_WRITES_PER_FLUSH,
+                             bucket);
+    return;
+  }
+  GRPC_STATS_INC_HISTOGRAM(
+      GRPC_STATS_HISTOGRAM_HTTP2_WRITES_PER_FLUSH,
+      grpc_stats_histo_find_bucket_slow(value, grpc_stats_table_6, 64));
+}
 void grpc_stats_inc_server_cqs_checked(int value) {
   value = grpc_core::Clamp(value, 0, 64);
   if (value < 3) {
@@ -663,17 +742,144 @@ void grpc_stats_inc_server_cqs_checked(int value) {
       GRPC_STATS_HISTOGRAM_SERVER_CQS_CHECKED,
       grpc_stats_histo_find_bucket_slow(value, grpc_stats_table_8, 8));
 }
-const int grpc_stats_histo_buckets[13] = {64, 128, 64, 64, 64, 64, 64,
-                                          64, 64,  64, 64, 64, 8};
-const int grpc_stats_histo_start[13] = {0,   64,  192, 256, 320, 384, 448,
-                                        512, 576, 640, 704, 768, 832};
-const int* const grpc_stats_histo_bucket_boundaries[13] = {
-    grpc_stats_table_0, grpc_stats_table_2, grpc_stats_table_4,
-    grpc_stats_table_6, grpc_stats_table_4, grpc_stats_table_4,
-    grpc_stats_table_6, grpc_stats_table_4, grpc_stats_table_6,
-    grpc_stats_table_6, grpc_stats_table_6, grpc_stats_table_6,
-    grpc_stats_table_8};
-void (*const grpc_stats_inc_histogram[13])(int x) = {
+void grpc_stats_inc_security_handshake_latency_us(int value) {
+  value = grpc_core::Clamp(value, 0, 16777216);
+  if (value < 5) {
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_SECURITY_HANDSHAKE_LATENCY_US,
+                             value);
+    return;
+  }
+  union {
+    double dbl;
+    uint64_t uint;
+  } _val, _bkt;
+  _val.dbl = value;
+  if (_val.uint < 4683743612465315840ull) {
+    int bucket =
+        grpc_stats_table_5[((_val.uint - 4617315517961601024ull) >> 50)] + 5;
+    _bkt.dbl = grpc_stats_table_4[bucket];
+    bucket -= (_val.uint < _bkt.uint);
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_SECURITY_HANDSHAKE_LATENCY_US,
+                             bucket);
+    return;
+  }
+  GRPC_STATS_INC_HISTOGRAM(
+      GRPC_STATS_HISTOGRAM_SECURITY_HANDSHAKE_LATENCY_US,
+      grpc_stats_histo_find_bucket_slow(value, grpc_stats_table_4, 64));
+}
+void grpc_stats_inc_combiner_queue_depth(int value) {
+  value = grpc_core::Clamp(value, 0, 1024);
+  if (value < 6) {
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_COMBINER_QUEUE_DEPTH, value);
+    return;
+  }
+  union {
+    double dbl;
+    uint64_t uint;
+  } _val, _bkt;
+  _val.dbl = value;
+  if (_val.uint < 4633078116657397760ull) {
+    int bucket =
+        grpc_stats_table_11[((_val.uint - 4618441417868443648ull) >> 49)] + 6;
+    _bkt.dbl = grpc_stats_table_10[bucket];
+    bucket -= (_val.uint < _bkt.uint);
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_COMBINER_QUEUE_DEPTH, bucket);
+    return;
+  }
+  GRPC_STATS_INC_HISTOGRAM(
+      GRPC_STATS_HISTOGRAM_COMBINER_QUEUE_DEPTH,
+      grpc_stats_histo_find_bucket_slow(value, grpc_stats_table_10, 32));
+}
+void grpc_stats_inc_combiner_ownership_time_us(int value) {
+  value = grpc_core::Clamp(value, 0, 16777216);
+  if (value < 5) {
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_COMBINER_OWNERSHIP_TIME_US,
+                             value);
+    return;
+  }
+  union {
+    double dbl;
+    uint64_t uint;
+  } _val, _bkt;
+  _val.dbl = value;
+  if (_val.uint < 4683743612465315840ull) {
+    int bucket =
+        grpc_stats_table_5[((_val.uint - 4617315517961601024ull) >> 50)] + 5;
+    _bkt.dbl = grpc_stats_table_4[bucket];
+    bucket -= (_val.uint < _bkt.uint);
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_COMBINER_OWNERSHIP_TIME_US,
+                             bucket);
+    return;
+  }
+  GRPC_STATS_INC_HISTOGRAM(
+      GRPC_STATS_HISTOGRAM_COMBINER_OWNERSHIP_TIME_US,
+      grpc_stats_histo_find_bucket_slow(value, grpc_stats_table_4, 64));
+}
+void grpc_stats_inc_work_serializer_queue_depth(int value) {
+  value = grpc_core::Clamp(value, 0, 1024);
+  if (value < 6) {
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_WORK_SERIALIZER_QUEUE_DEPTH,
+                             value);
+    return;
+  }
+  union {
+    double dbl;
+    uint64_t uint;
+  } _val, _bkt;
+  _val.dbl = value;
+  if (_val.uint < 4633078116657397760ull) {
+    int bucket =
+        grpc_stats_table_11[((_val.uint - 4618441417868443648ull) >> 49)] + 6;
+    _bkt.dbl = grpc_stats_table_10[bucket];
+    bucket -= (_val.uint < _bkt.uint);
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_WORK_SERIALIZER_QUEUE_DEPTH,
+                             bucket);
+    return;
+  }
+  GRPC_STATS_INC_HISTOGRAM(
+      GRPC_STATS_HISTOGRAM_WORK_SERIALIZER_QUEUE_DEPTH,
+      grpc_stats_histo_find_bucket_slow(value, grpc_stats_table_10, 32));
+}
+void grpc_stats_inc_work_serializer_ownership_time_us(int value) {
+  value = grpc_core::Clamp(value, 0, 16777216);
+  if (value < 5) {
+    GRPC_STATS_INC_HISTOGRAM(
+        GRPC_STATS_HISTOGRAM_WORK_SERIALIZER_OWNERSHIP_TIME_US, value);
+    return;
+  }
+  union {
+    double dbl;
+    uint64_t uint;
+  } _val, _bkt;
+  _val.dbl = value;
+  if (_val.uint < 4683743612465315840ull) {
+    int bucket =
+        grpc_stats_table_5[((_val.uint - 4617315517961601024ull) >> 50)] + 5;
+    _bkt.dbl = grpc_stats_table_4[bucket];
+    bucket -= (_val.uint < _bkt.uint);
+    GRPC_STATS_INC_HISTOGRAM(
+        GRPC_STATS_HISTOGRAM_WORK_SERIALIZER_OWNERSHIP_TIME_US, bucket);
+    return;
+  }
+  GRPC_STATS_INC_HISTOGRAM(
+      GRPC_STATS_HISTOGRAM_WORK_SERIALIZER_OWNERSHIP_TIME_US,
+      grpc_stats_histo_find_bucket_slow(value, grpc_stats_table_4, 64));
+}
+const int grpc_stats_histo_buckets[19] = {64, 128, 64, 64, 64, 64, 64,
+                                          64, 64,  64, 64, 64, 64, 8,
+                                          64, 32,  64, 32, 64};
+const int grpc_stats_histo_start[19] = {
+    0,   64,  192, 256, 320, 384, 448, 512, 576,  640,
+    704, 768, 832, 896, 904, 968, 1000, 1064, 1096};
+const int* const grpc_stats_histo_bucket_boundaries[19] = {
+    grpc_stats_table_0,  grpc_stats_table_2, grpc_stats_table_4,
+    grpc_stats_table_6,  grpc_stats_table_4, grpc_stats_table_4,
+    grpc_stats_table_6,  grpc_stats_table_4, grpc_stats_table_6,
+    grpc_stats_table_6,  grpc_stats_table_6, grpc_stats_table_6,
+    grpc_stats_table_6,  grpc_stats_table_8, grpc_stats_table_4,
+    grpc_stats_table_10, grpc_stats_table_4, grpc_stats_table_10,
+    grpc_stats_table_4};
+void (*const grpc_stats_inc_histogram[19])(int x) = {
     grpc_stats_inc_call_initial_size,
     grpc_stats_inc_poll_events_returned,
     grpc_stats_inc_tcp_write_size,
@@ -686,4 +892,10 @@ void (*const grpc_stats_inc_histogram[13])(int x) = {
     grpc_stats_inc_http2_send_message_per_write,
     grpc_stats_inc_http2_send_trailing_metadata_per_write,
     grpc_stats_inc_http2_send_flowctl_per_write,
-    grpc_stats_inc_server_cqs_checked};
+    grpc_stats_inc_http2_writes_per_flush,
+    grpc_stats_inc_server_cqs_checked,
+    grpc_stats_inc_security_handshake_latency_us,
+    grpc_stats_inc_combiner_queue_depth,
+    grpc_stats_inc_combiner_ownership_time_us,
+    grpc_stats_inc_work_serializer_queue_depth,
+    grpc_stats_inc_work_serializer_ownership_time_us};
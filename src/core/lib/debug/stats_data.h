@@ -49,6 +49,10 @@ typedef enum {
   GRPC_STATS_COUNTER_SYSCALL_READ,
   GRPC_STATS_COUNTER_TCP_BACKUP_POLLERS_CREATED,
   GRPC_STATS_COUNTER_TCP_BACKUP_POLLER_POLLS,
+  GRPC_STATS_COUNTER_TCP_RX_ZEROCOPY_BYTES,
+  GRPC_STATS_COUNTER_TCP_RX_COPIED_BYTES,
+  GRPC_STATS_COUNTER_TCP_READ_BUFFER_POOL_ALLOCS,
+  GRPC_STATS_COUNTER_TCP_READ_BUFFER_POOL_REUSES,
   GRPC_STATS_COUNTER_HTTP2_OP_BATCHES,
   GRPC_STATS_COUNTER_HTTP2_OP_CANCEL,
   GRPC_STATS_COUNTER_HTTP2_OP_SEND_INITIAL_METADATA,
@@ -126,6 +130,12 @@ typedef enum {
   GRPC_STATS_COUNTER_CQ_EV_QUEUE_TRYLOCK_FAILURES,
   GRPC_STATS_COUNTER_CQ_EV_QUEUE_TRYLOCK_SUCCESSES,
   GRPC_STATS_COUNTER_CQ_EV_QUEUE_TRANSIENT_POP_FAILURES,
+  GRPC_STATS_COUNTER_TLS_HANDSHAKES_FULL,
+  GRPC_STATS_COUNTER_TLS_HANDSHAKES_RESUMED,
+  GRPC_STATS_COUNTER_CALL_CREDS_TOKEN_CACHE_HITS,
+  GRPC_STATS_COUNTER_CALL_CREDS_TOKEN_CACHE_MISSES,
+  GRPC_STATS_COUNTER_CALL_CREDS_TOKEN_PREFETCHES,
+  GRPC_STATS_COUNTER_SECURITY_HANDSHAKE_OFFLOADED_STEPS,
   GRPC_STATS_COUNTER_COUNT
 } grpc_stats_counters;
 extern const char* grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT];
@@ -143,7 +153,13 @@ typedef enum {
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_MESSAGE_PER_WRITE,
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_TRAILING_METADATA_PER_WRITE,
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_FLOWCTL_PER_WRITE,
+  GRPC_STATS_HISTOGRAM_HTTP2_WRITES_PER_FLUSH,
   GRPC_STATS_HISTOGRAM_SERVER_CQS_CHECKED,
+  GRPC_STATS_HISTOGRAM_SECURITY_HANDSHAKE_LATENCY_US,
+  GRPC_STATS_HISTOGRAM_COMBINER_QUEUE_DEPTH,
+  GRPC_STATS_HISTOGRAM_COMBINER_OWNERSHIP_TIME_US,
+  GRPC_STATS_HISTOGRAM_WORK_SERIALIZER_QUEUE_DEPTH,
+  GRPC_STATS_HISTOGRAM_WORK_SERIALIZER_OWNERSHIP_TIME_US,
   GRPC_STATS_HISTOGRAM_COUNT
 } grpc_stats_histograms;
 extern const char* grpc_stats_histogram_name[GRPC_STATS_HISTOGRAM_COUNT];
@@ -173,9 +189,21 @@ typedef enum {
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_TRAILING_METADATA_PER_WRITE_BUCKETS = 64,
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_FLOWCTL_PER_WRITE_FIRST_SLOT = 768,
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_FLOWCTL_PER_WRITE_BUCKETS = 64,
-  GRPC_STATS_HISTOGRAM_SERVER_CQS_CHECKED_FIRST_SLOT = 832,
+  GRPC_STATS_HISTOGRAM_HTTP2_WRITES_PER_FLUSH_FIRST_SLOT = 832,
+  GRPC_STATS_HISTOGRAM_HTTP2_WRITES_PER_FLUSH_BUCKETS = 64,
+  GRPC_STATS_HISTOGRAM_SERVER_CQS_CHECKED_FIRST_SLOT = 896,
   GRPC_STATS_HISTOGRAM_SERVER_CQS_CHECKED_BUCKETS = 8,
-  GRPC_STATS_HISTOGRAM_BUCKETS = 840
+  GRPC_STATS_HISTOGRAM_SECURITY_HANDSHAKE_LATENCY_US_FIRST_SLOT = 904,
+  GRPC_STATS_HISTOGRAM_SECURITY_HANDSHAKE_LATENCY_US_BUCKETS = 64,
+  GRPC_STATS_HISTOGRAM_COMBINER_QUEUE_DEPTH_FIRST_SLOT = 968,
+  GRPC_STATS_HISTOGRAM_COMBINER_QUEUE_DEPTH_BUCKETS = 32,
+  GRPC_STATS_HISTOGRAM_COMBINER_OWNERSHIP_TIME_US_FIRST_SLOT = 1000,
+  GRPC_STATS_HISTOGRAM_COMBINER_OWNERSHIP_TIME_US_BUCKETS = 64,
+  GRPC_STATS_HISTOGRAM_WORK_SERIALIZER_QUEUE_DEPTH_FIRST_SLOT = 1064,
+  GRPC_STATS_HISTOGRAM_WORK_SERIALIZER_QUEUE_DEPTH_BUCKETS = 32,
+  GRPC_STATS_HISTOGRAM_WORK_SERIALIZER_OWNERSHIP_TIME_US_FIRST_SLOT = 1096,
+  GRPC_STATS_HISTOGRAM_WORK_SERIALIZER_OWNERSHIP_TIME_US_BUCKETS = 64,
+  GRPC_STATS_HISTOGRAM_BUCKETS = 1160
 } grpc_stats_histogram_constants;
 #if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
 #define GRPC_STATS_INC_CLIENT_CALLS_CREATED() \
@@ -220,6 +248,14 @@ typedef enum {
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_TCP_BACKUP_POLLERS_CREATED)
 #define GRPC_STATS_INC_TCP_BACKUP_POLLER_POLLS() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_TCP_BACKUP_POLLER_POLLS)
+#define GRPC_STATS_INC_TCP_RX_ZEROCOPY_BYTES() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_TCP_RX_ZEROCOPY_BYTES)
+#define GRPC_STATS_INC_TCP_RX_COPIED_BYTES() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_TCP_RX_COPIED_BYTES)
+#define GRPC_STATS_INC_TCP_READ_BUFFER_POOL_ALLOCS() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_TCP_READ_BUFFER_POOL_ALLOCS)
+#define GRPC_STATS_INC_TCP_READ_BUFFER_POOL_REUSES() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_TCP_READ_BUFFER_POOL_REUSES)
 #define GRPC_STATS_INC_HTTP2_OP_BATCHES() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HTTP2_OP_BATCHES)
 #define GRPC_STATS_INC_HTTP2_OP_CANCEL() \
@@ -396,6 +432,18 @@ typedef enum {
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CQ_EV_QUEUE_TRYLOCK_SUCCESSES)
 #define GRPC_STATS_INC_CQ_EV_QUEUE_TRANSIENT_POP_FAILURES() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CQ_EV_QUEUE_TRANSIENT_POP_FAILURES)
+#define GRPC_STATS_INC_TLS_HANDSHAKES_FULL() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_TLS_HANDSHAKES_FULL)
+#define GRPC_STATS_INC_TLS_HANDSHAKES_RESUMED() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_TLS_HANDSHAKES_RESUMED)
+#define GRPC_STATS_INC_CALL_CREDS_TOKEN_CACHE_HITS() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CALL_CREDS_TOKEN_CACHE_HITS)
+#define GRPC_STATS_INC_CALL_CREDS_TOKEN_CACHE_MISSES() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CALL_CREDS_TOKEN_CACHE_MISSES)
+#define GRPC_STATS_INC_CALL_CREDS_TOKEN_PREFETCHES() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CALL_CREDS_TOKEN_PREFETCHES)
+#define GRPC_STATS_INC_SECURITY_HANDSHAKE_OFFLOADED_STEPS() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_SECURITY_HANDSHAKE_OFFLOADED_STEPS)
 #define GRPC_STATS_INC_CALL_INITIAL_SIZE(value) \
   grpc_stats_inc_call_initial_size((int)(value))
 void grpc_stats_inc_call_initial_size(int value);
@@ -432,9 +480,27 @@ void grpc_stats_inc_http2_send_trailing_metadata_per_write(int value);
 #define GRPC_STATS_INC_HTTP2_SEND_FLOWCTL_PER_WRITE(value) \
   grpc_stats_inc_http2_send_flowctl_per_write((int)(value))
 void grpc_stats_inc_http2_send_flowctl_per_write(int value);
+#define GRPC_STATS_INC_HTTP2_WRITES_PER_FLUSH(value) \
+  grpc_stats_inc_http2_writes_per_flush((int)(value))
+void grpc_stats_inc_http2_writes_per_flush(int value);
 #define GRPC_STATS_INC_SERVER_CQS_CHECKED(value) \
   grpc_stats_inc_server_cqs_checked((int)(value))
 void grpc_stats_inc_server_cqs_checked(int value);
+#define GRPC_STATS_INC_SECURITY_HANDSHAKE_LATENCY_US(value) \
+  grpc_stats_inc_security_handshake_latency_us((int)(value))
+void grpc_stats_inc_security_handshake_latency_us(int value);
+#define GRPC_STATS_INC_COMBINER_QUEUE_DEPTH(value) \
+  grpc_stats_inc_combiner_queue_depth((int)(value))
+void grpc_stats_inc_combiner_queue_depth(int value);
+#define GRPC_STATS_INC_COMBINER_OWNERSHIP_TIME_US(value) \
+  grpc_stats_inc_combiner_ownership_time_us((int)(value))
+void grpc_stats_inc_combiner_ownership_time_us(int value);
+#define GRPC_STATS_INC_WORK_SERIALIZER_QUEUE_DEPTH(value) \
+  grpc_stats_inc_work_serializer_queue_depth((int)(value))
+void grpc_stats_inc_work_serializer_queue_depth(int value);
+#define GRPC_STATS_INC_WORK_SERIALIZER_OWNERSHIP_TIME_US(value) \
+  grpc_stats_inc_work_serializer_ownership_time_us((int)(value))
+void grpc_stats_inc_work_serializer_ownership_time_us(int value);
 #else
 #define GRPC_STATS_INC_CLIENT_CALLS_CREATED()
 #define GRPC_STATS_INC_SERVER_CALLS_CREATED()
@@ -457,6 +523,10 @@ void grpc_stats_inc_server_cqs_checked(int value);
 #define GRPC_STATS_INC_SYSCALL_READ()
 #define GRPC_STATS_INC_TCP_BACKUP_POLLERS_CREATED()
 #define GRPC_STATS_INC_TCP_BACKUP_POLLER_POLLS()
+#define GRPC_STATS_INC_TCP_RX_ZEROCOPY_BYTES()
+#define GRPC_STATS_INC_TCP_RX_COPIED_BYTES()
+#define GRPC_STATS_INC_TCP_READ_BUFFER_POOL_ALLOCS()
+#define GRPC_STATS_INC_TCP_READ_BUFFER_POOL_REUSES()
 #define GRPC_STATS_INC_HTTP2_OP_BATCHES()
 #define GRPC_STATS_INC_HTTP2_OP_CANCEL()
 #define GRPC_STATS_INC_HTTP2_OP_SEND_INITIAL_METADATA()
@@ -534,6 +604,12 @@ void grpc_stats_inc_server_cqs_checked(int value);
 #define GRPC_STATS_INC_CQ_EV_QUEUE_TRYLOCK_FAILURES()
 #define GRPC_STATS_INC_CQ_EV_QUEUE_TRYLOCK_SUCCESSES()
 #define GRPC_STATS_INC_CQ_EV_QUEUE_TRANSIENT_POP_FAILURES()
+#define GRPC_STATS_INC_TLS_HANDSHAKES_FULL()
+#define GRPC_STATS_INC_TLS_HANDSHAKES_RESUMED()
+#define GRPC_STATS_INC_CALL_CREDS_TOKEN_CACHE_HITS()
+#define GRPC_STATS_INC_CALL_CREDS_TOKEN_CACHE_MISSES()
+#define GRPC_STATS_INC_CALL_CREDS_TOKEN_PREFETCHES()
+#define GRPC_STATS_INC_SECURITY_HANDSHAKE_OFFLOADED_STEPS()
 #define GRPC_STATS_INC_CALL_INITIAL_SIZE(value)
 #define GRPC_STATS_INC_POLL_EVENTS_RETURNED(value)
 #define GRPC_STATS_INC_TCP_WRITE_SIZE(value)
@@ -546,11 +622,17 @@ void grpc_stats_inc_server_cqs_checked(int value);
 #define GRPC_STATS_INC_HTTP2_SEND_MESSAGE_PER_WRITE(value)
 #define GRPC_STATS_INC_HTTP2_SEND_TRAILING_METADATA_PER_WRITE(value)
 #define GRPC_STATS_INC_HTTP2_SEND_FLOWCTL_PER_WRITE(value)
+#define GRPC_STATS_INC_HTTP2_WRITES_PER_FLUSH(value)
 #define GRPC_STATS_INC_SERVER_CQS_CHECKED(value)
+#define GRPC_STATS_INC_SECURITY_HANDSHAKE_LATENCY_US(value)
+#define GRPC_STATS_INC_COMBINER_QUEUE_DEPTH(value)
+#define GRPC_STATS_INC_COMBINER_OWNERSHIP_TIME_US(value)
+#define GRPC_STATS_INC_WORK_SERIALIZER_QUEUE_DEPTH(value)
+#define GRPC_STATS_INC_WORK_SERIALIZER_OWNERSHIP_TIME_US(value)
 #endif /* defined(GRPC_COLLECT_STATS) || !defined(NDEBUG) */
-extern const int grpc_stats_histo_buckets[13];
-extern const int grpc_stats_histo_start[13];
-extern const int* const grpc_stats_histo_bucket_boundaries[13];
-extern void (*const grpc_stats_inc_histogram[13])(int x);
+extern const int grpc_stats_histo_buckets[19];
+extern const int grpc_stats_histo_start[19];
+extern const int* const grpc_stats_histo_bucket_boundaries[19];
+extern void (*const grpc_stats_inc_histogram[19])(int x);
 
 #endif /* GRPC_CORE_LIB_DEBUG_STATS_DATA_H */
@@ -19,6 +19,10 @@ syscall_write_per_iteration:FLOAT,
 syscall_read_per_iteration:FLOAT,
 tcp_backup_pollers_created_per_iteration:FLOAT,
 tcp_backup_poller_polls_per_iteration:FLOAT,
+tcp_rx_zerocopy_bytes_per_iteration:FLOAT,
+tcp_rx_copied_bytes_per_iteration:FLOAT,
+tcp_read_buffer_pool_allocs_per_iteration:FLOAT,
+tcp_read_buffer_pool_reuses_per_iteration:FLOAT,
 http2_op_batches_per_iteration:FLOAT,
 http2_op_cancel_per_iteration:FLOAT,
 http2_op_send_initial_metadata_per_iteration:FLOAT,
@@ -95,4 +99,10 @@ server_requested_calls_per_iteration:FLOAT,
 server_slowpath_requests_queued_per_iteration:FLOAT,
 cq_ev_queue_trylock_failures_per_iteration:FLOAT,
 cq_ev_queue_trylock_successes_per_iteration:FLOAT,
-cq_ev_queue_transient_pop_failures_per_iteration:FLOAT
+cq_ev_queue_transient_pop_failures_per_iteration:FLOAT,
+tls_handshakes_full_per_iteration:FLOAT,
+tls_handshakes_resumed_per_iteration:FLOAT,
+call_creds_token_cache_hits_per_iteration:FLOAT,
+call_creds_token_cache_misses_per_iteration:FLOAT,
+call_creds_token_prefetches_per_iteration:FLOAT,
+security_handshake_offloaded_steps_per_iteration:FLOAT
@@ -23,6 +23,7 @@
 #include <string.h>
 
 #include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
 #include <grpc/support/sync.h>
 #include <grpc/support/time.h>
 
@@ -206,6 +207,23 @@ Fork::child_postfork_func Fork::GetResetChildPollingEngineFunc() {
   return reset_child_polling_engine_;
 }
 
+void Fork::RegisterSetThreadingFunc(Fork::set_threading_func set_threading) {
+  int num_funcs = num_set_threading_funcs_.load(std::memory_order_acquire);
+  for (int i = 0; i < num_funcs; i++) {
+    if (set_threading_funcs_[i] == set_threading) return;
+  }
+  GPR_ASSERT(num_funcs < kMaxSetThreadingFuncs);
+  set_threading_funcs_[num_funcs] = set_threading;
+  num_set_threading_funcs_.store(num_funcs + 1, std::memory_order_release);
+}
+
+void Fork::SetThreadingOfRegisteredFuncs(bool threading) {
+  int num_funcs = num_set_threading_funcs_.load(std::memory_order_acquire);
+  for (int i = 0; i < num_funcs; i++) {
+    set_threading_funcs_[i](threading);
+  }
+}
+
 bool Fork::BlockExecCtx() {
   if (support_enabled_.load(std::memory_order_relaxed)) {
     return exec_ctx_state_->BlockExecCtx();
@@ -241,4 +259,7 @@ internal::ThreadState* Fork::thread_state_ = nullptr;
 std::atomic<bool> Fork::support_enabled_(false);
 bool Fork::override_enabled_ = false;
 Fork::child_postfork_func Fork::reset_child_polling_engine_ = nullptr;
+constexpr int Fork::kMaxSetThreadingFuncs;
+Fork::set_threading_func Fork::set_threading_funcs_[kMaxSetThreadingFuncs];
+std::atomic<int> Fork::num_set_threading_funcs_(0);
 }  // namespace grpc_core
@@ -38,6 +38,7 @@ class ThreadState;
 class Fork {
  public:
   typedef void (*child_postfork_func)(void);
+  typedef void (*set_threading_func)(bool threading);
 
   static void GlobalInit();
   static void GlobalShutdown();
@@ -66,6 +67,14 @@ class Fork {
       child_postfork_func reset_child_polling_engine);
   static child_postfork_func GetResetChildPollingEngineFunc();
 
+  // Provide a function that stops (threading == false) or restarts the threads
+  // of a component outside of iomgr. The prefork handler stops them before
+  // blocking new ExecCtxs, so that work they have queued can still finish, and
+  // the postfork handlers restart them. Registering a function again is a
+  // no-op.
+  static void RegisterSetThreadingFunc(set_threading_func set_threading);
+  static void SetThreadingOfRegisteredFuncs(bool threading);
+
   // Check if there is a single active ExecCtx
   // (the one used to invoke this function).  If there are more,
   // return false.  Otherwise, return true and block creation of
@@ -96,6 +105,9 @@ class Fork {
   static std::atomic<bool> support_enabled_;
   static bool override_enabled_;
   static child_postfork_func reset_child_polling_engine_;
+  static constexpr int kMaxSetThreadingFuncs = 4;
+  static set_threading_func set_threading_funcs_[kMaxSetThreadingFuncs];
+  static std::atomic<int> num_set_threading_funcs_;
 };
 
 }  // namespace grpc_core
@@ -27,6 +27,7 @@
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
+#include "src/core/lib/debug/stats.h"
 #include "src/core/lib/gprpp/mpscq.h"
 #include "src/core/lib/iomgr/executor.h"
 #include "src/core/lib/iomgr/iomgr_internal.h"
@@ -43,6 +44,14 @@ grpc_core::DebugOnlyTraceFlag grpc_combiner_trace(false, "combiner");
 #define STATE_UNORPHANED 1
 #define STATE_ELEM_COUNT_LOW_BIT 2
 
+// Maximum number of queued closures run back to back by one call to
+// grpc_combiner_continue_exec_ctx(), before the offload decision is made again
+#define MAX_CLOSURES_PER_BATCH 32
+
+// Only one in this many contended ownerships of a lock is timed, since reading
+// the clock costs more than running a short closure
+#define OWNERSHIP_TIME_SAMPLE_PERIOD 16
+
 static void combiner_exec(grpc_core::Combiner* lock, grpc_closure* closure,
                           grpc_error_handle error);
 static void combiner_finally_exec(grpc_core::Combiner* lock,
@@ -131,6 +140,7 @@ static void combiner_exec(grpc_core::Combiner* lock, grpc_closure* cl,
                               "C:%p grpc_combiner_execute c=%p last=%" PRIdPTR,
                               lock, cl, last));
   if (last == 1) {
+    lock->items_run = 0;
     gpr_atm_no_barrier_store(
         &lock->initiating_exec_ctx_or_null,
         reinterpret_cast<gpr_atm>(grpc_core::ExecCtx::Get()));
@@ -175,9 +185,64 @@ static void offload(void* arg, grpc_error_handle /*error*/) {
 static void queue_offload(grpc_core::Combiner* lock) {
   move_next();
   GRPC_COMBINER_TRACE(gpr_log(GPR_INFO, "C:%p queue_offload", lock));
+  GRPC_STATS_INC_COMBINER_LOCKS_OFFLOADED();
   grpc_core::Executor::Run(&lock->offload, GRPC_ERROR_NONE);
 }
 
+// Called when the owner finished its first item and more were queued behind
+// it: time how long it takes to get through them, if this ownership is sampled.
+static void start_ownership_timer(grpc_core::Combiner* lock) {
+  lock->owner_since =
+      lock->contended_ownerships++ % OWNERSHIP_TIME_SAMPLE_PERIOD == 0
+          ? gpr_get_cycle_counter()
+          : 0;
+}
+
+// Recorded once when a lock that ran more than one item is released, so that
+// uncontended locks don't pay for them.
+static void record_ownership_stats(gpr_cycle_counter GRPC_UNUSED owner_since,
+                                   int items_run) {
+  if (items_run < 2) return;
+  GRPC_STATS_INC_COMBINER_QUEUE_DEPTH(items_run);
+  if (owner_since != 0) {
+    GRPC_STATS_INC_COMBINER_OWNERSHIP_TIME_US(gpr_timespec_to_micros(
+        gpr_cycle_counter_sub(gpr_get_cycle_counter(), owner_since)));
+  }
+}
+
+// offload only if all the following conditions are true:
+// 1. the combiner is contended and has more than one closure to execute
+// 2. the current execution context needs to finish as soon as possible
+// 3. the current thread is not a worker for any background poller
+// 4. the DEFAULT executor is threaded
+static bool should_offload(grpc_core::Combiner* lock) {
+  bool contended =
+      gpr_atm_no_barrier_load(&lock->initiating_exec_ctx_or_null) == 0;
+  return contended && grpc_core::ExecCtx::Get()->IsReadyToFinish() &&
+         !grpc_iomgr_platform_is_any_background_poller_thread() &&
+         grpc_core::Executor::IsThreadedDefault();
+}
+
+// Returns true if the closure just run from the queue of the active combiner
+// \a lock can be retired right away and the next one run without going back
+// through ExecCtx::Flush(). That is the case if nothing else would have run
+// in between anyway: the exec_ctx has no closures of its own queued (those
+// run before the active combiner gets another turn), no other combiner is
+// active on it (those take turns with this one), the lock is not due to be
+// offloaded, and some closure other than the final list is still queued
+// after the one just run, so that retiring it cannot release the lock.
+static bool can_continue_batch(grpc_core::Combiner* lock) {
+  if (!grpc_closure_list_empty(*grpc_core::ExecCtx::Get()->closure_list()) ||
+      lock->next_combiner_on_this_exec_ctx != nullptr) {
+    return false;
+  }
+  gpr_atm elem_count = gpr_atm_acq_load(&lock->state) >> 1;
+  // elem_count includes the closure just run, and one for the final list if
+  // it is not empty.
+  gpr_atm needed = grpc_closure_list_empty(lock->final_list) ? 2 : 3;
+  return elem_count >= needed && !should_offload(lock);
+}
+
 bool grpc_combiner_continue_exec_ctx() {
   grpc_core::Combiner* lock =
       grpc_core::ExecCtx::Get()->combiner_data()->active_combiner;
@@ -185,26 +250,18 @@ bool grpc_combiner_continue_exec_ctx() {
     return false;
   }
 
-  bool contended =
-      gpr_atm_no_barrier_load(&lock->initiating_exec_ctx_or_null) == 0;
-
-  GRPC_COMBINER_TRACE(gpr_log(GPR_INFO,
-                              "C:%p grpc_combiner_continue_exec_ctx "
-                              "contended=%d "
-                              "exec_ctx_ready_to_finish=%d "
-                              "time_to_execute_final_list=%d",
-                              lock, contended,
-                              grpc_core::ExecCtx::Get()->IsReadyToFinish(),
-                              lock->time_to_execute_final_list));
-
-  // offload only if all the following conditions are true:
-  // 1. the combiner is contended and has more than one closure to execute
-  // 2. the current execution context needs to finish as soon as possible
-  // 3. the current thread is not a worker for any background poller
-  // 4. the DEFAULT executor is threaded
-  if (contended && grpc_core::ExecCtx::Get()->IsReadyToFinish() &&
-      !grpc_iomgr_platform_is_any_background_poller_thread() &&
-      grpc_core::Executor::IsThreadedDefault()) {
+  GRPC_COMBINER_TRACE(
+      gpr_log(GPR_INFO,
+              "C:%p grpc_combiner_continue_exec_ctx "
+              "contended=%d "
+              "exec_ctx_ready_to_finish=%d "
+              "time_to_execute_final_list=%d",
+              lock,
+              gpr_atm_no_barrier_load(&lock->initiating_exec_ctx_or_null) == 0,
+              grpc_core::ExecCtx::Get()->IsReadyToFinish(),
+              lock->time_to_execute_final_list));
+
+  if (should_offload(lock)) {
     // this execution context wants to move on: schedule remaining work to be
     // picked up on the executor
     queue_offload(lock);
@@ -215,31 +272,40 @@ bool grpc_combiner_continue_exec_ctx() {
       // peek to see if something new has shown up, and execute that with
       // priority
       (gpr_atm_acq_load(&lock->state) >> 1) > 1) {
-    grpc_core::MultiProducerSingleConsumerQueue::Node* n = lock->queue.Pop();
-    GRPC_COMBINER_TRACE(
-        gpr_log(GPR_INFO, "C:%p maybe_finish_one n=%p", lock, n));
-    if (n == nullptr) {
-      // queue is in an inconsistent state: use this as a cue that we should
-      // go off and do something else for a while (and come back later)
-      queue_offload(lock);
-      return true;
-    }
-    grpc_closure* cl = reinterpret_cast<grpc_closure*>(n);
+    for (int batch = 1;; ++batch) {
+      grpc_core::MultiProducerSingleConsumerQueue::Node* n = lock->queue.Pop();
+      GRPC_COMBINER_TRACE(
+          gpr_log(GPR_INFO, "C:%p maybe_finish_one n=%p", lock, n));
+      if (n == nullptr) {
+        // queue is in an inconsistent state: use this as a cue that we should
+        // go off and do something else for a while (and come back later)
+        queue_offload(lock);
+        return true;
+      }
+      grpc_closure* cl = reinterpret_cast<grpc_closure*>(n);
 #ifndef NDEBUG
-    cl->scheduled = false;
+      cl->scheduled = false;
 #endif
 #ifdef GRPC_ERROR_IS_ABSEIL_STATUS
-    grpc_error_handle cl_err =
-        grpc_core::internal::StatusMoveFromHeapPtr(cl->error_data.error);
-    cl->error_data.error = 0;
-    cl->cb(cl->cb_arg, std::move(cl_err));
+      grpc_error_handle cl_err =
+          grpc_core::internal::StatusMoveFromHeapPtr(cl->error_data.error);
+      cl->error_data.error = 0;
+      cl->cb(cl->cb_arg, std::move(cl_err));
 #else
-    grpc_error_handle cl_err =
-        reinterpret_cast<grpc_error_handle>(cl->error_data.error);
-    cl->error_data.error = 0;
-    cl->cb(cl->cb_arg, cl_err);
-    GRPC_ERROR_UNREF(cl_err);
+      grpc_error_handle cl_err =
+          reinterpret_cast<grpc_error_handle>(cl->error_data.error);
+      cl->error_data.error = 0;
+      cl->cb(cl->cb_arg, cl_err);
+      GRPC_ERROR_UNREF(cl_err);
 #endif
+      if (batch == MAX_CLOSURES_PER_BATCH || !can_continue_batch(lock)) {
+        break;
+      }
+      // At least one more item is queued, so this can't be the last count
+      // and none of the state transitions below apply.
+      if (++lock->items_run == 1) start_ownership_timer(lock);
+      gpr_atm_full_fetch_add(&lock->state, -STATE_ELEM_COUNT_LOW_BIT);
+    }
   } else {
     grpc_closure* c = lock->final_list.head;
     GPR_ASSERT(c != nullptr);
@@ -270,6 +336,11 @@ bool grpc_combiner_continue_exec_ctx() {
 
   move_next();
   lock->time_to_execute_final_list = false;
+  lock->items_run++;
+  // Read before giving up the lock below, after which they may be reset by the
+  // next owner or freed.
+  gpr_cycle_counter owner_since = lock->owner_since;
+  int items_run = lock->items_run;
   gpr_atm old_state =
       gpr_atm_full_fetch_add(&lock->state, -STATE_ELEM_COUNT_LOW_BIT);
   GRPC_COMBINER_TRACE(
@@ -293,9 +364,11 @@ bool grpc_combiner_continue_exec_ctx() {
       break;
     case OLD_STATE_WAS(false, 1):
       // had one count, one unorphaned --> unlocked unorphaned
+      record_ownership_stats(owner_since, items_run);
       return true;
     case OLD_STATE_WAS(true, 1):
       // and one count, one orphaned --> unlocked and orphaned
+      record_ownership_stats(owner_since, items_run);
       really_destroy(lock);
       return true;
     case OLD_STATE_WAS(false, 0):
@@ -304,6 +377,9 @@ bool grpc_combiner_continue_exec_ctx() {
       // deleted lock
       GPR_UNREACHABLE_CODE(return true);
   }
+  if (items_run == 1) {
+    start_ownership_timer(lock);
+  }
   push_first_on_exec_ctx(lock);
   return true;
 }
@@ -26,6 +26,7 @@
 #include <grpc/support/atm.h>
 
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gpr/time_precise.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 
 namespace grpc_core {
@@ -47,6 +48,14 @@ class Combiner {
   // lower bit - zero if orphaned (STATE_UNORPHANED)
   // other bits - number of items queued on the lock (STATE_ELEM_COUNT_LOW_BIT)
   gpr_atm state;
+  // number of items (queued closures or final lists) run by the current
+  // owner, and when it finished the first one if there were more and this
+  // ownership is timed (zero otherwise); only touched by the owner
+  int items_run = 0;
+  gpr_cycle_counter owner_since = 0;
+  // number of ownerships that ran more than one item, to sample which ones get
+  // timed; only touched by the owner
+  uint32_t contended_ownerships = 0;
   bool time_to_execute_final_list = false;
   grpc_closure_list final_list;
   grpc_closure offload;
@@ -36,6 +36,18 @@
 #include <sys/socket.h>
 #include <unistd.h>
 
+#ifdef GRPC_LINUX_IO_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+/* Kernel headers predating multishot poll (5.13) can't build the io_uring
+ * flavor of this engine */
+#if !defined(IORING_FEAT_RSRC_TAGS) || !defined(__NR_io_uring_setup)
+#undef GRPC_LINUX_IO_URING
+#endif
+#endif
+
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -68,6 +80,54 @@ static grpc_wakeup_fd global_wakeup_fd;
 #define MAX_EPOLL_EVENTS 100
 #define MAX_EPOLL_EVENTS_HANDLED_PER_ITERATION 1
 
+#ifdef GRPC_LINUX_IO_URING
+/* Number of submission queue entries requested from io_uring_setup(). Only
+ * poll add/remove requests are ever queued, and they are flushed on every
+ * io_uring_enter(), so this does not need to be large. The completion queue is
+ * sized so that multishot poll requests are very unlikely to be terminated
+ * because of an overflowing completion queue. */
+#define IO_URING_SQ_ENTRIES 256
+#define IO_URING_CQ_ENTRIES 4096
+/* Number of times in a row a poll request for an fd may fail to be armed
+ * before the fd is moved to the fallback epoll set */
+#define IO_URING_MAX_POLL_RETRIES 2
+
+/* Minimal io_uring instance used as a replacement for the epoll set: every fd
+ * is registered with a multishot IORING_OP_POLL_ADD request and readiness is
+ * reaped from the completion queue. */
+typedef struct io_uring_ring {
+  int ring_fd;
+
+  void* sq_ring_ptr;
+  size_t sq_ring_size;
+  void* cq_ring_ptr;
+  size_t cq_ring_size;
+  struct io_uring_sqe* sqes;
+  size_t sqes_size;
+
+  unsigned* sq_head;
+  unsigned* sq_tail;
+  unsigned* sq_ring_mask;
+  unsigned* sq_ring_entries;
+  unsigned* sq_array;
+
+  unsigned* cq_head;
+  unsigned* cq_tail;
+  unsigned* cq_ring_mask;
+  struct io_uring_cqe* cqes;
+
+  /* Protects the submission queue: fds are created and orphaned from any
+   * thread while the designated poller submits re-arm requests */
+  gpr_mu sq_mu;
+  /* Entries written to the submission queue but not yet handed to the kernel
+   * with io_uring_enter(). Guarded by sq_mu */
+  unsigned sq_pending;
+  /* Orphaned fds whose poll request has not ended yet, linked through
+   * grpc_fd::orphan_next. Guarded by sq_mu */
+  grpc_fd* orphaned_fds;
+} io_uring_ring;
+#endif
+
 /* NOTE ON SYNCHRONIZATION:
  * - Fields in this struct are only modified by the designated poller. Hence
  *   there is no need for any locks to protect the struct.
@@ -79,6 +139,17 @@ static grpc_wakeup_fd global_wakeup_fd;
 typedef struct epoll_set {
   int epfd;
 
+  /* True if the events are delivered by io_uring rather than epoll_wait()
+   * (i.e. the engine was created by grpc_init_io_uring_linux()). Only written
+   * at engine init time */
+  bool use_io_uring;
+#ifdef GRPC_LINUX_IO_URING
+  io_uring_ring ring;
+  /* True if the last epoll_wait() on the fallback epoll set (epfd, watched
+   * through the ring) may have left ready events behind */
+  bool epoll_fallback_pending;
+#endif
+
   /* The epoll_events after the last call to epoll_wait() */
   struct epoll_event events[MAX_EPOLL_EVENTS];
 
@@ -111,14 +182,205 @@ static int epoll_create_and_cloexec() {
   return fd;
 }
 
+#ifdef GRPC_LINUX_IO_URING
+static int io_uring_enter(int ring_fd, unsigned to_submit,
+                          unsigned min_complete, unsigned flags, void* arg,
+                          size_t arg_size) {
+  return static_cast<int>(syscall(__NR_io_uring_enter, ring_fd, to_submit,
+                                  min_complete, flags, arg, arg_size));
+}
+
+static void io_uring_ring_unmap(io_uring_ring* ring) {
+  if (ring->sqes != MAP_FAILED && ring->sqes != nullptr) {
+    munmap(ring->sqes, ring->sqes_size);
+  }
+  if (ring->cq_ring_ptr != MAP_FAILED && ring->cq_ring_ptr != nullptr &&
+      ring->cq_ring_ptr != ring->sq_ring_ptr) {
+    munmap(ring->cq_ring_ptr, ring->cq_ring_size);
+  }
+  if (ring->sq_ring_ptr != MAP_FAILED && ring->sq_ring_ptr != nullptr) {
+    munmap(ring->sq_ring_ptr, ring->sq_ring_size);
+  }
+  ring->sqes = nullptr;
+  ring->cq_ring_ptr = nullptr;
+  ring->sq_ring_ptr = nullptr;
+}
+
+/* Creates the io_uring instance. Returns false (and leaves nothing allocated)
+ * if the kernel does not support io_uring or lacks the features the engine
+ * depends on: multishot poll (5.13+, detected through IORING_FEAT_RSRC_TAGS
+ * which was introduced in the same release) and waiting with a timeout
+ * (IORING_FEAT_EXT_ARG). */
+static bool io_uring_ring_init(io_uring_ring* ring) {
+  memset(ring, 0, sizeof(*ring));
+  struct io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  params.flags = IORING_SETUP_CQSIZE;
+  params.cq_entries = IO_URING_CQ_ENTRIES;
+  ring->ring_fd = static_cast<int>(
+      syscall(__NR_io_uring_setup, IO_URING_SQ_ENTRIES, &params));
+  if (ring->ring_fd < 0) {
+    gpr_log(GPR_ERROR, "io_uring_setup unavailable: %s", strerror(errno));
+    return false;
+  }
+  const unsigned required_features = IORING_FEAT_SINGLE_MMAP |
+                                     IORING_FEAT_NODROP | IORING_FEAT_EXT_ARG |
+                                     IORING_FEAT_RSRC_TAGS;
+  if ((params.features & required_features) != required_features) {
+    gpr_log(GPR_ERROR, "io_uring lacks required features (have 0x%x)",
+            params.features);
+    close(ring->ring_fd);
+    return false;
+  }
+
+  ring->sq_ring_size =
+      params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  ring->cq_ring_size =
+      params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+  /* With IORING_FEAT_SINGLE_MMAP both rings live in a single mapping */
+  if (ring->cq_ring_size > ring->sq_ring_size) {
+    ring->sq_ring_size = ring->cq_ring_size;
+  }
+  ring->sq_ring_ptr =
+      mmap(nullptr, ring->sq_ring_size, PROT_READ | PROT_WRITE,
+           MAP_SHARED | MAP_POPULATE, ring->ring_fd, IORING_OFF_SQ_RING);
+  ring->cq_ring_ptr = ring->sq_ring_ptr;
+  ring->cq_ring_size = ring->sq_ring_size;
+  ring->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+  ring->sqes = static_cast<struct io_uring_sqe*>(
+      mmap(nullptr, ring->sqes_size, PROT_READ | PROT_WRITE,
+           MAP_SHARED | MAP_POPULATE, ring->ring_fd, IORING_OFF_SQES));
+  if (ring->sq_ring_ptr == MAP_FAILED || ring->sqes == MAP_FAILED) {
+    gpr_log(GPR_ERROR, "io_uring mmap failed: %s", strerror(errno));
+    io_uring_ring_unmap(ring);
+    close(ring->ring_fd);
+    return false;
+  }
+
+  char* sq = static_cast<char*>(ring->sq_ring_ptr);
+  ring->sq_head = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+  ring->sq_tail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+  ring->sq_ring_mask =
+      reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+  ring->sq_ring_entries =
+      reinterpret_cast<unsigned*>(sq + params.sq_off.ring_entries);
+  ring->sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+  char* cq = static_cast<char*>(ring->cq_ring_ptr);
+  ring->cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+  ring->cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+  ring->cq_ring_mask =
+      reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+  ring->cqes = reinterpret_cast<struct io_uring_cqe*>(cq + params.cq_off.cqes);
+
+  gpr_mu_init(&ring->sq_mu);
+  ring->sq_pending = 0;
+  ring->orphaned_fds = nullptr;
+  return true;
+}
+
+static void io_uring_ring_shutdown(io_uring_ring* ring) {
+  io_uring_ring_unmap(ring);
+  close(ring->ring_fd);
+  ring->ring_fd = -1;
+  gpr_mu_destroy(&ring->sq_mu);
+}
+
+/* Hands all pending submission queue entries to the kernel.
+ * REQUIRES: ring->sq_mu held */
+static void io_uring_ring_flush_locked(io_uring_ring* ring) {
+  while (ring->sq_pending > 0) {
+    GRPC_STATS_INC_SYSCALL_POLL();
+    int r = io_uring_enter(ring->ring_fd, ring->sq_pending, 0, 0, nullptr, 0);
+    if (r < 0) {
+      if (errno == EINTR || errno == EAGAIN || errno == EBUSY) continue;
+      gpr_log(GPR_ERROR, "io_uring_enter failed: %s", strerror(errno));
+      return;
+    }
+    ring->sq_pending -= static_cast<unsigned>(r);
+  }
+}
+
+/* The tag of the poll request watching the fallback epoll set */
+static void* io_uring_epoll_tag() { return &g_epoll_set.epfd; }
+
+/* Queues a poll add or remove request for the given tag (the same value epoll
+ * would have carried in epoll_event.data.ptr). The request is left for the
+ * next io_uring_enter() call: either io_uring_ring_flush_locked() or the one
+ * made by the designated poller in do_epoll_wait().
+ * REQUIRES: ring->sq_mu held */
+static void io_uring_ring_queue_poll_locked(io_uring_ring* ring, int fd,
+                                            void* tag, uint32_t events,
+                                            bool remove) {
+  unsigned tail = *ring->sq_tail;
+  if (tail - __atomic_load_n(ring->sq_head, __ATOMIC_ACQUIRE) ==
+      *ring->sq_ring_entries) {
+    io_uring_ring_flush_locked(ring);
+  }
+  unsigned idx = tail & *ring->sq_ring_mask;
+  struct io_uring_sqe* sqe = &ring->sqes[idx];
+  memset(sqe, 0, sizeof(*sqe));
+  if (remove) {
+    sqe->opcode = IORING_OP_POLL_REMOVE;
+    sqe->fd = -1;
+    sqe->addr = reinterpret_cast<uint64_t>(tag);
+    /* The completion of the removal itself carries no tag */
+    sqe->user_data = 0;
+  } else {
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = fd;
+    sqe->len = IORING_POLL_ADD_MULTI;
+    sqe->poll32_events = events;
+    sqe->user_data = reinterpret_cast<uint64_t>(tag);
+  }
+  ring->sq_array[idx] = idx;
+  __atomic_store_n(ring->sq_tail, tail + 1, __ATOMIC_RELEASE);
+  ring->sq_pending++;
+}
+
+/* Same as io_uring_ring_queue_poll_locked(). When 'flush' is set the request
+ * is submitted right away. */
+static void io_uring_ring_queue_poll(io_uring_ring* ring, int fd, void* tag,
+                                     uint32_t events, bool remove,
+                                     bool flush) {
+  gpr_mu_lock(&ring->sq_mu);
+  io_uring_ring_queue_poll_locked(ring, fd, tag, events, remove);
+  if (flush) io_uring_ring_flush_locked(ring);
+  gpr_mu_unlock(&ring->sq_mu);
+}
+#endif /* GRPC_LINUX_IO_URING */
+
 /* Must be called *only* once */
-static bool epoll_set_init() {
-  g_epoll_set.epfd = epoll_create_and_cloexec();
-  if (g_epoll_set.epfd < 0) {
+static bool epoll_set_init(bool use_io_uring) {
+  g_epoll_set.use_io_uring = use_io_uring;
+  if (use_io_uring) {
+#ifdef GRPC_LINUX_IO_URING
+    if (!io_uring_ring_init(&g_epoll_set.ring)) {
+      return false;
+    }
+    /* fds that io_uring repeatedly fails to poll are watched by a regular
+     * epoll set instead, which is itself polled through the ring */
+    g_epoll_set.epfd = epoll_create_and_cloexec();
+    if (g_epoll_set.epfd < 0) {
+      io_uring_ring_shutdown(&g_epoll_set.ring);
+      return false;
+    }
+    g_epoll_set.epoll_fallback_pending = false;
+    io_uring_ring_queue_poll(&g_epoll_set.ring, g_epoll_set.epfd,
+                             io_uring_epoll_tag(),
+                             static_cast<uint32_t>(EPOLLIN | EPOLLET), false,
+                             true);
+    gpr_log(GPR_INFO, "grpc io_uring fd: %d", g_epoll_set.ring.ring_fd);
+#else
     return false;
+#endif
+  } else {
+    g_epoll_set.epfd = epoll_create_and_cloexec();
+    if (g_epoll_set.epfd < 0) {
+      return false;
+    }
+    gpr_log(GPR_INFO, "grpc epoll fd: %d", g_epoll_set.epfd);
   }
 
-  gpr_log(GPR_INFO, "grpc epoll fd: %d", g_epoll_set.epfd);
   gpr_atm_no_barrier_store(&g_epoll_set.num_events, 0);
   gpr_atm_no_barrier_store(&g_epoll_set.cursor, 0);
   return true;
@@ -126,12 +388,39 @@ static bool epoll_set_init() {
 
 /* epoll_set_init() MUST be called before calling this. */
 static void epoll_set_shutdown() {
+#ifdef GRPC_LINUX_IO_URING
+  if (g_epoll_set.use_io_uring && g_epoll_set.ring.ring_fd >= 0) {
+    io_uring_ring_shutdown(&g_epoll_set.ring);
+  }
+#endif
   if (g_epoll_set.epfd >= 0) {
     close(g_epoll_set.epfd);
     g_epoll_set.epfd = -1;
   }
 }
 
+/* Starts watching 'fd' for 'events' (edge triggered); readiness is reported
+ * back with 'tag' as the event's data pointer. */
+static bool epoll_set_add_fd(int fd, void* tag, uint32_t events) {
+#ifdef GRPC_LINUX_IO_URING
+  if (g_epoll_set.use_io_uring) {
+    io_uring_ring_queue_poll(&g_epoll_set.ring, fd, tag, events, false, true);
+    return true;
+  }
+#endif
+  struct epoll_event ev;
+  ev.events = events;
+  ev.data.ptr = tag;
+  return epoll_ctl(g_epoll_set.epfd, EPOLL_CTL_ADD, fd, &ev) == 0;
+}
+
+/* Stops watching 'fd'. Not used by io_uring, see io_uring_fd_orphan(). */
+static bool epoll_set_del_fd(int fd) {
+  /* we need a phony event for earlier linux versions. */
+  epoll_event phony_event;
+  return epoll_ctl(g_epoll_set.epfd, EPOLL_CTL_DEL, fd, &phony_event) == 0;
+}
+
 /*******************************************************************************
  * Fd Declarations
  */
@@ -152,6 +441,23 @@ struct grpc_fd {
 
   struct grpc_fd* freelist_next;
 
+  /* The tag the fd was registered with in the epoll set. Only needed to
+   * unregister the fd from an io_uring based epoll set */
+  void* poll_tag;
+
+  /* io_uring only, guarded by the ring's sq_mu: whether the kernel still holds
+   * a poll request for the fd, whether the fd was orphaned (it must not be
+   * reused before that request ended), whether the fd was moved to the
+   * fallback epoll set, and how many times in a row arming it failed */
+  bool poll_armed;
+  bool poll_orphaned;
+  bool poll_in_epoll;
+  int poll_failures;
+  /* io_uring only, guarded by the ring's sq_mu: links of the ring's list of
+   * orphaned fds whose poll request has not ended yet */
+  grpc_fd* orphan_next;
+  grpc_fd* orphan_prev;
+
   grpc_iomgr_object iomgr_object;
 
   /* Only used when GRPC_ENABLE_FORK_SUPPORT=1 */
@@ -360,16 +666,19 @@ static grpc_fd* fd_create(int fd, const char* name, bool track_err) {
   }
 #endif
 
-  struct epoll_event ev;
-  ev.events = static_cast<uint32_t>(EPOLLIN | EPOLLOUT | EPOLLET);
   /* Use the least significant bit of ev.data.ptr to store track_err. We expect
    * the addresses to be word aligned. We need to store track_err to avoid
    * synchronization issues when accessing it after receiving an event.
    * Accessing fd would be a data race there because the fd might have been
    * returned to the free list at that point. */
-  ev.data.ptr = reinterpret_cast<void*>(reinterpret_cast<intptr_t>(new_fd) |
-                                        (track_err ? 1 : 0));
-  if (epoll_ctl(g_epoll_set.epfd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+  new_fd->poll_tag = reinterpret_cast<void*>(
+      reinterpret_cast<intptr_t>(new_fd) | (track_err ? 1 : 0));
+  new_fd->poll_armed = g_epoll_set.use_io_uring;
+  new_fd->poll_orphaned = false;
+  new_fd->poll_in_epoll = false;
+  new_fd->poll_failures = 0;
+  if (!epoll_set_add_fd(fd, new_fd->poll_tag,
+                        static_cast<uint32_t>(EPOLLIN | EPOLLOUT | EPOLLET))) {
     gpr_log(GPR_ERROR, "epoll_ctl failed: %s", strerror(errno));
   }
 
@@ -378,6 +687,57 @@ static grpc_fd* fd_create(int fd, const char* name, bool track_err) {
 
 static int fd_wrapped_fd(grpc_fd* fd) { return fd->fd; }
 
+static void fd_add_to_freelist(grpc_fd* fd) {
+  gpr_mu_lock(&fd_freelist_mu);
+  fd->freelist_next = fd_freelist;
+  fd_freelist = fd;
+  gpr_mu_unlock(&fd_freelist_mu);
+}
+
+#ifdef GRPC_LINUX_IO_URING
+/* Stops watching an fd that is being orphaned. Returns true if the grpc_fd
+ * can be reused right away. Otherwise the kernel still holds a poll request
+ * whose completions carry the fd's tag: the request is cancelled, and the
+ * poller puts the grpc_fd on the freelist once the request ended (see
+ * io_uring_poll_ended()). Must be called before the fd is closed, as the
+ * poll request pins the file it watches. */
+static bool io_uring_fd_orphan(grpc_fd* fd) {
+  io_uring_ring* ring = &g_epoll_set.ring;
+  gpr_mu_lock(&ring->sq_mu);
+  fd->poll_orphaned = true;
+  if (fd->poll_in_epoll) {
+    epoll_event phony_event;
+    epoll_ctl(g_epoll_set.epfd, EPOLL_CTL_DEL, fd->fd, &phony_event);
+    fd->poll_in_epoll = false;
+  }
+  bool armed = fd->poll_armed;
+  if (armed) {
+    io_uring_ring_queue_poll_locked(ring, fd->fd, fd->poll_tag, 0, true);
+    io_uring_ring_flush_locked(ring);
+    fd->orphan_prev = nullptr;
+    fd->orphan_next = ring->orphaned_fds;
+    if (ring->orphaned_fds != nullptr) ring->orphaned_fds->orphan_prev = fd;
+    ring->orphaned_fds = fd;
+  }
+  gpr_mu_unlock(&ring->sq_mu);
+  return !armed;
+}
+
+/* Puts the fds that are still waiting for their poll request to end on the
+ * freelist. Only called when nothing reaps completions anymore: at shutdown,
+ * or in a forked child, which must not touch the parent's ring. */
+static void io_uring_release_orphaned_fds() {
+  io_uring_ring* ring = &g_epoll_set.ring;
+  gpr_mu_lock(&ring->sq_mu);
+  while (ring->orphaned_fds != nullptr) {
+    grpc_fd* fd = ring->orphaned_fds;
+    ring->orphaned_fds = fd->orphan_next;
+    fd_add_to_freelist(fd);
+  }
+  gpr_mu_unlock(&ring->sq_mu);
+}
+#endif
+
 /* if 'releasing_fd' is true, it means that we are going to detach the internal
  * fd from grpc_fd structure (i.e which means we should not be calling
  * shutdown() syscall on that fd) */
@@ -386,11 +746,8 @@ static void fd_shutdown_internal(grpc_fd* fd, grpc_error_handle why,
   if (fd->read_closure->SetShutdown(GRPC_ERROR_REF(why))) {
     if (!releasing_fd) {
       shutdown(fd->fd, SHUT_RDWR);
-    } else {
-      /* we need a phony event for earlier linux versions. */
-      epoll_event phony_event;
-      if (epoll_ctl(g_epoll_set.epfd, EPOLL_CTL_DEL, fd->fd, &phony_event) !=
-          0) {
+    } else if (!g_epoll_set.use_io_uring) {
+      if (!epoll_set_del_fd(fd->fd)) {
         gpr_log(GPR_ERROR, "epoll_ctl failed: %s", strerror(errno));
       }
     }
@@ -415,6 +772,11 @@ static void fd_orphan(grpc_fd* fd, grpc_closure* on_done, int* release_fd,
                          is_release_fd);
   }
 
+  bool reusable = true;
+#ifdef GRPC_LINUX_IO_URING
+  if (g_epoll_set.use_io_uring) reusable = io_uring_fd_orphan(fd);
+#endif
+
   /* If release_fd is not NULL, we should be relinquishing control of the file
      descriptor fd->fd (but we still own the grpc_fd structure). */
   if (is_release_fd) {
@@ -431,10 +793,7 @@ static void fd_orphan(grpc_fd* fd, grpc_closure* on_done, int* release_fd,
   fd->write_closure->DestroyEvent();
   fd->error_closure->DestroyEvent();
 
-  gpr_mu_lock(&fd_freelist_mu);
-  fd->freelist_next = fd_freelist;
-  fd_freelist = fd;
-  gpr_mu_unlock(&fd_freelist_mu);
+  if (reusable) fd_add_to_freelist(fd);
 }
 
 static bool fd_is_shutdown(grpc_fd* fd) {
@@ -518,11 +877,8 @@ static grpc_error_handle pollset_global_init(void) {
   global_wakeup_fd.read_fd = -1;
   grpc_error_handle err = grpc_wakeup_fd_init(&global_wakeup_fd);
   if (err != GRPC_ERROR_NONE) return err;
-  struct epoll_event ev;
-  ev.events = static_cast<uint32_t>(EPOLLIN | EPOLLET);
-  ev.data.ptr = &global_wakeup_fd;
-  if (epoll_ctl(g_epoll_set.epfd, EPOLL_CTL_ADD, global_wakeup_fd.read_fd,
-                &ev) != 0) {
+  if (!epoll_set_add_fd(global_wakeup_fd.read_fd, &global_wakeup_fd,
+                        static_cast<uint32_t>(EPOLLIN | EPOLLET))) {
     return GRPC_OS_ERROR(errno, "epoll_ctl");
   }
   g_num_neighborhoods =
@@ -711,6 +1067,149 @@ static grpc_error_handle process_epoll_events(grpc_pollset* /*pollset*/) {
    NOTE ON SYNCHRONIZATION: At any point of time, only the g_active_poller
    (i.e the designated poller thread) will be calling this function. So there is
    no need for any synchronization when accesing fields in g_epoll_set */
+#ifdef GRPC_LINUX_IO_URING
+/* Called by the poller for the last completion of a poll request, once the
+   kernel stopped watching the fd for it: because the request was cancelled by
+   io_uring_fd_orphan(), because the completion queue overflowed, or because
+   arming the request failed ('res' < 0). Re-arms the request unless the fd is
+   gone; fds that keep failing to be armed are moved to the fallback epoll set.
+   Returns false if the fd was orphaned, in which case it is put back on the
+   freelist and the completion must be dropped. */
+static bool io_uring_poll_ended(void* tag, int res) {
+  io_uring_ring* ring = &g_epoll_set.ring;
+  if (tag == &global_wakeup_fd || tag == io_uring_epoll_tag()) {
+    if (res < 0) {
+      gpr_log(GPR_ERROR, "io_uring poll failed: %s", strerror(-res));
+    }
+    io_uring_ring_queue_poll(ring,
+                             tag == &global_wakeup_fd ? global_wakeup_fd.read_fd
+                                                      : g_epoll_set.epfd,
+                             tag, static_cast<uint32_t>(EPOLLIN | EPOLLET),
+                             false, false);
+    return true;
+  }
+  grpc_fd* fd = reinterpret_cast<grpc_fd*>(reinterpret_cast<intptr_t>(tag) &
+                                           ~static_cast<intptr_t>(1));
+  gpr_mu_lock(&ring->sq_mu);
+  if (fd->poll_orphaned) {
+    fd->poll_armed = false;
+    if (fd->orphan_prev != nullptr) {
+      fd->orphan_prev->orphan_next = fd->orphan_next;
+    } else {
+      ring->orphaned_fds = fd->orphan_next;
+    }
+    if (fd->orphan_next != nullptr) {
+      fd->orphan_next->orphan_prev = fd->orphan_prev;
+    }
+    gpr_mu_unlock(&ring->sq_mu);
+    fd_add_to_freelist(fd);
+    return false;
+  }
+  fd->poll_failures = res < 0 ? fd->poll_failures + 1 : 0;
+  if (fd_is_shutdown(fd)) {
+    fd->poll_armed = false;
+  } else if (fd->poll_failures <= IO_URING_MAX_POLL_RETRIES) {
+    io_uring_ring_queue_poll_locked(
+        ring, fd->fd, tag,
+        static_cast<uint32_t>(EPOLLIN | EPOLLOUT | EPOLLET), false);
+  } else {
+    fd->poll_armed = false;
+    struct epoll_event ev;
+    ev.events = static_cast<uint32_t>(EPOLLIN | EPOLLOUT | EPOLLET);
+    ev.data.ptr = tag;
+    if (epoll_ctl(g_epoll_set.epfd, EPOLL_CTL_ADD, fd->fd, &ev) == 0) {
+      fd->poll_in_epoll = true;
+      gpr_log(GPR_INFO, "io_uring can't poll fd %d (%s), using epoll", fd->fd,
+              strerror(-res));
+    } else {
+      gpr_log(GPR_ERROR, "epoll_ctl failed for fd %d: %s", fd->fd,
+              strerror(errno));
+    }
+  }
+  gpr_mu_unlock(&ring->sq_mu);
+  return true;
+}
+
+/* Appends the ready events of the fallback epoll set to g_epoll_set.events,
+   which holds 'r' events so far. Returns the new number of events. */
+static int io_uring_reap_epoll_events(int r) {
+  int n = epoll_wait(g_epoll_set.epfd, &g_epoll_set.events[r],
+                     MAX_EPOLL_EVENTS - r, 0);
+  if (n < 0) n = 0;
+  /* The ring only reports new readiness of the epoll set: fetch the rest
+     before waiting again */
+  g_epoll_set.epoll_fallback_pending = r + n == MAX_EPOLL_EVENTS;
+  return r + n;
+}
+
+/* Copies up to MAX_EPOLL_EVENTS poll completions from the io_uring completion
+   queue into g_epoll_set.events so that process_epoll_events() can handle them
+   exactly like epoll_wait() results. Poll requests that ended are handed to
+   io_uring_poll_ended(); the re-arm requests are submitted with the next
+   io_uring_enter(). Returns the number of events copied. */
+static int io_uring_reap_events() {
+  io_uring_ring* ring = &g_epoll_set.ring;
+  unsigned head = *ring->cq_head;
+  unsigned tail = __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE);
+  int r = 0;
+  if (g_epoll_set.epoll_fallback_pending) r = io_uring_reap_epoll_events(r);
+  while (head != tail && r < MAX_EPOLL_EVENTS) {
+    struct io_uring_cqe* cqe = &ring->cqes[head & *ring->cq_ring_mask];
+    head++;
+    void* tag = reinterpret_cast<void*>(cqe->user_data);
+    /* Completions of removal requests carry no tag */
+    if (tag == nullptr) continue;
+    if ((cqe->flags & IORING_CQE_F_MORE) == 0 &&
+        !io_uring_poll_ended(tag, cqe->res)) {
+      continue;
+    }
+    /* Failed and cancelled requests carry no readiness information */
+    if (cqe->res < 0) continue;
+    if (tag == io_uring_epoll_tag()) {
+      r = io_uring_reap_epoll_events(r);
+      continue;
+    }
+    g_epoll_set.events[r].events = static_cast<uint32_t>(cqe->res);
+    g_epoll_set.events[r].data.ptr = tag;
+    r++;
+  }
+  __atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE);
+  return r;
+}
+
+/* io_uring flavor of epoll_wait(): submits the pending poll requests, then
+   waits for at least one completion. */
+static int io_uring_wait(int timeout) {
+  io_uring_ring* ring = &g_epoll_set.ring;
+  int r = io_uring_reap_events();
+  if (r > 0) return r;
+
+  struct __kernel_timespec ts;
+  struct io_uring_getevents_arg arg;
+  memset(&arg, 0, sizeof(arg));
+  if (timeout >= 0) {
+    ts.tv_sec = timeout / GPR_MS_PER_SEC;
+    ts.tv_nsec = (timeout % GPR_MS_PER_SEC) * GPR_NS_PER_MS;
+    arg.ts = reinterpret_cast<uint64_t>(&ts);
+  }
+  /* Other threads queue and submit requests concurrently, so the pending
+     requests can't be submitted along with the (unlocked) wait. Only re-arms
+     queued by io_uring_poll_ended() are usually pending here. */
+  gpr_mu_lock(&ring->sq_mu);
+  io_uring_ring_flush_locked(ring);
+  gpr_mu_unlock(&ring->sq_mu);
+  r = io_uring_enter(ring->ring_fd, 0, 1,
+                     IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg,
+                     sizeof(arg));
+  if (r < 0) {
+    /* Running out of time is not an error for a poller */
+    if (errno == ETIME) return 0;
+    return r;
+  }
+  return io_uring_reap_events();
+}
+#endif /* GRPC_LINUX_IO_URING */
+
 static grpc_error_handle do_epoll_wait(grpc_pollset* ps, grpc_millis deadline) {
   GPR_TIMER_SCOPE("do_epoll_wait", 0);
 
@@ -721,6 +1220,12 @@ static grpc_error_handle do_epoll_wait(grpc_pollset* ps, grpc_millis deadline) {
   }
   do {
     GRPC_STATS_INC_SYSCALL_POLL();
+#ifdef GRPC_LINUX_IO_URING
+    if (g_epoll_set.use_io_uring) {
+      r = io_uring_wait(timeout);
+      continue;
+    }
+#endif
     r = epoll_wait(g_epoll_set.epfd, g_epoll_set.events, MAX_EPOLL_EVENTS,
                    timeout);
   } while (r < 0 && errno == EINTR);
@@ -728,7 +1233,10 @@ static grpc_error_handle do_epoll_wait(grpc_pollset* ps, grpc_millis deadline) {
     GRPC_SCHEDULING_END_BLOCKING_REGION;
   }
 
-  if (r < 0) return GRPC_OS_ERROR(errno, "epoll_wait");
+  if (r < 0) {
+    return GRPC_OS_ERROR(
+        errno, g_epoll_set.use_io_uring ? "io_uring_enter" : "epoll_wait");
+  }
 
   GRPC_STATS_INC_POLL_EVENTS_RETURNED(r);
 
@@ -1258,6 +1766,9 @@ static bool add_closure_to_background_poller(grpc_closure* /*closure*/,
 }
 
 static void shutdown_engine(void) {
+#ifdef GRPC_LINUX_IO_URING
+  if (g_epoll_set.use_io_uring) io_uring_release_orphaned_fds();
+#endif
   fd_global_shutdown();
   pollset_global_shutdown();
   epoll_set_shutdown();
@@ -1306,6 +1817,8 @@ static const grpc_event_engine_vtable vtable = {
     add_closure_to_background_poller,
 };
 
+static const grpc_event_engine_vtable* init_engine(bool use_io_uring);
+
 /* Called by the child process's post-fork handler to close open fds, including
  * the global epoll fd. This allows gRPC to shutdown in the child process
  * without interfering with connections or RPCs ongoing in the parent. */
@@ -1317,21 +1830,22 @@ static void reset_event_manager_on_fork() {
     fork_fd_list_head = fork_fd_list_head->fork_fd_list->next;
   }
   gpr_mu_unlock(&fork_fd_list_mu);
+  bool use_io_uring = g_epoll_set.use_io_uring;
   shutdown_engine();
-  grpc_init_epoll1_linux(true);
+  init_engine(use_io_uring);
 }
 
 /* It is possible that GLIBC has epoll but the underlying kernel doesn't.
  * Create epoll_fd (epoll_set_init() takes care of that) to make sure epoll
  * support is available */
-const grpc_event_engine_vtable* grpc_init_epoll1_linux(
-    bool /*explicit_request*/) {
+static const grpc_event_engine_vtable* init_engine(bool use_io_uring) {
   if (!grpc_has_wakeup_fd()) {
-    gpr_log(GPR_ERROR, "Skipping epoll1 because of no wakeup fd.");
+    gpr_log(GPR_ERROR, "Skipping %s because of no wakeup fd.",
+            use_io_uring ? "io_uring" : "epoll1");
     return nullptr;
   }
 
-  if (!epoll_set_init()) {
+  if (!epoll_set_init(use_io_uring)) {
     return nullptr;
   }
 
@@ -1351,6 +1865,44 @@ const grpc_event_engine_vtable* grpc_init_epoll1_linux(
   return &vtable;
 }
 
+const grpc_event_engine_vtable* grpc_init_epoll1_linux(
+    bool /*explicit_request*/) {
+  return init_engine(false);
+}
+
+/* The io_uring engine is opt-in: it is only used when named explicitly in
+ * GRPC_POLL_STRATEGY. If the kernel cannot provide it, epoll1 is used
+ * instead. */
+const grpc_event_engine_vtable* grpc_init_io_uring_linux(
+    bool explicit_request) {
+  if (!explicit_request) return nullptr;
+#ifdef GRPC_LINUX_IO_URING
+  const grpc_event_engine_vtable* engine = init_engine(true);
+  if (engine != nullptr) return engine;
+#endif
+  gpr_log(GPR_INFO, "io_uring unavailable, falling back to epoll1");
+  return init_engine(false);
+}
+
+bool grpc_io_uring_active_for_testing() { return g_epoll_set.use_io_uring; }
+
+void grpc_io_uring_fail_poll_for_testing(grpc_fd* fd, int failures) {
+#ifdef GRPC_LINUX_IO_URING
+  /* Cancelling the request makes it end with -ECANCELED, which
+     io_uring_poll_ended() counts as one more failure. */
+  io_uring_ring* ring = &g_epoll_set.ring;
+  gpr_mu_lock(&ring->sq_mu);
+  GPR_ASSERT(fd->poll_armed);
+  fd->poll_failures = failures - 1;
+  io_uring_ring_queue_poll_locked(ring, fd->fd, fd->poll_tag, 0, true);
+  io_uring_ring_flush_locked(ring);
+  gpr_mu_unlock(&ring->sq_mu);
+#else
+  (void)fd;
+  (void)failures;
+#endif
+}
+
 #else /* defined(GRPC_LINUX_EPOLL) */
 #if defined(GRPC_POSIX_SOCKET_EV_EPOLL1)
 #include "src/core/lib/iomgr/ev_epoll1_linux.h"
@@ -1360,5 +1912,14 @@ const grpc_event_engine_vtable* grpc_init_epoll1_linux(
     bool /*explicit_request*/) {
   return nullptr;
 }
+
+const grpc_event_engine_vtable* grpc_init_io_uring_linux(
+    bool /*explicit_request*/) {
+  return nullptr;
+}
+
+bool grpc_io_uring_active_for_testing() { return false; }
+
+void grpc_io_uring_fail_poll_for_testing(grpc_fd* /*fd*/, int /*failures*/) {}
 #endif /* defined(GRPC_POSIX_SOCKET_EV_EPOLL1) */
 #endif /* !defined(GRPC_LINUX_EPOLL) */
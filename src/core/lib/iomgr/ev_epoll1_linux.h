@@ -28,4 +28,17 @@
 
 const grpc_event_engine_vtable* grpc_init_epoll1_linux(bool explicit_request);
 
+// the epoll1 engine with fd readiness delivered through io_uring multishot poll
+// requests instead of epoll_wait(); falls back to plain epoll1 when the kernel
+// lacks io_uring support
+
+const grpc_event_engine_vtable* grpc_init_io_uring_linux(bool explicit_request);
+
+// Returns true if the running epoll1 engine gets fd readiness from io_uring.
+bool grpc_io_uring_active_for_testing();
+
+// Ends the poll request of 'fd' as if the kernel had rejected it for the
+// 'failures'th time in a row. Requires the io_uring engine.
+void grpc_io_uring_fail_poll_for_testing(grpc_fd* fd, int failures);
+
 #endif /* GRPC_CORE_LIB_IOMGR_EV_EPOLL1_LINUX_H */
@@ -165,7 +165,8 @@ bool ExecCtx::Flush() {
         c = next;
       }
     } else if (!grpc_combiner_continue_exec_ctx()) {
-      break;
+      if (grpc_closure_list_empty(drained_closure_list_)) break;
+      grpc_closure_list_move(&drained_closure_list_, &closure_list_);
     }
   }
   GPR_ASSERT(combiner_data_.active_combiner == nullptr);
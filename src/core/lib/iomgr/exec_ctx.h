@@ -160,7 +160,16 @@ class ExecCtx {
   /** Checks if there is work to be done */
   bool HasWork() {
     return combiner_data_.active_combiner != nullptr ||
-           !grpc_closure_list_empty(closure_list_);
+           !grpc_closure_list_empty(closure_list_) ||
+           !grpc_closure_list_empty(drained_closure_list_);
+  }
+
+  /** Schedule \a closure to run once every other closure and combiner queued
+   *  on this exec_ctx has been executed. Work that is cheaper when performed
+   *  once per flush (e.g. issuing endpoint writes gathered from many
+   *  transports) can use this to see everything the flush produced. */
+  void RunWhenDrained(grpc_closure* closure, grpc_error_handle error) {
+    grpc_closure_list_append(&drained_closure_list_, closure, error);
   }
 
   /** Flush any work that has been enqueued onto this grpc_exec_ctx.
@@ -239,6 +248,7 @@ class ExecCtx {
   /** Set exec_ctx_ to exec_ctx. */
 
   grpc_closure_list closure_list_ = GRPC_CLOSURE_LIST_INIT;
+  grpc_closure_list drained_closure_list_ = GRPC_CLOSURE_LIST_INIT;
   CombinerData combiner_data_ = {nullptr, nullptr};
   uintptr_t flags_;
 
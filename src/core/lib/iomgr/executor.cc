@@ -22,6 +22,8 @@
 
 #include <string.h>
 
+#include "absl/memory/memory.h"
+
 #include <grpc/support/alloc.h>
 #include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
@@ -29,12 +31,18 @@
 
 #include "src/core/lib/gpr/tls.h"
 #include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/gprpp/memory.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/iomgr/iomgr_internal.h"
 
 #define MAX_DEPTH 2
 
+GPR_GLOBAL_CONFIG_DEFINE_BOOL(
+    grpc_executor_work_stealing, false,
+    "If set, executor threads keep per-thread queues and steal work from "
+    "each other instead of sharing work by hashing closures onto threads.");
+
 #define EXECUTOR_TRACE(format, ...)                       \
   do {                                                    \
     if (GRPC_TRACE_FLAG_ENABLED(executor_trace)) {        \
@@ -92,6 +100,10 @@ Executor::Executor(const char* name) : name_(name) {
   adding_thread_lock_ = GPR_SPINLOCK_STATIC_INITIALIZER;
   gpr_atm_rel_store(&num_threads_, 0);
   max_threads_ = std::max(1u, 2 * gpr_cpu_num_cores());
+  if (GPR_GLOBAL_CONFIG_GET(grpc_executor_work_stealing)) {
+    work_stealing_ = absl::make_unique<WorkStealingExecutor>(
+        name, max_threads_, &Executor::RunClosures);
+  }
 }
 
 void Executor::Init() { SetThreading(true); }
@@ -156,6 +168,14 @@ void Executor::SetThreading(bool threading) {
     }
 
     GPR_ASSERT(num_threads_ == 0);
+    if (work_stealing_ != nullptr) {
+      // num_threads_ only records whether we are threaded; the threads
+      // themselves belong to work_stealing_.
+      work_stealing_->Start();
+      gpr_atm_rel_store(&num_threads_, 1);
+      EXECUTOR_TRACE("(%s) SetThreading(%d) done", name_, threading);
+      return;
+    }
     gpr_atm_rel_store(&num_threads_, 1);
     thd_state_ = static_cast<ThreadState*>(
         gpr_zalloc(sizeof(ThreadState) * max_threads_));
@@ -177,6 +197,14 @@ void Executor::SetThreading(bool threading) {
       return;
     }
 
+    if (work_stealing_ != nullptr) {
+      gpr_atm_rel_store(&num_threads_, 0);
+      work_stealing_->Stop();
+      grpc_iomgr_platform_shutdown_background_closure();
+      EXECUTOR_TRACE("(%s) SetThreading(%d) done", name_, threading);
+      return;
+    }
+
     for (size_t i = 0; i < max_threads_; i++) {
       gpr_mu_lock(&thd_state_[i].mu);
       thd_state_[i].shutdown = true;
@@ -283,6 +311,15 @@ void Executor::Enqueue(grpc_closure* closure, grpc_error_handle error,
       return;
     }
 
+    if (work_stealing_ != nullptr) {
+      if (!work_stealing_->Enqueue(closure, error, is_short)) {
+        // Lost a race with SetThreading(false).
+        grpc_closure_list_append(ExecCtx::Get()->closure_list(), closure,
+                                 error);
+      }
+      return;
+    }
+
     ThreadState* ts = g_this_thread_state;
     if (ts == nullptr) {
       ts = &thd_state_[HashPointer(ExecCtx::Get(), cur_thread_count)];
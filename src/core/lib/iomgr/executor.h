@@ -21,9 +21,15 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <memory>
+
 #include "src/core/lib/gpr/spinlock.h"
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/gprpp/thd.h"
 #include "src/core/lib/iomgr/closure.h"
+#include "src/core/lib/iomgr/executor/work_stealing_executor.h"
+
+GPR_GLOBAL_CONFIG_DECLARE_BOOL(grpc_executor_work_stealing);
 
 namespace grpc_core {
 
@@ -112,6 +118,9 @@ class Executor {
   size_t max_threads_;
   gpr_atm num_threads_;
   gpr_spinlock adding_thread_lock_;
+  // Set if GRPC_EXECUTOR_WORK_STEALING is enabled, in which case it runs the
+  // closures instead of the threads in |thd_state_|.
+  std::unique_ptr<WorkStealingExecutor> work_stealing_;
 };
 
 // Global initializer for executor
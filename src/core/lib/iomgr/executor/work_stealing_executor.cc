@@ -0,0 +1,520 @@
+/*
+ *
+ * Copyright 2021 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/iomgr/executor/work_stealing_executor.h"
+
+#include <algorithm>
+#include <memory>
+
+#include <grpc/support/cpu.h>
+#include <grpc/support/log.h>
+
+#ifdef GPR_LINUX
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+
+namespace grpc_core {
+
+extern TraceFlag executor_trace;
+
+namespace {
+
+// If the queue of the worker a closure lands on is longer than this and no
+// worker is parked, start another thread.
+constexpr size_t kMaxDepth = 2;
+// Number of closures a worker takes from the front of its queue at once.
+constexpr size_t kMaxBatch = 16;
+// Number of closures a worker runs from its LIFO slot in a row before it
+// looks at its queue, so that a chain of continuations can't starve it.
+constexpr int kMaxLifoRunsInARow = 3;
+// How long a closure may sit in a LIFO slot before another worker takes it.
+// Long enough that a running chain of continuations is never split up, short
+// enough that a continuation scheduled by a closure that then blocks, or runs
+// for a long time, is not held up noticeably.
+constexpr int64_t kLifoStealDelayMs = 1;
+// Number of batches a worker runs between two looks at which NUMA node it is
+// on, in case the scheduler moved it.
+constexpr size_t kNumaRefreshInterval = 64;
+
+// Returns the NUMA node of the CPU the calling thread runs on.
+int CurrentNumaNode() {
+#if defined(GPR_LINUX) && defined(SYS_getcpu)
+  unsigned cpu = 0;
+  unsigned node = 0;
+  if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) {
+    return static_cast<int>(node);
+  }
+#endif
+  return 0;
+}
+
+void SetClosureError(grpc_closure* closure, grpc_error_handle error) {
+#ifdef GRPC_ERROR_IS_ABSEIL_STATUS
+  closure->error_data.error = internal::StatusAllocHeapPtr(error);
+#else
+  closure->error_data.error = reinterpret_cast<intptr_t>(error);
+#endif
+}
+
+// Detaches and returns up to |max| closures from the front of |list|.
+grpc_closure_list TakeFront(grpc_closure_list* list, size_t max) {
+  grpc_closure_list taken = GRPC_CLOSURE_LIST_INIT;
+  if (list->head == nullptr || max == 0) return taken;
+  grpc_closure* last = list->head;
+  for (size_t i = 1; i < max && last->next_data.next != nullptr; ++i) {
+    last = last->next_data.next;
+  }
+  taken.head = list->head;
+  taken.tail = last;
+  list->head = last->next_data.next;
+  if (list->head == nullptr) list->tail = nullptr;
+  last->next_data.next = nullptr;
+  return taken;
+}
+
+}  // namespace
+
+struct WorkStealingExecutor::Worker {
+  // What this worker, as a thief, last saw in the LIFO slot of another one.
+  struct LifoSighting {
+    uint64_t fills;
+    gpr_timespec first_seen;
+  };
+
+  WorkStealingExecutor* executor;
+  size_t id;
+  // Written by the worker thread, read by thieves.
+  std::atomic<int> numa_node;
+  Thread thd;
+
+  gpr_mu mu;
+  // Guarded by mu.
+  grpc_closure_list queue;
+  // Written under mu. Read without it to find workers worth watching.
+  std::atomic<grpc_closure*> lifo_slot;
+  // Number of times lifo_slot was filled. Written under mu, lets thieves tell
+  // a closure that has been sitting in the slot from a newer one.
+  std::atomic<uint64_t> lifo_fills;
+  int lifo_runs_in_a_row;
+  // Number of closures in queue. Written under mu, read without it to find
+  // workers worth stealing from.
+  std::atomic<size_t> depth;
+
+  // Only used by this worker's thread.
+  std::unique_ptr<LifoSighting[]> lifo_sightings;
+  uint64_t lifo_fills_seen_at_park;
+
+  // Guarded by the executor's park_mu_.
+  gpr_cv cv;
+  bool woken;
+  bool watching_lifo;
+  Worker* parked_prev;
+  Worker* parked_next;
+};
+
+GPR_THREAD_LOCAL(WorkStealingExecutor::Worker*)
+WorkStealingExecutor::current_worker_;
+
+WorkStealingExecutor::WorkStealingExecutor(const char* name,
+                                           size_t max_threads,
+                                           RunClosuresFn run_closures)
+    : name_(name),
+      max_threads_(std::max<size_t>(1, max_threads)),
+      run_closures_(run_closures),
+      workers_(new Worker[max_threads_]) {
+  gpr_mu_init(&park_mu_);
+  for (size_t i = 0; i < max_threads_; ++i) {
+    Worker* worker = &workers_[i];
+    worker->executor = this;
+    worker->id = i;
+    worker->numa_node.store(0, std::memory_order_relaxed);
+    gpr_mu_init(&worker->mu);
+    worker->queue = GRPC_CLOSURE_LIST_INIT;
+    worker->lifo_slot.store(nullptr, std::memory_order_relaxed);
+    worker->lifo_fills.store(0, std::memory_order_relaxed);
+    worker->lifo_runs_in_a_row = 0;
+    worker->depth.store(0, std::memory_order_relaxed);
+    worker->lifo_sightings.reset(new Worker::LifoSighting[max_threads_]);
+    for (size_t j = 0; j < max_threads_; ++j) {
+      worker->lifo_sightings[j].fills = 0;
+      worker->lifo_sightings[j].first_seen =
+          gpr_inf_past(GPR_CLOCK_MONOTONIC);
+    }
+    worker->lifo_fills_seen_at_park = 0;
+    gpr_cv_init(&worker->cv);
+    worker->woken = false;
+    worker->watching_lifo = false;
+    worker->parked_prev = nullptr;
+    worker->parked_next = nullptr;
+  }
+}
+
+WorkStealingExecutor::~WorkStealingExecutor() {
+  GPR_ASSERT(!IsRunning());
+  for (size_t i = 0; i < max_threads_; ++i) {
+    gpr_mu_destroy(&workers_[i].mu);
+    gpr_cv_destroy(&workers_[i].cv);
+  }
+  delete[] workers_;
+  gpr_mu_destroy(&park_mu_);
+}
+
+void WorkStealingExecutor::Start() {
+  if (IsRunning()) return;
+  shutdown_.store(false, std::memory_order_relaxed);
+  workers_[0].thd =
+      Thread(name_, &WorkStealingExecutor::ThreadMain, &workers_[0]);
+  workers_[0].thd.Start();
+  num_threads_.store(1, std::memory_order_release);
+}
+
+void WorkStealingExecutor::Stop() {
+  if (!IsRunning()) return;
+  shutdown_.store(true, std::memory_order_seq_cst);
+  gpr_mu_lock(&park_mu_);
+  for (Worker* worker = parked_head_; worker != nullptr;
+       worker = worker->parked_next) {
+    gpr_cv_signal(&worker->cv);
+  }
+  gpr_mu_unlock(&park_mu_);
+
+  /* Ensure no thread is adding a new thread. Once this is past, then no
+   * thread will try to add a new one either (since shutdown is true) */
+  gpr_spinlock_lock(&adding_thread_lock_);
+  gpr_spinlock_unlock(&adding_thread_lock_);
+
+  size_t num_threads = num_threads_.load(std::memory_order_acquire);
+  for (size_t i = 0; i < num_threads; ++i) {
+    workers_[i].thd.Join();
+  }
+  num_threads_.store(0, std::memory_order_release);
+  // Every worker took itself off the list of parked workers before exiting.
+  GPR_ASSERT(parked_head_ == nullptr);
+
+  for (size_t i = 0; i < max_threads_; ++i) {
+    Worker* worker = &workers_[i];
+    grpc_closure_list list = GRPC_CLOSURE_LIST_INIT;
+    grpc_closure* lifo =
+        worker->lifo_slot.exchange(nullptr, std::memory_order_relaxed);
+    if (lifo != nullptr) grpc_closure_list_append(&list, lifo);
+    grpc_closure_list_move(&worker->queue, &list);
+    worker->depth.store(0, std::memory_order_relaxed);
+    run_closures_(name_, list);
+  }
+}
+
+bool WorkStealingExecutor::Enqueue(grpc_closure* closure,
+                                   grpc_error_handle error, bool is_short) {
+  size_t num_threads = num_threads_.load(std::memory_order_acquire);
+  if (num_threads == 0) return false;
+  Worker* worker = current_worker_;
+  const bool local = worker != nullptr && worker->executor == this;
+  if (!local) {
+    worker = &workers_[gpr_cpu_current_cpu() % num_threads];
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(executor_trace)) {
+    gpr_log(GPR_INFO, "EXECUTOR (%s) schedule %p (%s) to worker %" PRIdPTR,
+            name_, closure, is_short ? "short" : "long", worker->id);
+  }
+  SetClosureError(closure, error);
+  gpr_mu_lock(&worker->mu);
+  // Long jobs never take the LIFO slot: they would hold up the continuations
+  // queued behind them on this worker.
+  grpc_closure* queued = closure;
+  bool filled_lifo_slot = false;
+  if (local && is_short) {
+    queued = worker->lifo_slot.load(std::memory_order_relaxed);
+    worker->lifo_fills.fetch_add(1, std::memory_order_relaxed);
+    // Pairs with the seq_cst increment of num_parked_ in Park(): either the
+    // parking worker sees the slot full and watches it, or we see it parked.
+    worker->lifo_slot.store(closure, std::memory_order_seq_cst);
+    filled_lifo_slot = queued == nullptr;
+  }
+  size_t depth = 0;
+  if (queued != nullptr) {
+    grpc_closure_list_append(&worker->queue, queued);
+    depth = worker->depth.fetch_add(1, std::memory_order_seq_cst) + 1;
+  }
+  gpr_mu_unlock(&worker->mu);
+
+  if (queued != nullptr) {
+    if (!WakeOne() && (depth > kMaxDepth || !is_short)) MaybeAddThread();
+  } else if (filled_lifo_slot &&
+             num_lifo_watchers_.load(std::memory_order_seq_cst) == 0) {
+    // This worker normally runs its LIFO slot as soon as the current closure
+    // returns, but if that closure blocks, only a watching worker can take the
+    // slot over.
+    WakeOne();
+  }
+  return true;
+}
+
+grpc_closure_list WorkStealingExecutor::TakeLocal(Worker* worker) {
+  grpc_closure_list list = GRPC_CLOSURE_LIST_INIT;
+  gpr_mu_lock(&worker->mu);
+  grpc_closure* lifo = worker->lifo_slot.load(std::memory_order_relaxed);
+  if (lifo != nullptr && (worker->lifo_runs_in_a_row < kMaxLifoRunsInARow ||
+                          worker->queue.head == nullptr)) {
+    grpc_closure_list_append(&list, lifo);
+    worker->lifo_slot.store(nullptr, std::memory_order_relaxed);
+    ++worker->lifo_runs_in_a_row;
+  } else {
+    list = TakeFront(&worker->queue, kMaxBatch);
+    worker->lifo_runs_in_a_row = 0;
+    size_t n = 0;
+    for (grpc_closure* c = list.head; c != nullptr; c = c->next_data.next) ++n;
+    worker->depth.fetch_sub(n, std::memory_order_relaxed);
+  }
+  gpr_mu_unlock(&worker->mu);
+  return list;
+}
+
+grpc_closure_list WorkStealingExecutor::Steal(Worker* worker) {
+  grpc_closure_list stolen = GRPC_CLOSURE_LIST_INIT;
+  const size_t num_threads = num_threads_.load(std::memory_order_acquire);
+  // Two passes: workers on our NUMA node first, then everyone else.
+  for (int pass = 0; pass < 2 && stolen.head == nullptr; ++pass) {
+    for (size_t i = 1; i < num_threads; ++i) {
+      Worker* victim = &workers_[(worker->id + i) % num_threads];
+      const bool same_node =
+          victim->numa_node.load(std::memory_order_relaxed) ==
+          worker->numa_node.load(std::memory_order_relaxed);
+      if (same_node != (pass == 0)) continue;
+      if (victim->depth.load(std::memory_order_relaxed) == 0) continue;
+      gpr_mu_lock(&victim->mu);
+      size_t depth = victim->depth.load(std::memory_order_relaxed);
+      stolen = TakeFront(&victim->queue, (depth + 1) / 2);
+      size_t n = 0;
+      for (grpc_closure* c = stolen.head; c != nullptr; c = c->next_data.next) {
+        ++n;
+      }
+      victim->depth.fetch_sub(n, std::memory_order_relaxed);
+      gpr_mu_unlock(&victim->mu);
+      if (stolen.head != nullptr) {
+        if (GRPC_TRACE_FLAG_ENABLED(executor_trace)) {
+          gpr_log(GPR_INFO,
+                  "EXECUTOR (%s) worker %" PRIdPTR " stole %" PRIdPTR
+                  " closures from worker %" PRIdPTR,
+                  name_, worker->id, n, victim->id);
+        }
+        break;
+      }
+    }
+  }
+  if (stolen.head == nullptr) stolen = StealStaleLifo(worker);
+  return stolen;
+}
+
+grpc_closure_list WorkStealingExecutor::StealStaleLifo(Worker* worker) {
+  grpc_closure_list stolen = GRPC_CLOSURE_LIST_INIT;
+  const size_t num_threads = num_threads_.load(std::memory_order_acquire);
+  const gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
+  const gpr_timespec delay =
+      gpr_time_from_millis(kLifoStealDelayMs, GPR_TIMESPAN);
+  for (size_t i = 1; i < num_threads; ++i) {
+    Worker* victim = &workers_[(worker->id + i) % num_threads];
+    if (victim->lifo_slot.load(std::memory_order_relaxed) == nullptr) continue;
+    const uint64_t fills = victim->lifo_fills.load(std::memory_order_relaxed);
+    Worker::LifoSighting* sighting = &worker->lifo_sightings[victim->id];
+    if (sighting->fills != fills) {
+      // A closure we haven't seen before: give its owner some time to run it.
+      sighting->fills = fills;
+      sighting->first_seen = now;
+      continue;
+    }
+    if (gpr_time_cmp(gpr_time_sub(now, sighting->first_seen), delay) < 0) {
+      continue;
+    }
+    gpr_mu_lock(&victim->mu);
+    grpc_closure* lifo = victim->lifo_slot.load(std::memory_order_relaxed);
+    if (lifo != nullptr &&
+        victim->lifo_fills.load(std::memory_order_relaxed) == fills) {
+      grpc_closure_list_append(&stolen, lifo);
+      victim->lifo_slot.store(nullptr, std::memory_order_relaxed);
+    }
+    gpr_mu_unlock(&victim->mu);
+    if (stolen.head != nullptr) {
+      if (GRPC_TRACE_FLAG_ENABLED(executor_trace)) {
+        gpr_log(GPR_INFO,
+                "EXECUTOR (%s) worker %" PRIdPTR
+                " took the LIFO slot of worker %" PRIdPTR,
+                name_, worker->id, victim->id);
+      }
+      break;
+    }
+  }
+  return stolen;
+}
+
+bool WorkStealingExecutor::HasQueuedWork() const {
+  const size_t num_threads = num_threads_.load(std::memory_order_acquire);
+  for (size_t i = 0; i < num_threads; ++i) {
+    if (workers_[i].depth.load(std::memory_order_seq_cst) > 0) return true;
+  }
+  return false;
+}
+
+bool WorkStealingExecutor::ShouldWatchLifoSlots(Worker* worker) const {
+  const size_t num_threads = num_threads_.load(std::memory_order_acquire);
+  bool full = false;
+  uint64_t fills = 0;
+  for (size_t i = 0; i < num_threads; ++i) {
+    if (i == worker->id) continue;
+    if (workers_[i].lifo_slot.load(std::memory_order_seq_cst) != nullptr) {
+      full = true;
+    }
+    fills += workers_[i].lifo_fills.load(std::memory_order_relaxed);
+  }
+  // A worker that keeps filling its LIFO slot is likely running a chain of
+  // continuations, whose slot is only empty for a moment at a time. Going on
+  // watching it saves Enqueue() from waking a worker for every link.
+  const bool changed = fills != worker->lifo_fills_seen_at_park;
+  worker->lifo_fills_seen_at_park = fills;
+  return full || changed;
+}
+
+void WorkStealingExecutor::Park(Worker* worker) {
+  gpr_mu_lock(&park_mu_);
+  worker->woken = false;
+  worker->parked_prev = nullptr;
+  worker->parked_next = parked_head_;
+  if (parked_head_ != nullptr) parked_head_->parked_prev = worker;
+  parked_head_ = worker;
+  num_parked_.fetch_add(1, std::memory_order_seq_cst);
+  gpr_mu_unlock(&park_mu_);
+
+  // Work queued from now on wakes us up through WakeOne(), so it is enough to
+  // look for work queued before once, without holding park_mu_.
+  const bool has_work = HasQueuedWork();
+  const bool watch_lifo = !has_work && ShouldWatchLifoSlots(worker);
+
+  gpr_mu_lock(&park_mu_);
+  gpr_timespec deadline = gpr_inf_future(GPR_CLOCK_MONOTONIC);
+  if (watch_lifo) {
+    worker->watching_lifo = true;
+    num_lifo_watchers_.fetch_add(1, std::memory_order_seq_cst);
+    deadline = gpr_time_add(
+        gpr_now(GPR_CLOCK_MONOTONIC),
+        gpr_time_from_millis(kLifoStealDelayMs, GPR_TIMESPAN));
+  }
+  while (!has_work && !worker->woken &&
+         !shutdown_.load(std::memory_order_seq_cst)) {
+    if (gpr_cv_wait(&worker->cv, &park_mu_, deadline)) break;
+  }
+  if (worker->watching_lifo) {
+    worker->watching_lifo = false;
+    num_lifo_watchers_.fetch_sub(1, std::memory_order_relaxed);
+  }
+  if (!worker->woken) {
+    // Not woken by WakeOne(), which would have taken us off the list.
+    if (worker->parked_prev != nullptr) {
+      worker->parked_prev->parked_next = worker->parked_next;
+    } else {
+      parked_head_ = worker->parked_next;
+    }
+    if (worker->parked_next != nullptr) {
+      worker->parked_next->parked_prev = worker->parked_prev;
+    }
+    num_parked_.fetch_sub(1, std::memory_order_relaxed);
+  }
+  worker->parked_prev = nullptr;
+  worker->parked_next = nullptr;
+  gpr_mu_unlock(&park_mu_);
+}
+
+bool WorkStealingExecutor::WakeOne() {
+  // Pairs with the seq_cst increment of num_parked_ in Park(): either the
+  // parking worker sees the work the caller just queued, or we see it parked.
+  // Most calls find no parked worker, and don't need park_mu_ for that.
+  if (num_parked_.load(std::memory_order_seq_cst) == 0) return false;
+  bool woke = false;
+  gpr_mu_lock(&park_mu_);
+  if (parked_head_ != nullptr) {
+    // The most recently parked worker is the one most likely to still have a
+    // warm cache.
+    Worker* worker = parked_head_;
+    parked_head_ = worker->parked_next;
+    if (parked_head_ != nullptr) parked_head_->parked_prev = nullptr;
+    worker->parked_next = nullptr;
+    num_parked_.fetch_sub(1, std::memory_order_relaxed);
+    worker->woken = true;
+    gpr_cv_signal(&worker->cv);
+    woke = true;
+  }
+  gpr_mu_unlock(&park_mu_);
+  return woke;
+}
+
+void WorkStealingExecutor::MaybeAddThread() {
+  if (num_threads_.load(std::memory_order_relaxed) >= max_threads_ ||
+      shutdown_.load(std::memory_order_relaxed) ||
+      !gpr_spinlock_trylock(&adding_thread_lock_)) {
+    return;
+  }
+  size_t num_threads = num_threads_.load(std::memory_order_relaxed);
+  if (num_threads < max_threads_ &&
+      !shutdown_.load(std::memory_order_relaxed)) {
+    Worker* worker = &workers_[num_threads];
+    worker->thd = Thread(name_, &WorkStealingExecutor::ThreadMain, worker);
+    worker->thd.Start();
+    num_threads_.store(num_threads + 1, std::memory_order_release);
+  }
+  gpr_spinlock_unlock(&adding_thread_lock_);
+}
+
+void WorkStealingExecutor::ThreadMain(void* arg) {
+  Worker* worker = static_cast<Worker*>(arg);
+  WorkStealingExecutor* executor = worker->executor;
+  current_worker_ = worker;
+
+  ExecCtx exec_ctx(GRPC_EXEC_CTX_FLAG_IS_INTERNAL_THREAD);
+
+  size_t batches_until_numa_refresh = 0;
+  while (!executor->shutdown_.load(std::memory_order_acquire)) {
+    if (batches_until_numa_refresh == 0) {
+      worker->numa_node.store(CurrentNumaNode(), std::memory_order_relaxed);
+      batches_until_numa_refresh = kNumaRefreshInterval;
+    }
+    grpc_closure_list list = executor->TakeLocal(worker);
+    if (list.head == nullptr) list = executor->Steal(worker);
+    if (list.head == nullptr) {
+      executor->Park(worker);
+      // The thread may well wake up on another CPU.
+      batches_until_numa_refresh = 0;
+      continue;
+    }
+    --batches_until_numa_refresh;
+    // Leftover work here is better run by a parked worker than left waiting
+    // behind the batch we are about to run.
+    if (worker->depth.load(std::memory_order_relaxed) > 0) {
+      executor->WakeOne();
+    }
+    ExecCtx::Get()->InvalidateNow();
+    executor->run_closures_(executor->name_, list);
+  }
+
+  current_worker_ = nullptr;
+}
+
+}  // namespace grpc_core
@@ -0,0 +1,137 @@
+/*
+ *
+ * Copyright 2021 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_LIB_IOMGR_EXECUTOR_WORK_STEALING_EXECUTOR_H
+#define GRPC_CORE_LIB_IOMGR_EXECUTOR_WORK_STEALING_EXECUTOR_H
+
+#include <grpc/support/port_platform.h>
+
+#include <atomic>
+
+#include <grpc/support/sync.h>
+
+#include "src/core/lib/gpr/spinlock.h"
+#include "src/core/lib/gpr/tls.h"
+#include "src/core/lib/gprpp/thd.h"
+#include "src/core/lib/iomgr/closure.h"
+
+namespace grpc_core {
+
+// A closure executor where every worker thread owns its queue.
+//
+// Closures scheduled from a worker go to that worker: the most recent one
+// into a single-entry LIFO slot, so that a closure scheduling its
+// continuation runs it next while its data is still in cache, and older ones
+// to the back of the worker's queue. Closures scheduled from other threads go
+// to the worker of the current CPU. A worker that runs out of work steals half
+// of another worker's queue, trying workers on its own NUMA node first, and
+// parks when there is nothing to steal.
+//
+// A LIFO slot is left to its owner for kLifoStealDelayMs. While LIFO slots
+// are in use, parked workers wait with that timeout instead of indefinitely,
+// and take a closure that has sat in a slot for longer, in case its owner is
+// stuck in a long-running closure. Filling a slot only wakes a parked worker
+// when no parked worker is watching the slots already.
+//
+// No lock is shared by all workers on the scheduling or running path; the
+// lock guarding the list of parked workers is only taken when one of them has
+// to be woken, and by a worker parking or unparking.
+//
+// Threads are started lazily, like Executor's, up to |max_threads|.
+class WorkStealingExecutor {
+ public:
+  // Runs |list| on the calling thread and returns the number of closures run.
+  using RunClosuresFn = size_t (*)(const char* name, grpc_closure_list list);
+
+  WorkStealingExecutor(const char* name, size_t max_threads,
+                       RunClosuresFn run_closures);
+  // Requires Stop() to have been called, if Start() was.
+  ~WorkStealingExecutor();
+
+  WorkStealingExecutor(const WorkStealingExecutor&) = delete;
+  WorkStealingExecutor& operator=(const WorkStealingExecutor&) = delete;
+
+  // Starts the first worker thread.
+  void Start();
+
+  // Joins all the worker threads, then runs the closures they left behind on
+  // the calling thread.
+  void Stop();
+
+  bool IsRunning() const {
+    return num_threads_.load(std::memory_order_acquire) > 0;
+  }
+
+  // Schedules |closure|. Returns false, without taking ownership of |error|,
+  // if the executor isn't running.
+  bool Enqueue(grpc_closure* closure, grpc_error_handle error, bool is_short);
+
+ private:
+  struct Worker;
+
+  static void ThreadMain(void* arg);
+
+  // Takes the next closures to run for |worker|, from its LIFO slot or the
+  // front of its queue. Returns an empty list if it has none.
+  grpc_closure_list TakeLocal(Worker* worker);
+  // Moves half of another worker's queue to |worker| and returns it. Failing
+  // that, takes a closure that has been in another worker's LIFO slot for
+  // longer than kLifoStealDelayMs. Returns an empty list if there is neither.
+  grpc_closure_list Steal(Worker* worker);
+  grpc_closure_list StealStaleLifo(Worker* worker);
+  // Blocks until |worker| is woken up, or there is work to steal, or the
+  // executor is stopping. If some LIFO slot is full, only blocks for
+  // kLifoStealDelayMs.
+  void Park(Worker* worker);
+  // Wakes up one parked worker, if there is one. Returns false if there was
+  // none.
+  bool WakeOne();
+  // Returns true if some worker has closures queued, outside its LIFO slot.
+  bool HasQueuedWork() const;
+  // Returns true if |worker| should park for kLifoStealDelayMs only: when the
+  // LIFO slot of another worker is full, or some other worker filled its LIFO
+  // slot since |worker| last parked.
+  bool ShouldWatchLifoSlots(Worker* worker) const;
+  // Starts another worker thread, if |max_threads_| allows.
+  void MaybeAddThread();
+
+  // The worker running on this thread, if any.
+  static GPR_THREAD_LOCAL(Worker*) current_worker_;
+
+  const char* name_;
+  const size_t max_threads_;
+  const RunClosuresFn run_closures_;
+  Worker* workers_;
+  std::atomic<size_t> num_threads_{0};
+  std::atomic<bool> shutdown_{false};
+  gpr_spinlock adding_thread_lock_ = GPR_SPINLOCK_STATIC_INITIALIZER;
+
+  // Guards the list of parked workers, and their Worker::woken and
+  // Worker::watching_lifo.
+  gpr_mu park_mu_;
+  // Most recently parked first, linked through Worker::parked_next.
+  Worker* parked_head_ = nullptr;
+  std::atomic<size_t> num_parked_{0};
+  // Number of parked workers waiting for kLifoStealDelayMs rather than
+  // indefinitely. Written under park_mu_.
+  std::atomic<size_t> num_lifo_watchers_{0};
+};
+
+}  // namespace grpc_core
+
+#endif /* GRPC_CORE_LIB_IOMGR_EXECUTOR_WORK_STEALING_EXECUTOR_H */
@@ -71,10 +71,12 @@ void grpc_prefork() {
             "Fork support is only compatible with the epoll1 and poll polling "
             "strategies");
   }
+  grpc_core::Fork::SetThreadingOfRegisteredFuncs(false);
   if (!grpc_core::Fork::BlockExecCtx()) {
     gpr_log(GPR_INFO,
             "Other threads are currently calling into gRPC, skipping fork() "
             "handlers");
+    grpc_core::Fork::SetThreadingOfRegisteredFuncs(true);
     return;
   }
   grpc_timer_manager_set_threading(false);
@@ -90,6 +92,7 @@ void grpc_postfork_parent() {
     grpc_core::ExecCtx exec_ctx;
     grpc_timer_manager_set_threading(true);
     grpc_core::Executor::SetThreadingAll(true);
+    grpc_core::Fork::SetThreadingOfRegisteredFuncs(true);
   }
 }
 
@@ -104,6 +107,7 @@ void grpc_postfork_child() {
     }
     grpc_timer_manager_set_threading(true);
     grpc_core::Executor::SetThreadingAll(true);
+    grpc_core::Fork::SetThreadingOfRegisteredFuncs(true);
   }
 }
 
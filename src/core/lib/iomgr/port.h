@@ -69,6 +69,15 @@
 #if __GLIBC_PREREQ(2, 9)
 #define GRPC_LINUX_EPOLL_CREATE1 1
 #define GRPC_LINUX_EVENTFD 1
+#define GRPC_LINUX_INOTIFY 1
+#endif
+#if defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define GRPC_LINUX_IO_URING 1
+#endif
+#if __has_include(<linux/tls.h>)
+#define GRPC_LINUX_KTLS 1
+#endif
 #endif
 #if __GLIBC_PREREQ(2, 10)
 #define GRPC_LINUX_SOCKETUTILS 1
@@ -85,6 +94,7 @@
 #define GRPC_LINUX_EPOLL 1
 #define GRPC_LINUX_EPOLL_CREATE1 1
 #define GRPC_LINUX_EVENTFD 1
+#define GRPC_LINUX_INOTIFY 1
 #define GRPC_MSG_IOVLEN_TYPE int
 #endif
 #ifndef GRPC_LINUX_EVENTFD
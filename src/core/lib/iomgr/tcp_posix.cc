@@ -36,6 +36,12 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#if defined(GPR_LINUX) && defined(TCP_ZEROCOPY_RECEIVE)
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#define GRPC_TCP_RX_ZEROCOPY 1
+#endif
+
 #include <algorithm>
 #include <unordered_map>
 
@@ -350,6 +356,173 @@ class TcpZerocopySendCtx {
   bool memory_limited_ = false;
 };
 
+// A per-endpoint free list of equally sized receive buffers. Slices handed out
+// by Get() return their storage here when the last reference to them is
+// dropped (typically by the transport, on an arbitrary thread), so that a
+// connection in steady state reads into recycled memory instead of going
+// through malloc/free and the memory quota for every read. Idle buffers are
+// given back to the memory quota by a benign reclaimer.
+class TcpReadBufferPool {
+ public:
+  // Reads wanting more than this allocate one-off slices instead.
+  static constexpr size_t kMaxBufferSize = 64 * 1024;
+  // Above this memory quota pressure, buffers are neither handed out nor
+  // recycled: reads fall back to quota-sized one-off slices.
+  static constexpr double kMaxPressure = 0.8;
+
+  TcpReadBufferPool(MemoryOwner* memory_owner, size_t max_idle_buffers)
+      : memory_owner_(memory_owner), max_idle_buffers_(max_idle_buffers) {}
+
+  // Returns a slice of exactly `size` bytes, which must be a power of two no
+  // larger than kMaxBufferSize. A change of size retires the idle buffers of
+  // the previous size. Only called from the endpoint's read path.
+  grpc_slice Get(size_t size) {
+    GPR_DEBUG_ASSERT(size <= kMaxBufferSize);
+    Buffer* buffer = nullptr;
+    bool post_reclaimer = false;
+    {
+      MutexLock lock(&mu_);
+      post_reclaimer = !reclaimer_posted_;
+      reclaimer_posted_ = true;
+      if (size != buffer_size_) {
+        FreeIdleLocked();
+        buffer_size_ = size;
+      } else if (idle_ != nullptr) {
+        buffer = idle_;
+        idle_ = buffer->next;
+        --num_idle_;
+      }
+    }
+    if (buffer != nullptr) {
+      GRPC_STATS_INC_TCP_READ_BUFFER_POOL_REUSES();
+      buffer->refs.store(1, std::memory_order_relaxed);
+    } else {
+      GRPC_STATS_INC_TCP_READ_BUFFER_POOL_ALLOCS();
+      buffer = new (gpr_malloc(sizeof(Buffer) + size)) Buffer(this, size);
+      buffer->reservation = memory_owner_->MakeReservation(
+          MemoryRequest(sizeof(Buffer) + size));
+    }
+    Ref();
+    // The buffer handed out now is recycled later on: make sure it can be
+    // reclaimed once idle. This runs on the read path, so the memory owner is
+    // still alive.
+    if (post_reclaimer) PostReclaimer();
+    grpc_slice slice;
+    slice.refcount = &buffer->base;
+    slice.data.refcounted.bytes = reinterpret_cast<uint8_t*>(buffer + 1);
+    slice.data.refcounted.length = size;
+    return slice;
+  }
+
+  // Releases the idle buffers, e.g. when the memory quota is under pressure.
+  void Trim() {
+    MutexLock lock(&mu_);
+    FreeIdleLocked();
+  }
+
+  // Called when the owning endpoint is destroyed. Buffers still referenced by
+  // slices are freed, rather than recycled, once they are released.
+  void Orphan() {
+    {
+      MutexLock lock(&mu_);
+      orphaned_ = true;
+      memory_owner_ = nullptr;
+      FreeIdleLocked();
+    }
+    Unref();
+  }
+
+ private:
+  struct Buffer {
+    Buffer(TcpReadBufferPool* pool, size_t size)
+        : base(grpc_slice_refcount::Type::REGULAR, &refs, Destroy, this,
+               &base),
+          pool(pool),
+          size(size) {}
+    grpc_slice_refcount base;
+    std::atomic<size_t> refs{1};
+    TcpReadBufferPool* pool;
+    MemoryAllocator::Reservation reservation;
+    size_t size;
+    Buffer* next = nullptr;
+  };
+
+  static void Destroy(void* p) {
+    Buffer* buffer = static_cast<Buffer*>(p);
+    TcpReadBufferPool* pool = buffer->pool;
+    pool->Recycle(buffer);
+    pool->Unref();
+  }
+
+  static void FreeBuffer(Buffer* buffer) {
+    buffer->~Buffer();
+    gpr_free(buffer);
+  }
+
+  // Posts a reclaimer that frees the idle buffers when the memory quota runs
+  // low. It holds a reference to the pool until it runs, or until the memory
+  // owner shuts down.
+  void PostReclaimer() {
+    Ref();
+    memory_owner_->PostReclaimer(
+        ReclamationPass::kBenign,
+        [this](absl::optional<ReclamationSweep> sweep) {
+          {
+            MutexLock lock(&mu_);
+            if (sweep.has_value()) FreeIdleLocked();
+            // The next Get() posts a new reclaimer
+            reclaimer_posted_ = false;
+          }
+          Unref();
+        });
+  }
+
+  void Recycle(Buffer* buffer) {
+    {
+      MutexLock lock(&mu_);
+      // Buffers released while the memory quota is under pressure go back to
+      // the quota rather than to the idle list.
+      if (!orphaned_ && buffer->size == buffer_size_ &&
+          num_idle_ < max_idle_buffers_ &&
+          memory_owner_->InstantaneousPressure() < kMaxPressure) {
+        buffer->next = idle_;
+        idle_ = buffer;
+        ++num_idle_;
+        return;
+      }
+    }
+    FreeBuffer(buffer);
+  }
+
+  void FreeIdleLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    while (idle_ != nullptr) {
+      Buffer* next = idle_->next;
+      FreeBuffer(idle_);
+      idle_ = next;
+    }
+    num_idle_ = 0;
+  }
+
+  // References: 1 for the endpoint, and 1 per buffer currently handed out.
+  void Ref() { refs_.fetch_add(1, std::memory_order_relaxed); }
+
+  void Unref() {
+    if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      delete this;
+    }
+  }
+
+  MemoryOwner* memory_owner_;
+  const size_t max_idle_buffers_;
+  std::atomic<intptr_t> refs_{1};
+  Mutex mu_;
+  Buffer* idle_ ABSL_GUARDED_BY(mu_) = nullptr;
+  size_t num_idle_ ABSL_GUARDED_BY(mu_) = 0;
+  size_t buffer_size_ ABSL_GUARDED_BY(mu_) = 0;
+  bool orphaned_ ABSL_GUARDED_BY(mu_) = false;
+  bool reclaimer_posted_ ABSL_GUARDED_BY(mu_) = false;
+};
+
 }  // namespace grpc_core
 
 using grpc_core::TcpZerocopySendCtx;
@@ -423,6 +596,15 @@ struct grpc_tcp {
                                       on errors anymore */
   TcpZerocopySendCtx tcp_zerocopy_send_ctx;
   TcpZerocopySendRecord* current_zerocopy_send = nullptr;
+
+  /* True if reads of at least rx_zerocopy_bytes_threshold pending bytes should
+   * map the socket's receive queue (TCP_ZEROCOPY_RECEIVE) instead of copying.
+   * Reset to false if the kernel turns out not to support it. */
+  bool rx_zerocopy_enabled = false;
+  int rx_zerocopy_bytes_threshold = 0;
+
+  /* Recycles receive buffers across reads; null if disabled. */
+  grpc_core::TcpReadBufferPool* read_buffer_pool = nullptr;
 };
 
 struct backup_poller {
@@ -612,6 +794,9 @@ static void tcp_free(grpc_tcp* tcp) {
   grpc_fd_orphan(tcp->em_fd, tcp->release_fd_cb, tcp->release_fd,
                  "tcp_unref_orphan");
   grpc_slice_buffer_destroy_internal(&tcp->last_read_buffer);
+  if (tcp->read_buffer_pool != nullptr) {
+    tcp->read_buffer_pool->Orphan();
+  }
   /* The lock is not really necessary here, since all refs have been released */
   gpr_mu_lock(&tcp->tb_mu);
   grpc_core::TracedBuffer::Shutdown(
@@ -772,6 +957,10 @@ static void tcp_do_read(grpc_tcp* tcp) {
     }
 
     GRPC_STATS_INC_TCP_READ_SIZE(read_bytes);
+    if (tcp->rx_zerocopy_enabled) {
+      GRPC_STATS_ADD_COUNTER(GRPC_STATS_COUNTER_TCP_RX_COPIED_BYTES,
+                             read_bytes);
+    }
     add_to_estimate(tcp, static_cast<size_t>(read_bytes));
     GPR_DEBUG_ASSERT((size_t)read_bytes <=
                      tcp->incoming_buffer->length - total_read_bytes);
@@ -831,7 +1020,181 @@ static void tcp_do_read(grpc_tcp* tcp) {
   TCP_UNREF(tcp, "read");
 }
 
+#ifdef GRPC_TCP_RX_ZEROCOPY
+namespace {
+// Pages of a socket's receive queue mapped by a zerocopy read. They are
+// charged to the endpoint's memory quota like a copied read buffer would be,
+// until the last slice referencing them is dropped and they are unmapped.
+struct ZerocopyRxMapping {
+  ZerocopyRxMapping(void* addr, size_t length,
+                    grpc_core::MemoryAllocator::Reservation reservation)
+      : base(grpc_slice_refcount::Type::REGULAR, &refs, Destroy, this, &base),
+        addr(addr),
+        length(length),
+        reservation(std::move(reservation)) {}
+
+  static void Destroy(void* p) {
+    ZerocopyRxMapping* mapping = static_cast<ZerocopyRxMapping*>(p);
+    munmap(mapping->addr, mapping->length);
+    delete mapping;
+  }
+
+  grpc_slice_refcount base;
+  std::atomic<size_t> refs{1};
+  void* addr;
+  size_t length;
+  grpc_core::MemoryAllocator::Reservation reservation;
+};
+}  // namespace
+
+/* Asks the kernel to map up to length bytes of the receive queue at addr. */
+static int tcp_zerocopy_receive(grpc_tcp* tcp, void* addr, size_t length,
+                                struct tcp_zerocopy_receive* zc) {
+  memset(zc, 0, sizeof(*zc));
+  zc->address = reinterpret_cast<uint64_t>(addr);
+  zc->length = static_cast<uint32_t>(length);
+  socklen_t zc_len = sizeof(*zc);
+  int r;
+  do {
+    GRPC_STATS_INC_SYSCALL_READ();
+    r = getsockopt(tcp->fd, IPPROTO_TCP, TCP_ZEROCOPY_RECEIVE, zc, &zc_len);
+  } while (r < 0 && errno == EINTR);
+  if (r < 0 && errno != EAGAIN) {
+    gpr_log(GPR_DEBUG, "TCP:%p rx zerocopy disabled, getsockopt failed: %s",
+            tcp, strerror(errno));
+    tcp->rx_zerocopy_enabled = false;
+  }
+  return r;
+}
+
+/* Tries to hand the pending bytes to the upper layer without copying them, by
+ * mapping the pages of the socket's receive queue into a slice (the pages are
+ * unmapped when the last reference to the slice goes away). Only used when
+ * the receive queue holds enough bytes to amortize the mmap/munmap calls.
+ * Returns true if the read completed (read_cb has been called), false if the
+ * caller should read the data through recvmsg() instead. */
+static bool tcp_do_read_zerocopy(grpc_tcp* tcp) {
+  GPR_TIMER_SCOPE("tcp_do_read_zerocopy", 0);
+  static const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  if (!tcp->inq_capable) return false;
+  if (tcp->inq == 0) {
+    /* Woken up by a new read edge: TCP_INQ from the last read says nothing
+     * about what has arrived since, so ask for it. */
+    int pending;
+    if (ioctl(tcp->fd, FIONREAD, &pending) == 0) tcp->inq = pending;
+  }
+  if (tcp->inq < tcp->rx_zerocopy_bytes_threshold) return false;
+  size_t length = std::min(static_cast<size_t>(tcp->inq),
+                           static_cast<size_t>(tcp->max_read_chunk_size));
+  length -= length % page_size;
+  if (length == 0) return false;
+  void* addr = mmap(nullptr, length, PROT_READ, MAP_SHARED, tcp->fd, 0);
+  if (addr == MAP_FAILED) {
+    gpr_log(GPR_DEBUG, "TCP:%p rx zerocopy disabled, mmap failed: %s", tcp,
+            strerror(errno));
+    tcp->rx_zerocopy_enabled = false;
+    return false;
+  }
+  struct tcp_zerocopy_receive zc;
+  int r = tcp_zerocopy_receive(tcp, addr, length, &zc);
+  grpc_slice skipped = grpc_empty_slice();
+  if (r == 0 && zc.length == 0 && zc.recv_skip_hint > 0 &&
+      static_cast<int>(zc.recv_skip_hint) < tcp->inq) {
+    /* The head of the receive queue does not fill a page. Copy just that part
+     * out so that what follows it can still be mapped. */
+    skipped = tcp->memory_owner.MakeSlice(
+        grpc_core::MemoryRequest(zc.recv_skip_hint));
+    ssize_t n;
+    do {
+      GRPC_STATS_INC_SYSCALL_READ();
+      n = recv(tcp->fd, GRPC_SLICE_START_PTR(skipped), zc.recv_skip_hint, 0);
+    } while (n < 0 && errno == EINTR);
+    if (n <= 0) {
+      /* recvmsg() reports the error or end of stream */
+      grpc_slice_unref_internal(skipped);
+      munmap(addr, length);
+      return false;
+    }
+    GRPC_STATS_ADD_COUNTER(GRPC_STATS_COUNTER_TCP_RX_COPIED_BYTES, n);
+    skipped.data.refcounted.length = static_cast<size_t>(n);
+    tcp->inq -= static_cast<int>(n);
+    if (n == static_cast<ssize_t>(zc.recv_skip_hint)) {
+      r = tcp_zerocopy_receive(tcp, addr, length, &zc);
+    } else {
+      zc.length = 0;
+    }
+  }
+  if (GRPC_SLICE_LENGTH(skipped) == 0 && (r < 0 || zc.length == 0)) {
+    /* Nothing could be mapped or copied: the data is not page aligned and too
+     * short to be worth splitting, the peer closed the connection or an error
+     * is pending. recvmsg() deals with all of these. */
+    munmap(addr, length);
+    return false;
+  }
+  /* Unused buffer space left over from the previous read is kept for later */
+  grpc_slice_buffer_swap(tcp->incoming_buffer, &tcp->last_read_buffer);
+  if (GRPC_SLICE_LENGTH(skipped) > 0) {
+    add_to_estimate(tcp, GRPC_SLICE_LENGTH(skipped));
+    grpc_slice_buffer_add(tcp->incoming_buffer, skipped);
+  }
+  if (r < 0 || zc.length == 0) {
+    munmap(addr, length);
+  } else {
+    /* Only whole pages are mapped; release the part of the region that was
+     * not used right away */
+    size_t mapped = zc.length + (page_size - zc.length % page_size) % page_size;
+    if (mapped < length) {
+      munmap(static_cast<char*>(addr) + mapped, length - mapped);
+    }
+    GRPC_STATS_ADD_COUNTER(GRPC_STATS_COUNTER_TCP_RX_ZEROCOPY_BYTES, zc.length);
+    add_to_estimate(tcp, zc.length);
+    tcp->inq = std::max(tcp->inq - static_cast<int>(zc.length), 0);
+    ZerocopyRxMapping* mapping = new ZerocopyRxMapping(
+        addr, mapped,
+        tcp->memory_owner.MakeReservation(
+            grpc_core::MemoryRequest(mapped + sizeof(ZerocopyRxMapping))));
+    grpc_slice slice;
+    slice.refcount = &mapping->base;
+    slice.data.refcounted.bytes = static_cast<uint8_t*>(addr);
+    slice.data.refcounted.length = zc.length;
+    grpc_slice_buffer_add(tcp->incoming_buffer, slice);
+  }
+  /* Whatever is left in the receive queue is picked up by the next read,
+   * zerocopy again if there is still enough of it. Data arriving in the
+   * meantime raises a new read edge, so if nothing is left the next read
+   * waits for it. */
+  if (tcp->inq == 0) finish_estimate(tcp);
+  call_read_cb(tcp, GRPC_ERROR_NONE);
+  TCP_UNREF(tcp, "read");
+  return true;
+}
+#endif /* GRPC_TCP_RX_ZEROCOPY */
+
+static grpc_slice tcp_alloc_read_slice(grpc_tcp* tcp, int min_size,
+                                       int wanted_size) {
+  if (tcp->read_buffer_pool != nullptr &&
+      static_cast<size_t>(wanted_size) <=
+          grpc_core::TcpReadBufferPool::kMaxBufferSize) {
+    if (tcp->memory_owner.InstantaneousPressure() <
+        grpc_core::TcpReadBufferPool::kMaxPressure) {
+      /* Round up to a power of two so that small fluctuations of
+         target_length keep hitting the same size class. */
+      size_t size = 1;
+      while (size < static_cast<size_t>(wanted_size)) size <<= 1;
+      return tcp->read_buffer_pool->Get(size);
+    }
+    tcp->read_buffer_pool->Trim();
+  }
+  return tcp->memory_owner.MakeSlice(
+      grpc_core::MemoryRequest(min_size, wanted_size));
+}
+
 static void tcp_continue_read(grpc_tcp* tcp) {
+#ifdef GRPC_TCP_RX_ZEROCOPY
+  if (tcp->rx_zerocopy_enabled && tcp_do_read_zerocopy(tcp)) {
+    return;
+  }
+#endif /* GRPC_TCP_RX_ZEROCOPY */
   if (tcp->incoming_buffer->length == 0 &&
       tcp->incoming_buffer->count < MAX_READ_IOVEC) {
     if (GRPC_TRACE_FLAG_ENABLED(grpc_tcp_trace)) {
@@ -846,10 +1209,10 @@ static void tcp_continue_read(grpc_tcp* tcp) {
         target_length - static_cast<int>(tcp->incoming_buffer->length);
     grpc_slice_buffer_add_indexed(
         tcp->incoming_buffer,
-        tcp->memory_owner.MakeSlice(grpc_core::MemoryRequest(
-            tcp->min_read_chunk_size,
+        tcp_alloc_read_slice(
+            tcp, tcp->min_read_chunk_size,
             grpc_core::Clamp(extra_wanted, tcp->min_read_chunk_size,
-                             tcp->max_read_chunk_size))));
+                             tcp->max_read_chunk_size)));
   }
   if (GRPC_TRACE_FLAG_ENABLED(grpc_tcp_trace)) {
     gpr_log(GPR_INFO, "TCP:%p do_read", tcp);
@@ -1664,6 +2027,8 @@ grpc_endpoint* grpc_tcp_create(grpc_fd* em_fd,
                                const grpc_channel_args* channel_args,
                                absl::string_view peer_string) {
   static constexpr bool kZerocpTxEnabledDefault = false;
+  static constexpr bool kZerocpRxEnabledDefault = false;
+  static constexpr int kZerocpRxBytesThresholdDefault = 64 * 1024;
   int tcp_read_chunk_size = GRPC_TCP_DEFAULT_READ_SLICE_SIZE;
   int tcp_max_read_chunk_size = 4 * 1024 * 1024;
   int tcp_min_read_chunk_size = 256;
@@ -1672,6 +2037,9 @@ grpc_endpoint* grpc_tcp_create(grpc_fd* em_fd,
       grpc_core::TcpZerocopySendCtx::kDefaultSendBytesThreshold;
   int tcp_tx_zerocopy_max_simult_sends =
       grpc_core::TcpZerocopySendCtx::kDefaultMaxSends;
+  bool tcp_rx_zerocopy_enabled = kZerocpRxEnabledDefault;
+  int tcp_rx_zerocopy_bytes_thresh = kZerocpRxBytesThresholdDefault;
+  int tcp_read_buffer_pool_size = 0;
   if (channel_args != nullptr) {
     for (size_t i = 0; i < channel_args->num_args; i++) {
       if (0 ==
@@ -1706,6 +2074,21 @@ grpc_endpoint* grpc_tcp_create(grpc_fd* em_fd,
             grpc_core::TcpZerocopySendCtx::kDefaultMaxSends, 0, INT_MAX};
         tcp_tx_zerocopy_max_simult_sends =
             grpc_channel_arg_get_integer(&channel_args->args[i], options);
+      } else if (0 == strcmp(channel_args->args[i].key,
+                             GRPC_ARG_TCP_RX_ZEROCOPY_ENABLED)) {
+        tcp_rx_zerocopy_enabled = grpc_channel_arg_get_bool(
+            &channel_args->args[i], kZerocpRxEnabledDefault);
+      } else if (0 == strcmp(channel_args->args[i].key,
+                             GRPC_ARG_TCP_RX_ZEROCOPY_BYTES_THRESHOLD)) {
+        grpc_integer_options options = {kZerocpRxBytesThresholdDefault, 1,
+                                        INT_MAX};
+        tcp_rx_zerocopy_bytes_thresh =
+            grpc_channel_arg_get_integer(&channel_args->args[i], options);
+      } else if (0 == strcmp(channel_args->args[i].key,
+                             GRPC_ARG_TCP_READ_BUFFER_POOL_SIZE)) {
+        grpc_integer_options options = {0, 0, INT_MAX};
+        tcp_read_buffer_pool_size =
+            grpc_channel_arg_get_integer(&channel_args->args[i], options);
       }
     }
   }
@@ -1725,6 +2108,10 @@ grpc_endpoint* grpc_tcp_create(grpc_fd* em_fd,
                           ->memory_quota()
                           ->CreateMemoryOwner(peer_string);
   tcp->self_reservation = tcp->memory_owner.MakeReservation(sizeof(grpc_tcp));
+  if (tcp_read_buffer_pool_size > 0) {
+    tcp->read_buffer_pool = new grpc_core::TcpReadBufferPool(
+        &tcp->memory_owner, tcp_read_buffer_pool_size);
+  }
   grpc_resolved_address resolved_local_addr;
   memset(&resolved_local_addr, 0, sizeof(resolved_local_addr));
   resolved_local_addr.len = sizeof(resolved_local_addr.addr);
@@ -1796,6 +2183,15 @@ grpc_endpoint* grpc_tcp_create(grpc_fd* em_fd,
 #else
   tcp->inq_capable = false;
 #endif /* GRPC_HAVE_TCP_INQ */
+#ifdef GRPC_TCP_RX_ZEROCOPY
+  /* Receive zerocopy relies on TCP_INQ to know when enough bytes are pending
+   * to make mapping them worthwhile */
+  tcp->rx_zerocopy_enabled = tcp_rx_zerocopy_enabled && tcp->inq_capable;
+  tcp->rx_zerocopy_bytes_threshold = tcp_rx_zerocopy_bytes_thresh;
+#else
+  (void)tcp_rx_zerocopy_enabled;
+  (void)tcp_rx_zerocopy_bytes_thresh;
+#endif /* GRPC_TCP_RX_ZEROCOPY */
   /* Start being notified on errors if event engine can track errors. */
   if (grpc_event_engine_can_track_errors()) {
     /* Grab a ref to tcp so that we can safely access the tcp struct when
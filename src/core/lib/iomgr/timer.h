@@ -31,6 +31,7 @@
 typedef struct grpc_timer {
   grpc_millis deadline;
   // Uninitialized if not using heap, or INVALID_HEAP_INDEX if not in heap.
+  // The timing wheel keeps the level and slot of the timer here instead.
   uint32_t heap_index;
   bool pending;
   struct grpc_timer* next;
@@ -40,7 +41,8 @@ typedef struct grpc_timer {
   struct grpc_timer* hash_table_next;
 #endif
 
-  // Optional field used by custom timers
+  // Optional field used by custom timers, and by the timing wheel to find the
+  // wheel a timer is filed in.
   union {
     void* custom_timer;
     grpc_event_engine::experimental::EventEngine::TaskHandle ee_task_handle;
@@ -128,4 +130,9 @@ void grpc_kick_poller(void);
 /* Sets the timer implementation */
 void grpc_set_timer_impl(grpc_timer_vtable* vtable);
 
+/* Returns the generic timer implementation selected by GRPC_TIMER_IMPL: the
+   sharded heaps ("heap", the default) or the per-CPU hierarchical timing
+   wheels ("wheel"). */
+grpc_timer_vtable* grpc_generic_timer_impl();
+
 #endif /* GRPC_CORE_LIB_IOMGR_TIMER_H */
@@ -19,6 +19,7 @@
 #include <grpc/support/port_platform.h>
 
 #include <inttypes.h>
+#include <string.h>
 
 #include <string>
 
@@ -33,6 +34,7 @@
 #include "src/core/lib/gpr/spinlock.h"
 #include "src/core/lib/gpr/tls.h"
 #include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/iomgr/port.h"
 #include "src/core/lib/iomgr/time_averaged_stats.h"
@@ -45,6 +47,11 @@
 #define MIN_QUEUE_WINDOW_DURATION 0.01
 #define MAX_QUEUE_WINDOW_DURATION 1.0
 
+GPR_GLOBAL_CONFIG_DEFINE_STRING(
+    grpc_timer_impl, "heap",
+    "Declares which timer implementation to use: 'heap' (sharded heaps, the "
+    "default) or 'wheel' (per-CPU hierarchical timing wheels).")
+
 grpc_core::TraceFlag grpc_timer_trace(false, "timer");
 grpc_core::TraceFlag grpc_timer_check_trace(false, "timer_check");
 
@@ -332,7 +339,10 @@ static void note_deadline_change(timer_shard* shard) {
   }
 }
 
-void grpc_timer_init_unset(grpc_timer* timer) { timer->pending = false; }
+void grpc_timer_init_unset(grpc_timer* timer) {
+  timer->pending = false;
+  timer->custom_timer = nullptr;
+}
 
 static void timer_init(grpc_timer* timer, grpc_millis deadline,
                        grpc_closure* closure) {
@@ -716,3 +726,17 @@ static grpc_timer_check_result timer_check(grpc_millis* next) {
 grpc_timer_vtable grpc_generic_timer_vtable = {
     timer_init,      timer_cancel,        timer_check,
     timer_list_init, timer_list_shutdown, timer_consume_kick};
+
+extern grpc_timer_vtable grpc_wheel_timer_vtable;
+
+grpc_timer_vtable* grpc_generic_timer_impl() {
+  grpc_core::UniquePtr<char> value = GPR_GLOBAL_CONFIG_GET(grpc_timer_impl);
+  if (strcmp(value.get(), "wheel") == 0) {
+    return &grpc_wheel_timer_vtable;
+  }
+  if (strcmp(value.get(), "heap") != 0) {
+    gpr_log(GPR_ERROR, "Unknown timer implementation '%s', using 'heap'",
+            value.get());
+  }
+  return &grpc_generic_timer_vtable;
+}
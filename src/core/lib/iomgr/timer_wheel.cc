@@ -0,0 +1,466 @@
+/*
+ *
+ * Copyright 2021 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* A hierarchical timing wheel implementation of grpc_timer.
+ *
+ * Each wheel has kNumLevels levels of kNumSlots slots. A slot on level k spans
+ * kNumSlots^k milliseconds, so a timer goes into the lowest level whose range
+ * covers its deadline, and is moved ("cascaded") one level down each time the
+ * wheel reaches the start of its slot. Inserting and cancelling a timer are a
+ * list push and unlink; most timers are cancelled long before they would have
+ * been cascaded, so their whole life costs O(1).
+ *
+ * There is one wheel per CPU, chosen when the timer is set, so that threads on
+ * different CPUs rarely share a lock. Expiry is batched: a single checker
+ * advances every wheel that is due and schedules all of its expired closures
+ * in one pass.
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include <inttypes.h>
+
+#include <algorithm>
+#include <atomic>
+#include <new>
+
+#include <grpc/support/alloc.h>
+#include <grpc/support/cpu.h>
+#include <grpc/support/log.h>
+#include <grpc/support/sync.h>
+
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gpr/spinlock.h"
+#include "src/core/lib/gpr/tls.h"
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/timer.h"
+
+extern grpc_core::TraceFlag grpc_timer_trace;
+extern grpc_core::TraceFlag grpc_timer_check_trace;
+
+namespace {
+
+constexpr int kSlotBits = 6;
+constexpr uint32_t kNumSlots = 1u << kSlotBits;
+constexpr uint32_t kSlotMask = kNumSlots - 1;
+constexpr int kNumLevels = 4;
+// Deadlines further out than this are parked in the top level, and re-filed
+// each time their slot is cascaded.
+constexpr grpc_millis kMaxWheelSpan = grpc_millis{1}
+                                      << (kSlotBits * kNumLevels);
+
+// grpc_timer::heap_index holds the level and slot a pending timer is filed
+// in, and grpc_timer::custom_timer its wheel, so that cancelling it needs
+// neither a search nor a hash lookup.
+constexpr int kLevelShift = kSlotBits;
+
+struct timer_wheel {
+  gpr_mu mu;
+  /* All timers with deadlines before this have been fired. */
+  grpc_millis next_tick;
+  /* Number of timers held in the wheel. */
+  size_t num_timers;
+  /* No timer in this wheel fires before this. INF_FUTURE if the wheel is
+     empty. Written under mu, read without it by the checker. */
+  std::atomic<grpc_millis> min_deadline;
+  /* Bit i of occupied[level] is set iff slots[level][i] is non-empty. */
+  uint64_t occupied[kNumLevels];
+  /* Doubly linked, nullptr-terminated lists of timers. */
+  grpc_timer* slots[kNumLevels][kNumSlots];
+} GPR_ALIGN_STRUCT(GPR_CACHELINE_SIZE);
+
+size_t g_num_wheels;
+timer_wheel* g_wheels;
+
+struct shared_mutables {
+  /* The earliest min_deadline across all wheels. */
+  std::atomic<grpc_millis> min_timer;
+  /* Allow only one checker at once. */
+  gpr_spinlock checker_mu;
+  bool initialized;
+} GPR_ALIGN_STRUCT(GPR_CACHELINE_SIZE);
+
+shared_mutables g_shared_mutables;
+
+/* Thread local copy of g_shared_mutables.min_timer, to avoid touching the
+   shared cacheline when no timer can be due. */
+GPR_THREAD_LOCAL(grpc_millis) g_last_seen_min_timer;
+
+uint32_t level_of(grpc_timer* timer) {
+  return timer->heap_index >> kLevelShift;
+}
+uint32_t slot_of(grpc_timer* timer) { return timer->heap_index & kSlotMask; }
+
+/* Files |timer| in the slot its deadline maps to, relative to
+   wheel->next_tick.
+   REQUIRES: wheel->mu locked */
+void wheel_add(timer_wheel* wheel, grpc_timer* timer) {
+  grpc_millis deadline = timer->deadline;
+  grpc_millis delta = deadline - wheel->next_tick;
+  if (delta < 0) {
+    deadline = wheel->next_tick;
+    delta = 0;
+  } else if (delta >= kMaxWheelSpan) {
+    deadline = wheel->next_tick + kMaxWheelSpan - 1;
+    delta = kMaxWheelSpan - 1;
+  }
+  uint32_t level = 0;
+  while (delta >= (grpc_millis{1} << (kSlotBits * (level + 1)))) {
+    ++level;
+  }
+  uint32_t slot = static_cast<uint32_t>(deadline >> (kSlotBits * level)) &
+                  kSlotMask;
+  timer->heap_index = (level << kLevelShift) | slot;
+  grpc_timer** head = &wheel->slots[level][slot];
+  timer->prev = nullptr;
+  timer->next = *head;
+  if (*head != nullptr) (*head)->prev = timer;
+  *head = timer;
+  wheel->occupied[level] |= uint64_t{1} << slot;
+}
+
+/* REQUIRES: wheel->mu locked */
+void wheel_remove(timer_wheel* wheel, grpc_timer* timer) {
+  uint32_t level = level_of(timer);
+  uint32_t slot = slot_of(timer);
+  if (timer->prev == nullptr) {
+    wheel->slots[level][slot] = timer->next;
+    if (timer->next == nullptr) {
+      wheel->occupied[level] &= ~(uint64_t{1} << slot);
+    }
+  } else {
+    timer->prev->next = timer->next;
+  }
+  if (timer->next != nullptr) timer->next->prev = timer->prev;
+}
+
+/* Detaches and returns the list held by a slot.
+   REQUIRES: wheel->mu locked */
+grpc_timer* wheel_take_slot(timer_wheel* wheel, uint32_t level, uint32_t slot) {
+  grpc_timer* list = wheel->slots[level][slot];
+  wheel->slots[level][slot] = nullptr;
+  wheel->occupied[level] &= ~(uint64_t{1} << slot);
+  return list;
+}
+
+/* Returns a time no later than the earliest deadline in the wheel: the exact
+   tick of the next occupied level 0 slot, or the time at which the next
+   occupied slot of a higher level gets cascaded.
+   REQUIRES: wheel->mu locked */
+grpc_millis wheel_compute_min_deadline(timer_wheel* wheel) {
+  if (wheel->num_timers == 0) return GRPC_MILLIS_INF_FUTURE;
+  grpc_millis result = GRPC_MILLIS_INF_FUTURE;
+  for (int level = 0; level < kNumLevels; ++level) {
+    uint64_t occupied = wheel->occupied[level];
+    if (occupied == 0) continue;
+    const int shift = kSlotBits * level;
+    const grpc_millis span = grpc_millis{1} << shift;
+    /* The first slot boundary of this level at or after next_tick. */
+    const grpc_millis first = (wheel->next_tick + span - 1) >> shift;
+    const uint32_t pos = static_cast<uint32_t>(first) & kSlotMask;
+    /* Rotate so that bit 0 is the slot at |first|. */
+    uint64_t rotated = pos == 0 ? occupied
+                                : (occupied >> pos) |
+                                      (occupied << (kNumSlots - pos));
+    int distance = 0;
+    while ((rotated & 1) == 0) {
+      rotated >>= 1;
+      ++distance;
+    }
+    result = std::min(result, (first + distance) << shift);
+  }
+  return result;
+}
+
+/* Lowers g_shared_mutables.min_timer to |deadline|. Returns true if it did. */
+bool lower_min_timer(grpc_millis deadline) {
+  grpc_millis current = g_shared_mutables.min_timer.load();
+  while (deadline < current) {
+    if (g_shared_mutables.min_timer.compare_exchange_weak(current, deadline)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/* Advances |wheel| to |now|, scheduling the closures of every timer whose
+   deadline has been reached. Returns the number of timers fired.
+   REQUIRES: wheel->mu unlocked */
+size_t wheel_advance(timer_wheel* wheel, grpc_millis now,
+                     grpc_error_handle error) {
+  size_t n = 0;
+  gpr_mu_lock(&wheel->mu);
+  while (wheel->next_tick <= now && wheel->num_timers > 0) {
+    const grpc_millis tick = wheel->next_tick;
+    /* At the start of a level's slot, refile its timers one level down. A
+       slot that wraps around to 0 starts the next slot of the level above. */
+    for (int level = 1; level < kNumLevels; ++level) {
+      if ((tick & ((grpc_millis{1} << (kSlotBits * level)) - 1)) != 0) break;
+      uint32_t slot =
+          static_cast<uint32_t>(tick >> (kSlotBits * level)) & kSlotMask;
+      grpc_timer* timer = wheel_take_slot(wheel, level, slot);
+      while (timer != nullptr) {
+        grpc_timer* next = timer->next;
+        wheel_add(wheel, timer);
+        timer = next;
+      }
+    }
+    grpc_timer* timer =
+        wheel_take_slot(wheel, 0, static_cast<uint32_t>(tick) & kSlotMask);
+    while (timer != nullptr) {
+      grpc_timer* next = timer->next;
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_trace)) {
+        gpr_log(GPR_INFO, "TIMER %p: FIRE %" PRId64 "ms late", timer,
+                now - timer->deadline);
+      }
+      timer->pending = false;
+      grpc_core::ExecCtx::Run(DEBUG_LOCATION, timer->closure,
+                              GRPC_ERROR_REF(error));
+      --wheel->num_timers;
+      ++n;
+      timer = next;
+    }
+    wheel->next_tick = tick + 1;
+    if ((wheel->occupied[0] >> (wheel->next_tick & kSlotMask) & 1) == 0) {
+      /* Nothing fires or cascades before the next occupied slot of any level
+         comes up: skip straight to it, or past now if it is later. */
+      wheel->next_tick = std::min(now + 1, wheel_compute_min_deadline(wheel));
+    }
+  }
+  if (wheel->num_timers == 0 && wheel->next_tick <= now) {
+    wheel->next_tick = now + 1;
+  }
+  wheel->min_deadline.store(wheel_compute_min_deadline(wheel));
+  gpr_mu_unlock(&wheel->mu);
+  return n;
+}
+
+/* Fires every timer left in |wheel| with |error|.
+   REQUIRES: wheel->mu unlocked */
+size_t wheel_drain(timer_wheel* wheel, grpc_error_handle error) {
+  size_t n = 0;
+  gpr_mu_lock(&wheel->mu);
+  for (int level = 0; level < kNumLevels; ++level) {
+    for (uint32_t slot = 0; slot < kNumSlots; ++slot) {
+      grpc_timer* timer = wheel_take_slot(wheel, level, slot);
+      while (timer != nullptr) {
+        grpc_timer* next = timer->next;
+        timer->pending = false;
+        grpc_core::ExecCtx::Run(DEBUG_LOCATION, timer->closure,
+                                GRPC_ERROR_REF(error));
+        ++n;
+        timer = next;
+      }
+    }
+  }
+  wheel->num_timers = 0;
+  wheel->min_deadline.store(GRPC_MILLIS_INF_FUTURE);
+  gpr_mu_unlock(&wheel->mu);
+  return n;
+}
+
+grpc_timer_check_result run_some_expired_timers(grpc_millis now,
+                                                grpc_millis* next,
+                                                grpc_error_handle error) {
+  grpc_timer_check_result result = GRPC_TIMERS_NOT_CHECKED;
+  grpc_millis min_timer = g_shared_mutables.min_timer.load();
+  g_last_seen_min_timer = min_timer;
+
+  if (now < min_timer) {
+    if (next != nullptr) *next = std::min(*next, min_timer);
+    GRPC_ERROR_UNREF(error);
+    return GRPC_TIMERS_CHECKED_AND_EMPTY;
+  }
+
+  if (gpr_spinlock_trylock(&g_shared_mutables.checker_mu)) {
+    result = GRPC_TIMERS_CHECKED_AND_EMPTY;
+    /* Raise the shared minimum before looking at the wheels: a timer_init
+       racing with this pass either is seen by it, or lowers min_timer again
+       after the store below. */
+    g_shared_mutables.min_timer.store(GRPC_MILLIS_INF_FUTURE);
+    grpc_millis new_min = GRPC_MILLIS_INF_FUTURE;
+    for (size_t i = 0; i < g_num_wheels; ++i) {
+      timer_wheel* wheel = &g_wheels[i];
+      if (wheel->min_deadline.load() <= now) {
+        size_t fired = now == GRPC_MILLIS_INF_FUTURE
+                           ? wheel_drain(wheel, error)
+                           : wheel_advance(wheel, now, error);
+        if (fired > 0) result = GRPC_TIMERS_FIRED;
+        if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_check_trace)) {
+          gpr_log(GPR_INFO, "  .. wheel[%" PRIdPTR "] fired %" PRIdPTR, i,
+                  fired);
+        }
+      }
+      new_min = std::min(new_min, wheel->min_deadline.load());
+    }
+    lower_min_timer(new_min);
+    if (next != nullptr) {
+      *next = std::min(*next, g_shared_mutables.min_timer.load());
+    }
+    gpr_spinlock_unlock(&g_shared_mutables.checker_mu);
+  }
+
+  GRPC_ERROR_UNREF(error);
+  return result;
+}
+
+void timer_list_init() {
+  g_num_wheels = grpc_core::Clamp(gpr_cpu_num_cores(), 1u, 64u);
+  g_wheels = static_cast<timer_wheel*>(
+      gpr_malloc_aligned(g_num_wheels * sizeof(*g_wheels), GPR_CACHELINE_SIZE));
+  grpc_millis now = grpc_core::ExecCtx::Get()->Now();
+  for (size_t i = 0; i < g_num_wheels; ++i) {
+    timer_wheel* wheel = new (&g_wheels[i]) timer_wheel();
+    gpr_mu_init(&wheel->mu);
+    wheel->next_tick = now;
+    wheel->num_timers = 0;
+    wheel->min_deadline.store(GRPC_MILLIS_INF_FUTURE);
+  }
+  g_shared_mutables.min_timer.store(GRPC_MILLIS_INF_FUTURE);
+  g_shared_mutables.checker_mu = GPR_SPINLOCK_INITIALIZER;
+  g_shared_mutables.initialized = true;
+  g_last_seen_min_timer = 0;
+}
+
+void timer_list_shutdown() {
+  run_some_expired_timers(
+      GRPC_MILLIS_INF_FUTURE, nullptr,
+      GRPC_ERROR_CREATE_FROM_STATIC_STRING("Timer list shutdown"));
+  for (size_t i = 0; i < g_num_wheels; ++i) {
+    gpr_mu_destroy(&g_wheels[i].mu);
+    g_wheels[i].~timer_wheel();
+  }
+  gpr_free_aligned(g_wheels);
+  g_wheels = nullptr;
+  g_shared_mutables.initialized = false;
+}
+
+void timer_init(grpc_timer* timer, grpc_millis deadline,
+                grpc_closure* closure) {
+  timer->closure = closure;
+  timer->deadline = deadline;
+
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_trace)) {
+    gpr_log(GPR_INFO, "TIMER %p: SET %" PRId64 " now %" PRId64 " call %p[%p]",
+            timer, deadline, grpc_core::ExecCtx::Get()->Now(), closure,
+            closure->cb);
+  }
+
+  if (!g_shared_mutables.initialized) {
+    timer->pending = false;
+    timer->custom_timer = nullptr;
+    grpc_core::ExecCtx::Run(
+        DEBUG_LOCATION, timer->closure,
+        GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            "Attempt to create timer before initialization"));
+    return;
+  }
+
+  timer_wheel* wheel = &g_wheels[gpr_cpu_current_cpu() % g_num_wheels];
+  timer->custom_timer = wheel;
+  grpc_millis now = grpc_core::ExecCtx::Get()->Now();
+  if (deadline <= now) {
+    timer->pending = false;
+    grpc_core::ExecCtx::Run(DEBUG_LOCATION, timer->closure, GRPC_ERROR_NONE);
+    return;
+  }
+
+  gpr_mu_lock(&wheel->mu);
+  /* An empty wheel is not advanced by the checker: catch up with now before
+     filing the timer, rather than having the next check walk every tick the
+     wheel was idle for. */
+  if (wheel->num_timers == 0 && wheel->next_tick < now) {
+    wheel->next_tick = now;
+  }
+  timer->pending = true;
+  wheel_add(wheel, timer);
+  ++wheel->num_timers;
+  bool is_first_timer = deadline < wheel->min_deadline.load();
+  if (is_first_timer) {
+    wheel->min_deadline.store(deadline);
+  }
+  gpr_mu_unlock(&wheel->mu);
+
+  if (is_first_timer && lower_min_timer(deadline)) {
+    grpc_kick_poller();
+  }
+}
+
+void timer_cancel(grpc_timer* timer) {
+  if (!g_shared_mutables.initialized) {
+    /* must have already been cancelled, also the wheel mutex is invalid */
+    return;
+  }
+  timer_wheel* wheel = static_cast<timer_wheel*>(timer->custom_timer);
+  if (wheel == nullptr) {
+    /* grpc_timer_init_unset() without a grpc_timer_init() */
+    return;
+  }
+  gpr_mu_lock(&wheel->mu);
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_trace)) {
+    gpr_log(GPR_INFO, "TIMER %p: CANCEL pending=%s", timer,
+            timer->pending ? "true" : "false");
+  }
+  if (timer->pending) {
+    grpc_core::ExecCtx::Run(DEBUG_LOCATION, timer->closure,
+                            GRPC_ERROR_CANCELLED);
+    timer->pending = false;
+    wheel_remove(wheel, timer);
+    --wheel->num_timers;
+  }
+  gpr_mu_unlock(&wheel->mu);
+}
+
+void timer_consume_kick(void) {
+  /* Force re-evaluation of last seen min */
+  g_last_seen_min_timer = 0;
+}
+
+grpc_timer_check_result timer_check(grpc_millis* next) {
+  grpc_millis now = grpc_core::ExecCtx::Get()->Now();
+
+  /* fetch from a thread-local first: this avoids contention on a globally
+     mutable cacheline in the common case */
+  grpc_millis min_timer = g_last_seen_min_timer;
+  if (now < min_timer) {
+    if (next != nullptr) *next = std::min(*next, min_timer);
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_check_trace)) {
+      gpr_log(GPR_INFO, "TIMER CHECK SKIP: now=%" PRId64 " min_timer=%" PRId64,
+              now, min_timer);
+    }
+    return GRPC_TIMERS_CHECKED_AND_EMPTY;
+  }
+
+  grpc_error_handle shutdown_error =
+      now != GRPC_MILLIS_INF_FUTURE
+          ? GRPC_ERROR_NONE
+          : GRPC_ERROR_CREATE_FROM_STATIC_STRING("Shutting down timer system");
+  grpc_timer_check_result r =
+      run_some_expired_timers(now, next, shutdown_error);
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_check_trace)) {
+    gpr_log(GPR_INFO, "TIMER CHECK END: now=%" PRId64 " r=%d", now, r);
+  }
+  return r;
+}
+
+}  // namespace
+
+grpc_timer_vtable grpc_wheel_timer_vtable = {
+    timer_init,      timer_cancel,        timer_check,
+    timer_list_init, timer_list_shutdown, timer_consume_kick};
@@ -20,12 +20,19 @@
 
 #include "src/core/lib/iomgr/work_serializer.h"
 
+#include "src/core/lib/debug/stats.h"
+#include "src/core/lib/gpr/spinlock.h"
+#include "src/core/lib/gpr/time_precise.h"
+#include "src/core/lib/gprpp/construct_destruct.h"
+
 namespace grpc_core {
 
 DebugOnlyTraceFlag grpc_work_serializer_trace(false, "work_serializer");
 
 class WorkSerializer::WorkSerializerImpl : public Orphanable {
  public:
+  ~WorkSerializerImpl() override;
+
   void Run(std::function<void()> callback, const DebugLocation& location);
   void Schedule(std::function<void()> callback, const DebugLocation& location);
   void DrainQueue();
@@ -37,10 +44,19 @@ class WorkSerializer::WorkSerializerImpl : public Orphanable {
         : callback(std::move(cb)), location(loc) {}
 
     MultiProducerSingleConsumerQueue::Node mpscq_node;
-    const std::function<void()> callback;
+    std::function<void()> callback;
     const DebugLocation location;
+    // Next wrapper on free_wrappers_ while this one is not queued.
+    CallbackWrapper* next_free = nullptr;
   };
 
+  // Returns a wrapper for \a callback, reusing one run earlier if possible.
+  CallbackWrapper* NewCallbackWrapper(std::function<void()> callback,
+                                      const DebugLocation& location);
+  // Gives back a wrapper whose callback was run, for NewCallbackWrapper() to
+  // reuse.
+  void RecycleCallbackWrapper(CallbackWrapper* cb_wrapper);
+
   // Callers of DrainQueueOwned should make sure to grab the lock on the
   // workserializer with
   //
@@ -53,6 +69,13 @@ class WorkSerializer::WorkSerializerImpl : public Orphanable {
   // the lock to the work serializer.
   void DrainQueueOwned();
 
+  // Records stats for an ownership that ran \a callbacks_run queued
+  // callbacks, the first of which was started at \a owner_since (zero if this
+  // ownership is not timed). Uncontended ownerships, that ran none, are not
+  // recorded so as not to slow them down.
+  static void RecordOwnershipStats(gpr_cycle_counter owner_since,
+                                   int callbacks_run);
+
   // First 16 bits indicate ownership of the WorkSerializer, next 48 bits are
   // queue size (i.e., refs).
   static uint64_t MakeRefPair(uint16_t owners, uint64_t size) {
@@ -70,8 +93,63 @@ class WorkSerializer::WorkSerializerImpl : public Orphanable {
   // orphaned.
   std::atomic<uint64_t> refs_{MakeRefPair(0, 1)};
   MultiProducerSingleConsumerQueue queue_;
+  // Wrappers of callbacks that already ran, kept so that queueing a callback
+  // does not allocate once the queue has been that deep before. The list is
+  // only ever touched with gpr_spinlock_trylock(): on contention, producers
+  // allocate a new wrapper and the owner frees the one it is done with
+  // instead of waiting.
+  gpr_spinlock free_wrappers_lock_ = GPR_SPINLOCK_INITIALIZER;
+  CallbackWrapper* free_wrappers_ = nullptr;
+  // Only one in this many ownerships that run queued callbacks is timed, since
+  // reading the clock costs more than running a short callback.
+  static constexpr uint32_t kOwnershipTimeSamplePeriod = 16;
+
+  // Queued callbacks run by the current owner, and when it started the first
+  // if this ownership is timed. Only accessed by the owner.
+  int callbacks_run_ = 0;
+  gpr_cycle_counter owner_since_ = 0;
+  uint32_t contended_ownerships_ = 0;
 };
 
+WorkSerializer::WorkSerializerImpl::~WorkSerializerImpl() {
+  while (free_wrappers_ != nullptr) {
+    CallbackWrapper* cb_wrapper = free_wrappers_;
+    free_wrappers_ = cb_wrapper->next_free;
+    delete cb_wrapper;
+  }
+}
+
+WorkSerializer::WorkSerializerImpl::CallbackWrapper*
+WorkSerializer::WorkSerializerImpl::NewCallbackWrapper(
+    std::function<void()> callback, const DebugLocation& location) {
+  CallbackWrapper* cb_wrapper = nullptr;
+  if (gpr_spinlock_trylock(&free_wrappers_lock_)) {
+    cb_wrapper = free_wrappers_;
+    if (cb_wrapper != nullptr) free_wrappers_ = cb_wrapper->next_free;
+    gpr_spinlock_unlock(&free_wrappers_lock_);
+  }
+  if (cb_wrapper == nullptr) {
+    return new CallbackWrapper(std::move(callback), location);
+  }
+  Destruct(cb_wrapper);
+  Construct(cb_wrapper, std::move(callback), location);
+  return cb_wrapper;
+}
+
+void WorkSerializer::WorkSerializerImpl::RecycleCallbackWrapper(
+    CallbackWrapper* cb_wrapper) {
+  // Release whatever the callback captured now rather than when the wrapper
+  // is reused.
+  cb_wrapper->callback = nullptr;
+  if (gpr_spinlock_trylock(&free_wrappers_lock_)) {
+    cb_wrapper->next_free = free_wrappers_;
+    free_wrappers_ = cb_wrapper;
+    gpr_spinlock_unlock(&free_wrappers_lock_);
+  } else {
+    delete cb_wrapper;
+  }
+}
+
 void WorkSerializer::WorkSerializerImpl::Run(std::function<void()> callback,
                                              const DebugLocation& location) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_work_serializer_trace)) {
@@ -89,6 +167,7 @@ void WorkSerializer::WorkSerializerImpl::Run(std::function<void()> callback,
     if (GRPC_TRACE_FLAG_ENABLED(grpc_work_serializer_trace)) {
       gpr_log(GPR_INFO, "  Executing immediately");
     }
+    callbacks_run_ = 0;
     callback();
     DrainQueueOwned();
   } else {
@@ -96,7 +175,7 @@ void WorkSerializer::WorkSerializerImpl::Run(std::function<void()> callback,
     // count we just added and queue the callback.
     refs_.fetch_sub(MakeRefPair(1, 0), std::memory_order_acq_rel);
     CallbackWrapper* cb_wrapper =
-        new CallbackWrapper(std::move(callback), location);
+        NewCallbackWrapper(std::move(callback), location);
     if (GRPC_TRACE_FLAG_ENABLED(grpc_work_serializer_trace)) {
       gpr_log(GPR_INFO, "  Scheduling on queue : item %p", cb_wrapper);
     }
@@ -107,7 +186,7 @@ void WorkSerializer::WorkSerializerImpl::Run(std::function<void()> callback,
 void WorkSerializer::WorkSerializerImpl::Schedule(
     std::function<void()> callback, const DebugLocation& location) {
   CallbackWrapper* cb_wrapper =
-      new CallbackWrapper(std::move(callback), location);
+      NewCallbackWrapper(std::move(callback), location);
   if (GRPC_TRACE_FLAG_ENABLED(grpc_work_serializer_trace)) {
     gpr_log(GPR_INFO,
             "WorkSerializer::Schedule() %p Scheduling callback %p [%s:%d]",
@@ -144,12 +223,13 @@ void WorkSerializer::WorkSerializerImpl::DrainQueue() {
       refs_.fetch_add(MakeRefPair(1, 1), std::memory_order_acq_rel);
   if (GetOwners(prev_ref_pair) == 0) {
     // We took ownership of the WorkSerializer. Drain the queue.
+    callbacks_run_ = 0;
     DrainQueueOwned();
   } else {
     // Another thread is holding the WorkSerializer, so decrement the ownership
     // count we just added and queue a no-op callback.
     refs_.fetch_sub(MakeRefPair(1, 0), std::memory_order_acq_rel);
-    CallbackWrapper* cb_wrapper = new CallbackWrapper([]() {}, DEBUG_LOCATION);
+    CallbackWrapper* cb_wrapper = NewCallbackWrapper([]() {}, DEBUG_LOCATION);
     queue_.Push(&cb_wrapper->mpscq_node);
   }
 }
@@ -166,6 +246,7 @@ void WorkSerializer::WorkSerializerImpl::DrainQueueOwned() {
       if (GRPC_TRACE_FLAG_ENABLED(grpc_work_serializer_trace)) {
         gpr_log(GPR_INFO, "  Queue Drained. Destroying");
       }
+      RecordOwnershipStats(owner_since_, callbacks_run_);
       delete this;
       return;
     }
@@ -174,9 +255,14 @@ void WorkSerializer::WorkSerializerImpl::DrainQueueOwned() {
       // that we are using relaxed memory order semantics for the load on
       // failure since we don't care about that value.
       uint64_t expected = MakeRefPair(1, 1);
+      // Read first, as the next owner may reset them as soon as ownership is
+      // given up.
+      const gpr_cycle_counter owner_since = owner_since_;
+      const int callbacks_run = callbacks_run_;
       if (refs_.compare_exchange_strong(expected, MakeRefPair(0, 1),
                                         std::memory_order_acq_rel,
                                         std::memory_order_relaxed)) {
+        RecordOwnershipStats(owner_since, callbacks_run);
         return;
       }
     }
@@ -197,8 +283,24 @@ void WorkSerializer::WorkSerializerImpl::DrainQueueOwned() {
               cb_wrapper, cb_wrapper->location.file(),
               cb_wrapper->location.line());
     }
+    if (callbacks_run_++ == 0) {
+      owner_since_ = contended_ownerships_++ % kOwnershipTimeSamplePeriod == 0
+                         ? gpr_get_cycle_counter()
+                         : 0;
+    }
     cb_wrapper->callback();
-    delete cb_wrapper;
+    RecycleCallbackWrapper(cb_wrapper);
+  }
+}
+
+void WorkSerializer::WorkSerializerImpl::RecordOwnershipStats(
+    gpr_cycle_counter GRPC_UNUSED owner_since, int callbacks_run) {
+  // Stats are kept per CPU through the ExecCtx.
+  if (callbacks_run == 0 || ExecCtx::Get() == nullptr) return;
+  GRPC_STATS_INC_WORK_SERIALIZER_QUEUE_DEPTH(callbacks_run);
+  if (owner_since != 0) {
+    GRPC_STATS_INC_WORK_SERIALIZER_OWNERSHIP_TIME_US(gpr_timespec_to_micros(
+        gpr_cycle_counter_sub(gpr_get_cycle_counter(), owner_since)));
   }
 }
 
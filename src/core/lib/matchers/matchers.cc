@@ -16,12 +16,19 @@
 
 #include "src/core/lib/matchers/matchers.h"
 
+#include <inttypes.h>
+
+#include <algorithm>
+
 #include "absl/memory/memory.h"
+#include "absl/strings/ascii.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_join.h"
 #include "absl/strings/str_split.h"
 
+#include <grpc/support/log.h>
+
 namespace grpc_core {
 
 //
@@ -147,6 +154,210 @@ std::string StringMatcher::ToString() const {
   }
 }
 
+//
+// StringMatcherSet
+//
+
+namespace {
+
+// Returns a Latin-1 pattern matching the bytes of literal, ignoring ASCII
+// case like absl::EqualsIgnoreCase() if case_sensitive is false. Inline
+// case folding is avoided since it would also fold non-ASCII characters.
+std::string LiteralPattern(absl::string_view literal, bool case_sensitive) {
+  std::string pattern;
+  for (char c : literal) {
+    unsigned char byte = static_cast<unsigned char>(c);
+    if (!case_sensitive && absl::ascii_isalpha(byte)) {
+      pattern.push_back('[');
+      pattern.push_back(absl::ascii_tolower(byte));
+      pattern.push_back(absl::ascii_toupper(byte));
+      pattern.push_back(']');
+    } else if (absl::ascii_isalnum(byte)) {
+      pattern.push_back(c);
+    } else {
+      absl::StrAppendFormat(&pattern, "\\x{%02x}", byte);
+    }
+  }
+  return pattern;
+}
+
+}  // namespace
+
+StringMatcherSet::PatternSet::PatternSet(RE2::Options::Encoding encoding) {
+  options.set_encoding(encoding);
+  options.set_log_errors(false);
+}
+
+void StringMatcherSet::PatternSet::Add(std::string pattern, size_t index) {
+  patterns.push_back(std::move(pattern));
+  indices.push_back(index);
+}
+
+void StringMatcherSet::PatternSet::Compile() {
+  if (patterns.empty()) return;
+  // The set may fail to compile, or run out of memory on any match. The
+  // patterns are then matched one by one, so compile them once up front.
+  regexes.reserve(patterns.size());
+  for (const std::string& pattern : patterns) {
+    regexes.push_back(absl::make_unique<RE2>(pattern, options));
+  }
+  set = absl::make_unique<RE2::Set>(options, RE2::ANCHOR_BOTH);
+  for (const std::string& pattern : patterns) {
+    std::string error;
+    if (set->Add(pattern, &error) < 0) {
+      gpr_log(GPR_ERROR, "failed to add pattern %s to matcher set: %s",
+              pattern.c_str(), error.c_str());
+      set.reset();
+      return;
+    }
+  }
+  if (!set->Compile()) {
+    gpr_log(GPR_ERROR,
+            "failed to compile matcher set of %" PRIuPTR " patterns",
+            patterns.size());
+    set.reset();
+  }
+}
+
+void StringMatcherSet::PatternSet::MatchAll(
+    absl::string_view value, std::vector<size_t>* matches) const {
+  if (patterns.empty()) return;
+  if (set != nullptr) {
+    std::vector<int> set_matches;
+    RE2::Set::ErrorInfo error_info;
+    if (set->Match(re2::StringPiece(value.data(), value.size()), &set_matches,
+                   &error_info)) {
+      for (int i : set_matches) matches->push_back(indices[i]);
+      return;
+    }
+    if (error_info.kind == RE2::Set::kNoError) return;
+    // The automaton ran out of memory. Fall back to matching each pattern.
+  }
+  for (size_t i = 0; i < regexes.size(); ++i) {
+    if (RE2::FullMatch(re2::StringPiece(value.data(), value.size()),
+                       *regexes[i])) {
+      matches->push_back(indices[i]);
+    }
+  }
+}
+
+absl::optional<size_t> StringMatcherSet::PatternSet::FirstMatch(
+    absl::string_view value, size_t start) const {
+  size_t begin = std::lower_bound(indices.begin(), indices.end(), start) -
+                 indices.begin();
+  if (begin == indices.size()) return absl::nullopt;
+  if (set != nullptr) {
+    std::vector<int> set_matches;
+    RE2::Set::ErrorInfo error_info;
+    if (set->Match(re2::StringPiece(value.data(), value.size()), &set_matches,
+                   &error_info)) {
+      absl::optional<size_t> first;
+      for (int i : set_matches) {
+        if (static_cast<size_t>(i) >= begin &&
+            (!first.has_value() || indices[i] < *first)) {
+          first = indices[i];
+        }
+      }
+      return first;
+    }
+    if (error_info.kind == RE2::Set::kNoError) return absl::nullopt;
+    // The automaton ran out of memory. Fall back to matching each pattern.
+  }
+  for (size_t i = begin; i < regexes.size(); ++i) {
+    if (RE2::FullMatch(re2::StringPiece(value.data(), value.size()),
+                       *regexes[i])) {
+      return indices[i];
+    }
+  }
+  return absl::nullopt;
+}
+
+size_t StringMatcherSet::Add(const StringMatcher& matcher) {
+  size_t index = size_++;
+  switch (matcher.type()) {
+    case StringMatcher::Type::kExact:
+      if (matcher.case_sensitive()) {
+        exact_[matcher.string_matcher()].push_back(index);
+      } else {
+        exact_ignore_case_[absl::AsciiStrToLower(matcher.string_matcher())]
+            .push_back(index);
+      }
+      break;
+    case StringMatcher::Type::kPrefix:
+      literals_.Add(absl::StrCat(LiteralPattern(matcher.string_matcher(),
+                                                matcher.case_sensitive()),
+                                 "(?s:.*)"),
+                    index);
+      break;
+    case StringMatcher::Type::kSuffix:
+      literals_.Add(
+          absl::StrCat("(?s:.*)", LiteralPattern(matcher.string_matcher(),
+                                                 matcher.case_sensitive())),
+          index);
+      break;
+    case StringMatcher::Type::kContains:
+      literals_.Add(
+          absl::StrCat("(?s:.*)",
+                       LiteralPattern(matcher.string_matcher(),
+                                      matcher.case_sensitive()),
+                       "(?s:.*)"),
+          index);
+      break;
+    case StringMatcher::Type::kSafeRegex:
+      regexes_.Add(matcher.regex_matcher()->pattern(), index);
+      break;
+  }
+  return index;
+}
+
+void StringMatcherSet::Compile() {
+  literals_.Compile();
+  regexes_.Compile();
+}
+
+void StringMatcherSet::MatchAll(absl::string_view value,
+                                std::vector<size_t>* indices) const {
+  size_t begin = indices->size();
+  auto it = exact_.find(value);
+  if (it != exact_.end()) {
+    indices->insert(indices->end(), it->second.begin(), it->second.end());
+  }
+  if (!exact_ignore_case_.empty()) {
+    it = exact_ignore_case_.find(absl::AsciiStrToLower(value));
+    if (it != exact_ignore_case_.end()) {
+      indices->insert(indices->end(), it->second.begin(), it->second.end());
+    }
+  }
+  literals_.MatchAll(value, indices);
+  regexes_.MatchAll(value, indices);
+  std::sort(indices->begin() + begin, indices->end());
+}
+
+absl::optional<size_t> StringMatcherSet::FirstMatch(absl::string_view value,
+                                                    size_t start) const {
+  absl::optional<size_t> first;
+  auto update_first = [&first](absl::optional<size_t> index) {
+    if (index.has_value() && (!first.has_value() || *index < *first)) {
+      first = index;
+    }
+  };
+  auto first_in_list =
+      [start](const IndexList& list) -> absl::optional<size_t> {
+    auto it = std::lower_bound(list.begin(), list.end(), start);
+    if (it == list.end()) return absl::nullopt;
+    return *it;
+  };
+  auto it = exact_.find(value);
+  if (it != exact_.end()) update_first(first_in_list(it->second));
+  if (!exact_ignore_case_.empty()) {
+    it = exact_ignore_case_.find(absl::AsciiStrToLower(value));
+    if (it != exact_ignore_case_.end()) update_first(first_in_list(it->second));
+  }
+  update_first(literals_.FirstMatch(value, start));
+  update_first(regexes_.FirstMatch(value, start));
+  return first;
+}
+
 //
 // HeaderMatcher
 //
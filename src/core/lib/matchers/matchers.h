@@ -19,11 +19,15 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/inlined_vector.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
 #include "re2/re2.h"
+#include "re2/set.h"
 
 namespace grpc_core {
 
@@ -74,6 +78,73 @@ class StringMatcher {
   bool case_sensitive_ = true;
 };
 
+// A set of StringMatchers that are evaluated together, e.g. the path
+// matchers of a route table. Exact matchers are looked up in a hash map and
+// all other matchers are compiled into combined automata, so finding every
+// matcher that a value satisfies takes a single scan of the value no matter
+// how many matchers the set holds.
+class StringMatcherSet {
+ public:
+  StringMatcherSet() = default;
+  StringMatcherSet(StringMatcherSet&& other) = default;
+  StringMatcherSet& operator=(StringMatcherSet&& other) = default;
+
+  // Adds a copy of matcher to the set and returns its index. Must not be
+  // called after Compile().
+  size_t Add(const StringMatcher& matcher);
+
+  // Builds the automata. Must be called once, after the last Add().
+  void Compile();
+
+  // Appends the indices of the matchers that match value to *indices, in
+  // increasing order. Same result as calling StringMatcher::Match() for
+  // each matcher.
+  void MatchAll(absl::string_view value, std::vector<size_t>* indices) const;
+
+  // Returns the index of the first matcher at or after start that matches
+  // value, if any. Cheaper than MatchAll() when only the first few matches
+  // are needed: nothing is collected or sorted.
+  absl::optional<size_t> FirstMatch(absl::string_view value,
+                                    size_t start = 0) const;
+
+  size_t size() const { return size_; }
+
+ private:
+  // Matchers compiled into one RE2::Set.
+  struct PatternSet {
+    explicit PatternSet(RE2::Options::Encoding encoding);
+
+    void Add(std::string pattern, size_t index);
+    void Compile();
+    void MatchAll(absl::string_view value, std::vector<size_t>* indices) const;
+    absl::optional<size_t> FirstMatch(absl::string_view value,
+                                      size_t start) const;
+
+    RE2::Options options;
+    std::vector<std::string> patterns;
+    // Matcher index of each pattern, in increasing order.
+    std::vector<size_t> indices;
+    // Each pattern on its own, used when the set cannot be.
+    std::vector<std::unique_ptr<RE2>> regexes;
+    // Null if there are no patterns or the set failed to compile, in which
+    // case each pattern is matched on its own.
+    std::unique_ptr<RE2::Set> set;
+  };
+
+  using IndexList = absl::InlinedVector<size_t, 1>;
+
+  size_t size_ = 0;
+  // Case-sensitive exact matchers by value.
+  absl::flat_hash_map<std::string, IndexList> exact_;
+  // Case-insensitive exact matchers by lower case value.
+  absl::flat_hash_map<std::string, IndexList> exact_ignore_case_;
+  // Prefix, suffix and contains matchers. Compiled as Latin-1 so that they
+  // compare bytes, like StringMatcher::Match() does.
+  PatternSet literals_{RE2::Options::EncodingLatin1};
+  // Safe regex matchers.
+  PatternSet regexes_{RE2::Options::EncodingUTF8};
+};
+
 class HeaderMatcher {
  public:
   enum class Type {
@@ -132,6 +203,18 @@ class HeaderMatcher {
   // Valid for kSafeRegex.
   RE2* regex_matcher() const { return matcher_.regex_matcher(); }
 
+  // Valid for kExact, kPrefix, kSuffix, kSafeRegex and kContains.
+  bool case_sensitive() const { return matcher_.case_sensitive(); }
+
+  // Valid for kRange.
+  int64_t range_start() const { return range_start_; }
+  int64_t range_end() const { return range_end_; }
+
+  // Valid for kPresent.
+  bool present_match() const { return present_match_; }
+
+  bool invert_match() const { return invert_match_; }
+
   bool Match(const absl::optional<absl::string_view>& value) const;
 
   std::string ToString() const;
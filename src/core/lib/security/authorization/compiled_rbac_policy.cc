@@ -0,0 +1,518 @@
+// Copyright 2021 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/security/authorization/compiled_rbac_policy.h"
+
+#include <algorithm>
+
+#include "absl/container/inlined_vector.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
+
+#include <grpc/support/log.h>
+
+#include "src/core/lib/address_utils/sockaddr_utils.h"
+#include "src/core/lib/iomgr/sockaddr.h"
+
+namespace grpc_core {
+
+namespace {
+
+// Builds the key that predicates are deduplicated by. It must encode every
+// field that affects the result of the predicate: two predicates with the
+// same key share one compiled predicate. Each field is length-prefixed, so
+// that different sequences of fields never encode to the same key whatever
+// bytes they contain (unlike the ToString() of the matchers, which is meant
+// for logging and does not escape anything).
+class PredicateKey {
+ public:
+  explicit PredicateKey(absl::string_view kind) { Add(kind); }
+
+  PredicateKey& Add(absl::string_view field) {
+    absl::StrAppend(&key_, field.size(), ":", field);
+    return *this;
+  }
+  PredicateKey& Add(int64_t field) { return Add(absl::StrCat(field)); }
+
+  PredicateKey& Add(const StringMatcher& matcher) {
+    Add(static_cast<int64_t>(matcher.type()));
+    if (matcher.type() == StringMatcher::Type::kSafeRegex) {
+      return Add(matcher.regex_matcher()->pattern());
+    }
+    return Add(matcher.string_matcher()).Add(matcher.case_sensitive());
+  }
+
+  PredicateKey& Add(const HeaderMatcher& matcher) {
+    Add(matcher.name())
+        .Add(static_cast<int64_t>(matcher.type()))
+        .Add(matcher.invert_match());
+    switch (matcher.type()) {
+      case HeaderMatcher::Type::kRange:
+        return Add(matcher.range_start()).Add(matcher.range_end());
+      case HeaderMatcher::Type::kPresent:
+        return Add(matcher.present_match());
+      case HeaderMatcher::Type::kSafeRegex:
+        return Add(matcher.regex_matcher()->pattern());
+      default:
+        return Add(matcher.string_matcher()).Add(matcher.case_sensitive());
+    }
+  }
+
+  std::string Release() { return std::move(key_); }
+
+ private:
+  std::string key_;
+};
+
+}  // namespace
+
+//
+// CompiledRbacPolicy::EvalState
+//
+
+// Per-request evaluation state. Predicate results are memoized, so a
+// predicate shared by several policies is evaluated at most once.
+class CompiledRbacPolicy::EvalState {
+ public:
+  EvalState(const CompiledRbacPolicy* policy, const EvaluateArgs& args)
+      : policy_(policy),
+        args_(args),
+        results_(policy->predicates_.size(), kUnknown) {}
+
+  bool Evaluate(uint32_t node_id) {
+    const Node& node = policy_->nodes_[node_id];
+    switch (node.kind) {
+      case Node::Kind::kAnd:
+        for (uint32_t i = node.begin; i < node.end; ++i) {
+          if (!Evaluate(policy_->child_ids_[i])) return false;
+        }
+        return true;
+      case Node::Kind::kOr:
+        for (uint32_t i = node.begin; i < node.end; ++i) {
+          if (Evaluate(policy_->child_ids_[i])) return true;
+        }
+        return false;
+      case Node::Kind::kNot:
+        return !Evaluate(policy_->child_ids_[node.begin]);
+      case Node::Kind::kPredicate:
+        return EvaluatePredicate(node.begin);
+    }
+    return false;
+  }
+
+ private:
+  enum Result : uint8_t { kUnknown, kFalse, kTrue };
+
+  struct HeaderValues {
+    absl::InlinedVector<absl::string_view, 1> values;
+    std::string concatenated_value;
+  };
+
+  bool EvaluatePredicate(uint32_t id) {
+    if (results_[id] == kUnknown) {
+      const Predicate& predicate = policy_->predicates_[id];
+      switch (predicate.kind) {
+        case Predicate::Kind::kPathTrie:
+          ResolvePathTrie();
+          break;
+        case Predicate::Kind::kLocalIp:
+          ResolveCidrTrie(policy_->local_ip_trie_, args_.GetLocalAddress());
+          break;
+        case Predicate::Kind::kPeerIp:
+          ResolveCidrTrie(policy_->peer_ip_trie_, args_.GetPeerAddress());
+          break;
+        case Predicate::Kind::kPath:
+          ResolvePathMatchers();
+          break;
+        case Predicate::Kind::kHeader:
+          SetResult(id,
+                    predicate.header_matcher.Match(GetHeader(predicate.value)));
+          break;
+        case Predicate::Kind::kPort:
+          SetResult(id, predicate.value == args_.GetLocalPort());
+          break;
+        case Predicate::Kind::kAuthenticated:
+          SetResult(id, predicate.authenticated_matcher->Matches(args_));
+          break;
+      }
+    }
+    return results_[id] == kTrue;
+  }
+
+  void SetResult(uint32_t id, bool result) {
+    results_[id] = result ? kTrue : kFalse;
+  }
+
+  void ResolvePathTrie() {
+    for (uint32_t id : policy_->path_trie_predicates_) SetResult(id, false);
+    absl::string_view path = args_.GetPath();
+    // Matches PathAuthorizationMatcher, which never matches an empty path.
+    if (path.empty()) return;
+    const auto& trie = policy_->path_trie_;
+    uint32_t node = 0;
+    for (char c : path) {
+      for (uint32_t id : trie[node].prefix_predicates) SetResult(id, true);
+      const auto& children = trie[node].children;
+      auto it = std::lower_bound(
+          children.begin(), children.end(), c,
+          [](const std::pair<char, uint32_t>& child, char c) {
+            return child.first < c;
+          });
+      if (it == children.end() || it->first != c) return;
+      node = it->second;
+    }
+    for (uint32_t id : trie[node].prefix_predicates) SetResult(id, true);
+    for (uint32_t id : trie[node].exact_predicates) SetResult(id, true);
+  }
+
+  void ResolvePathMatchers() {
+    for (uint32_t id : policy_->path_matcher_predicates_) {
+      SetResult(id, false);
+    }
+    absl::string_view path = args_.GetPath();
+    if (path.empty()) return;
+    std::vector<size_t> matches;
+    policy_->path_matchers_.MatchAll(path, &matches);
+    for (size_t i : matches) {
+      SetResult(policy_->path_matcher_predicates_[i], true);
+    }
+  }
+
+  void ResolveCidrTrie(const CidrTrie& trie,
+                       const grpc_resolved_address& address) {
+    for (uint32_t id : trie.predicates) SetResult(id, false);
+    const grpc_sockaddr* addr =
+        reinterpret_cast<const grpc_sockaddr*>(address.addr);
+    const uint8_t* bytes;
+    const std::vector<CidrTrie::Node>* nodes;
+    uint32_t width;
+    if (addr->sa_family == GRPC_AF_INET) {
+      bytes = reinterpret_cast<const uint8_t*>(
+          &reinterpret_cast<const grpc_sockaddr_in*>(addr)->sin_addr);
+      nodes = &trie.ipv4;
+      width = 32;
+    } else if (addr->sa_family == GRPC_AF_INET6) {
+      bytes = reinterpret_cast<const uint8_t*>(
+          &reinterpret_cast<const grpc_sockaddr_in6*>(addr)->sin6_addr);
+      nodes = &trie.ipv6;
+      width = 128;
+    } else {
+      return;
+    }
+    uint32_t node = 0;
+    for (uint32_t i = 0;; ++i) {
+      for (uint32_t id : (*nodes)[node].predicates) SetResult(id, true);
+      if (i == width) return;
+      int bit = (bytes[i / 8] >> (7 - i % 8)) & 1;
+      node = (*nodes)[node].children[bit];
+      if (node == 0) return;
+    }
+  }
+
+  absl::optional<absl::string_view> GetHeader(int slot) {
+    if (headers_.empty()) {
+      headers_.resize(policy_->header_slots_.size());
+      args_.ForEachHeader([this](absl::string_view key,
+                                 absl::string_view value) {
+        auto it = policy_->header_slots_.find(key);
+        if (it != policy_->header_slots_.end()) {
+          headers_[it->second].values.push_back(value);
+        }
+      });
+    }
+    HeaderValues& header = headers_[slot];
+    // Same result as EvaluateArgs::GetHeaderValue().
+    if (header.values.empty()) return absl::nullopt;
+    if (header.values.size() == 1) return header.values.front();
+    if (header.concatenated_value.empty()) {
+      header.concatenated_value = absl::StrJoin(header.values, ",");
+    }
+    return header.concatenated_value;
+  }
+
+  const CompiledRbacPolicy* policy_;
+  const EvaluateArgs& args_;
+  absl::InlinedVector<uint8_t, 64> results_;
+  absl::InlinedVector<HeaderValues, 4> headers_;
+};
+
+//
+// CompiledRbacPolicy
+//
+
+CompiledRbacPolicy::CompiledRbacPolicy(
+    std::map<std::string, Rbac::Policy> policies) {
+  PredicateIds ids;
+  for (auto& p : policies) {
+    Policy policy;
+    policy.name = p.first;
+    policy.permissions = Compile(std::move(p.second.permissions), &ids);
+    policy.principals = Compile(std::move(p.second.principals), &ids);
+    policies_.push_back(std::move(policy));
+  }
+  path_matchers_.Compile();
+}
+
+const std::string* CompiledRbacPolicy::FindMatchingPolicy(
+    const EvaluateArgs& args) const {
+  if (policies_.empty()) return nullptr;
+  EvalState state(this, args);
+  for (const auto& policy : policies_) {
+    if (state.Evaluate(policy.permissions) &&
+        state.Evaluate(policy.principals)) {
+      return &policy.name;
+    }
+  }
+  return nullptr;
+}
+
+uint32_t CompiledRbacPolicy::Compile(Rbac::Permission permission,
+                                     PredicateIds* ids) {
+  switch (permission.type) {
+    case Rbac::Permission::RuleType::kAnd:
+    case Rbac::Permission::RuleType::kOr:
+    case Rbac::Permission::RuleType::kNot: {
+      std::vector<uint32_t> children;
+      for (const auto& rule : permission.permissions) {
+        children.push_back(Compile(std::move(*rule), ids));
+      }
+      return AddGroup(
+          permission.type == Rbac::Permission::RuleType::kAnd
+              ? Node::Kind::kAnd
+              : permission.type == Rbac::Permission::RuleType::kOr
+                    ? Node::Kind::kOr
+                    : Node::Kind::kNot,
+          std::move(children));
+    }
+    case Rbac::Permission::RuleType::kAny:
+      return AddGroup(Node::Kind::kAnd, {});
+    case Rbac::Permission::RuleType::kHeader:
+      return AddHeaderPredicate(std::move(permission.header_matcher), ids);
+    case Rbac::Permission::RuleType::kPath:
+      return AddPathPredicate(std::move(permission.string_matcher), ids);
+    case Rbac::Permission::RuleType::kDestIp:
+      return AddIpPredicate(Predicate::Kind::kLocalIp, permission.ip, ids);
+    case Rbac::Permission::RuleType::kDestPort: {
+      Predicate predicate;
+      predicate.kind = Predicate::Kind::kPort;
+      predicate.value = permission.port;
+      return AddPredicate(PredicateKey("port").Add(permission.port).Release(),
+                          std::move(predicate), ids);
+    }
+    case Rbac::Permission::RuleType::kReqServerName:
+      // Currently we do not support matching rules containing
+      // "requested_server_name".
+      return AddGroup(Node::Kind::kOr, {});
+  }
+  return AddGroup(Node::Kind::kOr, {});
+}
+
+uint32_t CompiledRbacPolicy::Compile(Rbac::Principal principal,
+                                     PredicateIds* ids) {
+  switch (principal.type) {
+    case Rbac::Principal::RuleType::kAnd:
+    case Rbac::Principal::RuleType::kOr:
+    case Rbac::Principal::RuleType::kNot: {
+      std::vector<uint32_t> children;
+      for (const auto& id : principal.principals) {
+        children.push_back(Compile(std::move(*id), ids));
+      }
+      return AddGroup(
+          principal.type == Rbac::Principal::RuleType::kAnd
+              ? Node::Kind::kAnd
+              : principal.type == Rbac::Principal::RuleType::kOr
+                    ? Node::Kind::kOr
+                    : Node::Kind::kNot,
+          std::move(children));
+    }
+    case Rbac::Principal::RuleType::kAny:
+      return AddGroup(Node::Kind::kAnd, {});
+    case Rbac::Principal::RuleType::kPrincipalName: {
+      Predicate predicate;
+      predicate.kind = Predicate::Kind::kAuthenticated;
+      std::string key = PredicateKey("authenticated")
+                            .Add(principal.string_matcher)
+                            .Release();
+      predicate.authenticated_matcher =
+          absl::make_unique<AuthenticatedAuthorizationMatcher>(
+              std::move(principal.string_matcher));
+      return AddPredicate(std::move(key), std::move(predicate), ids);
+    }
+    case Rbac::Principal::RuleType::kSourceIp:
+    case Rbac::Principal::RuleType::kDirectRemoteIp:
+      return AddIpPredicate(Predicate::Kind::kPeerIp, principal.ip, ids);
+    case Rbac::Principal::RuleType::kRemoteIp:
+      // Currently we do not support matching rules containing "remote_ip".
+      return AddGroup(Node::Kind::kOr, {});
+    case Rbac::Principal::RuleType::kHeader:
+      return AddHeaderPredicate(std::move(principal.header_matcher), ids);
+    case Rbac::Principal::RuleType::kPath:
+      return AddPathPredicate(std::move(principal.string_matcher), ids);
+  }
+  return AddGroup(Node::Kind::kOr, {});
+}
+
+uint32_t CompiledRbacPolicy::AddGroup(Node::Kind kind,
+                                      std::vector<uint32_t> children) {
+  Node node;
+  node.kind = kind;
+  node.begin = child_ids_.size();
+  child_ids_.insert(child_ids_.end(), children.begin(), children.end());
+  node.end = child_ids_.size();
+  nodes_.push_back(node);
+  return nodes_.size() - 1;
+}
+
+uint32_t CompiledRbacPolicy::AddPredicate(std::string key, Predicate predicate,
+                                          PredicateIds* ids) {
+  auto it = ids->find(key);
+  if (it == ids->end()) {
+    it = ids->emplace(std::move(key), predicates_.size()).first;
+    predicates_.push_back(std::move(predicate));
+  }
+  Node node;
+  node.kind = Node::Kind::kPredicate;
+  node.begin = it->second;
+  node.end = it->second;
+  nodes_.push_back(node);
+  return nodes_.size() - 1;
+}
+
+uint32_t CompiledRbacPolicy::AddPathPredicate(StringMatcher matcher,
+                                              PredicateIds* ids) {
+  Predicate predicate;
+  bool use_trie = matcher.case_sensitive() &&
+                  (matcher.type() == StringMatcher::Type::kExact ||
+                   matcher.type() == StringMatcher::Type::kPrefix);
+  predicate.kind =
+      use_trie ? Predicate::Kind::kPathTrie : Predicate::Kind::kPath;
+  std::string key = PredicateKey("path").Add(matcher).Release();
+  predicate.string_matcher = std::move(matcher);
+  size_t num_predicates = predicates_.size();
+  uint32_t node_id = AddPredicate(std::move(key), std::move(predicate), ids);
+  // Nothing else to do if an identical rule was added before.
+  if (predicates_.size() == num_predicates) return node_id;
+  uint32_t id = num_predicates;
+  if (!use_trie) {
+    path_matchers_.Add(predicates_[id].string_matcher);
+    path_matcher_predicates_.push_back(id);
+    return node_id;
+  }
+  uint32_t node = 0;
+  for (char c : predicates_[id].string_matcher.string_matcher()) {
+    auto& children = path_trie_[node].children;
+    auto it = std::lower_bound(
+        children.begin(), children.end(), c,
+        [](const std::pair<char, uint32_t>& child, char c) {
+          return child.first < c;
+        });
+    if (it == children.end() || it->first != c) {
+      uint32_t child = path_trie_.size();
+      children.insert(it, {c, child});
+      // Invalidates children.
+      path_trie_.emplace_back();
+      node = child;
+    } else {
+      node = it->second;
+    }
+  }
+  if (predicates_[id].string_matcher.type() == StringMatcher::Type::kPrefix) {
+    path_trie_[node].prefix_predicates.push_back(id);
+  } else {
+    path_trie_[node].exact_predicates.push_back(id);
+  }
+  path_trie_predicates_.push_back(id);
+  return node_id;
+}
+
+uint32_t CompiledRbacPolicy::AddHeaderPredicate(HeaderMatcher matcher,
+                                                PredicateIds* ids) {
+  Predicate predicate;
+  predicate.kind = Predicate::Kind::kHeader;
+  predicate.value =
+      header_slots_.emplace(matcher.name(), header_slots_.size())
+          .first->second;
+  std::string key = PredicateKey("header").Add(matcher).Release();
+  predicate.header_matcher = std::move(matcher);
+  return AddPredicate(std::move(key), std::move(predicate), ids);
+}
+
+uint32_t CompiledRbacPolicy::AddIpPredicate(Predicate::Kind kind,
+                                            const Rbac::CidrRange& range,
+                                            PredicateIds* ids) {
+  Predicate predicate;
+  predicate.kind = kind;
+  size_t num_predicates = predicates_.size();
+  uint32_t node_id = AddPredicate(
+      PredicateKey(kind == Predicate::Kind::kLocalIp ? "local_ip" : "peer_ip")
+          .Add(range.address_prefix)
+          .Add(range.prefix_len)
+          .Release(),
+      std::move(predicate), ids);
+  if (predicates_.size() > num_predicates) {
+    InsertCidrRange(range, num_predicates,
+                    kind == Predicate::Kind::kLocalIp ? &local_ip_trie_
+                                                      : &peer_ip_trie_);
+  }
+  return node_id;
+}
+
+void CompiledRbacPolicy::InsertCidrRange(const Rbac::CidrRange& range,
+                                         uint32_t predicate, CidrTrie* trie) {
+  trie->predicates.push_back(predicate);
+  grpc_resolved_address address;
+  grpc_error_handle error =
+      grpc_string_to_sockaddr(&address, range.address_prefix.c_str(),
+                              /*port does not matter here*/ 0);
+  if (error != GRPC_ERROR_NONE) {
+    // The range never matches.
+    gpr_log(GPR_DEBUG, "CidrRange address %s is not IPv4/IPv6. Error: %s",
+            range.address_prefix.c_str(), grpc_error_std_string(error).c_str());
+    GRPC_ERROR_UNREF(error);
+    return;
+  }
+  const grpc_sockaddr* addr =
+      reinterpret_cast<const grpc_sockaddr*>(address.addr);
+  const uint8_t* bytes;
+  std::vector<CidrTrie::Node>* nodes;
+  uint32_t width;
+  if (addr->sa_family == GRPC_AF_INET) {
+    bytes = reinterpret_cast<const uint8_t*>(
+        &reinterpret_cast<const grpc_sockaddr_in*>(addr)->sin_addr);
+    nodes = &trie->ipv4;
+    width = 32;
+  } else {
+    bytes = reinterpret_cast<const uint8_t*>(
+        &reinterpret_cast<const grpc_sockaddr_in6*>(addr)->sin6_addr);
+    nodes = &trie->ipv6;
+    width = 128;
+  }
+  // Same as grpc_sockaddr_mask_bits(): a prefix longer than the address
+  // matches the whole address.
+  uint32_t prefix_len = std::min(range.prefix_len, width);
+  uint32_t node = 0;
+  for (uint32_t i = 0; i < prefix_len; ++i) {
+    int bit = (bytes[i / 8] >> (7 - i % 8)) & 1;
+    if ((*nodes)[node].children[bit] == 0) {
+      (*nodes)[node].children[bit] = nodes->size();
+      nodes->emplace_back();
+    }
+    node = (*nodes)[node].children[bit];
+  }
+  (*nodes)[node].predicates.push_back(predicate);
+}
+
+}  // namespace grpc_core
@@ -0,0 +1,159 @@
+// Copyright 2021 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_CORE_LIB_SECURITY_AUTHORIZATION_COMPILED_RBAC_POLICY_H
+#define GRPC_CORE_LIB_SECURITY_AUTHORIZATION_COMPILED_RBAC_POLICY_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stdint.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+
+#include "src/core/lib/matchers/matchers.h"
+#include "src/core/lib/security/authorization/evaluate_args.h"
+#include "src/core/lib/security/authorization/matchers.h"
+#include "src/core/lib/security/authorization/rbac_policy.h"
+
+namespace grpc_core {
+
+// The policies of an RBAC config compiled into a flat decision program.
+//
+// Permission and principal trees become contiguous nodes that refer to leaf
+// predicates by index, so evaluating them involves no virtual calls.
+// Identical predicates are shared between policies and evaluated at most once
+// per request. Case-sensitive exact and prefix path rules are all resolved by
+// a single walk of a trie and the other path rules by a single
+// StringMatcherSet scan, CIDR ranges by a single walk of a binary radix tree
+// per address, and the header values the program refers to are gathered in a
+// single pass over the request's metadata.
+class CompiledRbacPolicy {
+ public:
+  CompiledRbacPolicy() = default;
+  explicit CompiledRbacPolicy(std::map<std::string, Rbac::Policy> policies);
+
+  CompiledRbacPolicy(const CompiledRbacPolicy&) = delete;
+  CompiledRbacPolicy& operator=(const CompiledRbacPolicy&) = delete;
+  CompiledRbacPolicy(CompiledRbacPolicy&&) = default;
+  CompiledRbacPolicy& operator=(CompiledRbacPolicy&&) = default;
+
+  // Returns the name of the first policy, in name order, that matches the
+  // request, or nullptr if none does.
+  const std::string* FindMatchingPolicy(const EvaluateArgs& args) const;
+
+  size_t num_policies() const { return policies_.size(); }
+
+ private:
+  class EvalState;
+
+  struct Node {
+    enum class Kind : uint8_t { kAnd, kOr, kNot, kPredicate };
+    Kind kind;
+    // Children are child_ids_[begin, end) for kAnd/kOr/kNot. An empty kAnd
+    // always matches and an empty kOr never does. For kPredicate, begin is
+    // the predicate index.
+    uint32_t begin;
+    uint32_t end;
+  };
+
+  struct Predicate {
+    enum class Kind : uint8_t {
+      // Resolved for all such predicates at once by path_trie_.
+      kPathTrie,
+      // Resolved for all such predicates at once by path_matchers_.
+      kPath,
+      // Resolved for all such predicates at once by local_ip_trie_ or
+      // peer_ip_trie_.
+      kLocalIp,
+      kPeerIp,
+      kHeader,
+      kPort,
+      kAuthenticated,
+    };
+    Kind kind;
+    // Header slot for kHeader, port for kPort.
+    int value = 0;
+    StringMatcher string_matcher;
+    HeaderMatcher header_matcher;
+    std::unique_ptr<AuthenticatedAuthorizationMatcher> authenticated_matcher;
+  };
+
+  struct PathTrieNode {
+    // Sorted by character.
+    std::vector<std::pair<char, uint32_t>> children;
+    // Predicates matching paths that start with the string of this node.
+    std::vector<uint32_t> prefix_predicates;
+    // Predicates matching exactly the string of this node.
+    std::vector<uint32_t> exact_predicates;
+  };
+
+  // Binary radix tree of CIDR ranges over the address bits, most significant
+  // first. Index 0 of each node vector is the root, so 0 also means "no
+  // child".
+  struct CidrTrie {
+    struct Node {
+      uint32_t children[2] = {0, 0};
+      // Predicates whose range ends at this node.
+      std::vector<uint32_t> predicates;
+    };
+    std::vector<Node> ipv4 = std::vector<Node>(1);
+    std::vector<Node> ipv6 = std::vector<Node>(1);
+    // All predicates of this tree, including those of invalid ranges.
+    std::vector<uint32_t> predicates;
+  };
+
+  struct Policy {
+    std::string name;
+    uint32_t permissions;
+    uint32_t principals;
+  };
+
+  using PredicateIds = std::map<std::string, uint32_t>;
+
+  uint32_t Compile(Rbac::Permission permission, PredicateIds* ids);
+  uint32_t Compile(Rbac::Principal principal, PredicateIds* ids);
+  uint32_t AddGroup(Node::Kind kind, std::vector<uint32_t> children);
+  uint32_t AddPredicate(std::string key, Predicate predicate,
+                        PredicateIds* ids);
+  uint32_t AddPathPredicate(StringMatcher matcher, PredicateIds* ids);
+  uint32_t AddHeaderPredicate(HeaderMatcher matcher, PredicateIds* ids);
+  uint32_t AddIpPredicate(Predicate::Kind kind, const Rbac::CidrRange& range,
+                          PredicateIds* ids);
+  static void InsertCidrRange(const Rbac::CidrRange& range, uint32_t predicate,
+                              CidrTrie* trie);
+
+  std::vector<Policy> policies_;
+  std::vector<Node> nodes_;
+  std::vector<uint32_t> child_ids_;
+  std::vector<Predicate> predicates_;
+  std::vector<PathTrieNode> path_trie_ = std::vector<PathTrieNode>(1);
+  std::vector<uint32_t> path_trie_predicates_;
+  StringMatcherSet path_matchers_;
+  // Predicate of each matcher in path_matchers_.
+  std::vector<uint32_t> path_matcher_predicates_;
+  CidrTrie local_ip_trie_;
+  CidrTrie peer_ip_trie_;
+  // Header name to slot in the per-request header values.
+  absl::flat_hash_map<std::string, int> header_slots_;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_LIB_SECURITY_AUTHORIZATION_COMPILED_RBAC_POLICY_H
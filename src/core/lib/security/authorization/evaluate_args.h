@@ -68,6 +68,16 @@ class EvaluateArgs {
   // string_view of that string.
   absl::optional<absl::string_view> GetHeaderValue(
       absl::string_view key, std::string* concatenated_value) const;
+  // Calls f(key, value) for each metadata element that GetHeaderValue() can
+  // return, in batch order.
+  template <typename F>
+  void ForEachHeader(F f) const {
+    if (metadata_ == nullptr) return;
+    metadata_->ForEach([&f](grpc_mdelem md) {
+      f(StringViewFromSlice(GRPC_MDKEY(md)),
+        StringViewFromSlice(GRPC_MDVALUE(md)));
+    });
+  }
 
   grpc_resolved_address GetLocalAddress() const;
   absl::string_view GetLocalAddressString() const;
@@ -18,7 +18,7 @@
 #include <grpc/support/port_platform.h>
 
 #include "src/core/lib/security/authorization/authorization_engine.h"
-#include "src/core/lib/security/authorization/matchers.h"
+#include "src/core/lib/security/authorization/compiled_rbac_policy.h"
 #include "src/core/lib/security/authorization/rbac_policy.h"
 
 namespace grpc_core {
@@ -39,20 +39,15 @@ class GrpcAuthorizationEngine : public AuthorizationEngine {
   Rbac::Action action() { return action_; }
 
   // Required only for testing purpose.
-  size_t num_policies() { return policies_.size(); }
+  size_t num_policies() { return policies_.num_policies(); }
 
   // Evaluates incoming request against RBAC policy and makes a decision to
   // whether allow/deny this request.
   Decision Evaluate(const EvaluateArgs& args) const override;
 
  private:
-  struct Policy {
-    std::string name;
-    std::unique_ptr<AuthorizationMatcher> matcher;
-  };
-
   Rbac::Action action_;
-  std::vector<Policy> policies_;
+  CompiledRbacPolicy policies_;
 };
 
 }  // namespace grpc_core
@@ -63,6 +63,15 @@ typedef enum {
 #define GRPC_IAM_AUTHORITY_SELECTOR_METADATA_KEY "x-goog-iam-authority-selector"
 
 #define GRPC_SECURE_TOKEN_REFRESH_THRESHOLD_SECS 60
+/* Once a cached token is within this many seconds of its expiration, requests
+   are still served the cached token but also kick off a background refresh, so
+   that calls don't stall on the fetch once the refresh threshold is reached. */
+#define GRPC_SECURE_TOKEN_PREFETCH_THRESHOLD_SECS 300
+/* Backoff between background refreshes of a token after one failed. */
+#define GRPC_SECURE_TOKEN_PREFETCH_INITIAL_BACKOFF_SECS 1
+#define GRPC_SECURE_TOKEN_PREFETCH_BACKOFF_MULTIPLIER 1.6
+#define GRPC_SECURE_TOKEN_PREFETCH_BACKOFF_JITTER 0.2
+#define GRPC_SECURE_TOKEN_PREFETCH_MAX_BACKOFF_SECS 30
 
 #define GRPC_COMPUTE_ENGINE_METADATA_HOST "metadata.google.internal."
 #define GRPC_COMPUTE_ENGINE_METADATA_TOKEN_PATH \
@@ -32,6 +32,7 @@
 #include <grpc/support/string_util.h>
 #include <grpc/support/sync.h>
 
+#include "src/core/lib/debug/stats.h"
 #include "src/core/lib/gprpp/ref_counted.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/slice/slice_internal.h"
@@ -41,11 +42,38 @@
 
 using grpc_core::Json;
 
+/* Maximum number of audiences whose signed JWT is kept around. */
+#define GRPC_JWT_CACHE_MAX_ENTRIES 32
+
 void grpc_service_account_jwt_access_credentials::reset_cache() {
-  GRPC_MDELEM_UNREF(cached_.jwt_md);
-  cached_.jwt_md = GRPC_MDNULL;
-  cached_.service_url.clear();
-  cached_.jwt_expiration = gpr_inf_past(GPR_CLOCK_REALTIME);
+  for (auto& p : cache_) {
+    GRPC_MDELEM_UNREF(p.second.jwt_md);
+  }
+  cache_.clear();
+}
+
+void grpc_service_account_jwt_access_credentials::evict_from_cache_locked() {
+  // Drop expired entries first; if that doesn't make room, drop the entry that
+  // expires the soonest.
+  gpr_timespec now = gpr_now(GPR_CLOCK_REALTIME);
+  auto soonest = cache_.end();
+  for (auto it = cache_.begin(); it != cache_.end();) {
+    if (gpr_time_cmp(it->second.jwt_expiration, now) <= 0) {
+      GRPC_MDELEM_UNREF(it->second.jwt_md);
+      it = cache_.erase(it);
+      continue;
+    }
+    if (soonest == cache_.end() ||
+        gpr_time_cmp(it->second.jwt_expiration,
+                     soonest->second.jwt_expiration) < 0) {
+      soonest = it;
+    }
+    ++it;
+  }
+  if (cache_.size() >= GRPC_JWT_CACHE_MAX_ENTRIES) {
+    GRPC_MDELEM_UNREF(soonest->second.jwt_md);
+    cache_.erase(soonest);
+  }
 }
 
 grpc_service_account_jwt_access_credentials::
@@ -72,37 +100,39 @@ bool grpc_service_account_jwt_access_credentials::get_request_metadata(
   }
   /* See if we can return a cached jwt. */
   grpc_mdelem jwt_md = GRPC_MDNULL;
-  {
-    gpr_mu_lock(&cache_mu_);
-    if (!cached_.service_url.empty() && cached_.service_url == *uri &&
-        !GRPC_MDISNULL(cached_.jwt_md) &&
-        (gpr_time_cmp(
-             gpr_time_sub(cached_.jwt_expiration, gpr_now(GPR_CLOCK_REALTIME)),
-             refresh_threshold) > 0)) {
-      jwt_md = GRPC_MDELEM_REF(cached_.jwt_md);
-    }
-    gpr_mu_unlock(&cache_mu_);
-  }
-
-  if (GRPC_MDISNULL(jwt_md)) {
-    char* jwt = nullptr;
+  gpr_mu_lock(&cache_mu_);
+  auto it = cache_.find(*uri);
+  if (it != cache_.end() &&
+      gpr_time_cmp(
+          gpr_time_sub(it->second.jwt_expiration, gpr_now(GPR_CLOCK_REALTIME)),
+          refresh_threshold) > 0) {
+    GRPC_STATS_INC_CALL_CREDS_TOKEN_CACHE_HITS();
+    jwt_md = GRPC_MDELEM_REF(it->second.jwt_md);
+  } else {
     /* Generate a new jwt. */
-    gpr_mu_lock(&cache_mu_);
-    reset_cache();
-    jwt = grpc_jwt_encode_and_sign(&key_, uri->c_str(), jwt_lifetime_, nullptr);
+    GRPC_STATS_INC_CALL_CREDS_TOKEN_CACHE_MISSES();
+    if (it != cache_.end()) {
+      GRPC_MDELEM_UNREF(it->second.jwt_md);
+      cache_.erase(it);
+    }
+    char* jwt =
+        grpc_jwt_encode_and_sign(&key_, uri->c_str(), jwt_lifetime_, nullptr);
     if (jwt != nullptr) {
       std::string md_value = absl::StrCat("Bearer ", jwt);
       gpr_free(jwt);
-      cached_.jwt_expiration =
+      if (cache_.size() >= GRPC_JWT_CACHE_MAX_ENTRIES) {
+        evict_from_cache_locked();
+      }
+      CachedJwt& cached = cache_[std::move(*uri)];
+      cached.jwt_expiration =
           gpr_time_add(gpr_now(GPR_CLOCK_REALTIME), jwt_lifetime_);
-      cached_.service_url = std::move(*uri);
-      cached_.jwt_md = grpc_mdelem_from_slices(
+      cached.jwt_md = grpc_mdelem_from_slices(
           grpc_slice_from_static_string(GRPC_AUTHORIZATION_METADATA_KEY),
           grpc_slice_from_cpp_string(std::move(md_value)));
-      jwt_md = GRPC_MDELEM_REF(cached_.jwt_md);
+      jwt_md = GRPC_MDELEM_REF(cached.jwt_md);
     }
-    gpr_mu_unlock(&cache_mu_);
   }
+  gpr_mu_unlock(&cache_mu_);
 
   if (!GRPC_MDISNULL(jwt_md)) {
     grpc_credentials_mdelem_array_add(md_array, jwt_md);
@@ -131,7 +161,6 @@ grpc_service_account_jwt_access_credentials::
   }
   jwt_lifetime_ = token_lifetime;
   gpr_mu_init(&cache_mu_);
-  reset_cache();
 }
 
 grpc_core::RefCountedPtr<grpc_call_credentials>
@@ -21,6 +21,7 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <map>
 #include <string>
 
 #include "absl/strings/str_format.h"
@@ -58,16 +59,18 @@ class grpc_service_account_jwt_access_credentials
   };
 
  private:
+  struct CachedJwt {
+    grpc_mdelem jwt_md;
+    gpr_timespec jwt_expiration;
+  };
+
   void reset_cache();
+  void evict_from_cache_locked();
 
-  // Have a simple cache for now with just 1 entry. We could have a map based on
-  // the service_url for a more sophisticated one.
+  // Signed JWTs keyed by audience (the service url without the service name),
+  // so that calls to several hosts don't keep re-signing a single entry.
   gpr_mu cache_mu_;
-  struct {
-    grpc_mdelem jwt_md = GRPC_MDNULL;
-    std::string service_url;
-    gpr_timespec jwt_expiration;
-  } cached_;
+  std::map<std::string, CachedJwt> cache_;
 
   grpc_auth_json_key key_;
   gpr_timespec jwt_lifetime_;
@@ -23,6 +23,14 @@
 #include <limits.h>
 #include <string.h>
 
+#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
@@ -34,8 +42,12 @@ extern "C" {
 #include <openssl/rsa.h>
 }
 
+#include "src/core/ext/filters/client_channel/backup_poller.h"
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gprpp/manual_constructor.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/http/httpcli.h"
 #include "src/core/lib/iomgr/polling_entity.h"
 #include "src/core/lib/slice/b64.h"
@@ -345,7 +357,6 @@ struct verifier_cb_ctx {
   grpc_slice signed_data;
   void* user_data;
   grpc_jwt_verification_done_cb user_cb;
-  grpc_http_response responses[HTTP_RESPONSE_COUNT];
 };
 /* Takes ownership of the header, claims and signature. */
 static verifier_cb_ctx* verifier_cb_ctx_create(
@@ -374,9 +385,6 @@ void verifier_cb_ctx_destroy(verifier_cb_ctx* ctx) {
   grpc_slice_unref_internal(ctx->signature);
   grpc_slice_unref_internal(ctx->signed_data);
   jose_header_destroy(ctx->header);
-  for (size_t i = 0; i < HTTP_RESPONSE_COUNT; i++) {
-    grpc_http_response_destroy(&ctx->responses[i]);
-  }
   /* TODO: see what to do with claims... */
   delete ctx;
 }
@@ -389,6 +397,14 @@ gpr_timespec grpc_jwt_verifier_clock_skew = {60, 0, GPR_TIMESPAN};
 /* Max delay defaults to one minute. */
 grpc_millis grpc_jwt_verifier_max_delay = 60 * GPR_MS_PER_SEC;
 
+/* Key cache TTL defaults to one hour. */
+grpc_millis grpc_jwt_verifier_key_cache_ttl = 60 * 60 * GPR_MS_PER_SEC;
+
+/* Min key refetch interval defaults to one minute. */
+grpc_millis grpc_jwt_verifier_min_key_refetch_interval = 60 * GPR_MS_PER_SEC;
+
+struct grpc_jwt_key_cache;
+
 struct email_key_mapping {
   char* email_domain;
   char* key_url_prefix;
@@ -397,7 +413,7 @@ struct grpc_jwt_verifier {
   email_key_mapping* mappings;
   size_t num_mappings; /* Should be very few, linear search ok. */
   size_t allocated_mappings;
-  grpc_httpcli_context http_ctx;
+  grpc_jwt_key_cache* key_cache;
 };
 
 static Json json_from_http(const grpc_httpcli_response* response) {
@@ -625,49 +641,166 @@ end:
   return result;
 }
 
-static void on_keys_retrieved(void* user_data, grpc_error_handle /*error*/) {
-  verifier_cb_ctx* ctx = static_cast<verifier_cb_ctx*>(user_data);
-  Json json = json_from_http(&ctx->responses[HTTP_RESPONSE_KEYS]);
-  EVP_PKEY* verification_key = nullptr;
-  grpc_jwt_verifier_status status = GRPC_JWT_VERIFIER_GENERIC_ERROR;
+/* Completes the verification of ctx with the issuer key matching its header,
+   or fails it if no such key could be found. Takes ownership of ctx. */
+static void verify_with_key(verifier_cb_ctx* ctx, EVP_PKEY* verification_key) {
+  grpc_jwt_verifier_status status;
   grpc_jwt_claims* claims = nullptr;
 
-  if (json.type() == Json::Type::JSON_NULL) {
-    status = GRPC_JWT_VERIFIER_KEY_RETRIEVAL_ERROR;
-    goto end;
-  }
-  verification_key =
-      find_verification_key(json, ctx->header->alg, ctx->header->kid);
   if (verification_key == nullptr) {
     gpr_log(GPR_ERROR, "Could not find verification key with kid %s.",
             ctx->header->kid);
     status = GRPC_JWT_VERIFIER_KEY_RETRIEVAL_ERROR;
-    goto end;
+  } else if (!verify_jwt_signature(verification_key, ctx->header->alg,
+                                   ctx->signature, ctx->signed_data)) {
+    status = GRPC_JWT_VERIFIER_BAD_SIGNATURE;
+  } else {
+    status = grpc_jwt_claims_check(ctx->claims, ctx->audience);
+    if (status == GRPC_JWT_VERIFIER_OK) {
+      /* Pass ownership. */
+      claims = ctx->claims;
+      ctx->claims = nullptr;
+    }
   }
+  ctx->user_cb(ctx->user_data, status, claims);
+  verifier_cb_ctx_destroy(ctx);
+}
 
-  if (!verify_jwt_signature(verification_key, ctx->header->alg, ctx->signature,
-                            ctx->signed_data)) {
-    status = GRPC_JWT_VERIFIER_BAD_SIGNATURE;
-    goto end;
+/* --- Key cache. --- */
+
+namespace {
+
+/* Verification keys of a single issuer. */
+struct issuer_keys {
+  /* Key set as served by the issuer, JSON null until it was first fetched. */
+  Json key_set;
+  /* Keys parsed out of key_set so far, indexed by "<alg>:<kid>". */
+  std::map<std::string, std::shared_ptr<EVP_PKEY>> parsed_keys;
+  grpc_millis expiration = GRPC_MILLIS_INF_PAST;
+  /* When key_set was fetched. A kid missing from it only triggers another
+     fetch once grpc_jwt_verifier_min_key_refetch_interval has passed. */
+  grpc_millis fetch_time = GRPC_MILLIS_INF_PAST;
+  bool fetch_pending = false;
+  /* Verifications waiting for the pending fetch. */
+  std::vector<verifier_cb_ctx*> waiters;
+};
+
+}  // namespace
+
+/* Shared by a verifier and its in-flight key fetches, so that a fetch started
+   in the background may outlive the verifier. */
+struct grpc_jwt_key_cache : public grpc_core::RefCounted<grpc_jwt_key_cache> {
+  grpc_jwt_key_cache()
+      : pollent(grpc_polling_entity_create_from_pollset_set(
+            grpc_pollset_set_create())) {
+    grpc_httpcli_context_init(&http_ctx);
   }
 
-  status = grpc_jwt_claims_check(ctx->claims, ctx->audience);
-  if (status == GRPC_JWT_VERIFIER_OK) {
-    /* Pass ownership. */
-    claims = ctx->claims;
-    ctx->claims = nullptr;
+  ~grpc_jwt_key_cache() override {
+    grpc_pollset_set_destroy(grpc_polling_entity_pollset_set(&pollent));
+    grpc_httpcli_context_destroy(&http_ctx);
   }
 
-end:
-  EVP_PKEY_free(verification_key);
-  ctx->user_cb(ctx->user_data, status, claims);
-  verifier_cb_ctx_destroy(ctx);
+  grpc_core::Mutex mu;
+  std::map<std::string, issuer_keys> issuers ABSL_GUARDED_BY(mu);
+  grpc_httpcli_context http_ctx;
+  /* Key fetches poll on this. Verifications waiting for a fetch add their
+     pollset to it for the duration of the wait. While there are background
+     refreshes, which nobody waits for, the backup poller polls it. */
+  grpc_polling_entity pollent;
+  int background_fetches ABSL_GUARDED_BY(mu) = 0;
+};
+
+struct key_fetch_ctx {
+  grpc_core::RefCountedPtr<grpc_jwt_key_cache> cache;
+  std::string issuer;
+  bool background = false;
+  grpc_http_response responses[HTTP_RESPONSE_COUNT] = {};
+
+  ~key_fetch_ctx() {
+    for (size_t i = 0; i < HTTP_RESPONSE_COUNT; i++) {
+      grpc_http_response_destroy(&responses[i]);
+    }
+  }
+};
+
+static std::shared_ptr<EVP_PKEY> issuer_keys_find(issuer_keys* keys,
+                                                  const char* alg,
+                                                  const char* kid) {
+  if (keys->key_set.type() != Json::Type::OBJECT) return nullptr;
+  std::string name = absl::StrCat(alg, ":", kid);
+  auto it = keys->parsed_keys.find(name);
+  if (it != keys->parsed_keys.end()) return it->second;
+  EVP_PKEY* key = find_verification_key(keys->key_set, alg, kid);
+  if (key == nullptr) return nullptr;
+  std::shared_ptr<EVP_PKEY> result(key, EVP_PKEY_free);
+  keys->parsed_keys.emplace(std::move(name), result);
+  return result;
+}
+
+static bool has_pollset(verifier_cb_ctx* ctx) {
+  return grpc_polling_entity_pollset(&ctx->pollent) != nullptr;
+}
+
+/* Stores the key set fetched for the issuer of fetch (unless the fetch failed,
+   in which case key_set is JSON null) and completes the verifications that were
+   waiting for it. Takes ownership of fetch. */
+static void key_fetch_done(key_fetch_ctx* fetch, Json key_set) {
+  grpc_jwt_key_cache* cache = fetch->cache.get();
+  std::vector<verifier_cb_ctx*> waiters;
+  std::vector<std::shared_ptr<EVP_PKEY>> keys;
+  {
+    grpc_core::MutexLock lock(&cache->mu);
+    issuer_keys& entry = cache->issuers[fetch->issuer];
+    grpc_millis now = grpc_core::ExecCtx::Get()->Now();
+    entry.fetch_pending = false;
+    if (key_set.type() != Json::Type::JSON_NULL) {
+      entry.key_set = std::move(key_set);
+      entry.parsed_keys.clear();
+      entry.expiration = now + grpc_jwt_verifier_key_cache_ttl;
+      entry.fetch_time = now;
+    }
+    if (fetch->background && --cache->background_fetches == 0) {
+      grpc_client_channel_stop_backup_polling(
+          grpc_polling_entity_pollset_set(&cache->pollent));
+    }
+    waiters.swap(entry.waiters);
+    for (verifier_cb_ctx* ctx : waiters) {
+      keys.push_back(entry.expiration > now
+                         ? issuer_keys_find(&entry, ctx->header->alg,
+                                            ctx->header->kid)
+                         : nullptr);
+    }
+    /* Drop the issuers whose keys have expired and are not being fetched, such
+       as those of the issuer of a failed fetch. */
+    for (auto it = cache->issuers.begin(); it != cache->issuers.end();) {
+      if (it->second.expiration <= now && !it->second.fetch_pending) {
+        it = cache->issuers.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+  for (size_t i = 0; i < waiters.size(); i++) {
+    if (has_pollset(waiters[i])) {
+      grpc_polling_entity_del_from_pollset_set(
+          &waiters[i]->pollent,
+          grpc_polling_entity_pollset_set(&cache->pollent));
+    }
+    verify_with_key(waiters[i], keys[i].get());
+  }
+  delete fetch;
+}
+
+static void on_keys_retrieved(void* user_data, grpc_error_handle /*error*/) {
+  key_fetch_ctx* fetch = static_cast<key_fetch_ctx*>(user_data);
+  key_fetch_done(fetch, json_from_http(&fetch->responses[HTTP_RESPONSE_KEYS]));
 }
 
 static void on_openid_config_retrieved(void* user_data,
                                        grpc_error_handle /*error*/) {
-  verifier_cb_ctx* ctx = static_cast<verifier_cb_ctx*>(user_data);
-  const grpc_http_response* response = &ctx->responses[HTTP_RESPONSE_OPENID];
+  key_fetch_ctx* fetch = static_cast<key_fetch_ctx*>(user_data);
+  const grpc_http_response* response = &fetch->responses[HTTP_RESPONSE_OPENID];
   Json json = json_from_http(response);
   grpc_httpcli_request req;
   const char* jwks_uri;
@@ -700,17 +833,16 @@ static void on_openid_config_retrieved(void* user_data,
      channel. This would allow us to cancel an authentication query when under
      extreme memory pressure. */
   grpc_httpcli_get(
-      &ctx->verifier->http_ctx, &ctx->pollent,
+      &fetch->cache->http_ctx, &fetch->cache->pollent,
       grpc_core::ResourceQuota::Default(), &req,
       grpc_core::ExecCtx::Get()->Now() + grpc_jwt_verifier_max_delay,
-      GRPC_CLOSURE_CREATE(on_keys_retrieved, ctx, grpc_schedule_on_exec_ctx),
-      &ctx->responses[HTTP_RESPONSE_KEYS]);
+      GRPC_CLOSURE_CREATE(on_keys_retrieved, fetch, grpc_schedule_on_exec_ctx),
+      &fetch->responses[HTTP_RESPONSE_KEYS]);
   gpr_free(req.host);
   return;
 
 error:
-  ctx->user_cb(ctx->user_data, GRPC_JWT_VERIFIER_KEY_RETRIEVAL_ERROR, nullptr);
-  verifier_cb_ctx_destroy(ctx);
+  key_fetch_done(fetch, Json());
 }
 
 static email_key_mapping* verifier_get_mapping(grpc_jwt_verifier* v,
@@ -757,27 +889,28 @@ const char* grpc_jwt_issuer_email_domain(const char* issuer) {
   return dot + 1;
 }
 
-/* Takes ownership of ctx. */
-static void retrieve_key_and_verify(verifier_cb_ctx* ctx) {
+/* Starts fetching the keys of issuer into the verifier's key cache. background
+   fetches are those no verification waits for. */
+static void key_fetch_start(grpc_jwt_verifier* verifier, const char* issuer,
+                            bool background) {
   const char* email_domain;
   grpc_closure* http_cb;
   char* path_prefix = nullptr;
-  const char* iss;
   grpc_httpcli_request req;
   memset(&req, 0, sizeof(grpc_httpcli_request));
   req.handshaker = &grpc_httpcli_ssl;
   http_response_index rsp_idx;
-
-  GPR_ASSERT(ctx != nullptr && ctx->header != nullptr &&
-             ctx->claims != nullptr);
-  iss = ctx->claims->iss;
-  if (ctx->header->kid == nullptr) {
-    gpr_log(GPR_ERROR, "Missing kid in jose header.");
-    goto error;
-  }
-  if (iss == nullptr) {
-    gpr_log(GPR_ERROR, "Missing iss in claims.");
-    goto error;
+  key_fetch_ctx* fetch = new key_fetch_ctx();
+  fetch->cache = verifier->key_cache->Ref();
+  fetch->issuer = issuer;
+  if (background) {
+    grpc_jwt_key_cache* cache = fetch->cache.get();
+    grpc_core::MutexLock lock(&cache->mu);
+    fetch->background = true;
+    if (cache->background_fetches++ == 0) {
+      grpc_client_channel_start_backup_polling(
+          grpc_polling_entity_pollset_set(&cache->pollent));
+    }
   }
 
   /* This code relies on:
@@ -785,28 +918,29 @@ static void retrieve_key_and_verify(verifier_cb_ctx* ctx) {
      Nobody seems to implement the account/email/webfinger part 2. of the spec
      so we will rely instead on email/url mappings if we detect such an issuer.
      Part 4, on the other hand is implemented by both google and salesforce. */
-  email_domain = grpc_jwt_issuer_email_domain(iss);
+  email_domain = grpc_jwt_issuer_email_domain(issuer);
   if (email_domain != nullptr) {
     email_key_mapping* mapping;
-    GPR_ASSERT(ctx->verifier != nullptr);
-    mapping = verifier_get_mapping(ctx->verifier, email_domain);
+    mapping = verifier_get_mapping(verifier, email_domain);
     if (mapping == nullptr) {
       gpr_log(GPR_ERROR, "Missing mapping for issuer email.");
-      goto error;
+      key_fetch_done(fetch, Json());
+      return;
     }
     req.host = gpr_strdup(mapping->key_url_prefix);
     path_prefix = strchr(req.host, '/');
     if (path_prefix == nullptr) {
-      gpr_asprintf(&req.http.path, "/%s", iss);
+      gpr_asprintf(&req.http.path, "/%s", issuer);
     } else {
       *(path_prefix++) = '\0';
-      gpr_asprintf(&req.http.path, "/%s/%s", path_prefix, iss);
+      gpr_asprintf(&req.http.path, "/%s/%s", path_prefix, issuer);
     }
-    http_cb =
-        GRPC_CLOSURE_CREATE(on_keys_retrieved, ctx, grpc_schedule_on_exec_ctx);
+    http_cb = GRPC_CLOSURE_CREATE(on_keys_retrieved, fetch,
+                                  grpc_schedule_on_exec_ctx);
     rsp_idx = HTTP_RESPONSE_KEYS;
   } else {
-    req.host = gpr_strdup(strstr(iss, "https://") == iss ? iss + 8 : iss);
+    req.host =
+        gpr_strdup(strstr(issuer, "https://") == issuer ? issuer + 8 : issuer);
     path_prefix = strchr(req.host, '/');
     if (path_prefix == nullptr) {
       req.http.path = gpr_strdup(GRPC_OPENID_CONFIG_URL_SUFFIX);
@@ -815,7 +949,7 @@ static void retrieve_key_and_verify(verifier_cb_ctx* ctx) {
       gpr_asprintf(&req.http.path, "/%s%s", path_prefix,
                    GRPC_OPENID_CONFIG_URL_SUFFIX);
     }
-    http_cb = GRPC_CLOSURE_CREATE(on_openid_config_retrieved, ctx,
+    http_cb = GRPC_CLOSURE_CREATE(on_openid_config_retrieved, fetch,
                                   grpc_schedule_on_exec_ctx);
     rsp_idx = HTTP_RESPONSE_OPENID;
   }
@@ -824,12 +958,87 @@ static void retrieve_key_and_verify(verifier_cb_ctx* ctx) {
      channel. This would allow us to cancel an authentication query when under
      extreme memory pressure. */
   grpc_httpcli_get(
-      &ctx->verifier->http_ctx, &ctx->pollent,
+      &fetch->cache->http_ctx, &fetch->cache->pollent,
       grpc_core::ResourceQuota::Default(), &req,
       grpc_core::ExecCtx::Get()->Now() + grpc_jwt_verifier_max_delay, http_cb,
-      &ctx->responses[rsp_idx]);
+      &fetch->responses[rsp_idx]);
   gpr_free(req.host);
   gpr_free(req.http.path);
+}
+
+/* Takes ownership of ctx. */
+static void retrieve_key_and_verify(verifier_cb_ctx* ctx) {
+  grpc_jwt_verifier* verifier;
+  const char* iss;
+  /* Copied since ctx (and with it its claims) may be gone once it is waiting
+     for a fetch or has been verified. */
+  std::string issuer;
+  std::shared_ptr<EVP_PKEY> verification_key;
+  bool start_fetch = false;
+  bool background_fetch = false;
+  bool unknown_kid = false;
+
+  GPR_ASSERT(ctx != nullptr && ctx->header != nullptr &&
+             ctx->claims != nullptr);
+  iss = ctx->claims->iss;
+  if (ctx->header->kid == nullptr) {
+    gpr_log(GPR_ERROR, "Missing kid in jose header.");
+    goto error;
+  }
+  if (iss == nullptr) {
+    gpr_log(GPR_ERROR, "Missing iss in claims.");
+    goto error;
+  }
+
+  /* Use the cached keys of the issuer while they are fresh, refreshing them in
+     the background once they get within grpc_jwt_verifier_max_delay (the
+     deadline of a fetch) of expiring. Otherwise, or if the key set does not
+     have the key (which may have been rotated in since), wait for a fetch,
+     sharing it with any other verification for the same issuer. A key set
+     fetched less than grpc_jwt_verifier_min_key_refetch_interval ago is taken
+     at its word, so that tokens with made-up kids can't make us fetch the
+     keys of their issuer over and over. */
+  GPR_ASSERT(ctx->verifier != nullptr);
+  verifier = ctx->verifier;
+  issuer = iss;
+  {
+    grpc_jwt_key_cache* cache = verifier->key_cache;
+    grpc_core::MutexLock lock(&cache->mu);
+    issuer_keys& entry = cache->issuers[issuer];
+    grpc_millis now = grpc_core::ExecCtx::Get()->Now();
+    if (entry.expiration > now) {
+      verification_key =
+          issuer_keys_find(&entry, ctx->header->alg, ctx->header->kid);
+    }
+    if (verification_key != nullptr) {
+      if (!entry.fetch_pending &&
+          entry.expiration - now < grpc_jwt_verifier_max_delay) {
+        entry.fetch_pending = true;
+        start_fetch = true;
+        background_fetch = true;
+      }
+    } else if (!entry.fetch_pending && entry.expiration > now &&
+               now - entry.fetch_time <
+                   grpc_jwt_verifier_min_key_refetch_interval) {
+      unknown_kid = true;
+    } else {
+      entry.waiters.push_back(ctx);
+      if (has_pollset(ctx)) {
+        grpc_polling_entity_add_to_pollset_set(
+            &ctx->pollent, grpc_polling_entity_pollset_set(&cache->pollent));
+      }
+      if (!entry.fetch_pending) {
+        entry.fetch_pending = true;
+        start_fetch = true;
+      }
+    }
+  }
+  if (verification_key != nullptr || unknown_kid) {
+    verify_with_key(ctx, verification_key.get());
+  }
+  if (start_fetch) {
+    key_fetch_start(verifier, issuer.c_str(), background_fetch);
+  }
   return;
 
 error:
@@ -882,11 +1091,75 @@ error:
   cb(user_data, GRPC_JWT_VERIFIER_BAD_FORMAT, nullptr);
 }
 
+/* --- Batch verification. --- */
+
+namespace {
+
+struct batch_verification;
+
+struct batch_verification_entry {
+  batch_verification* batch;
+  size_t index;
+};
+
+struct batch_verification {
+  /* One per JWT still being verified, plus one held while starting them. */
+  std::atomic<size_t> pending;
+  std::vector<batch_verification_entry> entries;
+  std::vector<grpc_jwt_verifier_status> statuses;
+  std::vector<grpc_jwt_claims*> claims;
+  grpc_jwt_batch_verification_done_cb cb;
+  void* user_data;
+};
+
+}  // namespace
+
+static void batch_verification_unref(batch_verification* batch) {
+  if (batch->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    batch->cb(batch->user_data, batch->statuses.size(),
+              batch->statuses.data(), batch->claims.data());
+    delete batch;
+  }
+}
+
+static void on_batch_entry_verified(void* user_data,
+                                    grpc_jwt_verifier_status status,
+                                    grpc_jwt_claims* claims) {
+  batch_verification_entry* entry =
+      static_cast<batch_verification_entry*>(user_data);
+  entry->batch->statuses[entry->index] = status;
+  entry->batch->claims[entry->index] = claims;
+  batch_verification_unref(entry->batch);
+}
+
+void grpc_jwt_verifier_verify_batch(grpc_jwt_verifier* verifier,
+                                    grpc_pollset* pollset, const char** jwts,
+                                    size_t num_jwts, const char* audience,
+                                    grpc_jwt_batch_verification_done_cb cb,
+                                    void* user_data) {
+  GPR_ASSERT(verifier != nullptr && (jwts != nullptr || num_jwts == 0) &&
+             audience != nullptr && cb != nullptr);
+  batch_verification* batch = new batch_verification();
+  batch->pending.store(num_jwts + 1, std::memory_order_relaxed);
+  batch->entries.resize(num_jwts);
+  batch->statuses.resize(num_jwts, GRPC_JWT_VERIFIER_GENERIC_ERROR);
+  batch->claims.resize(num_jwts, nullptr);
+  batch->cb = cb;
+  batch->user_data = user_data;
+  for (size_t i = 0; i < num_jwts; i++) {
+    batch->entries[i].batch = batch;
+    batch->entries[i].index = i;
+    grpc_jwt_verifier_verify(verifier, pollset, jwts[i], audience,
+                             on_batch_entry_verified, &batch->entries[i]);
+  }
+  batch_verification_unref(batch);
+}
+
 grpc_jwt_verifier* grpc_jwt_verifier_create(
     const grpc_jwt_verifier_email_domain_key_url_mapping* mappings,
     size_t num_mappings) {
   grpc_jwt_verifier* v = grpc_core::Zalloc<grpc_jwt_verifier>();
-  grpc_httpcli_context_init(&v->http_ctx);
+  v->key_cache = new grpc_jwt_key_cache();
 
   /* We know at least of one mapping. */
   v->allocated_mappings = 1 + num_mappings;
@@ -908,7 +1181,7 @@ grpc_jwt_verifier* grpc_jwt_verifier_create(
 void grpc_jwt_verifier_destroy(grpc_jwt_verifier* v) {
   size_t i;
   if (v == nullptr) return;
-  grpc_httpcli_context_destroy(&v->http_ctx);
+  v->key_cache->Unref();
   if (v->mappings != nullptr) {
     for (i = 0; i < v->num_mappings; i++) {
       gpr_free(v->mappings[i].email_domain);
@@ -83,6 +83,13 @@ struct grpc_jwt_verifier_email_domain_key_url_mapping {
 /* Globals to control the verifier. Not thread-safe. */
 extern gpr_timespec grpc_jwt_verifier_clock_skew;
 extern grpc_millis grpc_jwt_verifier_max_delay;
+/* How long the keys fetched for an issuer are reused for. They are refreshed in
+   the background once within grpc_jwt_verifier_max_delay of expiring. */
+extern grpc_millis grpc_jwt_verifier_key_cache_ttl;
+/* How long a kid missing from freshly fetched keys is taken to be unknown to
+   their issuer, rather than rotated in since, and fails verification without
+   fetching the keys again. */
+extern grpc_millis grpc_jwt_verifier_min_key_refetch_interval;
 
 /* The verifier can be created with some custom mappings to help with key
    discovery in the case where the issuer is an email address.
@@ -112,6 +119,25 @@ void grpc_jwt_verifier_verify(grpc_jwt_verifier* verifier,
                               grpc_jwt_verification_done_cb cb,
                               void* user_data);
 
+/* User provided callback that will be called when the verification of all the
+   JWTs of a batch is done (maybe in another thread).
+   statuses and claims have one entry per JWT, in the order the JWTs were given,
+   and are only valid for the duration of the callback. It is the
+   responsibility of the callee to call grpc_jwt_claims_destroy on the non-NULL
+   claims. */
+typedef void (*grpc_jwt_batch_verification_done_cb)(
+    void* user_data, size_t num_jwts, const grpc_jwt_verifier_status* statuses,
+    grpc_jwt_claims** claims);
+
+/* Verifies num_jwts JWTs for the given expected audience. The verifications
+   proceed concurrently and those of JWTs from the same issuer share a single
+   fetch of its keys. */
+void grpc_jwt_verifier_verify_batch(grpc_jwt_verifier* verifier,
+                                    grpc_pollset* pollset, const char** jwts,
+                                    size_t num_jwts, const char* audience,
+                                    grpc_jwt_batch_verification_done_cb cb,
+                                    void* user_data);
+
 /* --- TESTING ONLY exposed functions. --- */
 
 grpc_jwt_claims* grpc_jwt_claims_from_json(grpc_core::Json json);
@@ -34,6 +34,8 @@
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
 
+#include "src/core/ext/filters/client_channel/backup_poller.h"
+#include "src/core/lib/debug/stats.h"
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/iomgr/error.h"
@@ -243,15 +245,39 @@ void grpc_oauth2_token_fetcher_credentials::on_http_response(
   // Update cache and grab list of pending requests.
   gpr_mu_lock(&mu_);
   token_fetch_pending_ = false;
-  access_token_md_ = GRPC_MDELEM_REF(access_token_md);
-  token_expiration_ =
-      status == GRPC_CREDENTIALS_OK
-          ? gpr_time_add(gpr_now(GPR_CLOCK_MONOTONIC),
-                         gpr_time_from_millis(token_lifetime, GPR_TIMESPAN))
-          : gpr_inf_past(GPR_CLOCK_MONOTONIC);
+  const bool stop_backup_polling = prefetch_backup_polling_;
+  prefetch_backup_polling_ = false;
+  if (status == GRPC_CREDENTIALS_OK) {
+    GRPC_MDELEM_UNREF(access_token_md_);
+    access_token_md_ = GRPC_MDELEM_REF(access_token_md);
+    token_expiration_ =
+        gpr_time_add(gpr_now(GPR_CLOCK_MONOTONIC),
+                     gpr_time_from_millis(token_lifetime, GPR_TIMESPAN));
+    prefetch_backoff_.Reset();
+    next_prefetch_time_ = GRPC_MILLIS_INF_PAST;
+  } else if (!GRPC_MDISNULL(access_token_md_)) {
+    if (gpr_time_cmp(
+            gpr_time_sub(token_expiration_, gpr_now(GPR_CLOCK_MONOTONIC)),
+            gpr_time_from_seconds(GRPC_SECURE_TOKEN_REFRESH_THRESHOLD_SECS,
+                                  GPR_TIMESPAN)) > 0) {
+      // A failed prefetch leaves the still usable token in place. Back off
+      // before the next one, rather than fetching again on every request.
+      next_prefetch_time_ = prefetch_backoff_.NextAttemptTime();
+    } else {
+      // Anything else drops the cached token so that the next request
+      // fetches a new one.
+      GRPC_MDELEM_UNREF(access_token_md_);
+      access_token_md_ = GRPC_MDNULL;
+      token_expiration_ = gpr_inf_past(GPR_CLOCK_MONOTONIC);
+    }
+  }
   grpc_oauth2_pending_get_request_metadata* pending_request = pending_requests_;
   pending_requests_ = nullptr;
   gpr_mu_unlock(&mu_);
+  if (stop_backup_polling) {
+    grpc_client_channel_stop_backup_polling(
+        grpc_polling_entity_pollset_set(&pollent_));
+  }
   // Invoke callbacks for all pending requests.
   while (pending_request != nullptr) {
     grpc_error_handle new_error = GRPC_ERROR_NONE;
@@ -280,24 +306,50 @@ bool grpc_oauth2_token_fetcher_credentials::get_request_metadata(
     grpc_credentials_mdelem_array* md_array, grpc_closure* on_request_metadata,
     grpc_error_handle* /*error*/) {
   // Check if we can use the cached token.
-  grpc_millis refresh_threshold =
-      GRPC_SECURE_TOKEN_REFRESH_THRESHOLD_SECS * GPR_MS_PER_SEC;
   grpc_mdelem cached_access_token_md = GRPC_MDNULL;
+  bool start_prefetch = false;
   gpr_mu_lock(&mu_);
-  if (!GRPC_MDISNULL(access_token_md_) &&
-      gpr_time_cmp(
-          gpr_time_sub(token_expiration_, gpr_now(GPR_CLOCK_MONOTONIC)),
-          gpr_time_from_seconds(GRPC_SECURE_TOKEN_REFRESH_THRESHOLD_SECS,
-                                GPR_TIMESPAN)) > 0) {
-    cached_access_token_md = GRPC_MDELEM_REF(access_token_md_);
+  if (!GRPC_MDISNULL(access_token_md_)) {
+    gpr_timespec time_to_expiration =
+        gpr_time_sub(token_expiration_, gpr_now(GPR_CLOCK_MONOTONIC));
+    if (gpr_time_cmp(time_to_expiration,
+                     gpr_time_from_seconds(
+                         GRPC_SECURE_TOKEN_REFRESH_THRESHOLD_SECS,
+                         GPR_TIMESPAN)) > 0) {
+      cached_access_token_md = GRPC_MDELEM_REF(access_token_md_);
+      // The token is getting close to its refresh threshold: fetch its
+      // replacement in the background. No caller waits on the prefetch, so
+      // nothing would poll pollent_ for it: the backup poller does until it
+      // completes. If it is still in flight when the token crosses the
+      // threshold, the requests queued in pending_requests_ wait on it (and
+      // poll for it) instead of starting another fetch.
+      if (!token_fetch_pending_ &&
+          grpc_core::ExecCtx::Get()->Now() >= next_prefetch_time_ &&
+          gpr_time_cmp(time_to_expiration,
+                       gpr_time_from_seconds(
+                           GRPC_SECURE_TOKEN_PREFETCH_THRESHOLD_SECS,
+                           GPR_TIMESPAN)) <= 0) {
+        token_fetch_pending_ = true;
+        prefetch_backup_polling_ = true;
+        start_prefetch = true;
+      }
+    }
   }
   if (!GRPC_MDISNULL(cached_access_token_md)) {
     gpr_mu_unlock(&mu_);
+    GRPC_STATS_INC_CALL_CREDS_TOKEN_CACHE_HITS();
+    if (start_prefetch) {
+      GRPC_STATS_INC_CALL_CREDS_TOKEN_PREFETCHES();
+      grpc_client_channel_start_backup_polling(
+          grpc_polling_entity_pollset_set(&pollent_));
+      start_token_fetch();
+    }
     grpc_credentials_mdelem_array_add(md_array, cached_access_token_md);
     GRPC_MDELEM_UNREF(cached_access_token_md);
     return true;
   }
   // Couldn't get the token from the cache.
+  GRPC_STATS_INC_CALL_CREDS_TOKEN_CACHE_MISSES();
   // Add request to pending_requests_ and start a new fetch if needed.
   grpc_oauth2_pending_get_request_metadata* pending_request =
       static_cast<grpc_oauth2_pending_get_request_metadata*>(
@@ -315,16 +367,20 @@ bool grpc_oauth2_token_fetcher_credentials::get_request_metadata(
     start_fetch = true;
   }
   gpr_mu_unlock(&mu_);
-  if (start_fetch) {
-    Ref().release();
-    fetch_oauth2(grpc_credentials_metadata_request_create(this->Ref()),
-                 &httpcli_context_, &pollent_,
-                 on_oauth2_token_fetcher_http_response,
-                 grpc_core::ExecCtx::Get()->Now() + refresh_threshold);
-  }
+  if (start_fetch) start_token_fetch();
   return false;
 }
 
+void grpc_oauth2_token_fetcher_credentials::start_token_fetch() {
+  grpc_millis refresh_threshold =
+      GRPC_SECURE_TOKEN_REFRESH_THRESHOLD_SECS * GPR_MS_PER_SEC;
+  Ref().release();
+  fetch_oauth2(grpc_credentials_metadata_request_create(this->Ref()),
+               &httpcli_context_, &pollent_,
+               on_oauth2_token_fetcher_http_response,
+               grpc_core::ExecCtx::Get()->Now() + refresh_threshold);
+}
+
 void grpc_oauth2_token_fetcher_credentials::cancel_get_request_metadata(
     grpc_credentials_mdelem_array* md_array, grpc_error_handle error) {
   gpr_mu_lock(&mu_);
@@ -355,6 +411,15 @@ void grpc_oauth2_token_fetcher_credentials::cancel_get_request_metadata(
 grpc_oauth2_token_fetcher_credentials::grpc_oauth2_token_fetcher_credentials()
     : grpc_call_credentials(GRPC_CALL_CREDENTIALS_TYPE_OAUTH2),
       token_expiration_(gpr_inf_past(GPR_CLOCK_MONOTONIC)),
+      prefetch_backoff_(
+          grpc_core::BackOff::Options()
+              .set_initial_backoff(
+                  GRPC_SECURE_TOKEN_PREFETCH_INITIAL_BACKOFF_SECS *
+                  GPR_MS_PER_SEC)
+              .set_multiplier(GRPC_SECURE_TOKEN_PREFETCH_BACKOFF_MULTIPLIER)
+              .set_jitter(GRPC_SECURE_TOKEN_PREFETCH_BACKOFF_JITTER)
+              .set_max_backoff(GRPC_SECURE_TOKEN_PREFETCH_MAX_BACKOFF_SECS *
+                               GPR_MS_PER_SEC)),
       pollent_(grpc_polling_entity_create_from_pollset_set(
           grpc_pollset_set_create())) {
   gpr_mu_init(&mu_);
@@ -25,6 +25,7 @@
 
 #include <grpc/grpc_security.h>
 
+#include "src/core/lib/backoff/backoff.h"
 #include "src/core/lib/json/json.h"
 #include "src/core/lib/security/credentials/credentials.h"
 #include "src/core/lib/uri/uri_parser.h"
@@ -95,10 +96,17 @@ class grpc_oauth2_token_fetcher_credentials : public grpc_call_credentials {
                             grpc_millis deadline) = 0;
 
  private:
+  void start_token_fetch();
+
   gpr_mu mu_;
   grpc_mdelem access_token_md_ = GRPC_MDNULL;
   gpr_timespec token_expiration_;
   bool token_fetch_pending_ = false;
+  // Backoff between failed prefetches, and when the next one may start.
+  grpc_core::BackOff prefetch_backoff_;
+  grpc_millis next_prefetch_time_ = GRPC_MILLIS_INF_PAST;
+  // Whether the backup poller is polling pollent_ for an in-flight prefetch.
+  bool prefetch_backup_polling_ = false;
   grpc_oauth2_pending_get_request_metadata* pending_requests_ = nullptr;
   grpc_httpcli_context httpcli_context_;
   grpc_polling_entity pollent_;
@@ -79,6 +79,11 @@ grpc_ssl_credentials::create_security_connector(
           static_cast<tsi_ssl_session_cache*>(arg->value.pointer.p);
     }
   }
+  if (ssl_session_cache == nullptr &&
+      grpc_channel_args_find_bool(args, GRPC_ARG_SSL_DEFAULT_SESSION_CACHE,
+                                  true)) {
+    ssl_session_cache = tsi_ssl_session_cache_get_default();
+  }
   grpc_core::RefCountedPtr<grpc_channel_security_connector> sc =
       grpc_ssl_channel_security_connector_create(
           this->Ref(), std::move(call_creds), &config_, target,
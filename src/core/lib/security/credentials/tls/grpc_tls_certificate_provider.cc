@@ -24,6 +24,21 @@
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
 
+#include "src/core/lib/iomgr/port.h"
+
+#ifdef GRPC_LINUX_INOTIFY
+#include <errno.h>
+#include <limits.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <set>
+#endif
+
 #include "src/core/lib/gprpp/stat.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/surface/api_trace.h"
@@ -92,6 +107,35 @@ gpr_timespec TimeoutSecondsToDeadline(int64_t seconds) {
                       gpr_time_from_seconds(seconds, GPR_TIMESPAN));
 }
 
+#ifdef GRPC_LINUX_INOTIFY
+
+// After a change is noticed, wait for the directory to be quiet for this long
+// before reading, so that a key and a certificate rotated together are picked
+// up in a single update. Files that keep changing are read at the latest this
+// long after the first change.
+constexpr int kFileChangeSettleMs = 100;
+constexpr int kFileChangeMaxSettleMs = 1000;
+// How often to retry watching a directory that was removed or renamed, until
+// it is back.
+constexpr int kWatchRetryMs = 1000;
+
+// Returns the directory part of |path|.
+std::string DirectoryOf(const std::string& path) {
+  size_t pos = path.find_last_of('/');
+  if (pos == std::string::npos) return ".";
+  if (pos == 0) return "/";
+  return path.substr(0, pos);
+}
+
+// Returns the file name part of |path|.
+std::string BaseNameOf(const std::string& path) {
+  size_t pos = path.find_last_of('/');
+  if (pos == std::string::npos) return path;
+  return path.substr(pos + 1);
+}
+
+#endif  // GRPC_LINUX_INOTIFY
+
 }  // namespace
 
 FileWatcherCertificateProvider::FileWatcherCertificateProvider(
@@ -107,18 +151,17 @@ FileWatcherCertificateProvider::FileWatcherCertificateProvider(
   // Must be watching either root or identity certs.
   GPR_ASSERT(!private_key_path_.empty() || !root_cert_path_.empty());
   gpr_event_init(&shutdown_event_);
+  // Watch before the first read, so that no change can slip in between.
+  StartFileChangeNotification();
   ForceUpdate();
   auto thread_lambda = [](void* arg) {
     FileWatcherCertificateProvider* provider =
         static_cast<FileWatcherCertificateProvider*>(arg);
     GPR_ASSERT(provider != nullptr);
     while (true) {
-      void* value = gpr_event_wait(
-          &provider->shutdown_event_,
-          TimeoutSecondsToDeadline(provider->refresh_interval_sec_));
-      if (value != nullptr) {
+      if (provider->WaitForFileChange()) {
         return;
-      };
+      }
       provider->ForceUpdate();
     }
   };
@@ -174,9 +217,184 @@ FileWatcherCertificateProvider::~FileWatcherCertificateProvider() {
   // again after this object(provider) is destroyed.
   distributor_->SetWatchStatusCallback(nullptr);
   gpr_event_set(&shutdown_event_, reinterpret_cast<void*>(1));
+#ifdef GRPC_LINUX_INOTIFY
+  if (wakeup_fd_ >= 0) {
+    eventfd_write(wakeup_fd_, 1);
+  }
+#endif
   refresh_thread_.Join();
+#ifdef GRPC_LINUX_INOTIFY
+  if (inotify_fd_ >= 0) close(inotify_fd_);
+  if (wakeup_fd_ >= 0) close(wakeup_fd_);
+#endif
+}
+
+#ifdef GRPC_LINUX_INOTIFY
+
+bool FileWatcherCertificateProvider::StartFileChangeNotification() {
+  inotify_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (inotify_fd_ < 0) {
+    gpr_log(GPR_INFO,
+            "inotify unavailable (%s), polling credential files every %u "
+            "seconds",
+            strerror(errno), refresh_interval_sec_);
+    return false;
+  }
+  wakeup_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (wakeup_fd_ < 0) {
+    close(inotify_fd_);
+    inotify_fd_ = -1;
+    return false;
+  }
+  // Watch the directories rather than the files themselves: rotation
+  // usually replaces a file (or a symlink to a directory of files), which a
+  // watch on the old inode would never report.
+  for (const std::string* path :
+       {&root_cert_path_, &private_key_path_, &identity_certificate_path_}) {
+    if (!path->empty()) unwatched_directories_.insert(DirectoryOf(*path));
+  }
+  AddDirectoryWatches();
+  for (const std::string& directory : unwatched_directories_) {
+    gpr_log(GPR_ERROR, "Watching %s failed, retrying every %d ms",
+            directory.c_str(), kWatchRetryMs);
+  }
+  return true;
+}
+
+bool FileWatcherCertificateProvider::AddDirectoryWatches() {
+  bool added = false;
+  for (auto it = unwatched_directories_.begin();
+       it != unwatched_directories_.end();) {
+    int wd = inotify_add_watch(inotify_fd_, it->c_str(),
+                               IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE |
+                                   IN_DELETE | IN_DELETE_SELF | IN_MOVE_SELF);
+    if (wd < 0) {
+      ++it;
+      continue;
+    }
+    watched_directories_[wd] = *it;
+    it = unwatched_directories_.erase(it);
+    added = true;
+  }
+  return added;
+}
+
+bool FileWatcherCertificateProvider::WaitForFileChange() {
+  if (inotify_fd_ < 0) {
+    return gpr_event_wait(&shutdown_event_,
+                          TimeoutSecondsToDeadline(refresh_interval_sec_)) !=
+           nullptr;
+  }
+  std::set<std::string> file_names;
+  for (const std::string* path :
+       {&root_cert_path_, &private_key_path_, &identity_certificate_path_}) {
+    if (!path->empty()) file_names.insert(BaseNameOf(*path));
+  }
+  // Drains pending events. Returns true if any of them may affect the watched
+  // files.
+  auto drain_events = [this, &file_names]() {
+    alignas(struct inotify_event) char buf[4096];
+    bool relevant = false;
+    while (true) {
+      ssize_t len = read(inotify_fd_, buf, sizeof(buf));
+      if (len <= 0) break;
+      for (char* ptr = buf; ptr < buf + len;) {
+        const struct inotify_event* event =
+            reinterpret_cast<const struct inotify_event*>(ptr);
+        ptr += sizeof(struct inotify_event) + event->len;
+        if ((event->mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED)) !=
+            0) {
+          // The directory is gone from its path, e.g. it was replaced by an
+          // atomic rename. Watch whatever appears at that path next.
+          auto it = watched_directories_.find(event->wd);
+          if (it == watched_directories_.end()) {
+            // The end of a watch that was already given up.
+            continue;
+          }
+          if ((event->mask & IN_IGNORED) == 0) {
+            inotify_rm_watch(inotify_fd_, event->wd);
+          }
+          unwatched_directories_.insert(std::move(it->second));
+          watched_directories_.erase(it);
+        }
+        // Events about the directory itself, the watched files, or the
+        // "..data" style symlinks used for atomic updates of a directory.
+        if (event->len == 0 || file_names.count(event->name) > 0 ||
+            strncmp(event->name, "..", 2) == 0) {
+          relevant = true;
+        }
+      }
+    }
+    return relevant;
+  };
+  gpr_timespec deadline = TimeoutSecondsToDeadline(refresh_interval_sec_);
+  // When the first relevant event was seen, and when the files were last
+  // seen changing.
+  gpr_timespec first_change = gpr_inf_future(GPR_CLOCK_MONOTONIC);
+  gpr_timespec last_change = gpr_inf_future(GPR_CLOCK_MONOTONIC);
+  bool changed = false;
+  while (true) {
+    // Directories that came back may have new files in them.
+    if (!unwatched_directories_.empty() && AddDirectoryWatches() &&
+        !changed) {
+      changed = true;
+      first_change = last_change = gpr_now(GPR_CLOCK_MONOTONIC);
+    }
+    gpr_timespec wake_up = deadline;
+    if (changed) {
+      gpr_timespec settled = gpr_time_add(
+          last_change, gpr_time_from_millis(kFileChangeSettleMs, GPR_TIMESPAN));
+      gpr_timespec max_settled = gpr_time_add(
+          first_change,
+          gpr_time_from_millis(kFileChangeMaxSettleMs, GPR_TIMESPAN));
+      wake_up = gpr_time_min(settled, max_settled);
+    } else if (!unwatched_directories_.empty()) {
+      wake_up = gpr_time_min(
+          wake_up, gpr_time_add(gpr_now(GPR_CLOCK_MONOTONIC),
+                                gpr_time_from_millis(kWatchRetryMs,
+                                                     GPR_TIMESPAN)));
+    }
+    gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
+    if (changed && gpr_time_cmp(now, wake_up) >= 0) return false;
+    if (gpr_time_cmp(now, deadline) >= 0) return false;
+    int timeout_ms = static_cast<int>(std::min<int64_t>(
+        INT_MAX - 1,
+        std::max<int64_t>(0, gpr_time_to_millis(gpr_time_sub(wake_up, now)))));
+    struct pollfd fds[2];
+    fds[0].fd = wakeup_fd_;
+    fds[0].events = POLLIN;
+    fds[1].fd = inotify_fd_;
+    fds[1].events = POLLIN;
+    int r = poll(fds, 2, timeout_ms);
+    if (r < 0 && errno != EINTR) {
+      gpr_log(GPR_ERROR, "poll() on inotify failed: %s", strerror(errno));
+      return gpr_event_wait(&shutdown_event_, deadline) != nullptr;
+    }
+    if (gpr_event_get(&shutdown_event_) != nullptr) return true;
+    if (r > 0 && (fds[1].revents & POLLIN) != 0 && drain_events()) {
+      last_change = gpr_now(GPR_CLOCK_MONOTONIC);
+      if (!changed) first_change = last_change;
+      changed = true;
+    }
+  }
 }
 
+#else  // GRPC_LINUX_INOTIFY
+
+bool FileWatcherCertificateProvider::StartFileChangeNotification() {
+  return false;
+}
+
+bool FileWatcherCertificateProvider::AddDirectoryWatches() { return false; }
+
+bool FileWatcherCertificateProvider::WaitForFileChange() {
+  return gpr_event_wait(&shutdown_event_,
+                        TimeoutSecondsToDeadline(refresh_interval_sec_)) !=
+         nullptr;
+}
+
+#endif  // GRPC_LINUX_INOTIFY
+
 void FileWatcherCertificateProvider::ForceUpdate() {
   absl::optional<std::string> root_certificate;
   absl::optional<PemKeyCertPairList> pem_key_cert_pairs;
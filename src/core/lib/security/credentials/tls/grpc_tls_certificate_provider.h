@@ -21,6 +21,9 @@
 
 #include <string.h>
 
+#include <map>
+#include <set>
+
 #include "absl/container/inlined_vector.h"
 #include "absl/status/statusor.h"
 
@@ -105,6 +108,15 @@ class FileWatcherCertificateProvider final
   };
   // Force an update from the file system regardless of the interval.
   void ForceUpdate();
+  // Sets up change notifications for the directories holding the credential
+  // files, where the platform supports it. Returns false otherwise.
+  bool StartFileChangeNotification();
+  // Watches the directories in |unwatched_directories_| that exist. Returns
+  // true if any of them could be watched.
+  bool AddDirectoryWatches();
+  // Blocks until the credential files may have changed or the refresh
+  // interval elapses. Returns true if the provider is being shut down.
+  bool WaitForFileChange();
   // Read the root certificates from files and update the distributor.
   absl::optional<std::string> ReadRootCertificatesFromFile(
       const std::string& root_cert_full_path);
@@ -123,6 +135,15 @@ class FileWatcherCertificateProvider final
   RefCountedPtr<grpc_tls_certificate_distributor> distributor_;
   Thread refresh_thread_;
   gpr_event shutdown_event_;
+  // The inotify descriptor, and an eventfd used to wake the refreshing thread
+  // up on shutdown. Both are -1 if file change notification isn't available.
+  int inotify_fd_ = -1;
+  int wakeup_fd_ = -1;
+  // The directories holding the credential files, by watch descriptor, and
+  // the ones that aren't watched because they were removed or renamed. Only
+  // accessed by the refreshing thread once it is started.
+  std::map<int, std::string> watched_directories_;
+  std::set<std::string> unwatched_directories_;
 
   // Guards members below.
   Mutex mu_;
@@ -18,6 +18,12 @@
 
 #include "src/core/lib/security/credentials/tls/grpc_tls_certificate_verifier.h"
 
+#include <algorithm>
+
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/x509.h>
+
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
@@ -143,6 +149,121 @@ bool HostNameCertificateVerifier::Verify(
   return true;  // synchronous check
 }
 
+namespace {
+
+// Cached verification results are reused for at most this long.
+constexpr int64_t kVerificationResultMaxAgeSeconds = 60 * 60;
+
+// Returns the cache key of |request| verified by |verifier|: a digest of the
+// verifier's identity, the target name and the certificate chain presented by
+// the peer, or an empty string if the request carries no certificate.
+std::string VerificationResultCacheKey(
+    const grpc_tls_certificate_verifier* verifier,
+    const grpc_tls_custom_verification_check_request* request) {
+  const char* chain = request->peer_info.peer_cert_full_chain != nullptr
+                          ? request->peer_info.peer_cert_full_chain
+                          : request->peer_info.peer_cert;
+  if (chain == nullptr || request->peer_info.peer_cert == nullptr) return "";
+  const char* target_name =
+      request->target_name != nullptr ? request->target_name : "";
+  std::string input(reinterpret_cast<const char*>(&verifier),
+                    sizeof(verifier));
+  // Keep the terminating '\0' to separate the target name from the chain.
+  input.append(target_name, strlen(target_name) + 1);
+  input.append(chain);
+  unsigned char digest[EVP_MAX_MD_SIZE];
+  unsigned int digest_size = 0;
+  if (EVP_Digest(input.data(), input.size(), digest, &digest_size,
+                 EVP_sha256(), nullptr) != 1) {
+    return "";
+  }
+  return std::string(reinterpret_cast<const char*>(digest), digest_size);
+}
+
+// Returns when a result for a peer with leaf certificate |peer_cert| (in PEM)
+// stops being reusable, or an infinite past time if the certificate can't be
+// parsed.
+gpr_timespec VerificationResultExpiration(const char* peer_cert) {
+  gpr_timespec now = gpr_now(GPR_CLOCK_REALTIME);
+  gpr_timespec expiration = gpr_inf_past(GPR_CLOCK_REALTIME);
+  BIO* bio = BIO_new_mem_buf(peer_cert, static_cast<int>(strlen(peer_cert)));
+  if (bio == nullptr) return expiration;
+  X509* x509 = PEM_read_bio_X509(bio, nullptr, nullptr, nullptr);
+  BIO_free(bio);
+  if (x509 == nullptr) return expiration;
+  int days = 0;
+  int seconds = 0;
+  if (ASN1_TIME_diff(&days, &seconds, nullptr, X509_get_notAfter(x509)) == 1) {
+    int64_t remaining = static_cast<int64_t>(days) * 24 * 60 * 60 + seconds;
+    if (remaining > 0) {
+      expiration = gpr_time_add(
+          now, gpr_time_from_seconds(
+                   std::min(remaining, kVerificationResultMaxAgeSeconds),
+                   GPR_TIMESPAN));
+    }
+  }
+  X509_free(x509);
+  return expiration;
+}
+
+}  // namespace
+
+bool TlsVerificationResultCache::Lookup(
+    const grpc_tls_certificate_verifier* verifier,
+    const grpc_tls_custom_verification_check_request* request) {
+  std::string key = VerificationResultCacheKey(verifier, request);
+  if (key.empty()) return false;
+  MutexLock lock(&mu_);
+  auto it = entries_.find(key);
+  if (it == entries_.end()) return false;
+  if (gpr_time_cmp(it->second->expiration, gpr_now(GPR_CLOCK_REALTIME)) <= 0) {
+    lru_.erase(it->second);
+    entries_.erase(it);
+    return false;
+  }
+  lru_.splice(lru_.begin(), lru_, it->second);
+  return true;
+}
+
+void TlsVerificationResultCache::Insert(
+    const grpc_tls_certificate_verifier* verifier,
+    const grpc_tls_custom_verification_check_request* request,
+    uint64_t generation) {
+  std::string key = VerificationResultCacheKey(verifier, request);
+  if (key.empty()) return;
+  {
+    // Results served from the cache come back here too; don't extend their
+    // lifetime.
+    MutexLock lock(&mu_);
+    if (generation != generation_) return;
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+      lru_.splice(lru_.begin(), lru_, it->second);
+      return;
+    }
+  }
+  gpr_timespec expiration =
+      VerificationResultExpiration(request->peer_info.peer_cert);
+  if (gpr_time_cmp(expiration, gpr_now(GPR_CLOCK_REALTIME)) <= 0) return;
+  MutexLock lock(&mu_);
+  // Verified against roots or a verifier that were replaced meanwhile.
+  if (generation != generation_) return;
+  if (entries_.find(key) != entries_.end()) return;
+  if (entries_.size() >= max_entries_) {
+    entries_.erase(lru_.back().key);
+    lru_.pop_back();
+  }
+  lru_.push_front(Entry{key, expiration});
+  entries_.emplace(std::move(key), lru_.begin());
+}
+
+void TlsVerificationResultCache::Clear() {
+  MutexLock lock(&mu_);
+  generation_++;
+  entries_.clear();
+  lru_.clear();
+}
+
 }  // namespace grpc_core
 
 //
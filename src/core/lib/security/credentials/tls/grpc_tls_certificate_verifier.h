@@ -21,6 +21,10 @@
 
 #include <string.h>
 
+#include <list>
+#include <map>
+#include <string>
+
 #include "absl/status/status.h"
 
 #include <grpc/grpc_security.h>
@@ -101,6 +105,55 @@ class HostNameCertificateVerifier : public grpc_tls_certificate_verifier {
   void Cancel(grpc_tls_custom_verification_check_request*) override {}
 };
 
+// A size-bounded LRU cache of successful verification results, so that a
+// verifier doesn't need to be called again for a peer that presents the same
+// certificate chain for the same target name. Entries are reused until the
+// leaf certificate expires, for at most an hour, and the whole cache should be
+// cleared whenever the root certificates or the verifier change.
+class TlsVerificationResultCache
+    : public RefCounted<TlsVerificationResultCache> {
+ public:
+  explicit TlsVerificationResultCache(size_t max_entries)
+      : max_entries_(max_entries) {}
+
+  // Returns true if |request| matches a successful verification by |verifier|
+  // that has not expired yet.
+  bool Lookup(const grpc_tls_certificate_verifier* verifier,
+              const grpc_tls_custom_verification_check_request* request);
+  // Returns the current generation of the cache, which changes on Clear().
+  uint64_t generation() {
+    MutexLock lock(&mu_);
+    return generation_;
+  }
+  // Records that |verifier| successfully verified |request|. |generation| is
+  // the generation() read before the verification started: the result is
+  // dropped if the cache was cleared since then.
+  void Insert(const grpc_tls_certificate_verifier* verifier,
+              const grpc_tls_custom_verification_check_request* request,
+              uint64_t generation);
+  // Drops all the entries.
+  void Clear();
+
+  size_t size() {
+    MutexLock lock(&mu_);
+    return entries_.size();
+  }
+
+ private:
+  struct Entry {
+    std::string key;
+    gpr_timespec expiration;
+  };
+
+  const size_t max_entries_;
+  Mutex mu_;
+  uint64_t generation_ ABSL_GUARDED_BY(mu_) = 0;
+  // Most recently used first.
+  std::list<Entry> lru_ ABSL_GUARDED_BY(mu_);
+  std::map<std::string, std::list<Entry>::iterator> entries_
+      ABSL_GUARDED_BY(mu_);
+};
+
 }  // namespace grpc_core
 
 #endif  // GRPC_CORE_LIB_SECURITY_CREDENTIALS_TLS_GRPC_TLS_CERTIFICATE_VERIFIER_H
@@ -96,3 +96,9 @@ void grpc_tls_credentials_options_set_check_call_host(
   GPR_ASSERT(options != nullptr);
   options->set_check_call_host(check_call_host);
 }
+
+void grpc_tls_credentials_options_set_verification_result_cache_size(
+    grpc_tls_credentials_options* options, size_t max_entries) {
+  GPR_ASSERT(options != nullptr);
+  options->set_verification_result_cache_size(max_entries);
+}
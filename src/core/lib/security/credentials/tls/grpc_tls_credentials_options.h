@@ -51,6 +51,10 @@ struct grpc_tls_credentials_options
     return verifier_.get();
   }
   bool check_call_host() const { return check_call_host_; }
+  // Returns the cache of verification results, or nullptr if disabled.
+  grpc_core::TlsVerificationResultCache* verification_result_cache() {
+    return verification_result_cache_.get();
+  }
   // Returns the distributor from provider_ if it is set, nullptr otherwise.
   grpc_tls_certificate_distributor* certificate_distributor() {
     if (provider_ != nullptr) return provider_->distributor().get();
@@ -79,11 +83,26 @@ struct grpc_tls_credentials_options
   void set_certificate_verifier(
       grpc_core::RefCountedPtr<grpc_tls_certificate_verifier> verifier) {
     verifier_ = std::move(verifier);
+    // Cached results are keyed by verifier address, which may get reused.
+    if (verification_result_cache_ != nullptr) {
+      verification_result_cache_->Clear();
+    }
   }
   // Sets the verifier in the options.
   void set_check_call_host(bool check_call_host) {
     check_call_host_ = check_call_host;
   }
+  // Sets the maximum number of cached verification results. 0 disables the
+  // cache.
+  void set_verification_result_cache_size(size_t max_entries) {
+    if (max_entries == 0) {
+      verification_result_cache_.reset();
+    } else {
+      verification_result_cache_ =
+          grpc_core::MakeRefCounted<grpc_core::TlsVerificationResultCache>(
+              max_entries);
+    }
+  }
   // Sets the provider in the options.
   void set_certificate_provider(
       grpc_core::RefCountedPtr<grpc_tls_certificate_provider> provider) {
@@ -120,6 +139,8 @@ struct grpc_tls_credentials_options
   grpc_tls_version max_tls_version_ = grpc_tls_version::TLS1_3;
   grpc_core::RefCountedPtr<grpc_tls_certificate_verifier> verifier_;
   bool check_call_host_ = true;
+  grpc_core::RefCountedPtr<grpc_core::TlsVerificationResultCache>
+      verification_result_cache_;
   grpc_core::RefCountedPtr<grpc_tls_certificate_provider> provider_;
   bool watch_root_cert_ = false;
   std::string root_cert_name_;
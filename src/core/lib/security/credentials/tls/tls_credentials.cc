@@ -30,6 +30,7 @@
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/security/credentials/tls/grpc_tls_certificate_verifier.h"
 #include "src/core/lib/security/security_connector/tls/tls_security_connector.h"
+#include "src/core/tsi/ssl_transport_security.h"
 
 #define GRPC_CREDENTIALS_TYPE_TLS "Tls"
 
@@ -94,6 +95,11 @@ TlsCredentials::create_security_connector(
           static_cast<tsi_ssl_session_cache*>(arg->value.pointer.p);
     }
   }
+  if (ssl_session_cache == nullptr &&
+      grpc_channel_args_find_bool(args, GRPC_ARG_SSL_DEFAULT_SESSION_CACHE,
+                                  true)) {
+    ssl_session_cache = tsi_ssl_session_cache_get_default();
+  }
   grpc_core::RefCountedPtr<grpc_channel_security_connector> sc =
       grpc_core::TlsChannelSecurityConnector::CreateTlsChannelSecurityConnector(
           this->Ref(), options_, std::move(call_creds), target_name,
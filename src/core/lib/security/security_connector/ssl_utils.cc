@@ -30,6 +30,7 @@
 
 #include "src/core/ext/transport/chttp2/alpn/alpn.h"
 #include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/debug/stats.h"
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gprpp/host_port.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
@@ -169,6 +170,17 @@ grpc_error_handle grpc_ssl_check_alpn(const tsi_peer* peer) {
   return GRPC_ERROR_NONE;
 }
 
+void grpc_ssl_record_client_session_reuse(const tsi_peer* peer) {
+  const tsi_peer_property* p =
+      tsi_peer_get_property_by_name(peer, TSI_SSL_SESSION_REUSED_PEER_PROPERTY);
+  if (p != nullptr &&
+      absl::string_view(p->value.data, p->value.length) == "true") {
+    GRPC_STATS_INC_TLS_HANDSHAKES_RESUMED();
+  } else {
+    GRPC_STATS_INC_TLS_HANDSHAKES_FULL();
+  }
+}
+
 grpc_error_handle grpc_ssl_check_peer_name(absl::string_view peer_name,
                                            const tsi_peer* peer) {
   /* Check the peer name if specified. */
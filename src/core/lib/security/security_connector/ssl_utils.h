@@ -49,6 +49,9 @@ grpc_error_handle grpc_ssl_check_alpn(const tsi_peer* peer);
 /* Check peer name information returned from SSL handshakes. */
 grpc_error_handle grpc_ssl_check_peer_name(absl::string_view peer_name,
                                            const tsi_peer* peer);
+/* Record in the process-wide stats whether a client SSL handshake resumed a
+   cached session or had to do a full handshake. */
+void grpc_ssl_record_client_session_reuse(const tsi_peer* peer);
 /* Compare targer_name information extracted from SSL security connectors. */
 int grpc_ssl_cmp_target_name(absl::string_view target_name,
                              absl::string_view other_target_name,
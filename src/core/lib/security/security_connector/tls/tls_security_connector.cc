@@ -319,6 +319,7 @@ void TlsChannelSecurityConnector::add_handshakers(
     const grpc_channel_args* args, grpc_pollset_set* /*interested_parties*/,
     HandshakeManager* handshake_mgr) {
   MutexLock lock(&mu_);
+  MaybeUpdateHandshakerFactoryLocked();
   tsi_handshaker* tsi_hs = nullptr;
   if (client_handshaker_factory_ != nullptr) {
     // Instantiate TSI handshaker.
@@ -343,6 +344,7 @@ void TlsChannelSecurityConnector::check_peer(
   const char* target_name = overridden_target_name_.empty()
                                 ? target_name_.c_str()
                                 : overridden_target_name_.c_str();
+  grpc_ssl_record_client_session_reuse(&peer);
   grpc_error_handle error = grpc_ssl_check_alpn(&peer);
   if (error != GRPC_ERROR_NONE) {
     ExecCtx::Run(DEBUG_LOCATION, on_peer_checked, error);
@@ -426,6 +428,10 @@ void TlsChannelSecurityConnector::TlsChannelCertificateWatcher::
   MutexLock lock(&security_connector_->mu_);
   if (root_certs.has_value()) {
     security_connector_->pem_root_certs_ = root_certs;
+    // Results verified against the previous roots may no longer hold.
+    TlsVerificationResultCache* cache =
+        security_connector_->options_->verification_result_cache();
+    if (cache != nullptr) cache->Clear();
   }
   if (key_cert_pairs.has_value()) {
     security_connector_->pem_key_cert_pair_list_ = std::move(key_cert_pairs);
@@ -436,8 +442,11 @@ void TlsChannelSecurityConnector::TlsChannelCertificateWatcher::
       !security_connector_->options_->watch_identity_pair() ||
       security_connector_->pem_key_cert_pair_list_.has_value();
   if (root_ready && identity_ready) {
-    if (security_connector_->UpdateHandshakerFactoryLocked() !=
-        GRPC_SECURITY_OK) {
+    if (security_connector_->client_handshaker_factory_ != nullptr) {
+      // Defer the rebuild to the next handshake.
+      security_connector_->handshaker_factory_stale_ = true;
+    } else if (security_connector_->UpdateHandshakerFactoryLocked() !=
+               GRPC_SECURITY_OK) {
       gpr_log(GPR_ERROR, "Update handshaker factory failed.");
     }
   }
@@ -477,10 +486,20 @@ TlsChannelSecurityConnector::ChannelPendingVerifierRequest::
 }
 
 void TlsChannelSecurityConnector::ChannelPendingVerifierRequest::Start() {
+  verifier_ = security_connector_->options_->certificate_verifier()->Ref();
+  TlsVerificationResultCache* cache =
+      security_connector_->options_->verification_result_cache();
+  if (cache != nullptr) {
+    // Read before verifying: results must not outlive a Clear() that happens
+    // while the verifier runs.
+    cache_generation_ = cache->generation();
+    if (cache->Lookup(verifier_.get(), &request_)) {
+      OnVerifyDone(false, absl::OkStatus());
+      return;
+    }
+  }
   absl::Status sync_status;
-  grpc_tls_certificate_verifier* verifier =
-      security_connector_->options_->certificate_verifier();
-  bool is_done = verifier->Verify(
+  bool is_done = verifier_->Verify(
       &request_,
       absl::bind_front(&ChannelPendingVerifierRequest::OnVerifyDone, this,
                        true),
@@ -497,7 +516,13 @@ void TlsChannelSecurityConnector::ChannelPendingVerifierRequest::OnVerifyDone(
     security_connector_->pending_verifier_requests_.erase(on_peer_checked_);
   }
   grpc_error_handle error = GRPC_ERROR_NONE;
-  if (!status.ok()) {
+  if (status.ok()) {
+    TlsVerificationResultCache* cache =
+        security_connector_->options_->verification_result_cache();
+    if (cache != nullptr) {
+      cache->Insert(verifier_.get(), &request_, cache_generation_);
+    }
+  } else {
     error = GRPC_ERROR_CREATE_FROM_COPIED_STRING(
         absl::StrCat("Custom verification check failed with error: ",
                      status.ToString())
@@ -511,6 +536,14 @@ void TlsChannelSecurityConnector::ChannelPendingVerifierRequest::OnVerifyDone(
   delete this;
 }
 
+void TlsChannelSecurityConnector::MaybeUpdateHandshakerFactoryLocked() {
+  if (!handshaker_factory_stale_) return;
+  handshaker_factory_stale_ = false;
+  if (UpdateHandshakerFactoryLocked() != GRPC_SECURITY_OK) {
+    gpr_log(GPR_ERROR, "Update handshaker factory failed.");
+  }
+}
+
 // TODO(ZhenLian): implement the logic to signal waiting handshakers once
 // BlockOnInitialCredentialHandshaker is implemented.
 grpc_security_status
@@ -519,6 +552,7 @@ TlsChannelSecurityConnector::UpdateHandshakerFactoryLocked() {
   /* Free the client handshaker factory if exists. */
   if (client_handshaker_factory_ != nullptr) {
     tsi_ssl_client_handshaker_factory_unref(client_handshaker_factory_);
+    client_handshaker_factory_ = nullptr;
   }
   std::string pem_root_certs;
   if (pem_root_certs_.has_value()) {
@@ -607,6 +641,7 @@ void TlsServerSecurityConnector::add_handshakers(
     const grpc_channel_args* args, grpc_pollset_set* /*interested_parties*/,
     HandshakeManager* handshake_mgr) {
   MutexLock lock(&mu_);
+  MaybeUpdateHandshakerFactoryLocked();
   tsi_handshaker* tsi_hs = nullptr;
   if (server_handshaker_factory_ != nullptr) {
     // Instantiate TSI handshaker.
@@ -692,6 +727,10 @@ void TlsServerSecurityConnector::TlsServerCertificateWatcher::
   MutexLock lock(&security_connector_->mu_);
   if (root_certs.has_value()) {
     security_connector_->pem_root_certs_ = root_certs;
+    // Results verified against the previous roots may no longer hold.
+    TlsVerificationResultCache* cache =
+        security_connector_->options_->verification_result_cache();
+    if (cache != nullptr) cache->Clear();
   }
   if (key_cert_pairs.has_value()) {
     security_connector_->pem_key_cert_pair_list_ = std::move(key_cert_pairs);
@@ -706,8 +745,11 @@ void TlsServerSecurityConnector::TlsServerCertificateWatcher::
        identity_has_value) ||
       (root_being_watched && root_has_value && !identity_being_watched) ||
       (!root_being_watched && identity_being_watched && identity_has_value)) {
-    if (security_connector_->UpdateHandshakerFactoryLocked() !=
-        GRPC_SECURITY_OK) {
+    if (security_connector_->server_handshaker_factory_ != nullptr) {
+      // Defer the rebuild to the next handshake.
+      security_connector_->handshaker_factory_stale_ = true;
+    } else if (security_connector_->UpdateHandshakerFactoryLocked() !=
+               GRPC_SECURITY_OK) {
       gpr_log(GPR_ERROR, "Update handshaker factory failed.");
     }
   }
@@ -747,10 +789,20 @@ TlsServerSecurityConnector::ServerPendingVerifierRequest::
 }
 
 void TlsServerSecurityConnector::ServerPendingVerifierRequest::Start() {
+  verifier_ = security_connector_->options_->certificate_verifier()->Ref();
+  TlsVerificationResultCache* cache =
+      security_connector_->options_->verification_result_cache();
+  if (cache != nullptr) {
+    // Read before verifying: results must not outlive a Clear() that happens
+    // while the verifier runs.
+    cache_generation_ = cache->generation();
+    if (cache->Lookup(verifier_.get(), &request_)) {
+      OnVerifyDone(false, absl::OkStatus());
+      return;
+    }
+  }
   absl::Status sync_status;
-  grpc_tls_certificate_verifier* verifier =
-      security_connector_->options_->certificate_verifier();
-  bool is_done = verifier->Verify(
+  bool is_done = verifier_->Verify(
       &request_,
       absl::bind_front(&ServerPendingVerifierRequest::OnVerifyDone, this, true),
       &sync_status);
@@ -766,7 +818,13 @@ void TlsServerSecurityConnector::ServerPendingVerifierRequest::OnVerifyDone(
     security_connector_->pending_verifier_requests_.erase(on_peer_checked_);
   }
   grpc_error_handle error = GRPC_ERROR_NONE;
-  if (!status.ok()) {
+  if (status.ok()) {
+    TlsVerificationResultCache* cache =
+        security_connector_->options_->verification_result_cache();
+    if (cache != nullptr) {
+      cache->Insert(verifier_.get(), &request_, cache_generation_);
+    }
+  } else {
     error = GRPC_ERROR_CREATE_FROM_COPIED_STRING(
         absl::StrCat("Custom verification check failed with error: ",
                      status.ToString())
@@ -780,6 +838,14 @@ void TlsServerSecurityConnector::ServerPendingVerifierRequest::OnVerifyDone(
   delete this;
 }
 
+void TlsServerSecurityConnector::MaybeUpdateHandshakerFactoryLocked() {
+  if (!handshaker_factory_stale_) return;
+  handshaker_factory_stale_ = false;
+  if (UpdateHandshakerFactoryLocked() != GRPC_SECURITY_OK) {
+    gpr_log(GPR_ERROR, "Update handshaker factory failed.");
+  }
+}
+
 // TODO(ZhenLian): implement the logic to signal waiting handshakers once
 // BlockOnInitialCredentialHandshaker is implemented.
 grpc_security_status
@@ -787,6 +853,7 @@ TlsServerSecurityConnector::UpdateHandshakerFactoryLocked() {
   /* Free the server handshaker factory if exists. */
   if (server_handshaker_factory_ != nullptr) {
     tsi_ssl_server_handshaker_factory_unref(server_handshaker_factory_);
+    server_handshaker_factory_ = nullptr;
   }
   // The identity certs on the server side shouldn't be empty.
   GPR_ASSERT(pem_key_cert_pair_list_.has_value());
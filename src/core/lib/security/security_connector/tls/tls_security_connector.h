@@ -127,6 +127,10 @@ class TlsChannelSecurityConnector final
     // it won't be destroyed while the request is still ongoing.
     RefCountedPtr<TlsChannelSecurityConnector> security_connector_;
     grpc_tls_custom_verification_check_request request_;
+    // The verifier the request was started with, and the generation of the
+    // verification result cache at that time.
+    RefCountedPtr<grpc_tls_certificate_verifier> verifier_;
+    uint64_t cache_generation_ = 0;
     grpc_closure* on_peer_checked_;
   };
 
@@ -134,6 +138,10 @@ class TlsChannelSecurityConnector final
   // |certificate_watcher_| is watching get updated.
   grpc_security_status UpdateHandshakerFactoryLocked()
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  // Rebuilds |client_handshaker_factory_| if the certificates changed since it
+  // was last built. Connections that are already established keep the
+  // factory they were created from.
+  void MaybeUpdateHandshakerFactoryLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
 
   Mutex mu_;
   // We need a separate mutex for |pending_verifier_requests_|, otherwise there
@@ -146,6 +154,11 @@ class TlsChannelSecurityConnector final
   std::string overridden_target_name_;
   tsi_ssl_client_handshaker_factory* client_handshaker_factory_
       ABSL_GUARDED_BY(mu_) = nullptr;
+  // Set when new certificates arrived after the handshaker factory was built.
+  // The factory is then rebuilt by the next handshake rather than by the
+  // certificate update itself, so that a rotation doesn't rebuild the SSL
+  // contexts of every idle connector at once.
+  bool handshaker_factory_stale_ ABSL_GUARDED_BY(mu_) = false;
   tsi_ssl_session_cache* ssl_session_cache_ ABSL_GUARDED_BY(mu_) = nullptr;
   absl::optional<absl::string_view> pem_root_certs_ ABSL_GUARDED_BY(mu_);
   absl::optional<PemKeyCertPairList> pem_key_cert_pair_list_
@@ -237,6 +250,10 @@ class TlsServerSecurityConnector final : public grpc_server_security_connector {
     // it won't be destroyed while the request is still ongoing.
     RefCountedPtr<TlsServerSecurityConnector> security_connector_;
     grpc_tls_custom_verification_check_request request_;
+    // The verifier the request was started with, and the generation of the
+    // verification result cache at that time.
+    RefCountedPtr<grpc_tls_certificate_verifier> verifier_;
+    uint64_t cache_generation_ = 0;
     grpc_closure* on_peer_checked_;
   };
 
@@ -244,6 +261,10 @@ class TlsServerSecurityConnector final : public grpc_server_security_connector {
   // |certificate_watcher_| is watching get updated.
   grpc_security_status UpdateHandshakerFactoryLocked()
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  // Rebuilds |server_handshaker_factory_| if the certificates changed since it
+  // was last built. Connections that are already established keep the
+  // factory they were created from.
+  void MaybeUpdateHandshakerFactoryLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
 
   Mutex mu_;
   // We need a separate mutex for |pending_verifier_requests_|, otherwise there
@@ -254,6 +275,11 @@ class TlsServerSecurityConnector final : public grpc_server_security_connector {
       certificate_watcher_ = nullptr;
   tsi_ssl_server_handshaker_factory* server_handshaker_factory_
       ABSL_GUARDED_BY(mu_) = nullptr;
+  // Set when new certificates arrived after the handshaker factory was built.
+  // The factory is then rebuilt by the next handshake rather than by the
+  // certificate update itself, so that a rotation doesn't rebuild the SSL
+  // contexts of every idle connector at once.
+  bool handshaker_factory_stale_ ABSL_GUARDED_BY(mu_) = false;
   absl::optional<absl::string_view> pem_root_certs_ ABSL_GUARDED_BY(mu_);
   absl::optional<PemKeyCertPairList> pem_key_cert_pair_list_
       ABSL_GUARDED_BY(mu_);
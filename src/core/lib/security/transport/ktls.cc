@@ -0,0 +1,147 @@
+// Copyright 2021 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/security/transport/ktls.h"
+
+#include "src/core/lib/iomgr/port.h"
+
+#ifdef GRPC_LINUX_KTLS
+
+#include <errno.h>
+#include <linux/tls.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <string.h>
+#include <sys/socket.h>
+
+#include <grpc/support/log.h>
+
+#ifndef TCP_ULP
+#define TCP_ULP 31
+#endif
+#ifndef SOL_TLS
+#define SOL_TLS 282
+#endif
+
+namespace grpc_core {
+
+namespace {
+
+union KernelCryptoInfo {
+  tls12_crypto_info_aes_gcm_128 aes_gcm_128;
+#ifdef TLS_CIPHER_AES_GCM_256
+  tls12_crypto_info_aes_gcm_256 aes_gcm_256;
+#endif
+};
+
+template <typename T>
+socklen_t FillKernelCryptoInfo(const tsi_ktls_crypto_info& info,
+                               uint16_t cipher_type, T* out) {
+  static_assert(sizeof(out->key) <= sizeof(info.key), "key too large");
+  static_assert(sizeof(out->salt) == sizeof(info.salt), "salt size mismatch");
+  static_assert(sizeof(out->iv) == sizeof(info.iv), "iv size mismatch");
+  static_assert(sizeof(out->rec_seq) == sizeof(info.rec_seq),
+                "rec_seq size mismatch");
+  memset(out, 0, sizeof(*out));
+  out->info.version = info.tls_version;
+  out->info.cipher_type = cipher_type;
+  memcpy(out->key, info.key, sizeof(out->key));
+  memcpy(out->salt, info.salt, sizeof(out->salt));
+  memcpy(out->iv, info.iv, sizeof(out->iv));
+  memcpy(out->rec_seq, info.rec_seq, sizeof(out->rec_seq));
+  return sizeof(*out);
+}
+
+// Returns the size of the socket option value, or 0 if the cipher is not
+// supported by the kernel headers this was built against.
+socklen_t ToKernelCryptoInfo(const tsi_ktls_crypto_info& info,
+                             KernelCryptoInfo* out) {
+  if (info.tls_version != TLS_1_2_VERSION) return 0;
+  switch (info.cipher) {
+    case TSI_KTLS_CIPHER_AES_GCM_128:
+      return FillKernelCryptoInfo(info, TLS_CIPHER_AES_GCM_128,
+                                  &out->aes_gcm_128);
+#ifdef TLS_CIPHER_AES_GCM_256
+    case TSI_KTLS_CIPHER_AES_GCM_256:
+      return FillKernelCryptoInfo(info, TLS_CIPHER_AES_GCM_256,
+                                  &out->aes_gcm_256);
+#endif
+    default:
+      return 0;
+  }
+}
+
+}  // namespace
+
+grpc_error_handle OffloadTlsToKernel(
+    const tsi_handshaker_result* handshaker_result, grpc_endpoint* endpoint,
+    bool* offloaded) {
+  *offloaded = false;
+  int fd = grpc_endpoint_get_fd(endpoint);
+  if (fd < 0) return GRPC_ERROR_NONE;
+  tsi_ktls_crypto_info tx;
+  tsi_ktls_crypto_info rx;
+  if (tsi_handshaker_result_get_ktls_crypto_info(handshaker_result, &tx,
+                                                 &rx) != TSI_OK) {
+    return GRPC_ERROR_NONE;
+  }
+  KernelCryptoInfo tx_info;
+  KernelCryptoInfo rx_info;
+  socklen_t tx_info_size = ToKernelCryptoInfo(tx, &tx_info);
+  socklen_t rx_info_size = ToKernelCryptoInfo(rx, &rx_info);
+  memset(&tx, 0, sizeof(tx));
+  memset(&rx, 0, sizeof(rx));
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  if (tx_info_size == 0 || rx_info_size == 0) {
+    // Not supported by these kernel headers.
+  } else if (setsockopt(fd, IPPROTO_TCP, TCP_ULP, "tls", sizeof("tls")) !=
+             0) {
+    // Typically ENOENT, when the tls module is not available. The socket is
+    // unchanged.
+    gpr_log(GPR_DEBUG, "fd=%d: kTLS unavailable: TCP_ULP errno=%d", fd,
+            errno);
+  } else if (setsockopt(fd, SOL_TLS, TLS_RX, &rx_info, rx_info_size) != 0) {
+    // Until a direction is configured, the socket still behaves as plain
+    // TCP. Receive offload came to the kernel after transmit offload, so it
+    // is configured first: if it is missing, nothing has been offloaded yet.
+    gpr_log(GPR_DEBUG, "fd=%d: kTLS unavailable: TLS_RX errno=%d", fd,
+            errno);
+  } else if (setsockopt(fd, SOL_TLS, TLS_TX, &tx_info, tx_info_size) != 0) {
+    error = GRPC_OS_ERROR(errno, "setsockopt(TLS_TX)");
+  } else {
+    *offloaded = true;
+  }
+  memset(&tx_info, 0, sizeof(tx_info));
+  memset(&rx_info, 0, sizeof(rx_info));
+  return error;
+}
+
+}  // namespace grpc_core
+
+#else  // GRPC_LINUX_KTLS
+
+namespace grpc_core {
+
+grpc_error_handle OffloadTlsToKernel(
+    const tsi_handshaker_result* /*handshaker_result*/,
+    grpc_endpoint* /*endpoint*/, bool* offloaded) {
+  *offloaded = false;
+  return GRPC_ERROR_NONE;
+}
+
+}  // namespace grpc_core
+
+#endif  // GRPC_LINUX_KTLS
@@ -0,0 +1,38 @@
+// Copyright 2021 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_CORE_LIB_SECURITY_TRANSPORT_KTLS_H
+#define GRPC_CORE_LIB_SECURITY_TRANSPORT_KTLS_H
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/iomgr/endpoint.h"
+#include "src/core/lib/iomgr/error.h"
+#include "src/core/tsi/transport_security_interface.h"
+
+namespace grpc_core {
+
+// Tries to hand record protection for the TLS session of handshaker_result
+// over to the kernel (Linux kTLS), after which endpoint reads and writes
+// plaintext. Sets *offloaded to false and leaves the socket untouched when the
+// session, the endpoint or the kernel does not support it, in which case the
+// caller protects records in user space as usual. Returns an error only if the
+// socket was left in a state where neither is possible.
+grpc_error_handle OffloadTlsToKernel(
+    const tsi_handshaker_result* handshaker_result, grpc_endpoint* endpoint,
+    bool* offloaded);
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_LIB_SECURITY_TRANSPORT_KTLS_H
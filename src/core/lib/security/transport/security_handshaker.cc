@@ -23,18 +23,31 @@
 #include <stdbool.h>
 #include <string.h>
 
+#include <algorithm>
+#include <atomic>
 #include <limits>
+#include <memory>
+
+#include "absl/memory/memory.h"
 
 #include <grpc/slice_buffer.h>
 #include <grpc/support/alloc.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
+#include <grpc/support/time.h>
 
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/channel/channelz.h"
 #include "src/core/lib/channel/handshaker.h"
 #include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/debug/stats.h"
+#include "src/core/lib/gprpp/fork.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/thd.h"
+#include "src/core/lib/iomgr/executor/threadpool.h"
 #include "src/core/lib/security/context/security_context.h"
+#include "src/core/lib/security/transport/ktls.h"
 #include "src/core/lib/security/transport/secure_endpoint.h"
 #include "src/core/lib/security/transport/tsi_error.h"
 #include "src/core/lib/slice/slice_internal.h"
@@ -46,6 +59,79 @@ namespace grpc_core {
 
 namespace {
 
+// Process-wide pool running TSI handshaker steps off the I/O threads.
+// The number of queued and running steps is bounded: when the pool is
+// saturated, TryRun() fails and the caller runs the step inline, which
+// throttles the poller that is producing new handshakes. The threads are
+// started on first use and stopped at grpc_shutdown() and around fork().
+class HandshakeOffloadPool {
+ public:
+  static HandshakeOffloadPool* Get() {
+    static HandshakeOffloadPool* pool = new HandshakeOffloadPool();
+    return pool;
+  }
+
+  // Runs \a functor on a pool thread and returns true, unless the pool is
+  // saturated or stopped. Release() must be called once the step is done.
+  bool TryRun(grpc_completion_queue_functor* functor) {
+    if (in_flight_.fetch_add(1, std::memory_order_relaxed) >= max_in_flight_) {
+      in_flight_.fetch_sub(1, std::memory_order_relaxed);
+      return false;
+    }
+    MutexLock lock(&mu_);
+    if (!threading_) {
+      in_flight_.fetch_sub(1, std::memory_order_relaxed);
+      return false;
+    }
+    if (pool_ == nullptr) {
+      pool_ = absl::make_unique<ThreadPool>(
+          NumThreads(), "grpc_handshake",
+          Thread::Options().set_stack_size(kStackSize).set_tracked(false));
+    }
+    pool_->Add(functor);
+    return true;
+  }
+
+  void Release() { in_flight_.fetch_sub(1, std::memory_order_relaxed); }
+
+  // Stopping waits for the queued steps to finish. Until threading is turned
+  // back on, steps run inline.
+  static void SetThreading(bool threading) {
+    HandshakeOffloadPool* self = Get();
+    std::unique_ptr<ThreadPool> pool;
+    {
+      MutexLock lock(&self->mu_);
+      self->threading_ = threading;
+      if (!threading) pool = std::move(self->pool_);
+    }
+    // The steps drained here may try to offload the next one, so the pool is
+    // destroyed outside of mu_.
+    pool.reset();
+  }
+
+ private:
+  // Queued steps allowed per pool thread before falling back to inline.
+  static constexpr int kMaxInFlightPerThread = 8;
+  // Handshake crypto needs more stack than the thread pool's 64K default.
+  static constexpr size_t kStackSize = 256 * 1024;
+
+  HandshakeOffloadPool()
+      : max_in_flight_(NumThreads() * kMaxInFlightPerThread) {}
+
+  static int NumThreads() {
+    return std::max(2, static_cast<int>(gpr_cpu_num_cores() / 2));
+  }
+
+  const int max_in_flight_;
+  std::atomic<int> in_flight_{0};
+  Mutex mu_;
+  bool threading_ ABSL_GUARDED_BY(mu_) = true;
+  std::unique_ptr<ThreadPool> pool_ ABSL_GUARDED_BY(mu_);
+};
+
+constexpr int HandshakeOffloadPool::kMaxInFlightPerThread;
+constexpr size_t HandshakeOffloadPool::kStackSize;
+
 class SecurityHandshaker : public Handshaker {
  public:
   SecurityHandshaker(tsi_handshaker* handshaker,
@@ -78,6 +164,8 @@ class SecurityHandshaker : public Handshaker {
   static void OnHandshakeNextDoneGrpcWrapper(
       tsi_result result, void* user_data, const unsigned char* bytes_to_send,
       size_t bytes_to_send_size, tsi_handshaker_result* handshaker_result);
+  static void OffloadedHandshakerNext(grpc_completion_queue_functor* functor,
+                                      int /*success*/);
   static void OnPeerCheckedFn(void* arg, grpc_error_handle error);
   void OnPeerCheckedInner(grpc_error_handle error);
   size_t MoveReadBufferIntoHandshakeBuffer();
@@ -107,6 +195,25 @@ class SecurityHandshaker : public Handshaker {
   RefCountedPtr<grpc_auth_context> auth_context_;
   tsi_handshaker_result* handshaker_result_ = nullptr;
   size_t max_frame_size_ = 0;
+  bool tls_kernel_offload_ = false;
+  bool prefer_zero_copy_protector_ = false;
+
+  // Handshaker step offloading.
+  struct OffloadFunctor : public grpc_completion_queue_functor {
+    SecurityHandshaker* handshaker;
+    const unsigned char* bytes_received;
+    size_t bytes_received_size;
+  };
+  const bool offload_handshake_;
+  // Set once the TSI handshaker has returned TSI_ASYNC. It does its own work
+  // off the I/O thread, so its steps are not offloaded.
+  bool handshaker_is_async_ = false;
+  OffloadFunctor offload_functor_;
+  // Number of steps still inside tsi_handshaker_next() on the offload pool.
+  // tsi_handshaker_shutdown() must not race with it, so a shutdown arriving
+  // meanwhile is applied by the pool thread once the step returns.
+  int offloaded_steps_in_progress_ = 0;
+  gpr_timespec handshake_start_;
 };
 
 SecurityHandshaker::SecurityHandshaker(tsi_handshaker* handshaker,
@@ -119,7 +226,20 @@ SecurityHandshaker::SecurityHandshaker(tsi_handshaker* handshaker,
           static_cast<uint8_t*>(gpr_malloc(handshake_buffer_size_))),
       max_frame_size_(grpc_channel_args_find_integer(
           args, GRPC_ARG_TSI_MAX_FRAME_SIZE,
-          {0, 0, std::numeric_limits<int>::max()})) {
+          {0, 0, std::numeric_limits<int>::max()})),
+      tls_kernel_offload_(
+          grpc_channel_args_find_bool(args, GRPC_ARG_TLS_KERNEL_OFFLOAD,
+                                      false) &&
+          !grpc_channel_args_find_bool(args, GRPC_ARG_TCP_TX_ZEROCOPY_ENABLED,
+                                       false)),
+      prefer_zero_copy_protector_(grpc_channel_args_find_bool(
+          args, GRPC_ARG_TSI_ZERO_COPY_FRAME_PROTECTOR, false)),
+      offload_handshake_(grpc_channel_args_find_bool(
+          args, GRPC_ARG_SECURITY_HANDSHAKE_OFFLOAD, false)) {
+  offload_functor_.functor_run = &SecurityHandshaker::OffloadedHandshakerNext;
+  offload_functor_.inlineable = false;
+  offload_functor_.internal_success = 1;
+  offload_functor_.handshaker = this;
   grpc_slice_buffer_init(&outgoing_);
   GRPC_CLOSURE_INIT(&on_peer_checked_, &SecurityHandshaker::OnPeerCheckedFn,
                     this, grpc_schedule_on_exec_ctx);
@@ -181,7 +301,7 @@ void SecurityHandshaker::HandshakeFailedLocked(grpc_error_handle error) {
   gpr_log(GPR_DEBUG, "Security handshake failed: %s",
           grpc_error_std_string(error).c_str());
   if (!is_shutdown_) {
-    tsi_handshaker_shutdown(handshaker_);
+    if (offloaded_steps_in_progress_ == 0) tsi_handshaker_shutdown(handshaker_);
     // TODO(ctiller): It is currently necessary to shutdown endpoints
     // before destroying them, even if we know that there are no
     // pending read/write callbacks.  This should be fixed, at which
@@ -253,6 +373,18 @@ void SecurityHandshaker::OnPeerCheckedInner(grpc_error_handle error) {
         result));
     return;
   }
+  // Hand record protection over to the kernel if requested. Unused bytes are
+  // records already read from the socket, which the kernel would never see.
+  if (tls_kernel_offload_ && unused_bytes_size == 0) {
+    bool offloaded = false;
+    grpc_error_handle offload_error =
+        OffloadTlsToKernel(handshaker_result_, args_->endpoint, &offloaded);
+    if (offload_error != GRPC_ERROR_NONE) {
+      HandshakeFailedLocked(offload_error);
+      return;
+    }
+    if (offloaded) frame_protector_type = TSI_FRAME_PROTECTOR_NONE;
+  }
   tsi_zero_copy_grpc_protector* zero_copy_protector = nullptr;
   tsi_frame_protector* protector = nullptr;
   switch (frame_protector_type) {
@@ -272,6 +404,22 @@ void SecurityHandshaker::OnPeerCheckedInner(grpc_error_handle error) {
       }
       break;
     case TSI_FRAME_PROTECTOR_NORMAL:
+      // Use the zero-copy frame protector instead if requested and the
+      // handshaker result has one.
+      if (prefer_zero_copy_protector_) {
+        result = tsi_handshaker_result_create_zero_copy_grpc_protector(
+            handshaker_result_,
+            max_frame_size_ == 0 ? nullptr : &max_frame_size_,
+            &zero_copy_protector);
+        if (result == TSI_OK) break;
+        if (result != TSI_UNIMPLEMENTED) {
+          HandshakeFailedLocked(grpc_set_tsi_error_result(
+              GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+                  "Zero-copy frame protector creation failed"),
+              result));
+          return;
+        }
+      }
       // Create normal frame protector.
       result = tsi_handshaker_result_create_frame_protector(
           handshaker_result_, max_frame_size_ == 0 ? nullptr : &max_frame_size_,
@@ -317,6 +465,8 @@ void SecurityHandshaker::OnPeerCheckedInner(grpc_error_handle error) {
   args_->args = grpc_channel_args_copy_and_add(tmp_args, args_to_add.data(),
                                                args_to_add.size());
   grpc_channel_args_destroy(tmp_args);
+  GRPC_STATS_INC_SECURITY_HANDSHAKE_LATENCY_US(gpr_timespec_to_micros(
+      gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC), handshake_start_)));
   // Invoke callback.
   ExecCtx::Run(DEBUG_LOCATION, on_handshake_done_, GRPC_ERROR_NONE);
   // Set shutdown to true so that subsequent calls to
@@ -415,8 +565,55 @@ void SecurityHandshaker::OnHandshakeNextDoneGrpcWrapper(
   }
 }
 
+// Runs a handshaker step on the offload pool. Owns the ref that
+// DoHandshakerNextLocked()'s caller held for the step.
+void SecurityHandshaker::OffloadedHandshakerNext(
+    grpc_completion_queue_functor* functor, int /*success*/) {
+  ExecCtx exec_ctx;
+  OffloadFunctor* offload = static_cast<OffloadFunctor*>(functor);
+  SecurityHandshaker* h = offload->handshaker;
+  // An asynchronous handshaker may run its callback, which consumes the step's
+  // ref, before tsi_handshaker_next() returns here.
+  RefCountedPtr<SecurityHandshaker> self = h->Ref();
+  // The functor may be reused by the next step once tsi_handshaker_next()
+  // returns, so it is not touched afterwards.
+  const unsigned char* bytes_to_send = nullptr;
+  size_t bytes_to_send_size = 0;
+  tsi_handshaker_result* hs_result = nullptr;
+  tsi_result result = tsi_handshaker_next(
+      h->handshaker_, offload->bytes_received, offload->bytes_received_size,
+      &bytes_to_send, &bytes_to_send_size, &hs_result,
+      &OnHandshakeNextDoneGrpcWrapper, h);
+  {
+    MutexLock lock(&h->mu_);
+    if (result == TSI_ASYNC) h->handshaker_is_async_ = true;
+    if (--h->offloaded_steps_in_progress_ == 0 && h->is_shutdown_) {
+      tsi_handshaker_shutdown(h->handshaker_);
+    }
+  }
+  HandshakeOffloadPool::Get()->Release();
+  if (result != TSI_ASYNC) {
+    // Synchronous result: finish the step as if the handshaker had invoked
+    // its callback, which takes over the step's ref.
+    OnHandshakeNextDoneGrpcWrapper(result, h, bytes_to_send,
+                                   bytes_to_send_size, hs_result);
+  }
+}
+
 grpc_error_handle SecurityHandshaker::DoHandshakerNextLocked(
     const unsigned char* bytes_received, size_t bytes_received_size) {
+  if (offload_handshake_ && !handshaker_is_async_) {
+    // bytes_received points into handshake_buffer_, which is not touched again
+    // until the step completes and issues the next read.
+    offload_functor_.bytes_received = bytes_received;
+    offload_functor_.bytes_received_size = bytes_received_size;
+    ++offloaded_steps_in_progress_;
+    if (HandshakeOffloadPool::Get()->TryRun(&offload_functor_)) {
+      GRPC_STATS_INC_SECURITY_HANDSHAKE_OFFLOADED_STEPS();
+      return GRPC_ERROR_NONE;
+    }
+    --offloaded_steps_in_progress_;
+  }
   // Invoke TSI handshaker.
   const unsigned char* bytes_to_send = nullptr;
   size_t bytes_to_send_size = 0;
@@ -518,7 +715,7 @@ void SecurityHandshaker::Shutdown(grpc_error_handle why) {
   if (!is_shutdown_) {
     is_shutdown_ = true;
     connector_->cancel_check_peer(&on_peer_checked_, GRPC_ERROR_REF(why));
-    tsi_handshaker_shutdown(handshaker_);
+    if (offloaded_steps_in_progress_ == 0) tsi_handshaker_shutdown(handshaker_);
     grpc_endpoint_shutdown(args_->endpoint, GRPC_ERROR_REF(why));
     CleanupArgsForFailureLocked();
   }
@@ -530,6 +727,7 @@ void SecurityHandshaker::DoHandshake(grpc_tcp_server_acceptor* /*acceptor*/,
                                      HandshakerArgs* args) {
   auto ref = Ref();
   MutexLock lock(&mu_);
+  handshake_start_ = gpr_now(GPR_CLOCK_MONOTONIC);
   args_ = args;
   on_handshake_done_ = on_handshake_done;
   size_t bytes_received_size = MoveReadBufferIntoHandshakeBuffer();
@@ -624,6 +822,13 @@ RefCountedPtr<Handshaker> SecurityHandshakerCreate(
   }
 }
 
+void SecurityHandshakerInit() {
+  HandshakeOffloadPool::SetThreading(true);
+  Fork::RegisterSetThreadingFunc(HandshakeOffloadPool::SetThreading);
+}
+
+void SecurityHandshakerShutdown() { HandshakeOffloadPool::SetThreading(false); }
+
 void SecurityRegisterHandshakerFactories(CoreConfiguration::Builder* builder) {
   builder->handshaker_registry()->RegisterHandshakerFactory(
       false /* at_start */, HANDSHAKER_CLIENT,
@@ -35,6 +35,11 @@ RefCountedPtr<Handshaker> SecurityHandshakerCreate(
 /// Registers security handshaker factories.
 void SecurityRegisterHandshakerFactories(CoreConfiguration::Builder*);
 
+/// Starts and stops the threads that handshaker steps are offloaded to, at
+/// grpc_init() and grpc_shutdown(). They are also stopped around fork().
+void SecurityHandshakerInit();
+void SecurityHandshakerShutdown();
+
 }  // namespace grpc_core
 
 // TODO(arjunroy): This is transitional to account for the new handshaker API
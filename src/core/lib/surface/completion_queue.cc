@@ -24,6 +24,7 @@
 #include <string.h>
 
 #include <atomic>
+#include <memory>
 #include <vector>
 
 #include "absl/strings/str_format.h"
@@ -31,6 +32,7 @@
 
 #include <grpc/support/alloc.h>
 #include <grpc/support/atm.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
 #include <grpc/support/time.h>
@@ -215,34 +217,69 @@ namespace {
 /* Queue that holds the cq_completion_events. Internally uses
  * MultiProducerSingleConsumerQueue (a lockfree multiproducer single consumer
  * queue). It uses a queue_lock to support multiple consumers.
+ * With more than one shard (GRPC_CQ_SHARDED_EVENT_QUEUE), each shard is such a
+ * queue with its own queue_lock: events are pushed onto the shard of the
+ * producer's CPU, and consumers start at the shard of their own CPU and try
+ * every other shard before giving up, so that they don't all contend on the
+ * same queue_lock. Each shard also counts its own items, so that producers and
+ * consumers on different shards don't share a counter either.
  * Only used in completion queues whose completion_type is GRPC_CQ_NEXT */
 class CqEventQueue {
  public:
-  CqEventQueue() = default;
+  explicit CqEventQueue(size_t num_shards)
+      : num_shards_(num_shards),
+        sharded_(num_shards > 1 ? new Shard[num_shards] : nullptr),
+        shards_(num_shards > 1 ? sharded_.get() : &single_shard_) {}
   ~CqEventQueue() = default;
 
-  /* Note: The counter is not incremented/decremented atomically with push/pop.
-   * The count is only eventually consistent */
+  /* Note: The counters are not incremented/decremented atomically with
+   * push/pop. The count is only eventually consistent. It sums the counters of
+   * all shards, so it is kept off the push and pop paths. The loads are
+   * sequentially consistent: they pair with cq_next_data::num_waiters */
   intptr_t num_items() const {
-    return num_queue_items_.load(std::memory_order_relaxed);
+    intptr_t num_items = 0;
+    for (size_t i = 0; i < num_shards_; i++) {
+      num_items += shards_[i].num_items.load(std::memory_order_seq_cst);
+    }
+    return num_items;
   }
 
+  /* Returns true if the shard c was pushed onto was empty. Whenever the whole
+   * queue was, so was that shard */
   bool Push(grpc_cq_completion* c);
   grpc_cq_completion* Pop();
 
  private:
-  /* Spinlock to serialize consumers i.e pop() operations */
-  gpr_spinlock queue_lock_ = GPR_SPINLOCK_INITIALIZER;
+  struct Shard {
+    /* Spinlock to serialize consumers i.e pop() operations */
+    gpr_spinlock queue_lock = GPR_SPINLOCK_INITIALIZER;
+
+    grpc_core::MultiProducerSingleConsumerQueue queue;
 
-  grpc_core::MultiProducerSingleConsumerQueue queue_;
+    /* A lazy counter of number of items in the shard. This is NOT atomically
+       incremented/decremented along with push/pop operations and hence is
+       only eventually consistent */
+    std::atomic<intptr_t> num_items{0};
 
-  /* A lazy counter of number of items in the queue. This is NOT atomically
-     incremented/decremented along with push/pop operations and hence is only
-     eventually consistent */
-  std::atomic<intptr_t> num_queue_items_{0};
+    /* Keeps the consumer end of this shard and the producer end of the next
+       one off each other's cachelines */
+    char padding[GPR_CACHELINE_SIZE];
+  };
+
+  size_t CurrentShard() const {
+    return num_shards_ == 1 ? 0 : gpr_cpu_current_cpu() % num_shards_;
+  }
+
+  const size_t num_shards_;
+  /* The default single shard is kept inline, to avoid an extra allocation */
+  Shard single_shard_;
+  std::unique_ptr<Shard[]> sharded_;
+  Shard* const shards_;
 };
 
 struct cq_next_data {
+  explicit cq_next_data(size_t num_shards) : queue(num_shards) {}
+
   ~cq_next_data() {
     GPR_ASSERT(queue.num_items() == 0);
 #ifndef NDEBUG
@@ -263,6 +300,14 @@ struct cq_next_data {
       Initial count is dropped by grpc_completion_queue_shutdown */
   std::atomic<intptr_t> pending_events{1};
 
+  /** Number of threads in cq_next() that are about to poll or are polling.
+      A producer only needs to take the cq lock and kick the pollset when this
+      is non-zero. A waiter increments it before its last look at the queue,
+      and a producer reads it after pushing: with both sequentially
+      consistent, either the waiter sees the new item or the producer sees
+      the waiter */
+  std::atomic<intptr_t> num_waiters{0};
+
   /** 0 initially. 1 once we initiated shutdown */
   bool shutdown_called = false;
 };
@@ -397,6 +442,8 @@ static grpc_event cq_pluck(grpc_completion_queue* cq, void* tag,
 // Note that cq_init_next and cq_init_pluck do not use the shutdown_callback
 static void cq_init_next(void* data,
                          grpc_completion_queue_functor* shutdown_callback);
+static void cq_init_next_sharded(
+    void* data, grpc_completion_queue_functor* shutdown_callback);
 static void cq_init_pluck(void* data,
                           grpc_completion_queue_functor* shutdown_callback);
 static void cq_init_callback(void* data,
@@ -421,6 +468,13 @@ static const cq_vtable g_cq_vtable[] = {
      cq_end_op_for_callback, nullptr, nullptr},
 };
 
+/* Vtable for completion queues of type GRPC_CQ_NEXT created with a
+   GRPC_CQ_SHARDED_EVENT_QUEUE: only the event queue differs */
+static const cq_vtable g_sharded_next_cq_vtable = {
+    GRPC_CQ_NEXT,       sizeof(cq_next_data), cq_init_next_sharded,
+    cq_shutdown_next,   cq_destroy_next,      cq_begin_op_for_next,
+    cq_end_op_for_next, cq_next,              nullptr};
+
 #define DATA_FROM_CQ(cq) ((void*)((cq) + 1))
 #define POLLSET_FROM_CQ(cq) \
   ((grpc_pollset*)((cq)->vtable->data_size + (char*)DATA_FROM_CQ(cq)))
@@ -439,7 +493,25 @@ grpc_core::TraceFlag grpc_cq_pluck_trace(false, "queue_pluck");
 
 static void on_pollset_shutdown_done(void* arg, grpc_error_handle error);
 
-void grpc_cq_global_init() {}
+GPR_GLOBAL_CONFIG_DEFINE_BOOL(
+    grpc_cq_sharded_event_queue, false,
+    "If set, completion queues of type GRPC_CQ_NEXT keep one event queue per "
+    "CPU, so that many threads can call grpc_completion_queue_next() on one "
+    "completion queue without contending on a single queue. Events completed "
+    "on different CPUs may then be returned out of completion order.");
+
+static grpc_cq_event_queue_type g_default_event_queue_type =
+    GRPC_CQ_SINGLE_EVENT_QUEUE;
+
+void grpc_cq_global_init() {
+  g_default_event_queue_type = GPR_GLOBAL_CONFIG_GET(grpc_cq_sharded_event_queue)
+                                   ? GRPC_CQ_SHARDED_EVENT_QUEUE
+                                   : GRPC_CQ_SINGLE_EVENT_QUEUE;
+}
+
+grpc_cq_event_queue_type grpc_cq_default_event_queue_type() {
+  return g_default_event_queue_type;
+}
 
 void grpc_completion_queue_thread_local_cache_init(grpc_completion_queue* cq) {
   if (g_cached_cq == nullptr) {
@@ -474,30 +546,38 @@ int grpc_completion_queue_thread_local_cache_flush(grpc_completion_queue* cq,
 }
 
 bool CqEventQueue::Push(grpc_cq_completion* c) {
-  queue_.Push(
+  Shard* shard = &shards_[CurrentShard()];
+  shard->queue.Push(
       reinterpret_cast<grpc_core::MultiProducerSingleConsumerQueue::Node*>(c));
-  return num_queue_items_.fetch_add(1, std::memory_order_relaxed) == 0;
+  return shard->num_items.fetch_add(1, std::memory_order_seq_cst) == 0;
 }
 
 grpc_cq_completion* CqEventQueue::Pop() {
   grpc_cq_completion* c = nullptr;
 
-  if (gpr_spinlock_trylock(&queue_lock_)) {
-    GRPC_STATS_INC_CQ_EV_QUEUE_TRYLOCK_SUCCESSES();
+  size_t shard_index = CurrentShard();
+  for (size_t i = 0; i < num_shards_ && c == nullptr; i++) {
+    Shard* shard = &shards_[shard_index];
+    if (++shard_index == num_shards_) shard_index = 0;
 
-    bool is_empty = false;
-    c = reinterpret_cast<grpc_cq_completion*>(queue_.PopAndCheckEnd(&is_empty));
-    gpr_spinlock_unlock(&queue_lock_);
+    if (gpr_spinlock_trylock(&shard->queue_lock)) {
+      GRPC_STATS_INC_CQ_EV_QUEUE_TRYLOCK_SUCCESSES();
 
-    if (c == nullptr && !is_empty) {
-      GRPC_STATS_INC_CQ_EV_QUEUE_TRANSIENT_POP_FAILURES();
-    }
-  } else {
-    GRPC_STATS_INC_CQ_EV_QUEUE_TRYLOCK_FAILURES();
-  }
+      bool is_empty = false;
+      c = reinterpret_cast<grpc_cq_completion*>(
+          shard->queue.PopAndCheckEnd(&is_empty));
+      gpr_spinlock_unlock(&shard->queue_lock);
 
-  if (c) {
-    num_queue_items_.fetch_sub(1, std::memory_order_relaxed);
+      if (c) {
+        shard->num_items.fetch_sub(1, std::memory_order_relaxed);
+      }
+
+      if (c == nullptr && !is_empty) {
+        GRPC_STATS_INC_CQ_EV_QUEUE_TRANSIENT_POP_FAILURES();
+      }
+    } else {
+      GRPC_STATS_INC_CQ_EV_QUEUE_TRYLOCK_FAILURES();
+    }
   }
 
   return c;
@@ -505,17 +585,22 @@ grpc_cq_completion* CqEventQueue::Pop() {
 
 grpc_completion_queue* grpc_completion_queue_create_internal(
     grpc_cq_completion_type completion_type, grpc_cq_polling_type polling_type,
-    grpc_completion_queue_functor* shutdown_callback) {
+    grpc_completion_queue_functor* shutdown_callback,
+    grpc_cq_event_queue_type event_queue_type) {
   GPR_TIMER_SCOPE("grpc_completion_queue_create_internal", 0);
 
   grpc_completion_queue* cq;
 
   GRPC_API_TRACE(
       "grpc_completion_queue_create_internal(completion_type=%d, "
-      "polling_type=%d)",
-      2, (completion_type, polling_type));
-
-  const cq_vtable* vtable = &g_cq_vtable[completion_type];
+      "polling_type=%d, event_queue_type=%d)",
+      3, (completion_type, polling_type, event_queue_type));
+
+  const cq_vtable* vtable =
+      completion_type == GRPC_CQ_NEXT &&
+              event_queue_type == GRPC_CQ_SHARDED_EVENT_QUEUE
+          ? &g_sharded_next_cq_vtable
+          : &g_cq_vtable[completion_type];
   const cq_poller_vtable* poller_vtable =
       &g_poller_vtable_by_poller_type[polling_type];
 
@@ -542,7 +627,12 @@ grpc_completion_queue* grpc_completion_queue_create_internal(
 
 static void cq_init_next(void* data,
                          grpc_completion_queue_functor* /*shutdown_callback*/) {
-  new (data) cq_next_data();
+  new (data) cq_next_data(1);
+}
+
+static void cq_init_next_sharded(
+    void* data, grpc_completion_queue_functor* /*shutdown_callback*/) {
+  new (data) cq_next_data(gpr_cpu_num_cores());
 }
 
 static void cq_destroy_next(void* data) {
@@ -722,8 +812,9 @@ static void cq_end_op_for_next(
        (done via pending_events.fetch_sub(1, ACQ_REL)) in cq_shutdown_next
        */
     if (cqd->pending_events.load(std::memory_order_acquire) != 1) {
-      /* Only kick if this is the first item queued */
-      if (is_first) {
+      /* Only kick if this is the first item queued and someone may be
+         waiting for it */
+      if (is_first && cqd->num_waiters.load(std::memory_order_seq_cst) > 0) {
         gpr_mu_lock(cq->mu);
         grpc_error_handle kick_error =
             cq->poller_vtable->kick(POLLSET_FROM_CQ(cq), nullptr);
@@ -1044,8 +1135,15 @@ static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
     /* The main polling work happens in grpc_pollset_work */
     gpr_mu_lock(cq->mu);
     cq->num_polls++;
+    cqd->num_waiters.fetch_add(1, std::memory_order_seq_cst);
+    /* An item pushed before num_waiters was raised didn't kick: don't wait
+       for it */
+    if (cqd->queue.num_items() > 0) {
+      iteration_deadline = 0;
+    }
     grpc_error_handle err = cq->poller_vtable->work(
         POLLSET_FROM_CQ(cq), nullptr, iteration_deadline);
+    cqd->num_waiters.fetch_sub(1, std::memory_order_relaxed);
     gpr_mu_unlock(cq->mu);
 
     if (err != GRPC_ERROR_NONE) {
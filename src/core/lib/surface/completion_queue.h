@@ -26,6 +26,7 @@
 #include <grpc/grpc.h>
 
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/gprpp/manual_constructor.h"
 #include "src/core/lib/iomgr/pollset.h"
 
@@ -36,6 +37,18 @@ extern grpc_core::TraceFlag grpc_trace_operation_failures;
 extern grpc_core::DebugOnlyTraceFlag grpc_trace_pending_tags;
 extern grpc_core::DebugOnlyTraceFlag grpc_trace_cq_refcount;
 
+GPR_GLOBAL_CONFIG_DECLARE_BOOL(grpc_cq_sharded_event_queue);
+
+/* Specifies how a completion queue of type GRPC_CQ_NEXT holds completed events
+   until grpc_completion_queue_next() returns them. Ignored for other types */
+typedef enum {
+  /* A single queue, which one thread at a time can pop from */
+  GRPC_CQ_SINGLE_EVENT_QUEUE,
+  /* One queue per CPU. Events are queued on the queue of the CPU they were
+     completed on, and may be returned out of completion order */
+  GRPC_CQ_SHARDED_EVENT_QUEUE
+} grpc_cq_event_queue_type;
+
 typedef struct grpc_cq_completion {
   grpc_core::ManualConstructor<grpc_core::MultiProducerSingleConsumerQueue>
       node;
@@ -91,8 +104,14 @@ grpc_cq_completion_type grpc_get_cq_completion_type(grpc_completion_queue* cq);
 
 int grpc_get_cq_poll_num(grpc_completion_queue* cq);
 
+/* The event queue type of the completion queues created through the public
+   API: sharded if the grpc_cq_sharded_event_queue global config was set when
+   grpc was first initialized */
+grpc_cq_event_queue_type grpc_cq_default_event_queue_type();
+
 grpc_completion_queue* grpc_completion_queue_create_internal(
     grpc_cq_completion_type completion_type, grpc_cq_polling_type polling_type,
-    grpc_completion_queue_functor* shutdown_callback);
+    grpc_completion_queue_functor* shutdown_callback,
+    grpc_cq_event_queue_type event_queue_type);
 
 #endif /* GRPC_CORE_LIB_SURFACE_COMPLETION_QUEUE_H */
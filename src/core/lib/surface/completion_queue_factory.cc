@@ -32,7 +32,8 @@ static grpc_completion_queue* default_create(
     const grpc_completion_queue_factory* /*factory*/,
     const grpc_completion_queue_attributes* attr) {
   return grpc_completion_queue_create_internal(
-      attr->cq_completion_type, attr->cq_polling_type, attr->cq_shutdown_cb);
+      attr->cq_completion_type, attr->cq_polling_type, attr->cq_shutdown_cb,
+      grpc_cq_default_event_queue_type());
 }
 
 static grpc_completion_queue_factory_vtable default_vtable = {default_create};
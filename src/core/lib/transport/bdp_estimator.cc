@@ -37,6 +37,7 @@ BdpEstimator::BdpEstimator(const char* name)
       inter_ping_delay_(100),  // start at 100ms
       stable_estimate_count_(0),
       bw_est_(0),
+      rtt_est_(0),
       name_(name) {}
 
 grpc_millis BdpEstimator::CompletePing() {
@@ -45,6 +46,8 @@ grpc_millis BdpEstimator::CompletePing() {
   double dt = static_cast<double>(dt_ts.tv_sec) +
               1e-9 * static_cast<double>(dt_ts.tv_nsec);
   double bw = dt > 0 ? (static_cast<double>(accumulator_) / dt) : 0;
+  // same smoothing as TCP's SRTT
+  rtt_est_ = rtt_est_ == 0 ? dt : 0.875 * rtt_est_ + 0.125 * dt;
   int start_inter_ping_delay = inter_ping_delay_;
   if (GRPC_TRACE_FLAG_ENABLED(grpc_bdp_estimator_trace)) {
     gpr_log(GPR_INFO,
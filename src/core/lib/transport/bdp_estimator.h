@@ -42,6 +42,8 @@ class BdpEstimator {
 
   int64_t EstimateBdp() const { return estimate_; }
   double EstimateBandwidth() const { return bw_est_; }
+  // Smoothed round trip time of the BDP pings, in seconds (0 if unknown)
+  double EstimateRtt() const { return rtt_est_; }
 
   void AddIncomingBytes(int64_t num_bytes) { accumulator_ += num_bytes; }
 
@@ -87,6 +89,7 @@ class BdpEstimator {
   int inter_ping_delay_;
   int stable_estimate_count_;
   double bw_est_;
+  double rtt_est_;
   const char* name_;
 };
 
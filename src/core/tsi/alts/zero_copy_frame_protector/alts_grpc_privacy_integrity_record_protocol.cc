@@ -20,6 +20,10 @@
 
 #include "src/core/tsi/alts/zero_copy_frame_protector/alts_grpc_privacy_integrity_record_protocol.h"
 
+#include <string.h>
+
+#include <algorithm>
+
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
@@ -69,6 +73,89 @@ static tsi_result alts_grpc_privacy_integrity_protect(
   return TSI_OK;
 }
 
+/* Points rp->iovec_buf at the length bytes of sb starting at the given slice
+ * index and offset, and moves that position past them. Returns the number of
+ * iovecs used, at most one per slice of sb.  */
+static size_t point_iovec_buf_at(alts_grpc_record_protocol* rp,
+                                 grpc_slice_buffer* sb,
+                                 size_t* slice_index, size_t* slice_offset,
+                                 size_t length) {
+  size_t iovec_count = 0;
+  while (length > 0) {
+    grpc_slice& slice = sb->slices[*slice_index];
+    size_t slice_length =
+        std::min(GRPC_SLICE_LENGTH(slice) - *slice_offset, length);
+    if (slice_length > 0) {
+      rp->iovec_buf[iovec_count].iov_base =
+          GRPC_SLICE_START_PTR(slice) + *slice_offset;
+      rp->iovec_buf[iovec_count].iov_len = slice_length;
+      iovec_count++;
+    }
+    length -= slice_length;
+    *slice_offset += slice_length;
+    if (*slice_offset == GRPC_SLICE_LENGTH(slice)) {
+      (*slice_index)++;
+      *slice_offset = 0;
+    }
+  }
+  return iovec_count;
+}
+
+/* Seals the whole of unprotected_slices as consecutive frames. All frames are
+ * written into a single output slice, and each frame's plaintext iovecs point
+ * straight into the input slices, so no staging slice buffer or per-frame
+ * allocation is needed.  */
+static tsi_result alts_grpc_privacy_integrity_protect_frames(
+    alts_grpc_record_protocol* rp, grpc_slice_buffer* unprotected_slices,
+    size_t max_unprotected_data_size, grpc_slice_buffer* protected_slices) {
+  /* Input sanity check.  */
+  if (rp == nullptr || unprotected_slices == nullptr ||
+      protected_slices == nullptr || max_unprotected_data_size == 0) {
+    gpr_log(GPR_ERROR,
+            "Invalid arguments to alts_grpc_record_protocol protect frames.");
+    return TSI_INVALID_ARGUMENT;
+  }
+  /* Empty data still produces one (empty) frame, as protect() does.  */
+  size_t data_length = unprotected_slices->length;
+  size_t num_frames =
+      data_length == 0
+          ? 1
+          : (data_length + max_unprotected_data_size - 1) /
+                max_unprotected_data_size;
+  size_t frame_overhead = rp->header_length + rp->tag_length;
+  grpc_slice protected_slice =
+      GRPC_SLICE_MALLOC(data_length + num_frames * frame_overhead);
+  unsigned char* protected_ptr = GRPC_SLICE_START_PTR(protected_slice);
+  /* A frame never spans more input slices than the slice buffer holds.  */
+  alts_grpc_record_protocol_ensure_iovec_buf_size(rp, unprotected_slices);
+  size_t slice_index = 0;
+  size_t slice_offset = 0;
+  for (size_t frame = 0; frame < num_frames; frame++) {
+    size_t frame_data_length = std::min(data_length, max_unprotected_data_size);
+    size_t iovec_count = point_iovec_buf_at(rp, unprotected_slices,
+                                            &slice_index, &slice_offset,
+                                            frame_data_length);
+    iovec_t protected_iovec = {protected_ptr,
+                               frame_data_length + frame_overhead};
+    char* error_details = nullptr;
+    grpc_status_code status =
+        alts_iovec_record_protocol_privacy_integrity_protect(
+            rp->iovec_rp, rp->iovec_buf, iovec_count, protected_iovec,
+            &error_details);
+    if (status != GRPC_STATUS_OK) {
+      gpr_log(GPR_ERROR, "Failed to protect, %s", error_details);
+      gpr_free(error_details);
+      grpc_slice_unref_internal(protected_slice);
+      return TSI_INTERNAL_ERROR;
+    }
+    protected_ptr += protected_iovec.iov_len;
+    data_length -= frame_data_length;
+  }
+  grpc_slice_buffer_add(protected_slices, protected_slice);
+  grpc_slice_buffer_reset_and_unref_internal(unprotected_slices);
+  return TSI_OK;
+}
+
 static tsi_result alts_grpc_privacy_integrity_unprotect(
     alts_grpc_record_protocol* rp, grpc_slice_buffer* protected_slices,
     grpc_slice_buffer* unprotected_slices) {
@@ -115,10 +202,111 @@ static tsi_result alts_grpc_privacy_integrity_unprotect(
   return TSI_OK;
 }
 
+/* Copies the frame header at the given position of sb into rp->header_buf,
+ * moves the position past it and returns the total size of the frame it
+ * starts, length field included.  */
+static size_t read_frame_header(alts_grpc_record_protocol* rp,
+                                grpc_slice_buffer* sb,
+                                size_t* slice_index, size_t* slice_offset) {
+  size_t iovec_count = point_iovec_buf_at(rp, sb, slice_index, slice_offset,
+                                          rp->header_length);
+  unsigned char* dst = rp->header_buf;
+  for (size_t i = 0; i < iovec_count; i++) {
+    memcpy(dst, rp->iovec_buf[i].iov_base, rp->iovec_buf[i].iov_len);
+    dst += rp->iovec_buf[i].iov_len;
+  }
+  /* Gets little-endian frame length.  */
+  uint32_t frame_length = (static_cast<uint32_t>(rp->header_buf[3]) << 24) |
+                          (static_cast<uint32_t>(rp->header_buf[2]) << 16) |
+                          (static_cast<uint32_t>(rp->header_buf[1]) << 8) |
+                          static_cast<uint32_t>(rp->header_buf[0]);
+  return frame_length + kZeroCopyFrameLengthFieldSize;
+}
+
+/* Opens the full frames in the first protected_length bytes of
+ * protected_slices into a single output slice. The ciphertext iovecs of each
+ * frame point straight into the input slices and only the frame headers are
+ * copied, so no staging slice buffer or per-frame allocation is needed.  */
+static tsi_result alts_grpc_privacy_integrity_unprotect_frames(
+    alts_grpc_record_protocol* rp, grpc_slice_buffer* protected_slices,
+    size_t protected_length, grpc_slice_buffer* unprotected_slices) {
+  /* Input sanity check.  */
+  if (rp == nullptr || protected_slices == nullptr ||
+      unprotected_slices == nullptr ||
+      protected_length > protected_slices->length) {
+    gpr_log(GPR_ERROR,
+            "Invalid arguments to alts_grpc_record_protocol unprotect frames.");
+    return TSI_INVALID_ARGUMENT;
+  }
+  /* A frame never spans more input slices than the slice buffer holds.  */
+  alts_grpc_record_protocol_ensure_iovec_buf_size(rp, protected_slices);
+  /* Walks the frame headers first to size the output.  */
+  size_t frame_overhead = rp->header_length + rp->tag_length;
+  size_t unprotected_length = 0;
+  size_t slice_index = 0;
+  size_t slice_offset = 0;
+  for (size_t offset = 0; offset < protected_length;) {
+    if (protected_length - offset < frame_overhead) {
+      gpr_log(GPR_ERROR, "Protected slices do not have sufficient data.");
+      return TSI_INVALID_ARGUMENT;
+    }
+    size_t frame_length =
+        read_frame_header(rp, protected_slices, &slice_index, &slice_offset);
+    if (frame_length < frame_overhead ||
+        frame_length > protected_length - offset) {
+      gpr_log(GPR_ERROR, "Bad frame length.");
+      return TSI_DATA_CORRUPTED;
+    }
+    point_iovec_buf_at(rp, protected_slices, &slice_index, &slice_offset,
+                       frame_length - rp->header_length);
+    unprotected_length += frame_length - frame_overhead;
+    offset += frame_length;
+  }
+  grpc_slice unprotected_slice = GRPC_SLICE_MALLOC(unprotected_length);
+  unsigned char* unprotected_ptr = GRPC_SLICE_START_PTR(unprotected_slice);
+  slice_index = 0;
+  slice_offset = 0;
+  for (size_t offset = 0; offset < protected_length;) {
+    size_t frame_length =
+        read_frame_header(rp, protected_slices, &slice_index, &slice_offset);
+    iovec_t header_iovec = {rp->header_buf, rp->header_length};
+    iovec_t unprotected_iovec = {unprotected_ptr,
+                                 frame_length - frame_overhead};
+    size_t iovec_count =
+        point_iovec_buf_at(rp, protected_slices, &slice_index, &slice_offset,
+                           frame_length - rp->header_length);
+    char* error_details = nullptr;
+    grpc_status_code status =
+        alts_iovec_record_protocol_privacy_integrity_unprotect(
+            rp->iovec_rp, header_iovec, rp->iovec_buf, iovec_count,
+            unprotected_iovec, &error_details);
+    if (status != GRPC_STATUS_OK) {
+      gpr_log(GPR_ERROR, "Failed to unprotect, %s", error_details);
+      gpr_free(error_details);
+      grpc_slice_unref_internal(unprotected_slice);
+      return TSI_INTERNAL_ERROR;
+    }
+    unprotected_ptr += unprotected_iovec.iov_len;
+    offset += frame_length;
+  }
+  if (protected_length == protected_slices->length) {
+    grpc_slice_buffer_reset_and_unref_internal(protected_slices);
+  } else {
+    grpc_slice_buffer_reset_and_unref_internal(&rp->header_sb);
+    grpc_slice_buffer_move_first(protected_slices, protected_length,
+                                 &rp->header_sb);
+    grpc_slice_buffer_reset_and_unref_internal(&rp->header_sb);
+  }
+  grpc_slice_buffer_add(unprotected_slices, unprotected_slice);
+  return TSI_OK;
+}
+
 static const alts_grpc_record_protocol_vtable
     alts_grpc_privacy_integrity_record_protocol_vtable = {
         alts_grpc_privacy_integrity_protect,
-        alts_grpc_privacy_integrity_unprotect, nullptr};
+        alts_grpc_privacy_integrity_unprotect, nullptr,
+        alts_grpc_privacy_integrity_protect_frames,
+        alts_grpc_privacy_integrity_unprotect_frames};
 
 tsi_result alts_grpc_privacy_integrity_record_protocol_create(
     gsec_aead_crypter* crypter, size_t overflow_size, bool is_client,
@@ -50,6 +50,28 @@ tsi_result alts_grpc_record_protocol_protect(
     alts_grpc_record_protocol* self, grpc_slice_buffer* unprotected_slices,
     grpc_slice_buffer* protected_slices);
 
+/**
+ * This method protects unprotected data as a sequence of frames, each carrying
+ * at most max_unprotected_data_size bytes, and appends the protected frames to
+ * protected_slices. The result is the same as calling
+ * alts_grpc_record_protocol_protect() once per frame, but an implementation
+ * may seal all frames in a single pass into one output buffer. The input
+ * unprotected data slice buffer will be cleared.
+ *
+ * - self: an alts_grpc_record_protocol instance.
+ * - unprotected_slices: the unprotected data to be protected.
+ * - max_unprotected_data_size: maximum number of data bytes per frame, as
+ *   returned by alts_grpc_record_protocol_max_unprotected_data_size().
+ * - protected_slices: slice buffer where the protected frames are appended.
+ *
+ * This method returns TSI_OK in case of success, TSI_UNIMPLEMENTED if the
+ * record protocol has no multi-frame path (the caller should then protect
+ * frame by frame), or a specific error code in case of failure.
+ */
+tsi_result alts_grpc_record_protocol_protect_frames(
+    alts_grpc_record_protocol* self, grpc_slice_buffer* unprotected_slices,
+    size_t max_unprotected_data_size, grpc_slice_buffer* protected_slices);
+
 /**
  * This methods performs unprotect operation on a full frame of protected data
  * and appends unprotected data to unprotected_slices. It is the caller's
@@ -68,6 +90,28 @@ tsi_result alts_grpc_record_protocol_unprotect(
     alts_grpc_record_protocol* self, grpc_slice_buffer* protected_slices,
     grpc_slice_buffer* unprotected_slices);
 
+/**
+ * This method unprotects the full frames making up the first protected_length
+ * bytes of protected_slices, removes those bytes from protected_slices and
+ * appends the unprotected data of all frames to unprotected_slices. The result
+ * is the same as calling alts_grpc_record_protocol_unprotect() once per frame,
+ * but an implementation may open all frames in a single pass into one output
+ * buffer. Any bytes after the first protected_length are left in place.
+ *
+ * - self: an alts_grpc_record_protocol instance.
+ * - protected_slices: protected data starting with one or more full frames.
+ * - protected_length: total size of the full frames to unprotect.
+ * - unprotected_slices: slice buffer where unprotected data is appended.
+ *
+ * This method returns TSI_OK in case of success, TSI_UNIMPLEMENTED if the
+ * record protocol has no multi-frame path (the caller should then unprotect
+ * frame by frame; protected_slices is left untouched), or a specific error
+ * code in case of failure.
+ */
+tsi_result alts_grpc_record_protocol_unprotect_frames(
+    alts_grpc_record_protocol* self, grpc_slice_buffer* protected_slices,
+    size_t protected_length, grpc_slice_buffer* unprotected_slices);
+
 /**
  * This method returns maximum allowed unprotected data size, given maximum
  * protected frame size.
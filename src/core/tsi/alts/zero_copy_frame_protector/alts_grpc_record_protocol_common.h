@@ -39,6 +39,14 @@ struct alts_grpc_record_protocol_vtable {
                           grpc_slice_buffer* protected_slices,
                           grpc_slice_buffer* unprotected_slices);
   void (*destruct)(alts_grpc_record_protocol* self);
+  tsi_result (*protect_frames)(alts_grpc_record_protocol* self,
+                               grpc_slice_buffer* unprotected_slices,
+                               size_t max_unprotected_data_size,
+                               grpc_slice_buffer* protected_slices);
+  tsi_result (*unprotect_frames)(alts_grpc_record_protocol* self,
+                                 grpc_slice_buffer* protected_slices,
+                                 size_t protected_length,
+                                 grpc_slice_buffer* unprotected_slices);
 };
 /* Main struct for alts_grpc_record_protocol implementation, shared by both
  * integrity-only record protocol and privacy-integrity record protocol.
@@ -55,6 +63,13 @@ struct alts_grpc_record_protocol {
   size_t iovec_buf_length;
 };
 
+/**
+ * Makes sure rp->iovec_buf has room for at least one iovec_t per slice of the
+ * input sb.
+ */
+void alts_grpc_record_protocol_ensure_iovec_buf_size(
+    alts_grpc_record_protocol* rp, const grpc_slice_buffer* sb);
+
 /**
  * Converts the slices of input sb into iovec_t's and puts the result into
  * rp->iovec_buf. Note that the actual data are not copied, only
@@ -22,6 +22,8 @@
 
 #include <string.h>
 
+#include <algorithm>
+
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
@@ -59,31 +61,31 @@ typedef struct alts_zero_copy_grpc_protector {
 } alts_zero_copy_grpc_protector;
 
 /**
- * Given a slice buffer, parses the first 4 bytes little-endian unsigned frame
- * size and returns the total frame size including the frame field. Caller
- * needs to make sure the input slice buffer has at least 4 bytes. Returns true
- * on success and false on failure.
+ * Given a slice buffer, parses the 4 bytes little-endian unsigned frame size
+ * found offset bytes into it and returns the total frame size including the
+ * frame field. Caller needs to make sure the input slice buffer has at least
+ * offset + 4 bytes. Returns true on success and false on failure.
  */
-static bool read_frame_size(const grpc_slice_buffer* sb,
+static bool read_frame_size(const grpc_slice_buffer* sb, size_t offset,
                             uint32_t* total_frame_size) {
-  if (sb == nullptr || sb->length < kZeroCopyFrameLengthFieldSize) {
+  if (sb == nullptr || sb->length < offset + kZeroCopyFrameLengthFieldSize) {
     return false;
   }
   uint8_t frame_size_buffer[kZeroCopyFrameLengthFieldSize];
   uint8_t* buf = frame_size_buffer;
-  /* Copies the first 4 bytes to a temporary buffer.  */
+  /* Copies the 4 bytes at offset to a temporary buffer.  */
   size_t remaining = kZeroCopyFrameLengthFieldSize;
-  for (size_t i = 0; i < sb->count; i++) {
+  for (size_t i = 0; i < sb->count && remaining > 0; i++) {
     size_t slice_length = GRPC_SLICE_LENGTH(sb->slices[i]);
-    if (remaining <= slice_length) {
-      memcpy(buf, GRPC_SLICE_START_PTR(sb->slices[i]), remaining);
-      remaining = 0;
-      break;
-    } else {
-      memcpy(buf, GRPC_SLICE_START_PTR(sb->slices[i]), slice_length);
-      buf += slice_length;
-      remaining -= slice_length;
+    if (offset >= slice_length) {
+      offset -= slice_length;
+      continue;
     }
+    size_t length = std::min(slice_length - offset, remaining);
+    memcpy(buf, GRPC_SLICE_START_PTR(sb->slices[i]) + offset, length);
+    buf += length;
+    remaining -= length;
+    offset = 0;
   }
   GPR_ASSERT(remaining == 0);
   /* Gets little-endian frame size.  */
@@ -156,6 +158,13 @@ static tsi_result alts_zero_copy_grpc_protector_protect(
   }
   alts_zero_copy_grpc_protector* protector =
       reinterpret_cast<alts_zero_copy_grpc_protector*>(self);
+  /* Seals all frames in one pass if the record protocol supports it.  */
+  tsi_result result = alts_grpc_record_protocol_protect_frames(
+      protector->record_protocol, unprotected_slices,
+      protector->max_unprotected_data_size, protected_slices);
+  if (result != TSI_UNIMPLEMENTED) {
+    return result;
+  }
   /* Calls alts_grpc_record_protocol protect repeatly.  */
   while (unprotected_slices->length > protector->max_unprotected_data_size) {
     grpc_slice_buffer_move_first(unprotected_slices,
@@ -184,11 +193,36 @@ static tsi_result alts_zero_copy_grpc_protector_unprotect(
   alts_zero_copy_grpc_protector* protector =
       reinterpret_cast<alts_zero_copy_grpc_protector*>(self);
   grpc_slice_buffer_move_into(protected_slices, &protector->protected_sb);
+  /* Opens all full frames in one pass if the record protocol supports it.  */
+  size_t frames_length = 0;
+  uint32_t frame_size;
+  while (protector->protected_sb.length - frames_length >=
+         kZeroCopyFrameLengthFieldSize) {
+    if (!read_frame_size(&protector->protected_sb, frames_length,
+                         &frame_size)) {
+      grpc_slice_buffer_reset_and_unref_internal(&protector->protected_sb);
+      return TSI_DATA_CORRUPTED;
+    }
+    if (protector->protected_sb.length - frames_length < frame_size) break;
+    frames_length += frame_size;
+  }
+  if (frames_length > 0) {
+    tsi_result status = alts_grpc_record_protocol_unprotect_frames(
+        protector->unrecord_protocol, &protector->protected_sb, frames_length,
+        unprotected_slices);
+    if (status != TSI_UNIMPLEMENTED) {
+      protector->parsed_frame_size = 0;
+      if (status != TSI_OK) {
+        grpc_slice_buffer_reset_and_unref_internal(&protector->protected_sb);
+      }
+      return status;
+    }
+  }
   /* Keep unprotecting each frame if possible.  */
   while (protector->protected_sb.length >= kZeroCopyFrameLengthFieldSize) {
     if (protector->parsed_frame_size == 0) {
       /* We have not parsed frame size yet. Parses frame size.  */
-      if (!read_frame_size(&protector->protected_sb,
+      if (!read_frame_size(&protector->protected_sb, 0,
                            &protector->parsed_frame_size)) {
         grpc_slice_buffer_reset_and_unref_internal(&protector->protected_sb);
         return TSI_DATA_CORRUPTED;
@@ -97,7 +97,9 @@ const tsi_handshaker_result_vtable result_vtable = {
     nullptr, /* handshaker_result_create_zero_copy_grpc_protector */
     nullptr, /* handshaker_result_create_frame_protector */
     handshaker_result_get_unused_bytes,
-    handshaker_result_destroy};
+    handshaker_result_destroy,
+    nullptr, /* handshaker_result_get_ktls_crypto_info */
+};
 
 tsi_result create_handshaker_result(bool is_client,
                                     const unsigned char* received_bytes,
@@ -20,6 +20,8 @@
 
 #include "src/core/tsi/ssl/session_cache/ssl_session_cache.h"
 
+#include <functional>
+
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
 
@@ -52,6 +54,7 @@ class SslSessionLRUCache::Node {
 
  private:
   friend class SslSessionLRUCache;
+  friend class SslSessionLRUCache::Shard;
 
   std::string key_;
   std::unique_ptr<SslCachedSession> session_;
@@ -60,25 +63,117 @@ class SslSessionLRUCache::Node {
   Node* prev_ = nullptr;
 };
 
-SslSessionLRUCache::SslSessionLRUCache(size_t capacity) : capacity_(capacity) {
+namespace {
+
+// Each shard holds at least this many sessions, so caches of fewer than twice
+// as many are kept in a single shard and keep exact LRU semantics.
+constexpr size_t kMinShardCapacity = 64;
+constexpr size_t kMaxShards = 16;
+
+}  // namespace
+
+/// Independently locked part of the cache holding the keys that hash to it.
+class SslSessionLRUCache::Shard {
+ public:
+  explicit Shard(size_t capacity) : capacity_(capacity) {
+    GPR_ASSERT(capacity > 0);
+  }
+  ~Shard();
+
+  // Not copyable nor movable.
+  Shard(const Shard&) = delete;
+  Shard& operator=(const Shard&) = delete;
+
+  size_t Size();
+  void Put(const std::string& key, SslSessionPtr session);
+  SslSessionPtr Get(const std::string& key);
+  void Clear();
+
+ private:
+  Node* FindLocked(const std::string& key);
+  void Remove(Node* node);
+  void PushFront(Node* node);
+  void AssertInvariants();
+
+  grpc_core::Mutex lock_;
+  size_t capacity_;
+
+  Node* use_order_list_head_ = nullptr;
+  Node* use_order_list_tail_ = nullptr;
+  size_t use_order_list_size_ = 0;
+  std::map<std::string, Node*> entry_by_key_;
+};
+
+SslSessionLRUCache::SslSessionLRUCache(size_t capacity) {
   GPR_ASSERT(capacity > 0);
+  size_t num_shards = capacity / kMinShardCapacity;
+  if (num_shards < 1) num_shards = 1;
+  if (num_shards > kMaxShards) num_shards = kMaxShards;
+  shards_.reserve(num_shards);
+  for (size_t i = 0; i < num_shards; ++i) {
+    // Spread the remainder over the first shards so that the total capacity
+    // is exactly the requested one.
+    size_t shard_capacity =
+        capacity / num_shards + (i < capacity % num_shards ? 1 : 0);
+    shards_.emplace_back(new Shard(shard_capacity));
+  }
+}
+
+SslSessionLRUCache::~SslSessionLRUCache() = default;
+
+SslSessionLRUCache::Shard* SslSessionLRUCache::ShardForKey(
+    const std::string& key) {
+  if (shards_.size() == 1) return shards_[0].get();
+  size_t hash = std::hash<std::string>()(key);
+  return shards_[hash % shards_.size()].get();
 }
 
-SslSessionLRUCache::~SslSessionLRUCache() {
+size_t SslSessionLRUCache::Size() {
+  size_t size = 0;
+  for (const auto& shard : shards_) {
+    size += shard->Size();
+  }
+  return size;
+}
+
+void SslSessionLRUCache::Put(const char* key, SslSessionPtr session) {
+  std::string key_str(key);
+  ShardForKey(key_str)->Put(key_str, std::move(session));
+}
+
+SslSessionPtr SslSessionLRUCache::Get(const char* key) {
+  std::string key_str(key);
+  return ShardForKey(key_str)->Get(key_str);
+}
+
+void SslSessionLRUCache::Clear() {
+  for (const auto& shard : shards_) {
+    shard->Clear();
+  }
+}
+
+SslSessionLRUCache::Shard::~Shard() { Clear(); }
+
+void SslSessionLRUCache::Shard::Clear() {
+  grpc_core::MutexLock lock(&lock_);
   Node* node = use_order_list_head_;
   while (node) {
     Node* next = node->next_;
     delete node;
     node = next;
   }
+  use_order_list_head_ = nullptr;
+  use_order_list_tail_ = nullptr;
+  use_order_list_size_ = 0;
+  entry_by_key_.clear();
 }
 
-size_t SslSessionLRUCache::Size() {
+size_t SslSessionLRUCache::Shard::Size() {
   grpc_core::MutexLock lock(&lock_);
   return use_order_list_size_;
 }
 
-SslSessionLRUCache::Node* SslSessionLRUCache::FindLocked(
+SslSessionLRUCache::Node* SslSessionLRUCache::Shard::FindLocked(
     const std::string& key) {
   auto it = entry_by_key_.find(key);
   if (it == entry_by_key_.end()) {
@@ -92,7 +187,8 @@ SslSessionLRUCache::Node* SslSessionLRUCache::FindLocked(
   return node;
 }
 
-void SslSessionLRUCache::Put(const char* key, SslSessionPtr session) {
+void SslSessionLRUCache::Shard::Put(const std::string& key,
+                                    SslSessionPtr session) {
   grpc_core::MutexLock lock(&lock_);
   Node* node = FindLocked(key);
   if (node != nullptr) {
@@ -114,7 +210,7 @@ void SslSessionLRUCache::Put(const char* key, SslSessionPtr session) {
   }
 }
 
-SslSessionPtr SslSessionLRUCache::Get(const char* key) {
+SslSessionPtr SslSessionLRUCache::Shard::Get(const std::string& key) {
   grpc_core::MutexLock lock(&lock_);
   // Key is only used for lookups.
   Node* node = FindLocked(key);
@@ -124,7 +220,7 @@ SslSessionPtr SslSessionLRUCache::Get(const char* key) {
   return node->CopySession();
 }
 
-void SslSessionLRUCache::Remove(SslSessionLRUCache::Node* node) {
+void SslSessionLRUCache::Shard::Remove(SslSessionLRUCache::Node* node) {
   if (node->prev_ == nullptr) {
     use_order_list_head_ = node->next_;
   } else {
@@ -139,7 +235,7 @@ void SslSessionLRUCache::Remove(SslSessionLRUCache::Node* node) {
   use_order_list_size_--;
 }
 
-void SslSessionLRUCache::PushFront(SslSessionLRUCache::Node* node) {
+void SslSessionLRUCache::Shard::PushFront(SslSessionLRUCache::Node* node) {
   if (use_order_list_head_ == nullptr) {
     use_order_list_head_ = node;
     use_order_list_tail_ = node;
@@ -155,7 +251,7 @@ void SslSessionLRUCache::PushFront(SslSessionLRUCache::Node* node) {
 }
 
 #ifndef NDEBUG
-void SslSessionLRUCache::AssertInvariants() {
+void SslSessionLRUCache::Shard::AssertInvariants() {
   size_t size = 0;
   Node* prev = nullptr;
   Node* current = use_order_list_head_;
@@ -173,7 +269,7 @@ void SslSessionLRUCache::AssertInvariants() {
   GPR_ASSERT(entry_by_key_.size() == use_order_list_size_);
 }
 #else
-void SslSessionLRUCache::AssertInvariants() {}
+void SslSessionLRUCache::Shard::AssertInvariants() {}
 #endif
 
 }  // namespace tsi
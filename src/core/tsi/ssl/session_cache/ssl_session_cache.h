@@ -29,6 +29,9 @@ extern "C" {
 }
 
 #include <map>
+#include <memory>
+#include <string>
+#include <vector>
 
 #include "src/core/lib/gprpp/memory.h"
 #include "src/core/lib/gprpp/ref_counted.h"
@@ -42,6 +45,10 @@ extern "C" {
 /// name. Note that servers are required to share session ticket encryption keys
 /// in order for cache to be effective.
 ///
+/// Large caches are split into independently locked shards selected by key
+/// hash, so that a cache shared by many channels does not serialize all
+/// handshakes on one mutex. LRU order is then maintained per shard.
+///
 /// This class is thread safe.
 
 namespace tsi {
@@ -69,22 +76,19 @@ class SslSessionLRUCache : public grpc_core::RefCounted<SslSessionLRUCache> {
   /// Returns the session from the cache associated with \a key or null if not
   /// found.
   SslSessionPtr Get(const char* key);
+  /// Discards all sessions in the cache.
+  void Clear();
+
+  /// Returns the number of shards the cache was split into.
+  size_t num_shards() const { return shards_.size(); }
 
  private:
   class Node;
+  class Shard;
 
-  Node* FindLocked(const std::string& key);
-  void Remove(Node* node);
-  void PushFront(Node* node);
-  void AssertInvariants();
-
-  grpc_core::Mutex lock_;
-  size_t capacity_;
+  Shard* ShardForKey(const std::string& key);
 
-  Node* use_order_list_head_ = nullptr;
-  Node* use_order_list_tail_ = nullptr;
-  size_t use_order_list_size_ = 0;
-  std::map<std::string, Node*> entry_by_key_;
+  std::vector<std::unique_ptr<Shard>> shards_;
 };
 
 }  // namespace tsi
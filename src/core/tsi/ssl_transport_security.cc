@@ -33,6 +33,7 @@
 #include <sys/socket.h>
 #endif
 
+#include <algorithm>
 #include <string>
 
 #include "absl/strings/match.h"
@@ -50,6 +51,8 @@ extern "C" {
 #include <openssl/crypto.h> /* For OPENSSL_free */
 #include <openssl/engine.h>
 #include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/sha.h>
 #include <openssl/ssl.h>
 #include <openssl/tls1.h>
 #include <openssl/x509.h>
@@ -57,9 +60,11 @@ extern "C" {
 }
 
 #include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/slice/slice_internal.h"
 #include "src/core/tsi/ssl/session_cache/ssl_session_cache.h"
 #include "src/core/tsi/ssl_types.h"
 #include "src/core/tsi/transport_security.h"
+#include "src/core/tsi/transport_security_grpc.h"
 
 /* --- Constants. ---*/
 
@@ -67,6 +72,11 @@ extern "C" {
 #define TSI_SSL_MAX_PROTECTED_FRAME_SIZE_LOWER_BOUND 1024
 #define TSI_SSL_HANDSHAKER_OUTGOING_BUFFER_INITIAL_SIZE 1024
 
+/* Records decrypted by the zero-copy protector up to this size are copied out
+   rather than handed out as part of a record-sized slice, which they would
+   keep alive. */
+#define TSI_SSL_ZERO_COPY_SMALL_RECORD_SIZE 1024
+
 /* Putting a macro like this and littering the source file with #if is really
    bad practice.
    TODO(jboeuf): refactor all the #if / #endif in a separate module. */
@@ -78,10 +88,21 @@ extern "C" {
    SSL structure. This is what we would ultimately want though... */
 #define TSI_SSL_MAX_PROTECTION_OVERHEAD 100
 
+/* Number of sessions held by the process-wide default session cache. A cached
+   session takes a few KB, which bounds the cache to a few MB. */
+#define TSI_SSL_DEFAULT_SESSION_CACHE_CAPACITY 1024
+
+/* Number of configuration digest bytes prefixed (hex encoded) to session cache
+   keys. */
+#define TSI_SSL_SESSION_CACHE_KEY_DIGEST_SIZE 16
+
 /* --- Structure definitions. ---*/
 
 struct tsi_ssl_root_certs_store {
   X509_STORE* store;
+  /* Digest of the PEM roots the store was loaded from, which identifies it in
+     session cache keys. */
+  unsigned char pem_roots_digest[SHA256_DIGEST_LENGTH];
 };
 
 struct tsi_ssl_handshaker_factory {
@@ -95,6 +116,9 @@ struct tsi_ssl_client_handshaker_factory {
   unsigned char* alpn_protocol_list;
   size_t alpn_protocol_list_length;
   grpc_core::RefCountedPtr<tsi::SslSessionLRUCache> session_cache;
+  /* Hex encoded digest of the factory configuration followed by ':', used to
+     prefix session cache keys. */
+  char session_cache_key_prefix[2 * TSI_SSL_SESSION_CACHE_KEY_DIGEST_SIZE + 2];
 };
 
 struct tsi_ssl_server_handshaker_factory {
@@ -133,10 +157,31 @@ struct tsi_ssl_frame_protector {
   size_t buffer_size;
   size_t buffer_offset;
 };
+/* Variant of tsi_ssl_frame_protector for callers that exchange slice buffers.
+   Instead of the BIO pair, SSL reads and writes records through a slice BIO
+   (see ssl_slice_bio_method() below): protected bytes cross the BIO exactly
+   once in each direction. The same SSL object serves both directions, hence
+   the mutex. */
+struct tsi_ssl_zero_copy_grpc_protector {
+  tsi_zero_copy_grpc_protector base;
+  gpr_mu mu;
+  SSL* ssl;
+  /* Protected bytes not consumed by SSL yet. */
+  grpc_slice_buffer protected_input;
+  /* Records written by SSL, one slice each. */
+  grpc_slice_buffer protected_output;
+  /* Coalesces small unprotected slices into full records. */
+  unsigned char* buffer;
+  size_t buffer_size;
+  size_t buffer_offset;
+  size_t max_protected_frame_size;
+  /* Unused tail of the slice that SSL_read() decrypts into. */
+  grpc_slice read_slice;
+};
 /* --- Library Initialization. ---*/
 
 static gpr_once g_init_openssl_once = GPR_ONCE_INIT;
-static int g_ssl_ctx_ex_factory_index = -1;
+static int g_ssl_ex_session_cache_entry_index = -1;
 static const unsigned char kSslSessionIdContext[] = {'g', 'r', 'p', 'c'};
 #if !defined(OPENSSL_IS_BORINGSSL) && !defined(OPENSSL_NO_ENGINE)
 static const char kSslEnginePrefix[] = "engine:";
@@ -161,6 +206,20 @@ static unsigned long openssl_thread_id_cb(void) {
 }
 #endif
 
+/* Session cache and key attached to a client SSL object. New session callbacks
+   may run after the handshake (TLS 1.3 sends tickets post-handshake), when the
+   handshaker factory may already be gone, so they only rely on this. */
+struct tsi_ssl_session_cache_entry {
+  grpc_core::RefCountedPtr<tsi::SslSessionLRUCache> cache;
+  std::string key;
+};
+
+static void ssl_session_cache_entry_free(void* /*parent*/, void* ptr,
+                                         CRYPTO_EX_DATA* /*ad*/, int /*index*/,
+                                         long /*argl*/, void* /*argp*/) {
+  delete static_cast<tsi_ssl_session_cache_entry*>(ptr);
+}
+
 static void init_openssl(void) {
 #if OPENSSL_VERSION_NUMBER >= 0x10100000
   OPENSSL_init_ssl(0, nullptr);
@@ -184,9 +243,9 @@ static void init_openssl(void) {
     gpr_log(GPR_INFO, "OpenSSL callback has already been set.");
   }
 #endif
-  g_ssl_ctx_ex_factory_index =
-      SSL_CTX_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
-  GPR_ASSERT(g_ssl_ctx_ex_factory_index != -1);
+  g_ssl_ex_session_cache_entry_index = SSL_get_ex_new_index(
+      0, nullptr, nullptr, nullptr, ssl_session_cache_entry_free);
+  GPR_ASSERT(g_ssl_ex_session_cache_entry_index != -1);
 }
 
 /* --- Ssl utils. ---*/
@@ -1020,6 +1079,9 @@ tsi_ssl_root_certs_store* tsi_ssl_root_certs_store_create(
     gpr_free(root_store);
     return nullptr;
   }
+  GPR_ASSERT(EVP_Digest(pem_roots, strlen(pem_roots),
+                        root_store->pem_roots_digest, nullptr, EVP_sha256(),
+                        nullptr) == 1);
   return root_store;
 }
 
@@ -1046,6 +1108,22 @@ void tsi_ssl_session_cache_unref(tsi_ssl_session_cache* cache) {
   reinterpret_cast<tsi::SslSessionLRUCache*>(cache)->Unref();
 }
 
+static gpr_once g_default_session_cache_once = GPR_ONCE_INIT;
+static tsi::SslSessionLRUCache* g_default_session_cache = nullptr;
+
+static void init_default_session_cache(void) {
+  /* Intentionally leaked: factories created at any point, including during
+     shutdown, may hold references to it. */
+  g_default_session_cache =
+      tsi::SslSessionLRUCache::Create(TSI_SSL_DEFAULT_SESSION_CACHE_CAPACITY)
+          .release();
+}
+
+tsi_ssl_session_cache* tsi_ssl_session_cache_get_default(void) {
+  gpr_once_init(&g_default_session_cache_once, init_default_session_cache);
+  return reinterpret_cast<tsi_ssl_session_cache*>(g_default_session_cache);
+}
+
 /* --- tsi_frame_protector methods implementation. ---*/
 
 static tsi_result ssl_protector_protect(tsi_frame_protector* self,
@@ -1197,6 +1275,243 @@ static const tsi_frame_protector_vtable frame_protector_vtable = {
     ssl_protector_destroy,
 };
 
+/* --- tsi_zero_copy_grpc_protector methods implementation. ---*/
+
+/* Needs BIO_meth_new(), hence OpenSSL 1.1.0 or BoringSSL. */
+#if OPENSSL_VERSION_NUMBER >= 0x10100000
+/* BIO callbacks of the slice BIO. The BIO data is the owning
+   tsi_ssl_zero_copy_grpc_protector, whose mutex is held around every SSL
+   call. */
+static int ssl_slice_bio_write(BIO* bio, const char* data, int size) {
+  tsi_ssl_zero_copy_grpc_protector* impl =
+      static_cast<tsi_ssl_zero_copy_grpc_protector*>(BIO_get_data(bio));
+  BIO_clear_retry_flags(bio);
+  if (size <= 0) return 0;
+  /* SSL writes a whole record at a time, so every record lands in an exactly
+     sized slice. */
+  grpc_slice_buffer_add(
+      &impl->protected_output,
+      grpc_slice_from_copied_buffer(data, static_cast<size_t>(size)));
+  return size;
+}
+
+static int ssl_slice_bio_read(BIO* bio, char* data, int size) {
+  tsi_ssl_zero_copy_grpc_protector* impl =
+      static_cast<tsi_ssl_zero_copy_grpc_protector*>(BIO_get_data(bio));
+  BIO_clear_retry_flags(bio);
+  if (size <= 0) return 0;
+  size_t read_size =
+      std::min(static_cast<size_t>(size), impl->protected_input.length);
+  if (read_size == 0) {
+    BIO_set_retry_read(bio);
+    return -1;
+  }
+  grpc_slice_buffer_move_first_into_buffer(&impl->protected_input, read_size,
+                                           data);
+  return static_cast<int>(read_size);
+}
+
+static long ssl_slice_bio_ctrl(BIO* bio, int cmd, long /*num*/,
+                               void* /*ptr*/) {
+  switch (cmd) {
+    case BIO_CTRL_FLUSH:
+      return 1;
+    case BIO_CTRL_PENDING: {
+      tsi_ssl_zero_copy_grpc_protector* impl =
+          static_cast<tsi_ssl_zero_copy_grpc_protector*>(BIO_get_data(bio));
+      return static_cast<long>(impl->protected_input.length);
+    }
+    default:
+      return 0;
+  }
+}
+
+static int ssl_slice_bio_create(BIO* bio) {
+  BIO_set_init(bio, 1);
+  return 1;
+}
+
+static gpr_once g_ssl_slice_bio_method_once = GPR_ONCE_INIT;
+static BIO_METHOD* g_ssl_slice_bio_method = nullptr;
+
+static void init_ssl_slice_bio_method(void) {
+  g_ssl_slice_bio_method = BIO_meth_new(
+      BIO_get_new_index() | BIO_TYPE_SOURCE_SINK, "grpc slice buffer");
+  GPR_ASSERT(g_ssl_slice_bio_method != nullptr);
+  BIO_meth_set_write(g_ssl_slice_bio_method, ssl_slice_bio_write);
+  BIO_meth_set_read(g_ssl_slice_bio_method, ssl_slice_bio_read);
+  BIO_meth_set_ctrl(g_ssl_slice_bio_method, ssl_slice_bio_ctrl);
+  BIO_meth_set_create(g_ssl_slice_bio_method, ssl_slice_bio_create);
+}
+
+/* Returns the method of a BIO that hands the records written by SSL to
+   impl->protected_output and feeds SSL from impl->protected_input. Compared
+   with the BIO pair, this saves one copy of every protected byte in each
+   direction. The copy between SSL's own record buffer and the slices
+   remains. */
+static const BIO_METHOD* ssl_slice_bio_method(void) {
+  gpr_once_init(&g_ssl_slice_bio_method_once, init_ssl_slice_bio_method);
+  return g_ssl_slice_bio_method;
+}
+
+/* Moves all bytes pending in bio into a single new slice appended to
+   slices. */
+static tsi_result ssl_drain_bio(BIO* bio, grpc_slice_buffer* slices) {
+  int pending = static_cast<int>(BIO_pending(bio));
+  GPR_ASSERT(pending >= 0);
+  if (pending == 0) return TSI_OK;
+  grpc_slice slice = GRPC_SLICE_MALLOC(static_cast<size_t>(pending));
+  int read_from_bio = BIO_read(bio, GRPC_SLICE_START_PTR(slice), pending);
+  if (read_from_bio != pending) {
+    gpr_log(GPR_ERROR, "Could not drain BIO.");
+    grpc_slice_unref_internal(slice);
+    return TSI_INTERNAL_ERROR;
+  }
+  grpc_slice_buffer_add(slices, slice);
+  return TSI_OK;
+}
+
+static tsi_result ssl_zero_copy_grpc_protector_protect_locked(
+    tsi_ssl_zero_copy_grpc_protector* impl,
+    grpc_slice_buffer* unprotected_slices,
+    grpc_slice_buffer* protected_slices) {
+  tsi_result result = TSI_OK;
+  for (size_t i = 0; i < unprotected_slices->count && result == TSI_OK; i++) {
+    unsigned char* bytes = GRPC_SLICE_START_PTR(unprotected_slices->slices[i]);
+    size_t size = GRPC_SLICE_LENGTH(unprotected_slices->slices[i]);
+    bool is_last_slice = i + 1 == unprotected_slices->count;
+    while (size > 0 && result == TSI_OK) {
+      size_t chunk_size;
+      if (impl->buffer_offset == 0 &&
+          (size >= impl->buffer_size || is_last_slice)) {
+        /* Nothing to coalesce with: encrypt straight from the slice. */
+        chunk_size = std::min(size, impl->buffer_size);
+        result = do_ssl_write(impl->ssl, bytes, chunk_size);
+      } else {
+        chunk_size = std::min(size, impl->buffer_size - impl->buffer_offset);
+        memcpy(impl->buffer + impl->buffer_offset, bytes, chunk_size);
+        impl->buffer_offset += chunk_size;
+        if (impl->buffer_offset == impl->buffer_size) {
+          impl->buffer_offset = 0;
+          result = do_ssl_write(impl->ssl, impl->buffer, impl->buffer_size);
+        }
+      }
+      bytes += chunk_size;
+      size -= chunk_size;
+    }
+  }
+  /* Every protect call flushes, like secure_endpoint does with the regular
+     frame protector. */
+  if (result == TSI_OK && impl->buffer_offset > 0) {
+    size_t size = impl->buffer_offset;
+    impl->buffer_offset = 0;
+    result = do_ssl_write(impl->ssl, impl->buffer, size);
+  }
+  /* Also hands out anything SSL wrote on its own, e.g. post-handshake
+     messages. */
+  grpc_slice_buffer_move_into(&impl->protected_output, protected_slices);
+  grpc_slice_buffer_reset_and_unref_internal(unprotected_slices);
+  return result;
+}
+
+static tsi_result ssl_zero_copy_grpc_protector_protect(
+    tsi_zero_copy_grpc_protector* self, grpc_slice_buffer* unprotected_slices,
+    grpc_slice_buffer* protected_slices) {
+  tsi_ssl_zero_copy_grpc_protector* impl =
+      reinterpret_cast<tsi_ssl_zero_copy_grpc_protector*>(self);
+  gpr_mu_lock(&impl->mu);
+  tsi_result result = ssl_zero_copy_grpc_protector_protect_locked(
+      impl, unprotected_slices, protected_slices);
+  gpr_mu_unlock(&impl->mu);
+  return result;
+}
+
+/* Decrypts every complete record buffered in SSL into impl->read_slice. Large
+   records are handed to unprotected_slices as parts of it, small ones are
+   copied into slices of their own. */
+static tsi_result ssl_zero_copy_read_records(
+    tsi_ssl_zero_copy_grpc_protector* impl,
+    grpc_slice_buffer* unprotected_slices) {
+  while (true) {
+    if (GRPC_SLICE_LENGTH(impl->read_slice) <
+        TSI_SSL_ZERO_COPY_SMALL_RECORD_SIZE) {
+      grpc_slice_unref_internal(impl->read_slice);
+      impl->read_slice =
+          GRPC_SLICE_MALLOC(TSI_SSL_MAX_PROTECTED_FRAME_SIZE_UPPER_BOUND);
+    }
+    size_t read_size = GRPC_SLICE_LENGTH(impl->read_slice);
+    tsi_result result = do_ssl_read(
+        impl->ssl, GRPC_SLICE_START_PTR(impl->read_slice), &read_size);
+    if (result != TSI_OK || read_size == 0) return result;
+    if (read_size <= TSI_SSL_ZERO_COPY_SMALL_RECORD_SIZE) {
+      /* Leaves impl->read_slice in place for the next record. */
+      grpc_slice_buffer_add(
+          unprotected_slices,
+          grpc_slice_from_copied_buffer(
+              reinterpret_cast<const char*>(
+                  GRPC_SLICE_START_PTR(impl->read_slice)),
+              read_size));
+    } else {
+      grpc_slice_buffer_add(
+          unprotected_slices,
+          grpc_slice_split_head(&impl->read_slice, read_size));
+    }
+  }
+}
+
+static tsi_result ssl_zero_copy_grpc_protector_unprotect_locked(
+    tsi_ssl_zero_copy_grpc_protector* impl,
+    grpc_slice_buffer* protected_slices,
+    grpc_slice_buffer* unprotected_slices) {
+  grpc_slice_buffer_move_into(protected_slices, &impl->protected_input);
+  /* SSL may write on its own while reading, e.g. key update
+     acknowledgements. Those records go out with the next protect call. */
+  return ssl_zero_copy_read_records(impl, unprotected_slices);
+}
+
+static tsi_result ssl_zero_copy_grpc_protector_unprotect(
+    tsi_zero_copy_grpc_protector* self, grpc_slice_buffer* protected_slices,
+    grpc_slice_buffer* unprotected_slices) {
+  tsi_ssl_zero_copy_grpc_protector* impl =
+      reinterpret_cast<tsi_ssl_zero_copy_grpc_protector*>(self);
+  gpr_mu_lock(&impl->mu);
+  tsi_result result = ssl_zero_copy_grpc_protector_unprotect_locked(
+      impl, protected_slices, unprotected_slices);
+  gpr_mu_unlock(&impl->mu);
+  return result;
+}
+
+static void ssl_zero_copy_grpc_protector_destroy(
+    tsi_zero_copy_grpc_protector* self) {
+  tsi_ssl_zero_copy_grpc_protector* impl =
+      reinterpret_cast<tsi_ssl_zero_copy_grpc_protector*>(self);
+  gpr_free(impl->buffer);
+  grpc_slice_unref_internal(impl->read_slice);
+  /* Frees the slice BIO too. */
+  if (impl->ssl != nullptr) SSL_free(impl->ssl);
+  grpc_slice_buffer_destroy_internal(&impl->protected_input);
+  grpc_slice_buffer_destroy_internal(&impl->protected_output);
+  gpr_mu_destroy(&impl->mu);
+  gpr_free(impl);
+}
+
+static tsi_result ssl_zero_copy_grpc_protector_max_frame_size(
+    tsi_zero_copy_grpc_protector* self, size_t* max_frame_size) {
+  tsi_ssl_zero_copy_grpc_protector* impl =
+      reinterpret_cast<tsi_ssl_zero_copy_grpc_protector*>(self);
+  *max_frame_size = impl->max_protected_frame_size;
+  return TSI_OK;
+}
+
+static const tsi_zero_copy_grpc_protector_vtable
+    zero_copy_grpc_protector_vtable = {
+        ssl_zero_copy_grpc_protector_protect,
+        ssl_zero_copy_grpc_protector_unprotect,
+        ssl_zero_copy_grpc_protector_destroy,
+        ssl_zero_copy_grpc_protector_max_frame_size,
+};
+#endif
+
 /* --- tsi_server_handshaker_factory methods implementation. --- */
 
 static void tsi_ssl_handshaker_factory_destroy(
@@ -1331,6 +1646,8 @@ static tsi_result ssl_handshaker_result_extract_peer(
   return result;
 }
 
+/* The zero-copy protector is also available, but only used when requested
+   with GRPC_ARG_TSI_ZERO_COPY_FRAME_PROTECTOR. */
 static tsi_result ssl_handshaker_result_get_frame_protector_type(
     const tsi_handshaker_result* /*self*/,
     tsi_frame_protector_type* frame_protector_type) {
@@ -1338,18 +1655,12 @@ static tsi_result ssl_handshaker_result_get_frame_protector_type(
   return TSI_OK;
 }
 
-static tsi_result ssl_handshaker_result_create_frame_protector(
-    const tsi_handshaker_result* self, size_t* max_output_protected_frame_size,
-    tsi_frame_protector** protector) {
+/* Clamps the requested maximum protected frame size to the supported range and
+   returns the size to use. */
+static size_t ssl_protector_max_output_protected_frame_size(
+    size_t* max_output_protected_frame_size) {
   size_t actual_max_output_protected_frame_size =
       TSI_SSL_MAX_PROTECTED_FRAME_SIZE_UPPER_BOUND;
-  tsi_ssl_handshaker_result* impl =
-      reinterpret_cast<tsi_ssl_handshaker_result*>(
-          const_cast<tsi_handshaker_result*>(self));
-  tsi_ssl_frame_protector* protector_impl =
-      static_cast<tsi_ssl_frame_protector*>(
-          gpr_zalloc(sizeof(*protector_impl)));
-
   if (max_output_protected_frame_size != nullptr) {
     if (*max_output_protected_frame_size >
         TSI_SSL_MAX_PROTECTED_FRAME_SIZE_UPPER_BOUND) {
@@ -1362,6 +1673,82 @@ static tsi_result ssl_handshaker_result_create_frame_protector(
     }
     actual_max_output_protected_frame_size = *max_output_protected_frame_size;
   }
+  return actual_max_output_protected_frame_size;
+}
+
+static tsi_result ssl_handshaker_result_create_zero_copy_grpc_protector(
+    const tsi_handshaker_result* self, size_t* max_output_protected_frame_size,
+    tsi_zero_copy_grpc_protector** protector) {
+#if OPENSSL_VERSION_NUMBER < 0x10100000
+  /* No custom BIOs; the caller falls back to the regular frame protector. */
+  (void)self;
+  (void)max_output_protected_frame_size;
+  (void)protector;
+  return TSI_UNIMPLEMENTED;
+#else
+  tsi_ssl_handshaker_result* impl =
+      reinterpret_cast<tsi_ssl_handshaker_result*>(
+          const_cast<tsi_handshaker_result*>(self));
+  tsi_ssl_zero_copy_grpc_protector* protector_impl =
+      static_cast<tsi_ssl_zero_copy_grpc_protector*>(
+          gpr_zalloc(sizeof(*protector_impl)));
+  protector_impl->max_protected_frame_size =
+      ssl_protector_max_output_protected_frame_size(
+          max_output_protected_frame_size);
+  protector_impl->buffer_size = protector_impl->max_protected_frame_size -
+                                TSI_SSL_MAX_PROTECTION_OVERHEAD;
+  protector_impl->buffer =
+      static_cast<unsigned char*>(gpr_malloc(protector_impl->buffer_size));
+  protector_impl->read_slice = grpc_empty_slice();
+  grpc_slice_buffer_init(&protector_impl->protected_input);
+  grpc_slice_buffer_init(&protector_impl->protected_output);
+  gpr_mu_init(&protector_impl->mu);
+
+  /* Move whatever is still buffered in the BIO pair, in either direction,
+     over to the slice buffers before SSL switches to the slice BIO. */
+  tsi_result result =
+      ssl_drain_bio(SSL_get_rbio(impl->ssl), &protector_impl->protected_input);
+  if (result == TSI_OK) {
+    result =
+        ssl_drain_bio(impl->network_io, &protector_impl->protected_output);
+  }
+  if (result != TSI_OK) {
+    ssl_zero_copy_grpc_protector_destroy(&protector_impl->base);
+    return result;
+  }
+  BIO* slice_bio = BIO_new(ssl_slice_bio_method());
+  if (slice_bio == nullptr) {
+    gpr_log(GPR_ERROR, "Could not create slice BIO.");
+    ssl_zero_copy_grpc_protector_destroy(&protector_impl->base);
+    return TSI_OUT_OF_RESOURCES;
+  }
+  BIO_set_data(slice_bio, protector_impl);
+
+  /* Transfer ownership of ssl to the frame protector. SSL_set_bio() frees
+     the SSL side of the pair. */
+  protector_impl->ssl = impl->ssl;
+  impl->ssl = nullptr;
+  SSL_set_bio(protector_impl->ssl, slice_bio, slice_bio);
+  BIO_free(impl->network_io);
+  impl->network_io = nullptr;
+  protector_impl->base.vtable = &zero_copy_grpc_protector_vtable;
+  *protector = &protector_impl->base;
+  return TSI_OK;
+#endif
+}
+
+static tsi_result ssl_handshaker_result_create_frame_protector(
+    const tsi_handshaker_result* self, size_t* max_output_protected_frame_size,
+    tsi_frame_protector** protector) {
+  size_t actual_max_output_protected_frame_size =
+      ssl_protector_max_output_protected_frame_size(
+          max_output_protected_frame_size);
+  tsi_ssl_handshaker_result* impl =
+      reinterpret_cast<tsi_ssl_handshaker_result*>(
+          const_cast<tsi_handshaker_result*>(self));
+  tsi_ssl_frame_protector* protector_impl =
+      static_cast<tsi_ssl_frame_protector*>(
+          gpr_zalloc(sizeof(*protector_impl)));
   protector_impl->buffer_size =
       actual_max_output_protected_frame_size - TSI_SSL_MAX_PROTECTION_OVERHEAD;
   protector_impl->buffer =
@@ -1393,6 +1780,85 @@ static tsi_result ssl_handshaker_result_get_unused_bytes(
   return TSI_OK;
 }
 
+#if defined(OPENSSL_IS_BORINGSSL)
+static void ssl_fill_ktls_crypto_info(tsi_ktls_cipher cipher,
+                                      const uint8_t* key, size_t key_size,
+                                      const uint8_t* salt, uint64_t sequence,
+                                      tsi_ktls_crypto_info* info) {
+  memset(info, 0, sizeof(*info));
+  info->tls_version = TLS1_2_VERSION;
+  info->cipher = cipher;
+  memcpy(info->key, key, key_size);
+  memcpy(info->salt, salt, sizeof(info->salt));
+  for (size_t i = 0; i < sizeof(info->rec_seq); ++i) {
+    info->rec_seq[i] =
+        static_cast<uint8_t>(sequence >> (8 * (sizeof(info->rec_seq) - 1 - i)));
+  }
+  /* BoringSSL uses the record sequence number as the explicit nonce. */
+  memcpy(info->iv, info->rec_seq, sizeof(info->iv));
+}
+#endif /* defined(OPENSSL_IS_BORINGSSL) */
+
+static tsi_result ssl_handshaker_result_get_ktls_crypto_info(
+    const tsi_handshaker_result* self, tsi_ktls_crypto_info* tx,
+    tsi_ktls_crypto_info* rx) {
+#if defined(OPENSSL_IS_BORINGSSL)
+  const tsi_ssl_handshaker_result* impl =
+      reinterpret_cast<const tsi_ssl_handshaker_result*>(self);
+  SSL* ssl = impl->ssl;
+  /* Only TLS 1.2 is offloaded: TLS 1.3 connections carry post-handshake
+     messages (session tickets, key updates) that the kernel does not process.
+     Data already decrypted by the SSL object would be lost. */
+  if (ssl == nullptr || SSL_version(ssl) != TLS1_2_VERSION ||
+      SSL_pending(ssl) > 0) {
+    return TSI_UNIMPLEMENTED;
+  }
+  tsi_ktls_cipher cipher;
+  size_t key_size;
+  switch (SSL_CIPHER_get_cipher_nid(SSL_get_current_cipher(ssl))) {
+    case NID_aes_128_gcm:
+      cipher = TSI_KTLS_CIPHER_AES_GCM_128;
+      key_size = 16;
+      break;
+    case NID_aes_256_gcm:
+      cipher = TSI_KTLS_CIPHER_AES_GCM_256;
+      key_size = 32;
+      break;
+    default:
+      return TSI_UNIMPLEMENTED;
+  }
+  /* For TLS 1.2 AEAD ciphers, the key block holds no MAC keys: it is the
+     client write key, the server write key, then the client and server
+     implicit nonces. */
+  const size_t salt_size = sizeof(tx->salt);
+  uint8_t key_block[2 * (sizeof(tx->key) + sizeof(tx->salt))];
+  const size_t key_block_size = 2 * (key_size + salt_size);
+  if (SSL_get_key_block_len(ssl) != key_block_size ||
+      !SSL_generate_key_block(ssl, key_block, key_block_size)) {
+    return TSI_UNIMPLEMENTED;
+  }
+  const uint8_t* client_key = key_block;
+  const uint8_t* server_key = client_key + key_size;
+  const uint8_t* client_salt = server_key + key_size;
+  const uint8_t* server_salt = client_salt + salt_size;
+  const bool is_server = SSL_is_server(ssl);
+  ssl_fill_ktls_crypto_info(cipher, is_server ? server_key : client_key,
+                            key_size, is_server ? server_salt : client_salt,
+                            SSL_get_write_sequence(ssl), tx);
+  ssl_fill_ktls_crypto_info(cipher, is_server ? client_key : server_key,
+                            key_size, is_server ? client_salt : server_salt,
+                            SSL_get_read_sequence(ssl), rx);
+  OPENSSL_cleanse(key_block, sizeof(key_block));
+  return TSI_OK;
+#else
+  /* OpenSSL does not expose the key block nor the record sequence numbers. */
+  (void)self;
+  (void)tx;
+  (void)rx;
+  return TSI_UNIMPLEMENTED;
+#endif /* defined(OPENSSL_IS_BORINGSSL) */
+}
+
 static void ssl_handshaker_result_destroy(tsi_handshaker_result* self) {
   tsi_ssl_handshaker_result* impl =
       reinterpret_cast<tsi_ssl_handshaker_result*>(self);
@@ -1405,10 +1871,11 @@ static void ssl_handshaker_result_destroy(tsi_handshaker_result* self) {
 static const tsi_handshaker_result_vtable handshaker_result_vtable = {
     ssl_handshaker_result_extract_peer,
     ssl_handshaker_result_get_frame_protector_type,
-    nullptr, /* create_zero_copy_grpc_protector */
+    ssl_handshaker_result_create_zero_copy_grpc_protector,
     ssl_handshaker_result_create_frame_protector,
     ssl_handshaker_result_get_unused_bytes,
     ssl_handshaker_result_destroy,
+    ssl_handshaker_result_get_ktls_crypto_info,
 };
 
 static tsi_result ssl_handshaker_result_create(
@@ -1629,16 +2096,21 @@ static const tsi_handshaker_vtable handshaker_vtable = {
 /* --- tsi_ssl_handshaker_factory common methods. --- */
 
 static void tsi_ssl_handshaker_resume_session(
-    SSL* ssl, tsi::SslSessionLRUCache* session_cache) {
+    SSL* ssl, tsi_ssl_client_handshaker_factory* factory) {
   const char* server_name = SSL_get_servername(ssl, TLSEXT_NAMETYPE_host_name);
   if (server_name == nullptr) {
     return;
   }
-  tsi::SslSessionPtr session = session_cache->Get(server_name);
+  tsi_ssl_session_cache_entry* entry = new tsi_ssl_session_cache_entry;
+  entry->cache = factory->session_cache;
+  entry->key = std::string(factory->session_cache_key_prefix) + server_name;
+  tsi::SslSessionPtr session = entry->cache->Get(entry->key.c_str());
   if (session != nullptr) {
     // SSL_set_session internally increments reference counter.
     SSL_set_session(ssl, session.get());
   }
+  // The entry is owned by ssl from now on.
+  SSL_set_ex_data(ssl, g_ssl_ex_session_cache_entry_index, entry);
 }
 
 static tsi_result create_tsi_ssl_handshaker(SSL_CTX* ctx, int is_client,
@@ -1680,8 +2152,7 @@ static tsi_result create_tsi_ssl_handshaker(SSL_CTX* ctx, int is_client,
     tsi_ssl_client_handshaker_factory* client_factory =
         reinterpret_cast<tsi_ssl_client_handshaker_factory*>(factory);
     if (client_factory->session_cache != nullptr) {
-      tsi_ssl_handshaker_resume_session(ssl,
-                                        client_factory->session_cache.get());
+      tsi_ssl_handshaker_resume_session(ssl, client_factory);
     }
     ERR_clear_error();
     ssl_result = SSL_do_handshake(ssl);
@@ -1907,22 +2378,69 @@ static int server_handshaker_factory_npn_advertised_callback(
 /// It returns 1 if callback takes ownership over \a session and 0 otherwise.
 static int server_handshaker_factory_new_session_callback(
     SSL* ssl, SSL_SESSION* session) {
-  SSL_CTX* ssl_context = SSL_get_SSL_CTX(ssl);
-  if (ssl_context == nullptr) {
-    return 0;
-  }
-  void* arg = SSL_CTX_get_ex_data(ssl_context, g_ssl_ctx_ex_factory_index);
-  tsi_ssl_client_handshaker_factory* factory =
-      static_cast<tsi_ssl_client_handshaker_factory*>(arg);
-  const char* server_name = SSL_get_servername(ssl, TLSEXT_NAMETYPE_host_name);
-  if (server_name == nullptr) {
+  tsi_ssl_session_cache_entry* entry =
+      static_cast<tsi_ssl_session_cache_entry*>(
+          SSL_get_ex_data(ssl, g_ssl_ex_session_cache_entry_index));
+  if (entry == nullptr) {
     return 0;
   }
-  factory->session_cache->Put(server_name, tsi::SslSessionPtr(session));
+  entry->cache->Put(entry->key.c_str(), tsi::SslSessionPtr(session));
   // Return 1 to indicate transferred ownership over the given session.
   return 1;
 }
 
+/* Fills \a factory's session cache key prefix with a digest of the parts of
+   \a options that a resumed session must agree with, so that channels with
+   different trust or protocol configurations never share sessions. */
+static void ssl_client_handshaker_factory_init_session_cache_key_prefix(
+    const tsi_ssl_client_handshaker_options* options,
+    tsi_ssl_client_handshaker_factory* factory) {
+  std::string config;
+  auto append = [&config](const char* value) {
+    if (value == nullptr) {
+      config.append("\xff", 1);
+      return;
+    }
+    config.append(value, strlen(value) + 1);
+  };
+  append(options->pem_root_certs);
+  if (options->root_store != nullptr) {
+    config.push_back(1);
+    config.append(
+        reinterpret_cast<const char*>(options->root_store->pem_roots_digest),
+        sizeof(options->root_store->pem_roots_digest));
+  } else {
+    append(nullptr);
+  }
+  append(options->pem_key_cert_pair != nullptr
+             ? options->pem_key_cert_pair->private_key
+             : nullptr);
+  append(options->pem_key_cert_pair != nullptr
+             ? options->pem_key_cert_pair->cert_chain
+             : nullptr);
+  append(options->cipher_suites);
+  for (size_t i = 0; i < options->num_alpn_protocols; ++i) {
+    append(options->alpn_protocols[i]);
+  }
+  config.push_back(static_cast<char>(options->num_alpn_protocols));
+  config.push_back(static_cast<char>(options->min_tls_version));
+  config.push_back(static_cast<char>(options->max_tls_version));
+  config.push_back(options->skip_server_certificate_verification ? 1 : 0);
+  unsigned char digest[EVP_MAX_MD_SIZE];
+  unsigned int digest_size = 0;
+  GPR_ASSERT(EVP_Digest(config.data(), config.size(), digest, &digest_size,
+                        EVP_sha256(), nullptr) == 1);
+  GPR_ASSERT(digest_size >= TSI_SSL_SESSION_CACHE_KEY_DIGEST_SIZE);
+  static const char kHex[] = "0123456789abcdef";
+  char* out = factory->session_cache_key_prefix;
+  for (size_t i = 0; i < TSI_SSL_SESSION_CACHE_KEY_DIGEST_SIZE; ++i) {
+    *out++ = kHex[digest[i] >> 4];
+    *out++ = kHex[digest[i] & 0xf];
+  }
+  *out++ = ':';
+  *out = '\0';
+}
+
 /* --- tsi_ssl_handshaker_factory constructors. --- */
 
 static tsi_ssl_handshaker_factory_vtable client_handshaker_factory_vtable = {
@@ -1983,7 +2501,7 @@ tsi_result tsi_create_ssl_client_handshaker_factory_with_options(
     impl->session_cache =
         reinterpret_cast<tsi::SslSessionLRUCache*>(options->session_cache)
             ->Ref();
-    SSL_CTX_set_ex_data(ssl_context, g_ssl_ctx_ex_factory_index, impl);
+    ssl_client_handshaker_factory_init_session_cache_key_prefix(options, impl);
     SSL_CTX_sess_set_new_cb(ssl_context,
                             server_handshaker_factory_new_session_callback);
     SSL_CTX_set_session_cache_mode(ssl_context, SSL_SESS_CACHE_CLIENT);
@@ -77,6 +77,14 @@ void tsi_ssl_session_cache_ref(tsi_ssl_session_cache* cache);
 /* Decrement reference counter of \a cache.  */
 void tsi_ssl_session_cache_unref(tsi_ssl_session_cache* cache);
 
+/* Returns the process-wide session cache shared by channels that do not supply
+   their own. Sessions are keyed by server name and by a digest of the client
+   handshaker factory configuration, so channels only resume sessions that
+   were established with the same roots, key/cert pair, ciphers, ALPN and TLS
+   versions. The cache lives for the lifetime of the process; the returned
+   pointer is not ref'ed and must not be unref'ed by the caller.  */
+tsi_ssl_session_cache* tsi_ssl_session_cache_get_default(void);
+
 /* --- tsi_ssl_client_handshaker_factory object ---
 
    This object creates a client tsi_handshaker objects implemented in terms of
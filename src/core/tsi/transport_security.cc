@@ -285,6 +285,17 @@ tsi_result tsi_handshaker_result_get_unused_bytes(
   return self->vtable->get_unused_bytes(self, bytes, bytes_size);
 }
 
+tsi_result tsi_handshaker_result_get_ktls_crypto_info(
+    const tsi_handshaker_result* self, tsi_ktls_crypto_info* tx,
+    tsi_ktls_crypto_info* rx) {
+  if (self == nullptr || self->vtable == nullptr || tx == nullptr ||
+      rx == nullptr) {
+    return TSI_INVALID_ARGUMENT;
+  }
+  if (self->vtable->get_ktls_crypto_info == nullptr) return TSI_UNIMPLEMENTED;
+  return self->vtable->get_ktls_crypto_info(self, tx, rx);
+}
+
 void tsi_handshaker_result_destroy(tsi_handshaker_result* self) {
   if (self == nullptr) return;
   self->vtable->destroy(self);
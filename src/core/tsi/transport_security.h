@@ -117,6 +117,11 @@ struct tsi_handshaker_result_vtable {
                                  const unsigned char** bytes,
                                  size_t* bytes_size);
   void (*destroy)(tsi_handshaker_result* self);
+  /* May be null if the record protection state cannot be exported for kernel
+     TLS offload. */
+  tsi_result (*get_ktls_crypto_info)(const tsi_handshaker_result* self,
+                                     tsi_ktls_crypto_info* tx,
+                                     tsi_ktls_crypto_info* rx);
 };
 struct tsi_handshaker_result {
   const tsi_handshaker_result_vtable* vtable;
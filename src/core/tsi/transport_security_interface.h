@@ -275,6 +275,33 @@ tsi_result tsi_handshaker_result_get_unused_bytes(
     const tsi_handshaker_result* self, const unsigned char** bytes,
     size_t* bytes_size);
 
+/* Ciphers whose record protection can be offloaded to the kernel. */
+typedef enum {
+  TSI_KTLS_CIPHER_AES_GCM_128,
+  TSI_KTLS_CIPHER_AES_GCM_256,
+} tsi_ktls_cipher;
+
+/* Record protection state of one direction of an established TLS session, in
+   the layout used by the Linux kernel TLS (kTLS) socket options. Byte arrays
+   are in wire order.  */
+typedef struct {
+  uint16_t tls_version; /* e.g. 0x0303 for TLS 1.2 */
+  tsi_ktls_cipher cipher;
+  unsigned char key[32]; /* AES-GCM-128 only uses the first 16 bytes. */
+  unsigned char salt[4]; /* Implicit part of the record nonce. */
+  unsigned char iv[8];   /* Explicit part of the next record nonce. */
+  unsigned char rec_seq[8];
+} tsi_ktls_crypto_info;
+
+/* This method exports the record protection state of the session, so that
+   record protection can be handed over to the kernel. It returns
+   TSI_UNIMPLEMENTED if the implementation, protocol version or cipher suite
+   does not allow it. On success, the caller must not create a frame protector
+   from this handshaker result.  */
+tsi_result tsi_handshaker_result_get_ktls_crypto_info(
+    const tsi_handshaker_result* self, tsi_ktls_crypto_info* tx,
+    tsi_ktls_crypto_info* rx);
+
 /* This method releases the tsi_handshaker_handshaker object. After this method
    is called, no other method can be called on the object.  */
 void tsi_handshaker_result_destroy(tsi_handshaker_result* self);
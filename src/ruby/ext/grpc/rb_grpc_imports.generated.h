@@ -515,6 +515,9 @@ extern grpc_tls_credentials_options_set_verify_server_cert_type grpc_tls_credent
 typedef void(*grpc_tls_credentials_options_set_check_call_host_type)(grpc_tls_credentials_options* options, int check_call_host);
 extern grpc_tls_credentials_options_set_check_call_host_type grpc_tls_credentials_options_set_check_call_host_import;
 #define grpc_tls_credentials_options_set_check_call_host grpc_tls_credentials_options_set_check_call_host_import
+typedef void(*grpc_tls_credentials_options_set_verification_result_cache_size_type)(grpc_tls_credentials_options* options, size_t max_entries);
+extern grpc_tls_credentials_options_set_verification_result_cache_size_type grpc_tls_credentials_options_set_verification_result_cache_size_import;
+#define grpc_tls_credentials_options_set_verification_result_cache_size grpc_tls_credentials_options_set_verification_result_cache_size_import
 typedef grpc_channel_credentials*(*grpc_xds_credentials_create_type)(grpc_channel_credentials* fallback_credentials);
 extern grpc_xds_credentials_create_type grpc_xds_credentials_create_import;
 #define grpc_xds_credentials_create grpc_xds_credentials_create_import
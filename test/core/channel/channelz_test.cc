@@ -21,6 +21,8 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <map>
+
 #include <gtest/gtest.h>
 
 #include <grpc/support/alloc.h>
@@ -550,6 +552,36 @@ TEST_F(ChannelzRegistryBasedTest, ManyServersTest) {
   ValidateGetServers(10);
 }
 
+TEST(ChannelzSocketTest, HeaderCompressionStatsRenderedAsOptions) {
+  ExecCtx exec_ctx;
+  RefCountedPtr<SocketNode> socket = MakeRefCounted<SocketNode>(
+      "ipv4:127.0.0.1:1", "ipv4:127.0.0.1:2", "test socket", nullptr);
+  // Nothing is reported until headers were encoded.
+  Json json = socket->RenderJson();
+  EXPECT_EQ(json.object_value().at("data").object_value().count("option"),
+            0u);
+  SocketNode::HeaderCompressionStats* stats =
+      socket->header_compression_stats();
+  stats->uncompressed_bytes.fetch_add(1000);
+  stats->compressed_bytes.fetch_add(250);
+  stats->table_hits.store(7);
+  stats->table_insertions.store(3);
+  stats->table_evictions.store(1);
+  json = socket->RenderJson();
+  const Json& data = json.object_value().at("data");
+  std::map<std::string, std::string> options;
+  for (const Json& option : data.object_value().at("option").array_value()) {
+    options[option.object_value().at("name").string_value()] =
+        option.object_value().at("value").string_value();
+  }
+  EXPECT_EQ(options["header_uncompressed_bytes"], "1000");
+  EXPECT_EQ(options["header_compressed_bytes"], "250");
+  EXPECT_EQ(options["header_compression_ratio"], "0.250");
+  EXPECT_EQ(options["header_table_hits"], "7");
+  EXPECT_EQ(options["header_table_insertions"], "3");
+  EXPECT_EQ(options["header_table_evictions"], "1");
+}
+
 INSTANTIATE_TEST_SUITE_P(ChannelzChannelTestSweep, ChannelzChannelTest,
                          ::testing::Values(0, 8, 64, 1024, 1024 * 1024));
 
@@ -31,6 +31,8 @@
 #include "src/core/lib/iomgr/load_file.h"
 #include "src/core/lib/security/credentials/credentials.h"
 #include "src/core/lib/security/security_connector/ssl_utils_config.h"
+#include "src/core/tsi/ssl/session_cache/ssl_session_cache.h"
+#include "src/core/tsi/ssl_transport_security.h"
 #include "test/core/end2end/cq_verifier.h"
 #include "test/core/end2end/end2end_tests.h"
 #include "test/core/util/port.h"
@@ -109,8 +111,9 @@ grpc_channel* client_create(const char* server_addr,
       grpc_ssl_session_cache_create_channel_arg(cache),
   };
 
-  grpc_channel_args* client_args =
-      grpc_channel_args_copy_and_add(nullptr, args, GPR_ARRAY_SIZE(args));
+  // Without an explicit cache the channel uses the process-wide default one.
+  grpc_channel_args* client_args = grpc_channel_args_copy_and_add(
+      nullptr, args, cache != nullptr ? GPR_ARRAY_SIZE(args) : 1);
 
   grpc_channel* client = grpc_secure_channel_create(client_creds, server_addr,
                                                     client_args, nullptr);
@@ -283,6 +286,49 @@ TEST(H2SessionReuseTest, SingleReuse) {
   grpc_completion_queue_destroy(cq);
 }
 
+// Empties the process-wide session cache, so that the outcome of a test does
+// not depend on the sessions that earlier tests left in it.
+void clear_default_session_cache() {
+  reinterpret_cast<tsi::SslSessionLRUCache*>(
+      tsi_ssl_session_cache_get_default())
+      ->Clear();
+}
+
+TEST(H2SessionReuseTest, DefaultCacheReuse) {
+  clear_default_session_cache();
+  int port = grpc_pick_unused_port_or_die();
+
+  std::string server_addr = grpc_core::JoinHostPort("localhost", port);
+
+  grpc_completion_queue* cq = grpc_completion_queue_create_for_next(nullptr);
+
+  grpc_server* server = server_create(cq, server_addr.c_str());
+
+  // Channels that do not bring their own cache share the default one.
+  do_round_trip(cq, server, server_addr.c_str(), nullptr, false);
+  do_round_trip(cq, server, server_addr.c_str(), nullptr, true);
+  do_round_trip(cq, server, server_addr.c_str(), nullptr, true);
+
+  GPR_ASSERT(grpc_completion_queue_next(
+                 cq, grpc_timeout_milliseconds_to_deadline(100), nullptr)
+                 .type == GRPC_QUEUE_TIMEOUT);
+
+  grpc_completion_queue* shutdown_cq =
+      grpc_completion_queue_create_for_pluck(nullptr);
+  grpc_server_shutdown_and_notify(server, shutdown_cq, tag(1000));
+  GPR_ASSERT(grpc_completion_queue_pluck(shutdown_cq, tag(1000),
+                                         grpc_timeout_seconds_to_deadline(5),
+                                         nullptr)
+                 .type == GRPC_OP_COMPLETE);
+  grpc_server_destroy(server);
+  grpc_completion_queue_destroy(shutdown_cq);
+
+  grpc_completion_queue_shutdown(cq);
+  drain_cq(cq);
+  grpc_completion_queue_destroy(cq);
+  clear_default_session_cache();
+}
+
 }  // namespace
 }  // namespace testing
 }  // namespace grpc
@@ -0,0 +1,245 @@
+/*
+ *
+ * Copyright 2021 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include "src/core/lib/iomgr/port.h"
+
+/* This test only relevant on linux systems where epoll() is available */
+#ifdef GRPC_LINUX_EPOLL
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <grpc/grpc.h>
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+
+#include "src/core/lib/iomgr/ev_epoll1_linux.h"
+#include "src/core/lib/iomgr/ev_posix.h"
+#include "src/core/lib/iomgr/iomgr.h"
+#include "test/core/util/test_config.h"
+
+static gpr_mu* g_mu;
+static grpc_pollset* g_pollset;
+
+/* Enough writes to overflow the completion queue of the engine's ring, which
+   terminates the multishot poll request of the fd being written to */
+#define OVERFLOW_WRITE_CNT (2 * 4096)
+
+/* Matches IO_URING_MAX_POLL_RETRIES in ev_epoll1_linux.cc */
+#define MAX_POLL_RETRIES 2
+
+typedef struct {
+  grpc_closure closure;
+  bool done;
+} read_state;
+
+static void on_readable(void* arg, grpc_error_handle error) {
+  read_state* rs = static_cast<read_state*>(arg);
+  GPR_ASSERT(error == GRPC_ERROR_NONE);
+  gpr_mu_lock(g_mu);
+  rs->done = true;
+  GPR_ASSERT(
+      GRPC_LOG_IF_ERROR("pollset_kick", grpc_pollset_kick(g_pollset, nullptr)));
+  gpr_mu_unlock(g_mu);
+}
+
+/* Polls for up to 'timeout_ms'. Returns early, with true, once 'rs' (if not
+   null) is done. */
+static bool poll_for(read_state* rs, grpc_millis timeout_ms) {
+  grpc_core::ExecCtx exec_ctx;
+  grpc_millis deadline = grpc_core::ExecCtx::Get()->Now() + timeout_ms;
+  gpr_mu_lock(g_mu);
+  while ((rs == nullptr || !rs->done) &&
+         grpc_core::ExecCtx::Get()->Now() < deadline) {
+    grpc_pollset_worker* worker = nullptr;
+    GPR_ASSERT(GRPC_LOG_IF_ERROR(
+        "pollset_work", grpc_pollset_work(g_pollset, &worker, deadline)));
+    gpr_mu_unlock(g_mu);
+    grpc_core::ExecCtx::Get()->Flush();
+    grpc_core::ExecCtx::Get()->InvalidateNow();
+    gpr_mu_lock(g_mu);
+  }
+  bool done = rs != nullptr && rs->done;
+  gpr_mu_unlock(g_mu);
+  return done;
+}
+
+/* Waits for 'fd' to become readable. */
+static bool wait_readable(grpc_fd* fd) {
+  read_state rs;
+  rs.done = false;
+  GRPC_CLOSURE_INIT(&rs.closure, on_readable, &rs, grpc_schedule_on_exec_ctx);
+  {
+    grpc_core::ExecCtx exec_ctx;
+    grpc_fd_notify_on_read(fd, &rs.closure);
+  }
+  if (poll_for(&rs, 5000)) return true;
+  /* Don't leave the stack allocated closure registered */
+  grpc_core::ExecCtx exec_ctx;
+  grpc_fd_shutdown(fd, GRPC_ERROR_CREATE_FROM_STATIC_STRING("timed out"));
+  grpc_core::ExecCtx::Get()->Flush();
+  return false;
+}
+
+static void write_byte(int fd) {
+  char c = 'x';
+  GPR_ASSERT(write(fd, &c, 1) == 1);
+}
+
+static void drain(int fd) {
+  char buf[4096];
+  while (read(fd, buf, sizeof(buf)) > 0) {
+  }
+  GPR_ASSERT(errno == EAGAIN);
+}
+
+/* Creates a grpc_fd for the read end of a new pipe. The write end is returned
+   in 'peer'. Pipes take many small writes before they fill up. */
+static grpc_fd* create_fd(const char* name, int* peer) {
+  int p[2];
+  GPR_ASSERT(pipe2(p, O_NONBLOCK | O_CLOEXEC) == 0);
+  *peer = p[1];
+  grpc_core::ExecCtx exec_ctx;
+  grpc_fd* fd = grpc_fd_create(p[0], name, false);
+  grpc_pollset_add_fd(g_pollset, fd);
+  return fd;
+}
+
+static void destroy_fd(grpc_fd* fd, int peer) {
+  grpc_core::ExecCtx exec_ctx;
+  grpc_fd_orphan(fd, nullptr, nullptr, "test fd orphan");
+  close(peer);
+}
+
+/* An fd keeps receiving events after its multishot poll request was
+   terminated by an overflowing completion queue. */
+static void test_rearm_after_overflow() {
+  gpr_log(GPR_INFO, "test_rearm_after_overflow");
+  int peer;
+  grpc_fd* fd = create_fd("rearm", &peer);
+  for (int i = 0; i < OVERFLOW_WRITE_CNT; i++) {
+    write_byte(peer);
+  }
+  GPR_ASSERT(wait_readable(fd));
+  drain(grpc_fd_wrapped_fd(fd));
+  /* Let the poller reap the overflowed completions and re-arm */
+  poll_for(nullptr, 100);
+  write_byte(peer);
+  GPR_ASSERT(wait_readable(fd));
+  destroy_fd(fd, peer);
+}
+
+/* An orphaned fd is not reused until the poller saw the end of its poll
+   request: until then, completions for the old fd carry the same tag. */
+static void test_orphaned_fd_reused_after_poll_ended() {
+  gpr_log(GPR_INFO, "test_orphaned_fd_reused_after_poll_ended");
+  int peer1;
+  grpc_fd* fd1 = create_fd("orphan1", &peer1);
+  poll_for(nullptr, 10);
+  destroy_fd(fd1, peer1);
+  int peer2;
+  grpc_fd* fd2 = create_fd("orphan2", &peer2);
+  GPR_ASSERT(fd2 != fd1);
+  /* The poller reaps the cancellation and frees fd1 */
+  poll_for(nullptr, 10);
+  int peer3;
+  grpc_fd* fd3 = create_fd("orphan3", &peer3);
+  GPR_ASSERT(fd3 == fd1);
+  write_byte(peer3);
+  GPR_ASSERT(wait_readable(fd3));
+  destroy_fd(fd2, peer2);
+  destroy_fd(fd3, peer3);
+  poll_for(nullptr, 10);
+}
+
+/* A poll request that fails to be armed is retried. */
+static void test_failed_poll_retried() {
+  gpr_log(GPR_INFO, "test_failed_poll_retried");
+  int peer;
+  grpc_fd* fd = create_fd("retry", &peer);
+  grpc_io_uring_fail_poll_for_testing(fd, MAX_POLL_RETRIES);
+  poll_for(nullptr, 10);
+  write_byte(peer);
+  GPR_ASSERT(wait_readable(fd));
+  destroy_fd(fd, peer);
+  /* The fd was still watched by io_uring: it is only reused once its poll
+     request was cancelled */
+  int peer2;
+  grpc_fd* fd2 = create_fd("retry2", &peer2);
+  GPR_ASSERT(fd2 != fd);
+  destroy_fd(fd2, peer2);
+  poll_for(nullptr, 10);
+}
+
+/* An fd that io_uring keeps failing to poll is watched with epoll. */
+static void test_failed_polls_fall_back_to_epoll() {
+  gpr_log(GPR_INFO, "test_failed_polls_fall_back_to_epoll");
+  int peer;
+  grpc_fd* fd = create_fd("fallback", &peer);
+  grpc_io_uring_fail_poll_for_testing(fd, MAX_POLL_RETRIES + 1);
+  poll_for(nullptr, 10);
+  write_byte(peer);
+  GPR_ASSERT(wait_readable(fd));
+  drain(grpc_fd_wrapped_fd(fd));
+  write_byte(peer);
+  GPR_ASSERT(wait_readable(fd));
+  destroy_fd(fd, peer);
+  /* No poll request was left to cancel: the fd is reused right away */
+  int peer2;
+  grpc_fd* fd2 = create_fd("fallback2", &peer2);
+  GPR_ASSERT(fd2 == fd);
+  write_byte(peer2);
+  GPR_ASSERT(wait_readable(fd2));
+  destroy_fd(fd2, peer2);
+  poll_for(nullptr, 10);
+}
+
+static void destroy_pollset(void* p, grpc_error_handle /*error*/) {
+  grpc_pollset_destroy(static_cast<grpc_pollset*>(p));
+}
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  GPR_GLOBAL_CONFIG_SET(grpc_poll_strategy, "io_uring");
+  grpc_init();
+  {
+    grpc_core::ExecCtx exec_ctx;
+    if (grpc_io_uring_active_for_testing()) {
+      grpc_closure destroyed;
+      g_pollset = static_cast<grpc_pollset*>(gpr_zalloc(grpc_pollset_size()));
+      grpc_pollset_init(g_pollset, &g_mu);
+      test_rearm_after_overflow();
+      test_orphaned_fd_reused_after_poll_ended();
+      test_failed_poll_retried();
+      test_failed_polls_fall_back_to_epoll();
+      GRPC_CLOSURE_INIT(&destroyed, destroy_pollset, g_pollset,
+                        grpc_schedule_on_exec_ctx);
+      grpc_pollset_shutdown(g_pollset, &destroyed);
+      grpc_core::ExecCtx::Get()->Flush();
+      gpr_free(g_pollset);
+    } else {
+      gpr_log(GPR_INFO,
+              "Skipping the test. io_uring is not available on this kernel.");
+    }
+  }
+  grpc_shutdown();
+  return 0;
+}
+#else /* GRPC_LINUX_EPOLL */
+int main(int /*argc*/, char** /*argv*/) { return 0; }
+#endif
@@ -0,0 +1,174 @@
+/*
+ *
+ * Copyright 2021 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "src/core/lib/iomgr/exec_ctx.h"
+
+#include <inttypes.h>
+#include <string.h>
+
+#include <grpc/grpc.h>
+#include <grpc/support/log.h>
+
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/iomgr/combiner.h"
+#include "test/core/util/test_config.h"
+
+#define MAX_EVENTS 16
+
+/* Names of the closures in the order they ran */
+static const char* g_events[MAX_EVENTS];
+static size_t g_num_events;
+
+static void reset_events(void) { g_num_events = 0; }
+
+static void record(const char* name) {
+  GPR_ASSERT(g_num_events < MAX_EVENTS);
+  g_events[g_num_events++] = name;
+}
+
+static void expect_events(const char* const* expected, size_t n) {
+  for (size_t i = 0; i < g_num_events; i++) {
+    gpr_log(GPR_DEBUG, "event %" PRIuPTR ": %s", i, g_events[i]);
+  }
+  GPR_ASSERT(g_num_events == n);
+  for (size_t i = 0; i < n; i++) {
+    GPR_ASSERT(strcmp(g_events[i], expected[i]) == 0);
+  }
+}
+
+static grpc_core::Combiner* g_lock;
+
+static grpc_closure g_run;
+static grpc_closure g_run_nested;
+static grpc_closure g_combined;
+static grpc_closure g_combined_nested;
+static grpc_closure g_drained;
+static grpc_closure g_drained_nested;
+static grpc_closure g_drained_again;
+
+static void on_run_nested(void* /*arg*/, grpc_error_handle /*error*/) {
+  record("run_nested");
+}
+
+static void on_run(void* /*arg*/, grpc_error_handle /*error*/) {
+  record("run");
+  grpc_core::ExecCtx::Run(DEBUG_LOCATION, &g_run_nested, GRPC_ERROR_NONE);
+}
+
+static void on_combined_nested(void* /*arg*/, grpc_error_handle /*error*/) {
+  record("combined_nested");
+}
+
+static void on_combined(void* /*arg*/, grpc_error_handle /*error*/) {
+  record("combined");
+  g_lock->FinallyRun(&g_combined_nested, GRPC_ERROR_NONE);
+}
+
+static void on_drained(void* arg, grpc_error_handle error) {
+  record("drained");
+  GPR_ASSERT(error == static_cast<grpc_error_handle>(arg));
+}
+
+static void on_drained_again(void* /*arg*/, grpc_error_handle /*error*/) {
+  record("drained_again");
+}
+
+static void on_drained_nested(void* /*arg*/, grpc_error_handle /*error*/) {
+  record("drained_nested");
+}
+
+static void on_drained_reentrant(void* /*arg*/, grpc_error_handle /*error*/) {
+  record("drained");
+  grpc_core::ExecCtx::Get()->RunWhenDrained(&g_drained_again,
+                                            GRPC_ERROR_NONE);
+  grpc_core::ExecCtx::Run(DEBUG_LOCATION, &g_drained_nested, GRPC_ERROR_NONE);
+}
+
+/* A drained closure scheduled first still runs after the closure list and the
+   combiners, including the work they scheduled in turn. */
+static void test_runs_after_closures_and_combiners(void) {
+  gpr_log(GPR_DEBUG, "test_runs_after_closures_and_combiners");
+  reset_events();
+  g_lock = grpc_combiner_create();
+  grpc_error_handle error = GRPC_ERROR_CREATE_FROM_STATIC_STRING("drained");
+  GRPC_CLOSURE_INIT(&g_drained, on_drained, error, nullptr);
+  GRPC_CLOSURE_INIT(&g_run, on_run, nullptr, nullptr);
+  GRPC_CLOSURE_INIT(&g_run_nested, on_run_nested, nullptr, nullptr);
+  GRPC_CLOSURE_INIT(&g_combined, on_combined, nullptr, nullptr);
+  GRPC_CLOSURE_INIT(&g_combined_nested, on_combined_nested, nullptr, nullptr);
+  {
+    grpc_core::ExecCtx exec_ctx;
+    exec_ctx.RunWhenDrained(&g_drained, GRPC_ERROR_REF(error));
+    GPR_ASSERT(exec_ctx.HasWork());
+    grpc_core::ExecCtx::Run(DEBUG_LOCATION, &g_run, GRPC_ERROR_NONE);
+    g_lock->Run(&g_combined, GRPC_ERROR_NONE);
+    GPR_ASSERT(exec_ctx.Flush());
+    GPR_ASSERT(!exec_ctx.HasWork());
+    GRPC_COMBINER_UNREF(g_lock, "test_runs_after_closures_and_combiners");
+  }
+  GRPC_ERROR_UNREF(error);
+  static const char* const kExpected[] = {"run", "run_nested", "combined",
+                                          "combined_nested", "drained"};
+  expect_events(kExpected, GPR_ARRAY_SIZE(kExpected));
+}
+
+/* Work scheduled by a drained closure runs in the same flush, and a drained
+   closure it schedules runs once that work is done. */
+static void test_reentrant_scheduling(void) {
+  gpr_log(GPR_DEBUG, "test_reentrant_scheduling");
+  reset_events();
+  GRPC_CLOSURE_INIT(&g_drained, on_drained_reentrant, nullptr, nullptr);
+  GRPC_CLOSURE_INIT(&g_drained_again, on_drained_again, nullptr, nullptr);
+  GRPC_CLOSURE_INIT(&g_drained_nested, on_drained_nested, nullptr, nullptr);
+  grpc_core::ExecCtx exec_ctx;
+  exec_ctx.RunWhenDrained(&g_drained, GRPC_ERROR_NONE);
+  GPR_ASSERT(exec_ctx.Flush());
+  GPR_ASSERT(!exec_ctx.HasWork());
+  static const char* const kExpected[] = {"drained", "drained_nested",
+                                          "drained_again"};
+  expect_events(kExpected, GPR_ARRAY_SIZE(kExpected));
+}
+
+/* Drained closures that were never flushed explicitly run when the exec_ctx
+   goes away. */
+static void test_runs_at_destruction(void) {
+  gpr_log(GPR_DEBUG, "test_runs_at_destruction");
+  reset_events();
+  GRPC_CLOSURE_INIT(&g_drained, on_drained, nullptr, nullptr);
+  GRPC_CLOSURE_INIT(&g_run, on_run, nullptr, nullptr);
+  GRPC_CLOSURE_INIT(&g_run_nested, on_run_nested, nullptr, nullptr);
+  {
+    grpc_core::ExecCtx exec_ctx;
+    exec_ctx.RunWhenDrained(&g_drained, GRPC_ERROR_NONE);
+    grpc_core::ExecCtx::Run(DEBUG_LOCATION, &g_run, GRPC_ERROR_NONE);
+    GPR_ASSERT(g_num_events == 0);
+  }
+  static const char* const kExpected[] = {"run", "run_nested", "drained"};
+  expect_events(kExpected, GPR_ARRAY_SIZE(kExpected));
+}
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  grpc_init();
+  test_runs_after_closures_and_combiners();
+  test_reentrant_scheduling();
+  test_runs_at_destruction();
+  grpc_shutdown();
+
+  return 0;
+}
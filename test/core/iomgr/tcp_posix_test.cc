@@ -23,21 +23,31 @@
 
 #include <errno.h>
 #include <fcntl.h>
+#include <netinet/tcp.h>
 #include <string.h>
 #include <sys/socket.h>
 #include <sys/types.h>
 #include <unistd.h>
 
+#if defined(GPR_LINUX) && defined(TCP_ZEROCOPY_RECEIVE) && \
+    defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+#include <sys/mman.h>
+#define GRPC_TCP_RX_ZEROCOPY 1
+#endif
+
 #include <grpc/grpc.h>
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 #include <grpc/support/time.h>
 
+#include "src/core/lib/debug/stats.h"
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/iomgr/buffer_list.h"
 #include "src/core/lib/iomgr/ev_posix.h"
 #include "src/core/lib/iomgr/sockaddr_posix.h"
 #include "src/core/lib/iomgr/tcp_posix.h"
+#include "src/core/lib/resource_quota/api.h"
+#include "src/core/lib/resource_quota/resource_quota.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "test/core/iomgr/endpoint_tests.h"
 #include "test/core/util/test_config.h"
@@ -147,6 +157,38 @@ static size_t fill_socket_partial(int fd, size_t bytes) {
   return total_bytes;
 }
 
+#ifdef GRPC_TCP_RX_ZEROCOPY
+/* Like fill_socket_partial, but sends from page aligned memory with
+   MSG_ZEROCOPY. Over loopback, the kernel then hands the receiver whole page
+   fragments that it can map, whereas copied sends are packed into fragments
+   that never are. The returned buffer must be released with munmap(*buf,
+   bytes) once the data was read. Returns 0, without writing anything, if the
+   kernel does not support zerocopy sends. */
+static size_t fill_socket_zerocopy(int fd, size_t bytes, void** buf) {
+  int enable = 1;
+  if (setsockopt(fd, SOL_SOCKET, SO_ZEROCOPY, &enable, sizeof(enable)) != 0) {
+    return 0;
+  }
+  *buf = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+              MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  GPR_ASSERT(*buf != MAP_FAILED);
+  unsigned char* data = static_cast<unsigned char*>(*buf);
+  for (size_t i = 0; i < bytes; ++i) {
+    data[i] = static_cast<uint8_t>(i % 256);
+  }
+  ssize_t write_bytes;
+  size_t total_bytes = 0;
+  do {
+    write_bytes =
+        send(fd, data + total_bytes, bytes - total_bytes, MSG_ZEROCOPY);
+    if (write_bytes > 0) {
+      total_bytes += static_cast<size_t>(write_bytes);
+    }
+  } while ((write_bytes >= 0 || errno == EINTR) && bytes > total_bytes);
+  return total_bytes;
+}
+#endif /* GRPC_TCP_RX_ZEROCOPY */
+
 struct read_socket_state {
   grpc_endpoint* ep;
   size_t read_bytes;
@@ -254,6 +296,361 @@ static void read_test(size_t num_bytes, size_t slice_size) {
       static_cast<grpc_resource_quota*>(a[1].value.pointer.p));
 }
 
+/* Write to a socket, then read from it using the grpc_tcp API with a read
+   buffer pool. Every read after the first one must reuse the buffers released
+   by the previous read. The last slice read is kept alive past the destruction
+   of the endpoint, so that it is released to an orphaned pool. */
+static void read_buffer_pool_read_test(size_t num_bytes, size_t slice_size) {
+  int sv[2];
+  grpc_endpoint* ep;
+  struct read_socket_state state;
+  size_t written_bytes;
+  grpc_millis deadline =
+      grpc_timespec_to_millis_round_up(grpc_timeout_seconds_to_deadline(20));
+  grpc_core::ExecCtx exec_ctx;
+
+  gpr_log(GPR_INFO,
+          "Read buffer pool read test of size %" PRIuPTR
+          ", slice size %" PRIuPTR,
+          num_bytes, slice_size);
+
+  create_sockets(sv);
+
+  grpc_arg a[3];
+  a[0].key = const_cast<char*>(GRPC_ARG_TCP_READ_CHUNK_SIZE);
+  a[0].type = GRPC_ARG_INTEGER;
+  a[0].value.integer = static_cast<int>(slice_size);
+  a[1].key = const_cast<char*>(GRPC_ARG_TCP_READ_BUFFER_POOL_SIZE);
+  a[1].type = GRPC_ARG_INTEGER;
+  a[1].value.integer = 4;
+  a[2].key = const_cast<char*>(GRPC_ARG_RESOURCE_QUOTA);
+  a[2].type = GRPC_ARG_POINTER;
+  a[2].value.pointer.p = grpc_resource_quota_create("test");
+  a[2].value.pointer.vtable = grpc_resource_quota_arg_vtable();
+  grpc_channel_args args = {GPR_ARRAY_SIZE(a), a};
+  ep = grpc_tcp_create(
+      grpc_fd_create(sv[1], "read_buffer_pool_read_test", false), &args,
+      "test");
+  grpc_endpoint_add_to_pollset(ep, g_pollset);
+
+#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
+  grpc_stats_data before;
+  grpc_stats_collect(&before);
+#endif /* defined(GRPC_COLLECT_STATS) || !defined(NDEBUG) */
+
+  written_bytes = fill_socket_partial(sv[0], num_bytes);
+  gpr_log(GPR_INFO, "Wrote %" PRIuPTR " bytes", written_bytes);
+
+  state.ep = ep;
+  state.read_bytes = 0;
+  state.target_read_bytes = written_bytes;
+  grpc_slice_buffer_init(&state.incoming);
+  GRPC_CLOSURE_INIT(&state.read_cb, read_cb, &state, grpc_schedule_on_exec_ctx);
+
+  grpc_endpoint_read(ep, &state.incoming, &state.read_cb, /*urgent=*/false);
+
+  gpr_mu_lock(g_mu);
+  while (state.read_bytes < state.target_read_bytes) {
+    grpc_pollset_worker* worker = nullptr;
+    GPR_ASSERT(GRPC_LOG_IF_ERROR(
+        "pollset_work", grpc_pollset_work(g_pollset, &worker, deadline)));
+    gpr_mu_unlock(g_mu);
+
+    gpr_mu_lock(g_mu);
+  }
+  GPR_ASSERT(state.read_bytes == state.target_read_bytes);
+  gpr_mu_unlock(g_mu);
+
+#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
+  grpc_stats_data after;
+  grpc_stats_collect(&after);
+  int64_t allocs =
+      after.counters[GRPC_STATS_COUNTER_TCP_READ_BUFFER_POOL_ALLOCS] -
+      before.counters[GRPC_STATS_COUNTER_TCP_READ_BUFFER_POOL_ALLOCS];
+  int64_t reuses =
+      after.counters[GRPC_STATS_COUNTER_TCP_READ_BUFFER_POOL_REUSES] -
+      before.counters[GRPC_STATS_COUNTER_TCP_READ_BUFFER_POOL_REUSES];
+  gpr_log(GPR_INFO,
+          "Read buffer pool: %" PRId64 " allocs, %" PRId64 " reuses", allocs,
+          reuses);
+  GPR_ASSERT(allocs > 0);
+  if (written_bytes > slice_size) {
+    GPR_ASSERT(reuses > 0);
+  } else {
+    GPR_ASSERT(reuses == 0);
+  }
+#endif /* defined(GRPC_COLLECT_STATS) || !defined(NDEBUG) */
+
+  GPR_ASSERT(state.incoming.count > 0);
+  grpc_slice last = grpc_slice_ref_internal(
+      state.incoming.slices[state.incoming.count - 1]);
+  grpc_slice_buffer_destroy_internal(&state.incoming);
+  grpc_endpoint_destroy(ep);
+  grpc_core::ExecCtx::Get()->Flush();
+  grpc_slice_unref_internal(last);
+  grpc_resource_quota_unref(
+      static_cast<grpc_resource_quota*>(a[2].value.pointer.p));
+}
+
+/* Writes num_bytes to 'fd' and reads them back from 'ep', leaving the last
+   read in state->incoming. */
+static void write_and_read(int fd, grpc_endpoint* ep,
+                           struct read_socket_state* state, size_t num_bytes) {
+  grpc_millis deadline =
+      grpc_timespec_to_millis_round_up(grpc_timeout_seconds_to_deadline(20));
+  state->ep = ep;
+  state->read_bytes = 0;
+  state->target_read_bytes = fill_socket_partial(fd, num_bytes);
+  GPR_ASSERT(state->target_read_bytes == num_bytes);
+  GRPC_CLOSURE_INIT(&state->read_cb, read_cb, state,
+                    grpc_schedule_on_exec_ctx);
+  grpc_endpoint_read(ep, &state->incoming, &state->read_cb, /*urgent=*/false);
+  gpr_mu_lock(g_mu);
+  while (state->read_bytes < state->target_read_bytes) {
+    grpc_pollset_worker* worker = nullptr;
+    GPR_ASSERT(GRPC_LOG_IF_ERROR(
+        "pollset_work", grpc_pollset_work(g_pollset, &worker, deadline)));
+    gpr_mu_unlock(g_mu);
+
+    gpr_mu_lock(g_mu);
+  }
+  GPR_ASSERT(state->read_bytes == state->target_read_bytes);
+  gpr_mu_unlock(g_mu);
+}
+
+/* Idle buffers of a read buffer pool are freed when the memory quota reclaims
+   memory, so that the next read allocates a new buffer. Reads fill whole
+   buffers: the unused tail of a buffer would be kept for the next read. */
+static void read_buffer_pool_reclaim_test(void) {
+#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
+  const size_t buffer_size = 8192;
+  int sv[2];
+  struct read_socket_state state;
+  grpc_core::ExecCtx exec_ctx;
+
+  gpr_log(GPR_INFO, "Read buffer pool reclaim test");
+
+  create_sockets(sv);
+
+  grpc_resource_quota* resource_quota = grpc_resource_quota_create("test");
+  grpc_arg a[3];
+  a[0].key = const_cast<char*>(GRPC_ARG_TCP_READ_CHUNK_SIZE);
+  a[0].type = GRPC_ARG_INTEGER;
+  a[0].value.integer = static_cast<int>(buffer_size);
+  a[1].key = const_cast<char*>(GRPC_ARG_TCP_READ_BUFFER_POOL_SIZE);
+  a[1].type = GRPC_ARG_INTEGER;
+  a[1].value.integer = 4;
+  a[2].key = const_cast<char*>(GRPC_ARG_RESOURCE_QUOTA);
+  a[2].type = GRPC_ARG_POINTER;
+  a[2].value.pointer.p = resource_quota;
+  a[2].value.pointer.vtable = grpc_resource_quota_arg_vtable();
+  grpc_channel_args args = {GPR_ARRAY_SIZE(a), a};
+  grpc_endpoint* ep = grpc_tcp_create(
+      grpc_fd_create(sv[1], "read_buffer_pool_reclaim_test", false), &args,
+      "test");
+  grpc_endpoint_add_to_pollset(ep, g_pollset);
+  grpc_slice_buffer_init(&state.incoming);
+
+  const int allocs = GRPC_STATS_COUNTER_TCP_READ_BUFFER_POOL_ALLOCS;
+  const int reuses = GRPC_STATS_COUNTER_TCP_READ_BUFFER_POOL_REUSES;
+  grpc_stats_data before;
+  grpc_stats_data after;
+  /* The first read allocates a buffer, which is idle once released */
+  grpc_stats_collect(&before);
+  write_and_read(sv[0], ep, &state, buffer_size);
+  grpc_slice_buffer_reset_and_unref_internal(&state.incoming);
+  grpc_stats_collect(&after);
+  GPR_ASSERT(after.counters[allocs] - before.counters[allocs] == 1);
+
+  /* Overcommit the memory quota to start a reclamation sweep */
+  {
+    grpc_resource_quota_resize(resource_quota, 1024);
+    grpc_core::MemoryOwner memory_owner =
+        grpc_core::ResourceQuotaFromChannelArgs(&args)
+            ->memory_quota()
+            ->CreateMemoryOwner("reclaim");
+    auto reservation =
+        memory_owner.MakeReservation(grpc_core::MemoryRequest(1024 * 1024));
+    grpc_core::ExecCtx::Get()->Flush();
+  }
+  grpc_resource_quota_resize(resource_quota, 1024 * 1024 * 1024);
+
+  /* The idle buffer is gone: the next read allocates again */
+  grpc_stats_collect(&before);
+  write_and_read(sv[0], ep, &state, buffer_size);
+  grpc_stats_collect(&after);
+  GPR_ASSERT(after.counters[allocs] - before.counters[allocs] == 1);
+  GPR_ASSERT(after.counters[reuses] == before.counters[reuses]);
+
+  grpc_slice_buffer_destroy_internal(&state.incoming);
+  grpc_endpoint_destroy(ep);
+  close(sv[0]);
+  grpc_resource_quota_unref(resource_quota);
+#endif /* defined(GRPC_COLLECT_STATS) || !defined(NDEBUG) */
+}
+
+/* Returns true if the kernel lets a TCP socket map its receive queue. */
+static bool rx_zerocopy_supported(void) {
+#ifdef GRPC_TCP_RX_ZEROCOPY
+  int sv[2];
+  create_inet_sockets(sv);
+  size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  bool supported = false;
+  void* addr = mmap(nullptr, page_size, PROT_READ, MAP_SHARED, sv[1], 0);
+  if (addr != MAP_FAILED) {
+    struct tcp_zerocopy_receive zc;
+    memset(&zc, 0, sizeof(zc));
+    zc.address = reinterpret_cast<uint64_t>(addr);
+    zc.length = static_cast<uint32_t>(page_size);
+    socklen_t zc_len = sizeof(zc);
+    supported = getsockopt(sv[1], IPPROTO_TCP, TCP_ZEROCOPY_RECEIVE, &zc,
+                           &zc_len) == 0 ||
+                errno == EAGAIN;
+    munmap(addr, page_size);
+  }
+  close(sv[0]);
+  close(sv[1]);
+  return supported;
+#else
+  return false;
+#endif /* GRPC_TCP_RX_ZEROCOPY */
+}
+
+struct rx_zerocopy_read_state {
+  struct read_socket_state read;
+  /* Every slice read, kept alive until the end of the test */
+  grpc_slice_buffer retained;
+};
+
+static void rx_zerocopy_read_cb(void* user_data, grpc_error_handle error) {
+  struct rx_zerocopy_read_state* state =
+      static_cast<struct rx_zerocopy_read_state*>(user_data);
+  for (size_t i = 0; i < state->read.incoming.count; ++i) {
+    grpc_slice_buffer_add(
+        &state->retained,
+        grpc_slice_ref_internal(state->read.incoming.slices[i]));
+  }
+  read_cb(&state->read, error);
+}
+
+/* Write to a TCP socket, then read from it using the grpc_tcp API with
+   receive zerocopy enabled. The bytes read must match the bytes written, and
+   once at least rx_zerocopy_threshold bytes are pending some of them must be
+   mapped rather than copied whenever the kernel supports it. */
+static void rx_zerocopy_read_test(size_t num_bytes) {
+  const int rx_zerocopy_threshold = 4096;
+  int sv[2];
+  grpc_endpoint* ep;
+  struct rx_zerocopy_read_state state;
+  size_t written_bytes;
+  grpc_millis deadline =
+      grpc_timespec_to_millis_round_up(grpc_timeout_seconds_to_deadline(20));
+  grpc_core::ExecCtx exec_ctx;
+
+  gpr_log(GPR_INFO, "Rx zerocopy read test of size %" PRIuPTR, num_bytes);
+
+  create_inet_sockets(sv);
+
+  grpc_arg a[3];
+  a[0].key = const_cast<char*>(GRPC_ARG_TCP_RX_ZEROCOPY_ENABLED);
+  a[0].type = GRPC_ARG_INTEGER;
+  a[0].value.integer = 1;
+  a[1].key = const_cast<char*>(GRPC_ARG_TCP_RX_ZEROCOPY_BYTES_THRESHOLD);
+  a[1].type = GRPC_ARG_INTEGER;
+  a[1].value.integer = rx_zerocopy_threshold;
+  a[2].key = const_cast<char*>(GRPC_ARG_RESOURCE_QUOTA);
+  a[2].type = GRPC_ARG_POINTER;
+  a[2].value.pointer.p = grpc_resource_quota_create("test");
+  a[2].value.pointer.vtable = grpc_resource_quota_arg_vtable();
+  grpc_channel_args args = {GPR_ARRAY_SIZE(a), a};
+  ep = grpc_tcp_create(grpc_fd_create(sv[1], "rx_zerocopy_read_test", false),
+                       &args, "test");
+  grpc_endpoint_add_to_pollset(ep, g_pollset);
+
+#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
+  grpc_stats_data before;
+  grpc_stats_collect(&before);
+#endif /* defined(GRPC_COLLECT_STATS) || !defined(NDEBUG) */
+
+  void* zerocopy_buf = nullptr;
+  written_bytes = 0;
+#ifdef GRPC_TCP_RX_ZEROCOPY
+  written_bytes = fill_socket_zerocopy(sv[0], num_bytes, &zerocopy_buf);
+#endif /* GRPC_TCP_RX_ZEROCOPY */
+  const bool sent_zerocopy = written_bytes > 0;
+  if (!sent_zerocopy) {
+    written_bytes = fill_socket_partial(sv[0], num_bytes);
+  }
+  gpr_log(GPR_INFO, "Wrote %" PRIuPTR " bytes%s", written_bytes,
+          sent_zerocopy ? " zerocopy" : "");
+
+  state.read.ep = ep;
+  state.read.read_bytes = 0;
+  state.read.target_read_bytes = written_bytes;
+  grpc_slice_buffer_init(&state.read.incoming);
+  grpc_slice_buffer_init(&state.retained);
+  GRPC_CLOSURE_INIT(&state.read.read_cb, rx_zerocopy_read_cb, &state,
+                    grpc_schedule_on_exec_ctx);
+
+  grpc_endpoint_read(ep, &state.read.incoming, &state.read.read_cb,
+                     /*urgent=*/false);
+
+  gpr_mu_lock(g_mu);
+  while (state.read.read_bytes < state.read.target_read_bytes) {
+    grpc_pollset_worker* worker = nullptr;
+    GPR_ASSERT(GRPC_LOG_IF_ERROR(
+        "pollset_work", grpc_pollset_work(g_pollset, &worker, deadline)));
+    gpr_mu_unlock(g_mu);
+
+    gpr_mu_lock(g_mu);
+  }
+  GPR_ASSERT(state.read.read_bytes == state.read.target_read_bytes);
+  gpr_mu_unlock(g_mu);
+
+#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
+  grpc_stats_data after;
+  grpc_stats_collect(&after);
+  int64_t zerocopy_bytes =
+      after.counters[GRPC_STATS_COUNTER_TCP_RX_ZEROCOPY_BYTES] -
+      before.counters[GRPC_STATS_COUNTER_TCP_RX_ZEROCOPY_BYTES];
+  int64_t copied_bytes =
+      after.counters[GRPC_STATS_COUNTER_TCP_RX_COPIED_BYTES] -
+      before.counters[GRPC_STATS_COUNTER_TCP_RX_COPIED_BYTES];
+  gpr_log(GPR_INFO, "Read %" PRId64 " bytes zerocopy, %" PRId64 " copied",
+          zerocopy_bytes, copied_bytes);
+  GPR_ASSERT(zerocopy_bytes + copied_bytes ==
+             static_cast<int64_t>(written_bytes));
+  if (written_bytes < static_cast<size_t>(rx_zerocopy_threshold)) {
+    GPR_ASSERT(zerocopy_bytes == 0);
+  } else if (sent_zerocopy && rx_zerocopy_supported()) {
+    /* Only the parts of the stream that do not fill a page are copied */
+    GPR_ASSERT(zerocopy_bytes > copied_bytes);
+    /* Everything read is still referenced from state.retained. Mapped pages
+       are charged to the endpoint's quota like copied ones, so the quota is
+       (more than) 90% used once it is shrunk to 10/9 of the bytes read. */
+    grpc_resource_quota* resource_quota =
+        static_cast<grpc_resource_quota*>(a[2].value.pointer.p);
+    grpc_resource_quota_resize(resource_quota, written_bytes * 10 / 9);
+    GPR_ASSERT(grpc_core::ResourceQuota::FromC(resource_quota)
+                   ->memory_quota()
+                   ->IsMemoryPressureHigh());
+    grpc_resource_quota_resize(resource_quota, 1024 * 1024 * 1024);
+  } else {
+    gpr_log(GPR_INFO, "Zerocopy is not supported by the kernel");
+  }
+#endif /* defined(GRPC_COLLECT_STATS) || !defined(NDEBUG) */
+
+  grpc_slice_buffer_destroy_internal(&state.retained);
+  grpc_slice_buffer_destroy_internal(&state.read.incoming);
+  grpc_endpoint_destroy(ep);
+  close(sv[0]);
+#ifdef GRPC_TCP_RX_ZEROCOPY
+  if (zerocopy_buf != nullptr) munmap(zerocopy_buf, num_bytes);
+#endif /* GRPC_TCP_RX_ZEROCOPY */
+  grpc_resource_quota_unref(
+      static_cast<grpc_resource_quota*>(a[2].value.pointer.p));
+}
+
 /* Write to a socket until it fills up, then read from it using the grpc_tcp
    API. */
 static void large_read_test(size_t slice_size) {
@@ -590,6 +987,12 @@ void run_tests(void) {
   read_test(10000, 1);
   large_read_test(8192);
   large_read_test(1);
+  read_buffer_pool_read_test(100, 8192);
+  read_buffer_pool_read_test(100000, 8192);
+  read_buffer_pool_read_test(100000, 137);
+  read_buffer_pool_reclaim_test();
+  rx_zerocopy_read_test(100);
+  rx_zerocopy_read_test(1000000);
 
   write_test(100, 8192, false);
   write_test(100, 1, false);
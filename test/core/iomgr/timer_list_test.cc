@@ -18,7 +18,7 @@
 
 #include "src/core/lib/iomgr/port.h"
 
-// This test only works with the generic timer implementation
+// This test only works with the generic and timing wheel implementations
 #ifndef GRPC_CUSTOM_SOCKET
 
 #include <string.h>
@@ -27,6 +27,7 @@
 #include <grpc/support/log.h>
 
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/iomgr/iomgr_internal.h"
 #include "src/core/lib/iomgr/timer.h"
 #include "test/core/util/test_config.h"
@@ -36,6 +37,7 @@
 
 extern grpc_core::TraceFlag grpc_timer_trace;
 extern grpc_core::TraceFlag grpc_timer_check_trace;
+extern grpc_timer_vtable grpc_wheel_timer_vtable;
 
 static int cb_called[MAX_CB][2];
 static const int64_t kMillisIn25Days = 2160000000;
@@ -153,6 +155,116 @@ void destruction_test(void) {
   GPR_ASSERT(1 == cb_called[2][0]);
 }
 
+/* Timers spread over every level of the timing wheel, and beyond it, fire at
+   their deadline and not a millisecond earlier. */
+static void cascade_test(void) {
+  const grpc_millis kDelays[] = {1,    63,   64,     65,      4095,
+                                 4096, 4097, 300000, 20000000};
+  constexpr size_t kNumTimers = GPR_ARRAY_SIZE(kDelays);
+  grpc_timer timers[kNumTimers];
+  grpc_core::ExecCtx exec_ctx;
+
+  gpr_log(GPR_INFO, "cascade_test");
+
+  grpc_timer_list_init();
+  memset(cb_called, 0, sizeof(cb_called));
+
+  grpc_millis start = grpc_core::ExecCtx::Get()->Now();
+  for (size_t i = 0; i < kNumTimers; i++) {
+    grpc_timer_init(
+        &timers[i], start + kDelays[i],
+        GRPC_CLOSURE_CREATE(cb, (void*)(intptr_t)i, grpc_schedule_on_exec_ctx));
+  }
+  for (size_t i = 0; i < kNumTimers; i++) {
+    grpc_core::ExecCtx::Get()->TestOnlySetNow(start + kDelays[i] - 1);
+    grpc_timer_check(nullptr);
+    grpc_core::ExecCtx::Get()->Flush();
+    GPR_ASSERT(cb_called[i][1] == 0);
+    grpc_core::ExecCtx::Get()->TestOnlySetNow(start + kDelays[i]);
+    GPR_ASSERT(grpc_timer_check(nullptr) == GRPC_TIMERS_FIRED);
+    grpc_core::ExecCtx::Get()->Flush();
+    GPR_ASSERT(cb_called[i][1] == 1);
+    GPR_ASSERT(cb_called[i][0] == 0);
+  }
+
+  grpc_timer_list_shutdown();
+}
+
+/* A single check made long after timers on every level of the timing wheel
+   were due fires all of them, and leaves the wheel in a state where timers
+   set afterwards still fire at their deadline. */
+static void late_check_test(void) {
+  const grpc_millis kDelays[] = {100, 5000, 300000, 20000000};
+  constexpr size_t kNumTimers = GPR_ARRAY_SIZE(kDelays);
+  grpc_timer timers[kNumTimers];
+  grpc_timer later_timers[kNumTimers];
+  grpc_core::ExecCtx exec_ctx;
+
+  gpr_log(GPR_INFO, "late_check_test");
+
+  grpc_timer_list_init();
+  memset(cb_called, 0, sizeof(cb_called));
+
+  grpc_millis start = grpc_core::ExecCtx::Get()->Now();
+  for (size_t i = 0; i < kNumTimers; i++) {
+    grpc_timer_init(
+        &timers[i], start + kDelays[i],
+        GRPC_CLOSURE_CREATE(cb, (void*)(intptr_t)i, grpc_schedule_on_exec_ctx));
+  }
+  grpc_millis now = start + kDelays[kNumTimers - 1] + 12345;
+  grpc_core::ExecCtx::Get()->TestOnlySetNow(now);
+  GPR_ASSERT(grpc_timer_check(nullptr) == GRPC_TIMERS_FIRED);
+  grpc_core::ExecCtx::Get()->Flush();
+  for (size_t i = 0; i < kNumTimers; i++) {
+    GPR_ASSERT(cb_called[i][1] == 1);
+  }
+
+  for (size_t i = 0; i < kNumTimers; i++) {
+    grpc_timer_init(&later_timers[i], now + kDelays[i],
+                    GRPC_CLOSURE_CREATE(cb, (void*)(intptr_t)(i + kNumTimers),
+                                        grpc_schedule_on_exec_ctx));
+  }
+  for (size_t i = 0; i < kNumTimers; i++) {
+    grpc_core::ExecCtx::Get()->TestOnlySetNow(now + kDelays[i] - 1);
+    grpc_timer_check(nullptr);
+    grpc_core::ExecCtx::Get()->Flush();
+    GPR_ASSERT(cb_called[i + kNumTimers][1] == 0);
+    grpc_core::ExecCtx::Get()->TestOnlySetNow(now + kDelays[i]);
+    GPR_ASSERT(grpc_timer_check(nullptr) == GRPC_TIMERS_FIRED);
+    grpc_core::ExecCtx::Get()->Flush();
+    GPR_ASSERT(cb_called[i + kNumTimers][1] == 1);
+  }
+
+  grpc_timer_list_shutdown();
+}
+
+/* A timer set after the list sat idle for longer than the timing wheel spans
+   reports its own deadline as the next one to check, and fires on time. */
+static void idle_test(void) {
+  grpc_timer timer;
+  grpc_core::ExecCtx exec_ctx;
+
+  gpr_log(GPR_INFO, "idle_test");
+
+  grpc_timer_list_init();
+  memset(cb_called, 0, sizeof(cb_called));
+
+  grpc_millis now = grpc_core::ExecCtx::Get()->Now() + 10 * 3600 * 1000;
+  grpc_core::ExecCtx::Get()->TestOnlySetNow(now);
+  grpc_timer_init(
+      &timer, now + 10,
+      GRPC_CLOSURE_CREATE(cb, (void*)(intptr_t)0, grpc_schedule_on_exec_ctx));
+  grpc_millis next = GRPC_MILLIS_INF_FUTURE;
+  GPR_ASSERT(grpc_timer_check(&next) != GRPC_TIMERS_FIRED);
+  GPR_ASSERT(next == now + 10);
+  grpc_core::ExecCtx::Get()->TestOnlySetNow(now + 10);
+  GPR_ASSERT(grpc_timer_check(nullptr) == GRPC_TIMERS_FIRED);
+  grpc_core::ExecCtx::Get()->Flush();
+  GPR_ASSERT(1 == cb_called[0][1]);
+
+  grpc_timer_list_shutdown();
+}
+
 /* Cleans up a list with pending timers that simulate long-running-services.
    This test does the following:
     1) Simulates grpc server start time to 25 days in the past (completed in
@@ -218,17 +330,21 @@ void long_running_service_cleanup_test(void) {
   GPR_ASSERT(1 == cb_called[3][0]);
 }
 
-int main(int argc, char** argv) {
+static void run_tests(int argc, char** argv, grpc_timer_vtable* timer_impl) {
   /* Tests with default g_start_time */
   {
     grpc::testing::TestEnvironment env(argc, argv);
     grpc_core::ExecCtx::GlobalInit();
     grpc_core::ExecCtx exec_ctx;
     grpc_set_default_iomgr_platform();
+    if (timer_impl != nullptr) grpc_set_timer_impl(timer_impl);
     grpc_iomgr_platform_init();
     gpr_set_log_verbosity(GPR_LOG_SEVERITY_DEBUG);
     add_test();
     destruction_test();
+    cascade_test();
+    late_check_test();
+    idle_test();
     grpc_iomgr_platform_shutdown();
   }
   grpc_core::ExecCtx::GlobalShutdown();
@@ -246,6 +362,7 @@ int main(int argc, char** argv) {
     grpc_core::ExecCtx::TestOnlyGlobalInit(new_start);
     grpc_core::ExecCtx exec_ctx;
     grpc_set_default_iomgr_platform();
+    if (timer_impl != nullptr) grpc_set_timer_impl(timer_impl);
     grpc_iomgr_platform_init();
     gpr_set_log_verbosity(GPR_LOG_SEVERITY_DEBUG);
     long_running_service_cleanup_test();
@@ -254,7 +371,11 @@ int main(int argc, char** argv) {
     grpc_iomgr_platform_shutdown();
   }
   grpc_core::ExecCtx::GlobalShutdown();
+}
 
+int main(int argc, char** argv) {
+  run_tests(argc, argv, nullptr);
+  run_tests(argc, argv, &grpc_wheel_timer_vtable);
   return 0;
 }
 
@@ -18,7 +18,9 @@
 
 #include "src/core/lib/iomgr/work_serializer.h"
 
+#include <algorithm>
 #include <memory>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -27,9 +29,11 @@
 #include <grpc/grpc.h>
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
+#include <grpc/support/thd_id.h>
 
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/thd.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
 #include "test/core/util/test_config.h"
 
 namespace {
@@ -190,6 +194,75 @@ TEST(WorkSerializerTest, ExecuteManyMixedRunScheduleAndDrain) {
   }
 }
 
+// Schedules \a n callbacks on \a lock that append their index to \a order,
+// and whether they ran on the current thread to \a on_this_thread, followed
+// by one that sets \a done.
+void ScheduleMany(grpc_core::WorkSerializer* lock, int n,
+                  std::vector<int>* order, std::vector<bool>* on_this_thread,
+                  gpr_event* done) {
+  gpr_thd_id this_thread = gpr_thd_currentid();
+  for (int i = 0; i < n; ++i) {
+    lock->Schedule(
+        [order, on_this_thread, this_thread, i]() {
+          order->push_back(i);
+          on_this_thread->push_back(gpr_thd_currentid() == this_thread);
+        },
+        DEBUG_LOCATION);
+  }
+  lock->Schedule([done]() { gpr_event_set(done, reinterpret_cast<void*>(1)); },
+                 DEBUG_LOCATION);
+}
+
+void ExpectInOrder(const std::vector<int>& order, int n) {
+  ASSERT_EQ(order.size(), static_cast<size_t>(n));
+  for (int i = 0; i < n; ++i) {
+    EXPECT_EQ(order[i], i);
+  }
+}
+
+TEST(WorkSerializerTest, DrainWithoutExecCtxRunsEverything) {
+  grpc_core::WorkSerializer lock;
+  std::vector<int> order;
+  std::vector<bool> on_this_thread;
+  gpr_event done;
+  gpr_event_init(&done);
+  ScheduleMany(&lock, 1000, &order, &on_this_thread, &done);
+  lock.DrainQueue();
+  EXPECT_NE(gpr_event_get(&done), nullptr);
+  ExpectInOrder(order, 1000);
+  EXPECT_EQ(std::count(on_this_thread.begin(), on_this_thread.end(), true),
+            1000);
+}
+
+TEST(WorkSerializerTest, DrainUnderExecCtxRunsEverything) {
+  grpc_core::ExecCtx exec_ctx;
+  grpc_core::WorkSerializer lock;
+  std::vector<int> order;
+  std::vector<bool> on_this_thread;
+  gpr_event done;
+  gpr_event_init(&done);
+  ScheduleMany(&lock, 1000, &order, &on_this_thread, &done);
+  lock.DrainQueue();
+  EXPECT_NE(gpr_event_get(&done), nullptr);
+  ExpectInOrder(order, 1000);
+  EXPECT_EQ(std::count(on_this_thread.begin(), on_this_thread.end(), true),
+            1000);
+}
+
+TEST(WorkSerializerTest, CapturesReleasedOnceCallbackRan) {
+  grpc_core::WorkSerializer lock;
+  for (int round = 0; round < 3; ++round) {
+    // Callbacks queued behind this round's first one reuse the wrappers of
+    // the previous rounds, which must not hold on to what they captured.
+    auto captured = std::make_shared<int>(round);
+    lock.Schedule([captured]() {}, DEBUG_LOCATION);
+    lock.Schedule([captured]() {}, DEBUG_LOCATION);
+    EXPECT_EQ(captured.use_count(), 3);
+    lock.DrainQueue();
+    EXPECT_EQ(captured.use_count(), 1);
+  }
+}
+
 }  // namespace
 
 int main(int argc, char** argv) {
@@ -0,0 +1,239 @@
+/*
+ *
+ * Copyright 2021 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Exercises the work-stealing backend through the Executor API, with
+   GRPC_EXECUTOR_WORK_STEALING set */
+
+#include <atomic>
+
+#include <grpc/grpc.h>
+#include <grpc/support/log.h>
+#include <grpc/support/thd_id.h>
+
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/executor.h"
+#include "test/core/util/test_config.h"
+
+static const int kNumProducers = 10;
+static const int kClosuresPerProducer = 10000;
+static const int kChainLength = 1000;
+
+static void increment(void* arg, grpc_error_handle /*error*/) {
+  static_cast<std::atomic<int>*>(arg)->fetch_add(1);
+}
+
+static grpc_core::ExecutorJobType job_type(bool is_short) {
+  return is_short ? grpc_core::ExecutorJobType::SHORT
+                  : grpc_core::ExecutorJobType::LONG;
+}
+
+/* Waits for up to 30 seconds for |count| to reach |expected|. */
+static bool wait_for_count(const std::atomic<int>& count, int expected) {
+  gpr_timespec deadline = grpc_timeout_seconds_to_deadline(30);
+  while (count.load() != expected) {
+    if (gpr_time_cmp(gpr_now(GPR_CLOCK_MONOTONIC), deadline) > 0) {
+      gpr_log(GPR_ERROR, "count is %d, expected %d", count.load(), expected);
+      return false;
+    }
+    gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(1));
+  }
+  return true;
+}
+
+// Thread that schedules closures from outside the executor.
+class ProducerThread {
+ public:
+  ProducerThread(std::atomic<int>* count, bool is_short)
+      : count_(count), is_short_(is_short) {
+    thd_ = grpc_core::Thread(
+        "work_stealing_executor_test_producer",
+        [](void* th) { static_cast<ProducerThread*>(th)->Run(); }, this);
+  }
+
+  void Start() { thd_.Start(); }
+  void Join() { thd_.Join(); }
+
+ private:
+  void Run() {
+    grpc_core::ExecCtx exec_ctx;
+    for (int i = 0; i < kClosuresPerProducer; ++i) {
+      GRPC_CLOSURE_INIT(&closures_[i], increment, count_, nullptr);
+      grpc_core::Executor::Run(&closures_[i], GRPC_ERROR_NONE,
+                               grpc_core::ExecutorType::DEFAULT,
+                               job_type(is_short_));
+    }
+  }
+
+  std::atomic<int>* count_;
+  bool is_short_;
+  grpc_closure closures_[kClosuresPerProducer];
+  grpc_core::Thread thd_;
+};
+
+static void test_many_producers(bool is_short) {
+  gpr_log(GPR_INFO, "test_many_producers(is_short=%d)", is_short);
+  std::atomic<int> count{0};
+  ProducerThread* producers[kNumProducers];
+  for (int i = 0; i < kNumProducers; ++i) {
+    producers[i] = new ProducerThread(&count, is_short);
+    producers[i]->Start();
+  }
+  for (int i = 0; i < kNumProducers; ++i) {
+    producers[i]->Join();
+  }
+  GPR_ASSERT(wait_for_count(count, kNumProducers * kClosuresPerProducer));
+  for (int i = 0; i < kNumProducers; ++i) {
+    delete producers[i];
+  }
+}
+
+// Each link schedules the next one from the executor thread running it, which
+// puts it in that thread's LIFO slot, and a side closure, which goes to its
+// queue where other threads may steal it.
+struct Chain {
+  grpc_closure links[kChainLength];
+  grpc_closure side[kChainLength];
+  std::atomic<int> links_run{0};
+  std::atomic<int> side_run{0};
+  gpr_thd_id thread = 0;
+  int moves = 0;
+  gpr_event done;
+};
+
+static void run_link(void* arg, grpc_error_handle /*error*/) {
+  Chain* chain = static_cast<Chain*>(arg);
+  int i = chain->links_run.fetch_add(1) + 1;
+  if (i > 1 && chain->thread != gpr_thd_currentid()) ++chain->moves;
+  chain->thread = gpr_thd_currentid();
+  if (i == kChainLength) {
+    gpr_event_set(&chain->done, reinterpret_cast<void*>(1));
+    return;
+  }
+  GRPC_CLOSURE_INIT(&chain->side[i], increment, &chain->side_run, nullptr);
+  grpc_core::Executor::Run(&chain->side[i], GRPC_ERROR_NONE);
+  GRPC_CLOSURE_INIT(&chain->links[i], run_link, chain, nullptr);
+  grpc_core::Executor::Run(&chain->links[i], GRPC_ERROR_NONE);
+}
+
+static void test_chain(void) {
+  gpr_log(GPR_INFO, "test_chain");
+  Chain* chain = new Chain;
+  gpr_event_init(&chain->done);
+  {
+    grpc_core::ExecCtx exec_ctx;
+    GRPC_CLOSURE_INIT(&chain->links[0], run_link, chain, nullptr);
+    grpc_core::Executor::Run(&chain->links[0], GRPC_ERROR_NONE);
+  }
+  GPR_ASSERT(gpr_event_wait(&chain->done, grpc_timeout_seconds_to_deadline(
+                                              30)) != nullptr);
+  GPR_ASSERT(chain->links_run.load() == kChainLength);
+  /* Links are only taken out of the LIFO slot of the thread running the chain
+     when that thread doesn't get to run for kLifoStealDelayMs */
+  gpr_log(GPR_INFO, "chain moved threads %d times", chain->moves);
+  GPR_ASSERT(chain->moves <= kChainLength / 10);
+  GPR_ASSERT(wait_for_count(chain->side_run, kChainLength - 1));
+  delete chain;
+}
+
+// Schedules a continuation, which goes to the LIFO slot of the thread running
+// this closure, then blocks until the continuation has run, which is only
+// possible if another thread takes it out of the slot.
+struct BlockedLifo {
+  grpc_closure blocker;
+  grpc_closure continuation;
+  gpr_thd_id blocker_thread = 0;
+  gpr_thd_id continuation_thread = 0;
+  gpr_event continuation_done;
+  gpr_event done;
+};
+
+static void run_continuation(void* arg, grpc_error_handle /*error*/) {
+  BlockedLifo* b = static_cast<BlockedLifo*>(arg);
+  b->continuation_thread = gpr_thd_currentid();
+  gpr_event_set(&b->continuation_done, reinterpret_cast<void*>(1));
+}
+
+static void run_blocker(void* arg, grpc_error_handle /*error*/) {
+  BlockedLifo* b = static_cast<BlockedLifo*>(arg);
+  b->blocker_thread = gpr_thd_currentid();
+  GRPC_CLOSURE_INIT(&b->continuation, run_continuation, b, nullptr);
+  grpc_core::Executor::Run(&b->continuation, GRPC_ERROR_NONE);
+  gpr_event_wait(&b->continuation_done, grpc_timeout_seconds_to_deadline(30));
+  gpr_event_set(&b->done, reinterpret_cast<void*>(1));
+}
+
+static void test_blocked_lifo(void) {
+  gpr_log(GPR_INFO, "test_blocked_lifo");
+  BlockedLifo b;
+  gpr_event_init(&b.continuation_done);
+  gpr_event_init(&b.done);
+  {
+    grpc_core::ExecCtx exec_ctx;
+    GRPC_CLOSURE_INIT(&b.blocker, run_blocker, &b, nullptr);
+    grpc_core::Executor::Run(&b.blocker, GRPC_ERROR_NONE);
+  }
+  GPR_ASSERT(gpr_event_wait(&b.done, grpc_timeout_seconds_to_deadline(60)) !=
+             nullptr);
+  /* The continuation was stolen out of the LIFO slot of the blocked thread */
+  GPR_ASSERT(gpr_event_get(&b.continuation_done) != nullptr);
+  GPR_ASSERT(b.continuation_thread != b.blocker_thread);
+}
+
+static void test_restart(void) {
+  gpr_log(GPR_INFO, "test_restart");
+  std::atomic<int> count{0};
+  grpc_closure closures[3];
+  for (int i = 0; i < 3; ++i) {
+    grpc_core::Executor::SetThreadingAll(false);
+    GPR_ASSERT(!grpc_core::Executor::IsThreadedDefault());
+    {
+      /* Without threads, closures run on the ExecCtx */
+      grpc_core::ExecCtx exec_ctx;
+      GRPC_CLOSURE_INIT(&closures[i], increment, &count, nullptr);
+      grpc_core::Executor::Run(&closures[i], GRPC_ERROR_NONE,
+                               grpc_core::ExecutorType::DEFAULT,
+                               job_type(i % 2 == 0));
+      GPR_ASSERT(count.load() == i);
+    }
+    GPR_ASSERT(count.load() == i + 1);
+    grpc_core::Executor::SetThreadingAll(true);
+    GPR_ASSERT(grpc_core::Executor::IsThreadedDefault());
+  }
+  grpc_closure closure;
+  GRPC_CLOSURE_INIT(&closure, increment, &count, nullptr);
+  {
+    grpc_core::ExecCtx exec_ctx;
+    grpc_core::Executor::Run(&closure, GRPC_ERROR_NONE);
+  }
+  GPR_ASSERT(wait_for_count(count, 4));
+}
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  GPR_GLOBAL_CONFIG_SET(grpc_executor_work_stealing, true);
+  grpc_init();
+  test_many_producers(true);
+  test_many_producers(false);
+  test_chain();
+  /* Needs the executor to have more than one thread, which
+     test_many_producers made sure of */
+  test_blocked_lifo();
+  test_restart();
+  grpc_shutdown();
+  return 0;
+}
@@ -19,6 +19,8 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include "test/core/util/evaluate_args_test_util.h"
+
 namespace grpc_core {
 
 TEST(GrpcAuthorizationEngineTest, AllowEngineWithMatchingPolicy) {
@@ -107,9 +109,194 @@ TEST(GrpcAuthorizationEngineTest, DenyEngineWithEmptyPolicies) {
   EXPECT_TRUE(decision.matching_policy_name.empty());
 }
 
+Rbac::Policy MakePathPolicy(StringMatcher::Type type, const char* path,
+                            bool case_sensitive = true) {
+  return Rbac::Policy(
+      Rbac::Permission(
+          Rbac::Permission::RuleType::kPath,
+          StringMatcher::Create(type, path, case_sensitive).value()),
+      Rbac::Principal(Rbac::Principal::RuleType::kAny));
+}
+
+Rbac::Policy MakeDestIpPolicy(const char* address_prefix, uint32_t prefix_len) {
+  return Rbac::Policy(
+      Rbac::Permission(Rbac::Permission::RuleType::kDestIp,
+                       Rbac::CidrRange(address_prefix, prefix_len)),
+      Rbac::Principal(Rbac::Principal::RuleType::kAny));
+}
+
+TEST(GrpcAuthorizationEngineTest, PathPolicies) {
+  std::map<std::string, Rbac::Policy> policies;
+  policies["policy1"] =
+      MakePathPolicy(StringMatcher::Type::kExact, "/pkg.Service/Method1");
+  policies["policy2"] =
+      MakePathPolicy(StringMatcher::Type::kPrefix, "/pkg.Service/Method2");
+  policies["policy3"] =
+      MakePathPolicy(StringMatcher::Type::kPrefix, "/PKG.Service/",
+                     /*case_sensitive=*/false);
+  policies["policy4"] = MakePathPolicy(StringMatcher::Type::kPrefix, "");
+  GrpcAuthorizationEngine engine(
+      Rbac(Rbac::Action::kAllow, std::move(policies)));
+  struct {
+    const char* path;
+    const char* matching_policy_name;
+  } cases[] = {
+      {"/pkg.Service/Method1", "policy1"},
+      {"/pkg.Service/Method2", "policy2"},
+      {"/pkg.Service/Method2Streaming", "policy2"},
+      {"/pkg.Service/Method1Streaming", "policy3"},
+      {"/pkg.Service", "policy4"},
+  };
+  for (const auto& c : cases) {
+    EvaluateArgsTestUtil util;
+    util.AddPairToMetadata(":path", c.path);
+    AuthorizationEngine::Decision decision =
+        engine.Evaluate(util.MakeEvaluateArgs());
+    EXPECT_EQ(decision.type, AuthorizationEngine::Decision::Type::kAllow);
+    EXPECT_EQ(decision.matching_policy_name, c.matching_policy_name)
+        << c.path;
+  }
+  // An empty path matches no path rule, not even the empty prefix.
+  EvaluateArgsTestUtil util;
+  AuthorizationEngine::Decision decision =
+      engine.Evaluate(util.MakeEvaluateArgs());
+  EXPECT_EQ(decision.type, AuthorizationEngine::Decision::Type::kDeny);
+}
+
+TEST(GrpcAuthorizationEngineTest, DestIpPolicies) {
+  std::map<std::string, Rbac::Policy> policies;
+  policies["policy1"] = MakeDestIpPolicy("10.1.2.0", 24);
+  policies["policy2"] = MakeDestIpPolicy("10.1.0.0", 16);
+  policies["policy3"] = MakeDestIpPolicy("10.1.2.3", 64);
+  policies["policy4"] = MakeDestIpPolicy("2001:db8::", 32);
+  policies["policy5"] = MakeDestIpPolicy("0.0.0.0", 0);
+  policies["policy6"] = MakeDestIpPolicy("not_an_address", 0);
+  GrpcAuthorizationEngine engine(
+      Rbac(Rbac::Action::kDeny, std::move(policies)));
+  struct {
+    const char* local_uri;
+    const char* matching_policy_name;
+  } cases[] = {
+      {"ipv4:10.1.2.3:443", "policy1"},
+      {"ipv4:10.1.3.3:443", "policy2"},
+      {"ipv4:10.2.2.3:443", "policy5"},
+      {"ipv6:[2001:db8::1]:443", "policy4"},
+  };
+  for (const auto& c : cases) {
+    EvaluateArgsTestUtil util;
+    util.SetLocalEndpoint(c.local_uri);
+    AuthorizationEngine::Decision decision =
+        engine.Evaluate(util.MakeEvaluateArgs());
+    EXPECT_EQ(decision.type, AuthorizationEngine::Decision::Type::kDeny);
+    EXPECT_EQ(decision.matching_policy_name, c.matching_policy_name)
+        << c.local_uri;
+  }
+  EvaluateArgsTestUtil util;
+  util.SetLocalEndpoint("ipv6:[2001:db9::1]:443");
+  AuthorizationEngine::Decision decision =
+      engine.Evaluate(util.MakeEvaluateArgs());
+  EXPECT_EQ(decision.type, AuthorizationEngine::Decision::Type::kAllow);
+}
+
+TEST(GrpcAuthorizationEngineTest, HeaderPoliciesShareOnePass) {
+  std::map<std::string, Rbac::Policy> policies;
+  policies["policy1"] = Rbac::Policy(
+      Rbac::Permission(Rbac::Permission::RuleType::kAny),
+      Rbac::Principal(Rbac::Principal::RuleType::kHeader,
+                      HeaderMatcher::Create(/*name=*/"key-a",
+                                            HeaderMatcher::Type::kExact,
+                                            /*matcher=*/"foo")
+                          .value()));
+  policies["policy2"] = Rbac::Policy(
+      Rbac::Permission(Rbac::Permission::RuleType::kHeader,
+                       HeaderMatcher::Create(/*name=*/"key-a",
+                                             HeaderMatcher::Type::kExact,
+                                             /*matcher=*/"foo,bar")
+                           .value()),
+      Rbac::Principal(Rbac::Principal::RuleType::kNot,
+                      Rbac::Principal(Rbac::Principal::RuleType::kHeader,
+                                      HeaderMatcher::Create(
+                                          /*name=*/"key-b",
+                                          HeaderMatcher::Type::kPresent,
+                                          /*matcher=*/"", /*range_start=*/0,
+                                          /*range_end=*/0,
+                                          /*present_match=*/true)
+                                          .value())));
+  GrpcAuthorizationEngine engine(
+      Rbac(Rbac::Action::kAllow, std::move(policies)));
+  EvaluateArgsTestUtil util;
+  util.AddPairToMetadata("key-a", "foo");
+  util.AddPairToMetadata("key-c", "baz");
+  util.AddPairToMetadata("key-a", "bar");
+  AuthorizationEngine::Decision decision =
+      engine.Evaluate(util.MakeEvaluateArgs());
+  EXPECT_EQ(decision.type, AuthorizationEngine::Decision::Type::kAllow);
+  EXPECT_EQ(decision.matching_policy_name, "policy2");
+  EvaluateArgsTestUtil util2;
+  util2.AddPairToMetadata("key-a", "foo");
+  util2.AddPairToMetadata("key-a", "bar");
+  util2.AddPairToMetadata("key-b", "");
+  decision = engine.Evaluate(util2.MakeEvaluateArgs());
+  EXPECT_EQ(decision.type, AuthorizationEngine::Decision::Type::kDeny);
+}
+
+// Predicates are deduplicated across policies. Matchers whose ToString()
+// output is identical but whose semantics differ must not be merged.
+TEST(GrpcAuthorizationEngineTest, PathPoliciesWithSameToStringNotMerged) {
+  std::map<std::string, Rbac::Policy> policies;
+  // Case-sensitive match of a path that ends with ", case_sensitive=false".
+  policies["policy1"] = MakePathPolicy(StringMatcher::Type::kExact,
+                                       "/svc/m, case_sensitive=false");
+  policies["policy2"] = MakePathPolicy(StringMatcher::Type::kExact, "/svc/m",
+                                       /*case_sensitive=*/false);
+  GrpcAuthorizationEngine engine(
+      Rbac(Rbac::Action::kDeny, std::move(policies)));
+  EvaluateArgsTestUtil util;
+  util.AddPairToMetadata(":path", "/SVC/M");
+  AuthorizationEngine::Decision decision =
+      engine.Evaluate(util.MakeEvaluateArgs());
+  EXPECT_EQ(decision.type, AuthorizationEngine::Decision::Type::kDeny);
+  EXPECT_EQ(decision.matching_policy_name, "policy2");
+}
+
+TEST(GrpcAuthorizationEngineTest, HeaderPoliciesWithSameToStringNotMerged) {
+  std::map<std::string, Rbac::Policy> policies;
+  policies["policy1"] = Rbac::Policy(
+      Rbac::Permission(Rbac::Permission::RuleType::kHeader,
+                       HeaderMatcher::Create(/*name=*/"key-a",
+                                             HeaderMatcher::Type::kExact,
+                                             /*matcher=*/"foo",
+                                             /*range_start=*/0,
+                                             /*range_end=*/0,
+                                             /*present_match=*/false,
+                                             /*invert_match=*/true)
+                           .value()),
+      Rbac::Principal(Rbac::Principal::RuleType::kAny));
+  // Not inverted, but the name makes ToString() read like policy1's.
+  policies["policy2"] = Rbac::Policy(
+      Rbac::Permission(Rbac::Permission::RuleType::kHeader,
+                       HeaderMatcher::Create(/*name=*/"key-a not",
+                                             HeaderMatcher::Type::kExact,
+                                             /*matcher=*/"foo")
+                           .value()),
+      Rbac::Principal(Rbac::Principal::RuleType::kAny));
+  GrpcAuthorizationEngine engine(
+      Rbac(Rbac::Action::kDeny, std::move(policies)));
+  EvaluateArgsTestUtil util;
+  util.AddPairToMetadata("key-a", "foo");
+  util.AddPairToMetadata("key-a not", "foo");
+  AuthorizationEngine::Decision decision =
+      engine.Evaluate(util.MakeEvaluateArgs());
+  EXPECT_EQ(decision.type, AuthorizationEngine::Decision::Type::kDeny);
+  EXPECT_EQ(decision.matching_policy_name, "policy2");
+}
+
 }  // namespace grpc_core
 
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
-  return RUN_ALL_TESTS();
+  grpc_init();
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
 }
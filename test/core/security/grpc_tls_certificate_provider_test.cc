@@ -22,16 +22,26 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include "absl/strings/str_cat.h"
+
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
 
 #include "src/core/lib/gpr/tmpfile.h"
 #include "src/core/lib/iomgr/load_file.h"
+#include "src/core/lib/iomgr/port.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "test/core/util/test_config.h"
 #include "test/core/util/tls_utils.h"
 
+#ifdef GRPC_LINUX_INOTIFY
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #define CA_CERT_PATH "src/core/tsi/test_creds/ca.pem"
 #define SERVER_CERT_PATH "src/core/tsi/test_creds/server1.pem"
 #define SERVER_KEY_PATH "src/core/tsi/test_creds/server1.key"
@@ -185,6 +195,19 @@ class GrpcTlsCertificateProviderTest : public ::testing::Test {
     return &watchers_.back();
   }
 
+  // Waits up to 5 seconds for |state| to be updated with |root_cert|.
+  static bool WaitForRootCert(WatcherState* state,
+                              const std::string& root_cert) {
+    gpr_timespec deadline = grpc_timeout_seconds_to_deadline(5);
+    while (gpr_time_cmp(gpr_now(GPR_CLOCK_MONOTONIC), deadline) < 0) {
+      for (const CredentialInfo& info : state->GetCredentialQueue()) {
+        if (info.root_certs == root_cert) return true;
+      }
+      gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(10));
+    }
+    return false;
+  }
+
   void CancelWatch(WatcherState* state) {
     MutexLock lock(&mu_);
     distributor_->CancelTlsCertificatesWatch(state->watcher);
@@ -490,6 +513,110 @@ TEST_F(GrpcTlsCertificateProviderTest,
   CancelWatch(watcher_state_1);
 }
 
+#ifdef GRPC_LINUX_INOTIFY
+
+// The following tests use a refresh interval the tests never reach, so that
+// only file change notifications can trigger updates.
+constexpr unsigned int kLongRefreshIntervalSec = 3600;
+
+// Writes |data| to the file at |path|, replacing its contents.
+void WriteFile(const std::string& path, absl::string_view data,
+               const char* mode = "w") {
+  FILE* file = fopen(path.c_str(), mode);
+  GPR_ASSERT(file != nullptr);
+  GPR_ASSERT(fwrite(data.data(), 1, data.size(), file) == data.size());
+  GPR_ASSERT(fclose(file) == 0);
+}
+
+// Creates a directory named |name| under a new temporary directory, holding a
+// root certificate file with |root_cert|. Returns the temporary directory.
+std::string MakeCertDirectory(const std::string& name,
+                              absl::string_view root_cert) {
+  char base[] = "/tmp/grpc_tls_certificate_provider_test_XXXXXX";
+  GPR_ASSERT(mkdtemp(base) != nullptr);
+  GPR_ASSERT(mkdir(absl::StrCat(base, "/", name).c_str(), 0700) == 0);
+  WriteFile(absl::StrCat(base, "/", name, "/root.pem"), root_cert);
+  return base;
+}
+
+// Replaces |base|/|name| with a new directory holding |root_cert|, the way
+// atomic rotation tools do.
+void RotateCertDirectory(const std::string& base, const std::string& name,
+                         absl::string_view root_cert) {
+  const std::string path = absl::StrCat(base, "/", name);
+  GPR_ASSERT(mkdir((path + ".new").c_str(), 0700) == 0);
+  WriteFile(path + ".new/root.pem", root_cert);
+  GPR_ASSERT(rename(path.c_str(), (path + ".old").c_str()) == 0);
+  GPR_ASSERT(rename((path + ".new").c_str(), path.c_str()) == 0);
+  GPR_ASSERT(remove((path + ".old/root.pem").c_str()) == 0);
+  GPR_ASSERT(rmdir((path + ".old").c_str()) == 0);
+}
+
+TEST_F(GrpcTlsCertificateProviderTest,
+       FileWatcherCertificateProviderNotifiedOfChanges) {
+  TmpFile tmp_root_cert(root_cert_);
+  FileWatcherCertificateProvider provider("", "", tmp_root_cert.name(),
+                                          kLongRefreshIntervalSec);
+  WatcherState* watcher_state_1 =
+      MakeWatcher(provider.distributor(), kCertName, absl::nullopt);
+  EXPECT_TRUE(WaitForRootCert(watcher_state_1, root_cert_));
+  tmp_root_cert.RewriteFile(root_cert_2_);
+  EXPECT_TRUE(WaitForRootCert(watcher_state_1, root_cert_2_));
+  // Clean up.
+  CancelWatch(watcher_state_1);
+}
+
+TEST_F(GrpcTlsCertificateProviderTest,
+       FileWatcherCertificateProviderFollowsDirectoryRotations) {
+  const std::string base = MakeCertDirectory("certs", root_cert_);
+  const std::string root_cert_path = base + "/certs/root.pem";
+  FileWatcherCertificateProvider provider("", "", root_cert_path,
+                                          kLongRefreshIntervalSec);
+  WatcherState* watcher_state_1 =
+      MakeWatcher(provider.distributor(), kCertName, absl::nullopt);
+  EXPECT_TRUE(WaitForRootCert(watcher_state_1, root_cert_));
+  // The directory being watched is replaced; later rotations must still be
+  // noticed.
+  RotateCertDirectory(base, "certs", root_cert_2_);
+  EXPECT_TRUE(WaitForRootCert(watcher_state_1, root_cert_2_));
+  RotateCertDirectory(base, "certs", root_cert_);
+  EXPECT_TRUE(WaitForRootCert(watcher_state_1, root_cert_));
+  // Clean up.
+  CancelWatch(watcher_state_1);
+  GPR_ASSERT(remove(root_cert_path.c_str()) == 0);
+  GPR_ASSERT(rmdir((base + "/certs").c_str()) == 0);
+  GPR_ASSERT(rmdir(base.c_str()) == 0);
+}
+
+TEST_F(GrpcTlsCertificateProviderTest,
+       FileWatcherCertificateProviderReadsFilesThatKeepChanging) {
+  const std::string base = MakeCertDirectory("certs", root_cert_);
+  const std::string root_cert_path = base + "/certs/root.pem";
+  FileWatcherCertificateProvider provider("", "", root_cert_path,
+                                          kLongRefreshIntervalSec);
+  WatcherState* watcher_state_1 =
+      MakeWatcher(provider.distributor(), kCertName, absl::nullopt);
+  EXPECT_TRUE(WaitForRootCert(watcher_state_1, root_cert_));
+  // Keep changing the file for longer than the provider waits for changes to
+  // settle. An update must still be delivered while the changes go on.
+  gpr_timespec deadline = grpc_timeout_seconds_to_deadline(5);
+  bool updated = false;
+  while (!updated &&
+         gpr_time_cmp(gpr_now(GPR_CLOCK_MONOTONIC), deadline) < 0) {
+    WriteFile(root_cert_path, "\n", "a");
+    gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(20));
+    updated = !watcher_state_1->GetCredentialQueue().empty();
+  }
+  EXPECT_TRUE(updated);
+  // Clean up.
+  CancelWatch(watcher_state_1);
+  GPR_ASSERT(remove(root_cert_path.c_str()) == 0);
+  GPR_ASSERT(rmdir((base + "/certs").c_str()) == 0);
+  GPR_ASSERT(rmdir(base.c_str()) == 0);
+}
+
+#endif  // GRPC_LINUX_INOTIFY
+
 TEST_F(GrpcTlsCertificateProviderTest, FailedKeyCertMatchOnEmptyPrivateKey) {
   absl::StatusOr<bool> status =
       PrivateKeyAndCertificateMatch(/*private_key=*/"", cert_chain_);
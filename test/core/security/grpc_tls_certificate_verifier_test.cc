@@ -33,6 +33,10 @@
 #include "test/core/util/test_config.h"
 #include "test/core/util/tls_utils.h"
 
+#define SERVER_CERT_PATH "src/core/tsi/test_creds/server1.pem"
+#define SERVER_CERT_PATH_2 "src/core/tsi/test_creds/server0.pem"
+#define CLIENT_CERT_PATH "src/core/tsi/test_creds/client.pem"
+
 namespace grpc_core {
 
 namespace testing {
@@ -251,6 +255,90 @@ TEST_F(GrpcTlsCertificateVerifierTest, HostnameVerifierCommonNameCheckFails) {
             "UNAUTHENTICATED: Hostname Verification Check failed.");
 }
 
+TEST_F(GrpcTlsCertificateVerifierTest, VerificationResultCacheHitsAndMisses) {
+  std::string cert = GetFileContents(SERVER_CERT_PATH);
+  auto cache = MakeRefCounted<TlsVerificationResultCache>(2);
+  request_.target_name = "foo.test.google.fr";
+  request_.peer_info.peer_cert = cert.c_str();
+  EXPECT_FALSE(cache->Lookup(&hostname_certificate_verifier_, &request_));
+  cache->Insert(&hostname_certificate_verifier_, &request_,
+                cache->generation());
+  EXPECT_EQ(cache->size(), 1);
+  EXPECT_TRUE(cache->Lookup(&hostname_certificate_verifier_, &request_));
+  // The same chain presented for another target name is verified again.
+  request_.target_name = "bar.test.google.fr";
+  EXPECT_FALSE(cache->Lookup(&hostname_certificate_verifier_, &request_));
+  cache->Clear();
+  EXPECT_EQ(cache->size(), 0);
+  request_.target_name = "foo.test.google.fr";
+  EXPECT_FALSE(cache->Lookup(&hostname_certificate_verifier_, &request_));
+}
+
+TEST_F(GrpcTlsCertificateVerifierTest,
+       VerificationResultCacheIsKeyedByVerifier) {
+  std::string cert = GetFileContents(SERVER_CERT_PATH);
+  HostNameCertificateVerifier other_verifier;
+  auto cache = MakeRefCounted<TlsVerificationResultCache>(2);
+  request_.target_name = "foo.test.google.fr";
+  request_.peer_info.peer_cert = cert.c_str();
+  cache->Insert(&hostname_certificate_verifier_, &request_,
+                cache->generation());
+  EXPECT_TRUE(cache->Lookup(&hostname_certificate_verifier_, &request_));
+  EXPECT_FALSE(cache->Lookup(&other_verifier, &request_));
+}
+
+TEST_F(GrpcTlsCertificateVerifierTest,
+       VerificationResultCacheDropsResultsStartedBeforeClear) {
+  std::string cert = GetFileContents(SERVER_CERT_PATH);
+  auto cache = MakeRefCounted<TlsVerificationResultCache>(2);
+  request_.target_name = "foo.test.google.fr";
+  request_.peer_info.peer_cert = cert.c_str();
+  uint64_t generation = cache->generation();
+  cache->Clear();
+  cache->Insert(&hostname_certificate_verifier_, &request_, generation);
+  EXPECT_EQ(cache->size(), 0);
+  EXPECT_FALSE(cache->Lookup(&hostname_certificate_verifier_, &request_));
+}
+
+TEST_F(GrpcTlsCertificateVerifierTest,
+       VerificationResultCacheIgnoresRequestsWithoutCerts) {
+  auto cache = MakeRefCounted<TlsVerificationResultCache>(2);
+  request_.target_name = "foo.test.google.fr";
+  cache->Insert(&hostname_certificate_verifier_, &request_,
+                cache->generation());
+  EXPECT_EQ(cache->size(), 0);
+  std::string invalid_cert = "not a certificate";
+  request_.peer_info.peer_cert = invalid_cert.c_str();
+  cache->Insert(&hostname_certificate_verifier_, &request_,
+                cache->generation());
+  EXPECT_EQ(cache->size(), 0);
+  EXPECT_FALSE(cache->Lookup(&hostname_certificate_verifier_, &request_));
+}
+
+TEST_F(GrpcTlsCertificateVerifierTest, VerificationResultCacheEvictsLru) {
+  std::string cert_1 = GetFileContents(SERVER_CERT_PATH);
+  std::string cert_2 = GetFileContents(SERVER_CERT_PATH_2);
+  std::string cert_3 = GetFileContents(CLIENT_CERT_PATH);
+  auto cache = MakeRefCounted<TlsVerificationResultCache>(2);
+  const grpc_tls_certificate_verifier* verifier =
+      &hostname_certificate_verifier_;
+  request_.peer_info.peer_cert = cert_1.c_str();
+  cache->Insert(verifier, &request_, cache->generation());
+  request_.peer_info.peer_cert = cert_2.c_str();
+  cache->Insert(verifier, &request_, cache->generation());
+  // Touch |cert_1| so that |cert_2| becomes the least recently used entry.
+  request_.peer_info.peer_cert = cert_1.c_str();
+  EXPECT_TRUE(cache->Lookup(verifier, &request_));
+  request_.peer_info.peer_cert = cert_3.c_str();
+  cache->Insert(verifier, &request_, cache->generation());
+  EXPECT_EQ(cache->size(), 2);
+  EXPECT_TRUE(cache->Lookup(verifier, &request_));
+  request_.peer_info.peer_cert = cert_1.c_str();
+  EXPECT_TRUE(cache->Lookup(verifier, &request_));
+  request_.peer_info.peer_cert = cert_2.c_str();
+  EXPECT_FALSE(cache->Lookup(verifier, &request_));
+}
+
 }  // namespace testing
 
 }  // namespace grpc_core
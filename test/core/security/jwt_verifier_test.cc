@@ -347,9 +347,12 @@ static int httpcli_post_should_not_be_called(
   return 1;
 }
 
+static int g_google_keys_fetch_count = 0;
+
 static int httpcli_get_google_keys_for_email(
     const grpc_httpcli_request* request, grpc_millis /*deadline*/,
     grpc_closure* on_done, grpc_httpcli_response* response) {
+  g_google_keys_fetch_count++;
   *response = http_response(200, good_google_email_keys());
   GPR_ASSERT(request->handshaker == &grpc_httpcli_ssl);
   GPR_ASSERT(strcmp(request->host, "www.googleapis.com") == 0);
@@ -394,6 +397,181 @@ static void test_jwt_verifier_google_email_issuer_success(void) {
   grpc_httpcli_set_override(nullptr, nullptr);
 }
 
+static void test_jwt_verifier_key_cache(void) {
+  grpc_core::ExecCtx exec_ctx;
+  grpc_jwt_verifier* verifier = grpc_jwt_verifier_create(nullptr, 0);
+  char* jwt = nullptr;
+  char* key_str = json_key_str(json_key_str_part3_for_google_email_issuer);
+  grpc_auth_json_key key = grpc_auth_json_key_create_from_string(key_str);
+  gpr_free(key_str);
+  GPR_ASSERT(grpc_auth_json_key_is_valid(&key));
+  jwt = grpc_jwt_encode_and_sign(&key, expected_audience, expected_lifetime,
+                                 nullptr);
+  grpc_auth_json_key_destruct(&key);
+  GPR_ASSERT(jwt != nullptr);
+  g_google_keys_fetch_count = 0;
+  grpc_httpcli_set_override(httpcli_get_google_keys_for_email,
+                            httpcli_post_should_not_be_called);
+  /* First verification fetches the keys. */
+  grpc_jwt_verifier_verify(verifier, nullptr, jwt, expected_audience,
+                           on_verification_success,
+                           const_cast<char*>(expected_user_data));
+  grpc_core::ExecCtx::Get()->Flush();
+  GPR_ASSERT(g_google_keys_fetch_count == 1);
+  /* Second one is served from the key cache. */
+  grpc_jwt_verifier_verify(verifier, nullptr, jwt, expected_audience,
+                           on_verification_success,
+                           const_cast<char*>(expected_user_data));
+  grpc_core::ExecCtx::Get()->Flush();
+  GPR_ASSERT(g_google_keys_fetch_count == 1);
+  grpc_jwt_verifier_destroy(verifier);
+  gpr_free(jwt);
+  grpc_httpcli_set_override(nullptr, nullptr);
+}
+
+static void test_jwt_verifier_key_cache_refresh(void) {
+  grpc_core::ExecCtx exec_ctx;
+  grpc_millis saved_key_cache_ttl = grpc_jwt_verifier_key_cache_ttl;
+  /* Cached keys are always close enough to expiring to be refreshed. */
+  grpc_jwt_verifier_key_cache_ttl = grpc_jwt_verifier_max_delay / 2;
+  grpc_jwt_verifier* verifier = grpc_jwt_verifier_create(nullptr, 0);
+  char* jwt = nullptr;
+  char* key_str = json_key_str(json_key_str_part3_for_google_email_issuer);
+  grpc_auth_json_key key = grpc_auth_json_key_create_from_string(key_str);
+  gpr_free(key_str);
+  GPR_ASSERT(grpc_auth_json_key_is_valid(&key));
+  jwt = grpc_jwt_encode_and_sign(&key, expected_audience, expected_lifetime,
+                                 nullptr);
+  grpc_auth_json_key_destruct(&key);
+  GPR_ASSERT(jwt != nullptr);
+  g_google_keys_fetch_count = 0;
+  grpc_httpcli_set_override(httpcli_get_google_keys_for_email,
+                            httpcli_post_should_not_be_called);
+  grpc_jwt_verifier_verify(verifier, nullptr, jwt, expected_audience,
+                           on_verification_success,
+                           const_cast<char*>(expected_user_data));
+  grpc_core::ExecCtx::Get()->Flush();
+  GPR_ASSERT(g_google_keys_fetch_count == 1);
+  /* Served from the cache, while the keys are refreshed in the background. The
+     refresh outlives the verifier. */
+  grpc_jwt_verifier_verify(verifier, nullptr, jwt, expected_audience,
+                           on_verification_success,
+                           const_cast<char*>(expected_user_data));
+  grpc_jwt_verifier_destroy(verifier);
+  grpc_core::ExecCtx::Get()->Flush();
+  GPR_ASSERT(g_google_keys_fetch_count == 2);
+  gpr_free(jwt);
+  grpc_httpcli_set_override(nullptr, nullptr);
+  grpc_jwt_verifier_key_cache_ttl = saved_key_cache_ttl;
+}
+
+static int httpcli_get_google_keys_without_kid(
+    const grpc_httpcli_request* /*request*/, grpc_millis /*deadline*/,
+    grpc_closure* on_done, grpc_httpcli_response* response) {
+  g_google_keys_fetch_count++;
+  *response = http_response(200, gpr_strdup("{}"));
+  grpc_core::ExecCtx::Run(DEBUG_LOCATION, on_done, GRPC_ERROR_NONE);
+  return 1;
+}
+
+static void on_verification_unknown_kid(void* user_data,
+                                        grpc_jwt_verifier_status status,
+                                        grpc_jwt_claims* claims) {
+  GPR_ASSERT(status == GRPC_JWT_VERIFIER_KEY_RETRIEVAL_ERROR);
+  GPR_ASSERT(claims == nullptr);
+  GPR_ASSERT(user_data == (void*)expected_user_data);
+}
+
+static void test_jwt_verifier_key_cache_unknown_kid(void) {
+  grpc_core::ExecCtx exec_ctx;
+  grpc_jwt_verifier* verifier = grpc_jwt_verifier_create(nullptr, 0);
+  char* jwt = nullptr;
+  char* key_str = json_key_str(json_key_str_part3_for_google_email_issuer);
+  grpc_auth_json_key key = grpc_auth_json_key_create_from_string(key_str);
+  gpr_free(key_str);
+  GPR_ASSERT(grpc_auth_json_key_is_valid(&key));
+  jwt = grpc_jwt_encode_and_sign(&key, expected_audience, expected_lifetime,
+                                 nullptr);
+  grpc_auth_json_key_destruct(&key);
+  GPR_ASSERT(jwt != nullptr);
+  g_google_keys_fetch_count = 0;
+  grpc_httpcli_set_override(httpcli_get_google_keys_without_kid,
+                            httpcli_post_should_not_be_called);
+  /* The keys are fetched, and don't have the kid of the token. */
+  grpc_millis start = exec_ctx.Now();
+  grpc_jwt_verifier_verify(verifier, nullptr, jwt, expected_audience,
+                           on_verification_unknown_kid,
+                           const_cast<char*>(expected_user_data));
+  grpc_core::ExecCtx::Get()->Flush();
+  GPR_ASSERT(g_google_keys_fetch_count == 1);
+  /* Until the min refetch interval has passed, the kid is taken to be
+     unknown without fetching the keys again. */
+  grpc_jwt_verifier_verify(verifier, nullptr, jwt, expected_audience,
+                           on_verification_unknown_kid,
+                           const_cast<char*>(expected_user_data));
+  grpc_core::ExecCtx::Get()->Flush();
+  GPR_ASSERT(g_google_keys_fetch_count == 1);
+  /* Then it could have been rotated in since. */
+  exec_ctx.TestOnlySetNow(start + grpc_jwt_verifier_min_key_refetch_interval);
+  grpc_jwt_verifier_verify(verifier, nullptr, jwt, expected_audience,
+                           on_verification_unknown_kid,
+                           const_cast<char*>(expected_user_data));
+  grpc_core::ExecCtx::Get()->Flush();
+  GPR_ASSERT(g_google_keys_fetch_count == 2);
+  grpc_jwt_verifier_destroy(verifier);
+  gpr_free(jwt);
+  grpc_httpcli_set_override(nullptr, nullptr);
+}
+
+static bool g_batch_verification_done = false;
+
+static void on_batch_verification_done(void* user_data, size_t num_jwts,
+                                       const grpc_jwt_verifier_status* statuses,
+                                       grpc_jwt_claims** claims) {
+  GPR_ASSERT(user_data == (void*)expected_user_data);
+  GPR_ASSERT(num_jwts == 3);
+  GPR_ASSERT(statuses[0] == GRPC_JWT_VERIFIER_OK);
+  GPR_ASSERT(statuses[1] == GRPC_JWT_VERIFIER_BAD_FORMAT);
+  GPR_ASSERT(statuses[2] == GRPC_JWT_VERIFIER_OK);
+  GPR_ASSERT(claims[1] == nullptr);
+  for (size_t i = 0; i < num_jwts; i += 2) {
+    GPR_ASSERT(claims[i] != nullptr);
+    GPR_ASSERT(strcmp(grpc_jwt_claims_audience(claims[i]),
+                      expected_audience) == 0);
+    grpc_jwt_claims_destroy(claims[i]);
+  }
+  g_batch_verification_done = true;
+}
+
+static void test_jwt_verifier_verify_batch(void) {
+  grpc_core::ExecCtx exec_ctx;
+  grpc_jwt_verifier* verifier = grpc_jwt_verifier_create(nullptr, 0);
+  char* jwt = nullptr;
+  char* key_str = json_key_str(json_key_str_part3_for_google_email_issuer);
+  grpc_auth_json_key key = grpc_auth_json_key_create_from_string(key_str);
+  gpr_free(key_str);
+  GPR_ASSERT(grpc_auth_json_key_is_valid(&key));
+  jwt = grpc_jwt_encode_and_sign(&key, expected_audience, expected_lifetime,
+                                 nullptr);
+  grpc_auth_json_key_destruct(&key);
+  GPR_ASSERT(jwt != nullptr);
+  const char* jwts[] = {jwt, "bad jwt", jwt};
+  g_google_keys_fetch_count = 0;
+  g_batch_verification_done = false;
+  grpc_httpcli_set_override(httpcli_get_google_keys_for_email,
+                            httpcli_post_should_not_be_called);
+  grpc_jwt_verifier_verify_batch(verifier, nullptr, jwts, 3, expected_audience,
+                                 on_batch_verification_done,
+                                 const_cast<char*>(expected_user_data));
+  grpc_core::ExecCtx::Get()->Flush();
+  GPR_ASSERT(g_batch_verification_done);
+  /* Both valid JWTs waited on the same key fetch. */
+  GPR_ASSERT(g_google_keys_fetch_count == 1);
+  grpc_jwt_verifier_destroy(verifier);
+  gpr_free(jwt);
+  grpc_httpcli_set_override(nullptr, nullptr);
+}
+
 static int httpcli_get_custom_keys_for_email(
     const grpc_httpcli_request* request, grpc_millis /*deadline*/,
     grpc_closure* on_done, grpc_httpcli_response* response) {
@@ -633,6 +811,10 @@ int main(int argc, char** argv) {
   test_bad_audience_claims_failure();
   test_bad_subject_claims_failure();
   test_jwt_verifier_google_email_issuer_success();
+  test_jwt_verifier_key_cache();
+  test_jwt_verifier_key_cache_refresh();
+  test_jwt_verifier_key_cache_unknown_kid();
+  test_jwt_verifier_verify_batch();
   test_jwt_verifier_custom_email_issuer_success();
   test_jwt_verifier_url_issuer_success();
   test_jwt_verifier_url_issuer_bad_config();
@@ -16,6 +16,8 @@
 
 #include <gtest/gtest.h>
 
+#include "absl/strings/str_cat.h"
+
 namespace grpc_core {
 
 TEST(StringMatcherTest, ExactMatchCaseSensitive) {
@@ -128,6 +130,95 @@ TEST(StringMatcherTest, ContainsMatchCaseInSensitive) {
   EXPECT_FALSE(string_matcher->Match("Test-Containz"));
 }
 
+TEST(StringMatcherSetTest, MatchesLikeIndividualMatchers) {
+  std::vector<StringMatcher> matchers;
+  for (bool case_sensitive : {true, false}) {
+    for (const char* literal :
+         {"/pkg.Service/Method", "/pkg.Service/", "", "a.b*c(d)",
+          "\xc3\xa9t\xc3\xa9", "k", "\n"}) {
+      for (auto type :
+           {StringMatcher::Type::kExact, StringMatcher::Type::kPrefix,
+            StringMatcher::Type::kSuffix, StringMatcher::Type::kContains}) {
+        matchers.push_back(
+            StringMatcher::Create(type, literal, case_sensitive).value());
+      }
+    }
+  }
+  for (const char* regex : {"/pkg\\.Service/.*", "[a-z]+", ".*\\d{3}", "",
+                            "\xc3\xa9.*"}) {
+    matchers.push_back(
+        StringMatcher::Create(StringMatcher::Type::kSafeRegex, regex).value());
+  }
+  StringMatcherSet matcher_set;
+  for (size_t i = 0; i < matchers.size(); ++i) {
+    EXPECT_EQ(matcher_set.Add(matchers[i]), i);
+  }
+  matcher_set.Compile();
+  for (const char* value :
+       {"/pkg.Service/Method", "/PKG.service/method", "/pkg.Service/Other",
+        "x/pkg.Service/Method123", "", "a.b*c(d)", "A.B*C(D)x", "aXbxc(d)",
+        "\xc3\xa9t\xc3\xa9", "\xc3\x89T\xc3\x89", "\xe2\x84\xaa",
+        "K", "line\nbreak", "\xff\xfe", "lower"}) {
+    std::vector<size_t> expected;
+    for (size_t i = 0; i < matchers.size(); ++i) {
+      if (matchers[i].Match(value)) expected.push_back(i);
+    }
+    std::vector<size_t> indices;
+    matcher_set.MatchAll(value, &indices);
+    EXPECT_EQ(indices, expected) << value;
+    std::vector<size_t> first_matches;
+    for (absl::optional<size_t> i = matcher_set.FirstMatch(value);
+         i.has_value(); i = matcher_set.FirstMatch(value, *i + 1)) {
+      first_matches.push_back(*i);
+    }
+    EXPECT_EQ(first_matches, expected) << value;
+  }
+}
+
+TEST(StringMatcherSetTest, MatchesWhenSetFailsToCompile) {
+  // Each of these patterns compiles on its own, but not all of them together.
+  std::vector<StringMatcher> matchers;
+  for (int i = 0; i < 100; ++i) {
+    matchers.push_back(StringMatcher::Create(StringMatcher::Type::kSafeRegex,
+                                             absl::StrCat(i, "[a-z]{1000}"))
+                           .value());
+  }
+  matchers.push_back(
+      StringMatcher::Create(StringMatcher::Type::kPrefix, "4").value());
+  StringMatcherSet matcher_set;
+  for (size_t i = 0; i < matchers.size(); ++i) {
+    EXPECT_EQ(matcher_set.Add(matchers[i]), i);
+  }
+  matcher_set.Compile();
+  for (const std::string& value :
+       {absl::StrCat("7", std::string(1000, 'a')),
+        absl::StrCat("42", std::string(1000, 'z')),
+        absl::StrCat("42", std::string(999, 'z')), std::string("4")}) {
+    std::vector<size_t> expected;
+    for (size_t i = 0; i < matchers.size(); ++i) {
+      if (matchers[i].Match(value)) expected.push_back(i);
+    }
+    std::vector<size_t> indices;
+    matcher_set.MatchAll(value, &indices);
+    EXPECT_EQ(indices, expected) << value;
+    std::vector<size_t> first_matches;
+    for (absl::optional<size_t> i = matcher_set.FirstMatch(value);
+         i.has_value(); i = matcher_set.FirstMatch(value, *i + 1)) {
+      first_matches.push_back(*i);
+    }
+    EXPECT_EQ(first_matches, expected) << value;
+  }
+}
+
+TEST(StringMatcherSetTest, Empty) {
+  StringMatcherSet matcher_set;
+  matcher_set.Compile();
+  std::vector<size_t> indices;
+  matcher_set.MatchAll("value", &indices);
+  EXPECT_TRUE(indices.empty());
+  EXPECT_FALSE(matcher_set.FirstMatch("value").has_value());
+}
+
 TEST(HeaderMatcherTest, StringMatcher) {
   auto header_matcher =
       HeaderMatcher::Create(/*name=*/"key", HeaderMatcher::Type::kExact,
@@ -0,0 +1,558 @@
+//
+// Copyright 2021 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "src/core/lib/security/transport/security_handshaker.h"
+
+#include <string.h>
+
+#include <functional>
+#include <string>
+
+#include <gtest/gtest.h>
+#include <openssl/ssl.h>
+
+#include <grpc/grpc.h>
+#include <grpc/grpc_security.h>
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/channel/handshaker.h"
+#include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/debug/stats.h"
+#include "src/core/lib/iomgr/endpoint_pair.h"
+#include "src/core/lib/iomgr/load_file.h"
+#include "src/core/lib/iomgr/pollset.h"
+#include "src/core/lib/iomgr/port.h"
+#include "src/core/lib/security/credentials/fake/fake_credentials.h"
+#include "src/core/lib/security/credentials/ssl/ssl_credentials.h"
+#include "src/core/lib/security/security_connector/fake/fake_security_connector.h"
+#include "src/core/lib/slice/slice_internal.h"
+#include "test/core/util/test_config.h"
+
+#ifdef GRPC_LINUX_KTLS
+#include <linux/tls.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "src/core/lib/iomgr/socket_utils_posix.h"
+#include "src/core/lib/iomgr/tcp_posix.h"
+
+#ifndef TCP_ULP
+#define TCP_ULP 31
+#endif
+#ifndef SOL_TLS
+#define SOL_TLS 282
+#endif
+#endif  // GRPC_LINUX_KTLS
+
+#define CA_CERT_PATH "src/core/tsi/test_creds/ca.pem"
+#define SERVER_CERT_PATH "src/core/tsi/test_creds/server1.pem"
+#define SERVER_KEY_PATH "src/core/tsi/test_creds/server1.key"
+
+namespace grpc_core {
+namespace {
+
+// Runs a client and a server security handshake against each other over an
+// endpoint pair.
+class SecurityHandshakerTest : public ::testing::Test {
+ protected:
+  struct HandshakeState {
+    SecurityHandshakerTest* test;
+    bool done = false;
+    grpc_error_handle error = GRPC_ERROR_NONE;
+    grpc_endpoint* endpoint = nullptr;
+  };
+
+  struct IoState {
+    SecurityHandshakerTest* test;
+    grpc_endpoint* endpoint;
+    grpc_slice_buffer buffer;
+    // Reads continue until the buffer holds at least this many bytes.
+    size_t length;
+    grpc_closure closure;
+    bool done = false;
+    grpc_error_handle error = GRPC_ERROR_NONE;
+  };
+
+  void SetUp() override {
+    pollset_ = static_cast<grpc_pollset*>(gpr_zalloc(grpc_pollset_size()));
+    grpc_pollset_init(pollset_, &mu_);
+  }
+
+  void TearDown() override {
+    ExecCtx exec_ctx;
+    grpc_closure destroyed;
+    GRPC_CLOSURE_INIT(
+        &destroyed,
+        [](void* arg, grpc_error_handle /*error*/) {
+          grpc_pollset_destroy(static_cast<grpc_pollset*>(arg));
+        },
+        pollset_, grpc_schedule_on_exec_ctx);
+    grpc_pollset_shutdown(pollset_, &destroyed);
+    ExecCtx::Get()->Flush();
+    gpr_free(pollset_);
+  }
+
+  // Runs the handshakes of client_connector and server_connector against each
+  // other over pair, and expects them to succeed. Returns the endpoints the
+  // handshakes hand over, or null endpoints if they failed.
+  grpc_endpoint_pair RunHandshakes(
+      grpc_channel_security_connector* client_connector,
+      grpc_server_security_connector* server_connector, grpc_endpoint_pair pair,
+      const grpc_channel_args* args) {
+    grpc_endpoint_add_to_pollset(pair.client, pollset_);
+    grpc_endpoint_add_to_pollset(pair.server, pollset_);
+    HandshakeState client_state{this};
+    HandshakeState server_state{this};
+    auto client_mgr = MakeRefCounted<HandshakeManager>();
+    auto server_mgr = MakeRefCounted<HandshakeManager>();
+    client_connector->add_handshakers(args, nullptr, client_mgr.get());
+    server_connector->add_handshakers(args, nullptr, server_mgr.get());
+    grpc_millis deadline = ExecCtx::Get()->Now() + 10 * GPR_MS_PER_SEC;
+    client_mgr->DoHandshake(pair.client, args, deadline, nullptr,
+                            OnHandshakeDone, &client_state);
+    server_mgr->DoHandshake(pair.server, args, deadline, nullptr,
+                            OnHandshakeDone, &server_state);
+    ExecCtx::Get()->Flush();
+    // The handshake managers fail the handshakes at the deadline.
+    PollWhile([&]() { return !client_state.done || !server_state.done; });
+    EXPECT_EQ(client_state.error, GRPC_ERROR_NONE)
+        << grpc_error_std_string(client_state.error);
+    EXPECT_EQ(server_state.error, GRPC_ERROR_NONE)
+        << grpc_error_std_string(server_state.error);
+    GRPC_ERROR_UNREF(client_state.error);
+    GRPC_ERROR_UNREF(server_state.error);
+    return {client_state.endpoint, server_state.endpoint};
+  }
+
+  // Runs fake transport security handshakes with
+  // GRPC_ARG_SECURITY_HANDSHAKE_OFFLOAD set to \a offload.
+  void RunFakeHandshakes(bool offload) {
+    ExecCtx exec_ctx;
+    grpc_arg arg = grpc_channel_arg_integer_create(
+        const_cast<char*>(GRPC_ARG_SECURITY_HANDSHAKE_OFFLOAD), offload);
+    grpc_channel_args args = {1, &arg};
+    RefCountedPtr<grpc_channel_security_connector> client_connector =
+        grpc_fake_channel_security_connector_create(
+            RefCountedPtr<grpc_channel_credentials>(
+                grpc_fake_transport_security_credentials_create()),
+            nullptr, "foo.test.google.fr", &args);
+    RefCountedPtr<grpc_server_security_connector> server_connector =
+        grpc_fake_server_security_connector_create(
+            RefCountedPtr<grpc_server_credentials>(
+                grpc_fake_transport_security_server_credentials_create()));
+    DestroyEndpoints(RunHandshakes(
+        client_connector.get(), server_connector.get(),
+        grpc_iomgr_create_endpoint_pair("security_handshaker_test", nullptr),
+        &args));
+  }
+
+  // Runs SSL handshakes of at most TLS version \a max_tls_version over pair.
+  grpc_endpoint_pair RunSslHandshakes(grpc_tls_version max_tls_version,
+                                      grpc_endpoint_pair pair,
+                                      const grpc_channel_args* args) {
+    grpc_slice ca_slice;
+    grpc_slice cert_slice;
+    grpc_slice key_slice;
+    GPR_ASSERT(GRPC_LOG_IF_ERROR("load_file",
+                                 grpc_load_file(CA_CERT_PATH, 1, &ca_slice)));
+    GPR_ASSERT(GRPC_LOG_IF_ERROR(
+        "load_file", grpc_load_file(SERVER_CERT_PATH, 1, &cert_slice)));
+    GPR_ASSERT(GRPC_LOG_IF_ERROR(
+        "load_file", grpc_load_file(SERVER_KEY_PATH, 1, &key_slice)));
+    const char* ca_cert =
+        reinterpret_cast<const char*> GRPC_SLICE_START_PTR(ca_slice);
+    grpc_ssl_pem_key_cert_pair pem_key_cert_pair = {
+        reinterpret_cast<const char*> GRPC_SLICE_START_PTR(key_slice),
+        reinterpret_cast<const char*> GRPC_SLICE_START_PTR(cert_slice)};
+    RefCountedPtr<grpc_ssl_credentials> channel_creds(
+        static_cast<grpc_ssl_credentials*>(
+            grpc_ssl_credentials_create(ca_cert, nullptr, nullptr, nullptr)));
+    RefCountedPtr<grpc_ssl_server_credentials> server_creds(
+        static_cast<grpc_ssl_server_credentials*>(
+            grpc_ssl_server_credentials_create(ca_cert, &pem_key_cert_pair, 1,
+                                               0, nullptr)));
+    grpc_slice_unref(ca_slice);
+    grpc_slice_unref(cert_slice);
+    grpc_slice_unref(key_slice);
+    channel_creds->set_max_tls_version(max_tls_version);
+    server_creds->set_max_tls_version(max_tls_version);
+    grpc_channel_args* client_args = nullptr;
+    RefCountedPtr<grpc_channel_security_connector> client_connector =
+        channel_creds->create_security_connector(nullptr, "foo.test.google.fr",
+                                                 args, &client_args);
+    RefCountedPtr<grpc_server_security_connector> server_connector =
+        server_creds->create_security_connector(args);
+    GPR_ASSERT(client_connector != nullptr);
+    GPR_ASSERT(server_connector != nullptr);
+    grpc_endpoint_pair result = RunHandshakes(
+        client_connector.get(), server_connector.get(), pair, client_args);
+    grpc_channel_args_destroy(client_args);
+    return result;
+  }
+
+  // Writes \a message to \a endpoint and expects the write to succeed.
+  void Write(grpc_endpoint* endpoint, const std::string& message) {
+    IoState state{this, endpoint};
+    grpc_slice_buffer_init(&state.buffer);
+    grpc_slice_buffer_add(&state.buffer, grpc_slice_from_cpp_string(message));
+    GRPC_CLOSURE_INIT(&state.closure, OnIoDone, &state,
+                      grpc_schedule_on_exec_ctx);
+    grpc_endpoint_write(endpoint, &state.buffer, &state.closure, nullptr);
+    ExecCtx::Get()->Flush();
+    PollWhile([&]() { return !state.done; });
+    EXPECT_EQ(state.error, GRPC_ERROR_NONE)
+        << grpc_error_std_string(state.error);
+    GRPC_ERROR_UNREF(state.error);
+    grpc_slice_buffer_destroy_internal(&state.buffer);
+  }
+
+  // Reads at least \a length bytes from \a endpoint and returns them.
+  std::string Read(grpc_endpoint* endpoint, size_t length) {
+    IoState state{this, endpoint};
+    grpc_slice_buffer_init(&state.buffer);
+    state.length = length;
+    GRPC_CLOSURE_INIT(&state.closure, OnReadDone, &state,
+                      grpc_schedule_on_exec_ctx);
+    grpc_endpoint_read(endpoint, &state.buffer, &state.closure,
+                       /*urgent=*/false);
+    ExecCtx::Get()->Flush();
+    PollWhile([&]() { return !state.done; });
+    EXPECT_EQ(state.error, GRPC_ERROR_NONE)
+        << grpc_error_std_string(state.error);
+    GRPC_ERROR_UNREF(state.error);
+    std::string data;
+    for (size_t i = 0; i < state.buffer.count; ++i) {
+      data += std::string(StringViewFromSlice(state.buffer.slices[i]));
+    }
+    grpc_slice_buffer_destroy_internal(&state.buffer);
+    return data;
+  }
+
+  static void DestroyEndpoints(grpc_endpoint_pair pair) {
+    for (grpc_endpoint* endpoint : {pair.client, pair.server}) {
+      if (endpoint == nullptr) continue;
+      grpc_endpoint_shutdown(endpoint, GRPC_ERROR_NONE);
+      grpc_endpoint_destroy(endpoint);
+    }
+  }
+
+ private:
+  // Polls until \a pending returns false or a deadline passes. \a pending is
+  // called with mu_ held; whatever makes it return false must kick pollset_.
+  void PollWhile(const std::function<bool()>& pending) {
+    grpc_millis deadline = ExecCtx::Get()->Now() + 10 * GPR_MS_PER_SEC;
+    gpr_mu_lock(mu_);
+    while (pending()) {
+      if (ExecCtx::Get()->Now() >= deadline) {
+        ADD_FAILURE() << "timed out";
+        break;
+      }
+      grpc_pollset_worker* worker = nullptr;
+      GRPC_LOG_IF_ERROR("pollset_work",
+                        grpc_pollset_work(pollset_, &worker, deadline));
+      gpr_mu_unlock(mu_);
+      ExecCtx::Get()->Flush();
+      gpr_mu_lock(mu_);
+    }
+    gpr_mu_unlock(mu_);
+  }
+
+  static void OnHandshakeDone(void* arg, grpc_error_handle error) {
+    HandshakerArgs* args = static_cast<HandshakerArgs*>(arg);
+    HandshakeState* state = static_cast<HandshakeState*>(args->user_data);
+    if (error == GRPC_ERROR_NONE) {
+      // On success, the callback owns the handshake's results.
+      grpc_channel_args_destroy(args->args);
+      grpc_slice_buffer_destroy_internal(args->read_buffer);
+      gpr_free(args->read_buffer);
+    }
+    gpr_mu_lock(state->test->mu_);
+    state->done = true;
+    state->error = GRPC_ERROR_REF(error);
+    if (error == GRPC_ERROR_NONE) state->endpoint = args->endpoint;
+    GRPC_LOG_IF_ERROR("pollset_kick",
+                      grpc_pollset_kick(state->test->pollset_, nullptr));
+    gpr_mu_unlock(state->test->mu_);
+  }
+
+  static void OnIoDone(void* arg, grpc_error_handle error) {
+    IoState* state = static_cast<IoState*>(arg);
+    gpr_mu_lock(state->test->mu_);
+    state->done = true;
+    state->error = GRPC_ERROR_REF(error);
+    GRPC_LOG_IF_ERROR("pollset_kick",
+                      grpc_pollset_kick(state->test->pollset_, nullptr));
+    gpr_mu_unlock(state->test->mu_);
+  }
+
+  static void OnReadDone(void* arg, grpc_error_handle error) {
+    IoState* state = static_cast<IoState*>(arg);
+    if (error == GRPC_ERROR_NONE && state->buffer.length < state->length) {
+      grpc_endpoint_read(state->endpoint, &state->buffer, &state->closure,
+                         /*urgent=*/false);
+      return;
+    }
+    OnIoDone(arg, error);
+  }
+
+  gpr_mu* mu_;
+  grpc_pollset* pollset_;
+};
+
+#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
+int64_t OffloadedSteps() {
+  grpc_stats_data stats;
+  grpc_stats_collect(&stats);
+  return stats.counters[GRPC_STATS_COUNTER_SECURITY_HANDSHAKE_OFFLOADED_STEPS];
+}
+#endif
+
+TEST_F(SecurityHandshakerTest, OffloadedHandshake) {
+#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
+  int64_t offloaded_steps = OffloadedSteps();
+#endif
+  RunFakeHandshakes(/*offload=*/true);
+#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
+  // Each side runs at least one handshaker step, and the pool is idle.
+  EXPECT_GE(OffloadedSteps() - offloaded_steps, 2);
+#endif
+}
+
+TEST_F(SecurityHandshakerTest, InlineHandshake) {
+#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
+  int64_t offloaded_steps = OffloadedSteps();
+#endif
+  RunFakeHandshakes(/*offload=*/false);
+#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
+  EXPECT_EQ(OffloadedSteps(), offloaded_steps);
+#endif
+}
+
+TEST_F(SecurityHandshakerTest, StoppedOffloadPoolRunsStepsInline) {
+  // What grpc_shutdown() and the prefork handler do.
+  SecurityHandshakerShutdown();
+#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
+  int64_t offloaded_steps = OffloadedSteps();
+#endif
+  RunFakeHandshakes(/*offload=*/true);
+#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
+  EXPECT_EQ(OffloadedSteps(), offloaded_steps);
+#endif
+  // The pool threads are started again on demand.
+  SecurityHandshakerInit();
+  RunFakeHandshakes(/*offload=*/true);
+#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
+  EXPECT_GE(OffloadedSteps() - offloaded_steps, 2);
+#endif
+}
+
+#ifdef GRPC_LINUX_KTLS
+
+// Connects two TCP sockets over the loopback interface. kTLS only applies to
+// TCP sockets, which grpc_iomgr_create_endpoint_pair() does not create.
+void CreateTcpSocketPair(int fds[2]) {
+  int listener = socket(AF_INET, SOCK_STREAM, 0);
+  GPR_ASSERT(listener >= 0);
+  sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  socklen_t addr_len = sizeof(addr);
+  GPR_ASSERT(bind(listener, reinterpret_cast<sockaddr*>(&addr), addr_len) ==
+             0);
+  GPR_ASSERT(listen(listener, 1) == 0);
+  GPR_ASSERT(getsockname(listener, reinterpret_cast<sockaddr*>(&addr),
+                         &addr_len) == 0);
+  fds[0] = socket(AF_INET, SOCK_STREAM, 0);
+  GPR_ASSERT(fds[0] >= 0);
+  GPR_ASSERT(connect(fds[0], reinterpret_cast<sockaddr*>(&addr), addr_len) ==
+             0);
+  fds[1] = accept(listener, nullptr, nullptr);
+  GPR_ASSERT(fds[1] >= 0);
+  close(listener);
+}
+
+grpc_endpoint_pair CreateTcpEndpointPair(const grpc_channel_args* args) {
+  int fds[2];
+  CreateTcpSocketPair(fds);
+  GPR_ASSERT(grpc_set_socket_nonblocking(fds[0], 1) == GRPC_ERROR_NONE);
+  GPR_ASSERT(grpc_set_socket_nonblocking(fds[1], 1) == GRPC_ERROR_NONE);
+  const grpc_channel_args* tcp_args =
+      CoreConfiguration::Get()
+          .channel_args_preconditioning()
+          .PreconditionChannelArgs(args);
+  grpc_endpoint_pair pair;
+  pair.client =
+      grpc_tcp_create(grpc_fd_create(fds[0], "security_handshaker_test:client",
+                                     false),
+                      tcp_args, "tcp-client");
+  pair.server =
+      grpc_tcp_create(grpc_fd_create(fds[1], "security_handshaker_test:server",
+                                     false),
+                      tcp_args, "tcp-server");
+  grpc_channel_args_destroy(tcp_args);
+  return pair;
+}
+
+// Whether the kernel can take both directions of a TLS 1.2 AES-GCM session
+// over from user space.
+bool KernelTlsAvailable() {
+  int fds[2];
+  CreateTcpSocketPair(fds);
+  tls12_crypto_info_aes_gcm_128 info;
+  memset(&info, 0, sizeof(info));
+  info.info.version = TLS_1_2_VERSION;
+  info.info.cipher_type = TLS_CIPHER_AES_GCM_128;
+  bool available =
+      setsockopt(fds[0], IPPROTO_TCP, TCP_ULP, "tls", sizeof("tls")) == 0 &&
+      setsockopt(fds[0], SOL_TLS, TLS_RX, &info, sizeof(info)) == 0 &&
+      setsockopt(fds[0], SOL_TLS, TLS_TX, &info, sizeof(info)) == 0;
+  close(fds[0]);
+  close(fds[1]);
+  return available;
+}
+
+// Returns why TLS 1.2 sessions cannot be handed over to the kernel in this
+// build and on this machine, or nullptr if they can.
+const char* KernelTlsUnsupportedReason() {
+  if (!KernelTlsAvailable()) return "the kernel does not support kTLS";
+#if defined(OPENSSL_IS_BORINGSSL)
+  return nullptr;
+#else
+  return "only BoringSSL exports the session keys";
+#endif
+}
+
+// Whether the kernel protects the records written to and read from the socket
+// of endpoint.
+bool KernelTlsInstalled(grpc_endpoint* endpoint) {
+  char ulp[16] = {};
+  socklen_t ulp_len = sizeof(ulp);
+  return getsockopt(grpc_endpoint_get_fd(endpoint), IPPROTO_TCP, TCP_ULP, ulp,
+                    &ulp_len) == 0 &&
+         strcmp(ulp, "tls") == 0;
+}
+
+// Returns up to 4096 bytes queued for reading on the socket of endpoint once
+// at least length are, without consuming them.
+std::string PeekSocket(grpc_endpoint* endpoint, size_t length) {
+  int fd = grpc_endpoint_get_fd(endpoint);
+  char buf[4096];
+  ssize_t peeked = 0;
+  for (int i = 0; i < 100 && peeked < static_cast<ssize_t>(length); ++i) {
+    pollfd pfd = {fd, POLLIN, 0};
+    poll(&pfd, 1, 100);
+    peeked = recv(fd, buf, sizeof(buf), MSG_PEEK | MSG_DONTWAIT);
+    if (peeked < 0) peeked = 0;
+  }
+  return std::string(buf, peeked);
+}
+
+class KernelTlsOffloadTest : public SecurityHandshakerTest {
+ protected:
+  // Runs SSL handshakes of at most TLS version \a max_tls_version over a TCP
+  // connection with GRPC_ARG_TLS_KERNEL_OFFLOAD set.
+  grpc_endpoint_pair RunOffloadHandshakes(grpc_tls_version max_tls_version) {
+    grpc_arg arg = grpc_channel_arg_integer_create(
+        const_cast<char*>(GRPC_ARG_TLS_KERNEL_OFFLOAD), 1);
+    grpc_channel_args args = {1, &arg};
+    return RunSslHandshakes(max_tls_version, CreateTcpEndpointPair(&args),
+                            &args);
+  }
+
+  // Sends \a message from one endpoint to the other. If \a kernel_tls, the
+  // kernel decrypts the records before they are read from the socket;
+  // otherwise they must still be encrypted there.
+  void ExpectTransfer(grpc_endpoint* from, grpc_endpoint* to,
+                      const std::string& message, bool kernel_tls) {
+    Write(from, message);
+    std::string queued = PeekSocket(to, message.size());
+    if (kernel_tls) {
+      EXPECT_EQ(queued, message);
+    } else {
+      EXPECT_NE(queued.size(), 0);
+      EXPECT_EQ(queued.find(message), std::string::npos);
+    }
+    EXPECT_EQ(Read(to, message.size()), message);
+  }
+};
+
+// A TLS 1.2 session is handed over to the kernel wherever it supports kTLS.
+TEST_F(KernelTlsOffloadTest, Tls12) {
+  const char* unsupported = KernelTlsUnsupportedReason();
+  if (unsupported != nullptr) {
+    GTEST_SKIP() << "TLS 1.2 sessions stay in user space: " << unsupported;
+  }
+  ExecCtx exec_ctx;
+  grpc_endpoint_pair pair = RunOffloadHandshakes(grpc_tls_version::TLS1_2);
+  ASSERT_NE(pair.client, nullptr);
+  ASSERT_NE(pair.server, nullptr);
+  EXPECT_TRUE(KernelTlsInstalled(pair.client));
+  EXPECT_TRUE(KernelTlsInstalled(pair.server));
+  ExpectTransfer(pair.client, pair.server, "client to server", true);
+  ExpectTransfer(pair.server, pair.client, "server to client", true);
+  DestroyEndpoints(pair);
+}
+
+// Otherwise it is protected in user space, as if offload was not requested.
+TEST_F(KernelTlsOffloadTest, Tls12FallsBackWithoutKernelTls) {
+  const char* unsupported = KernelTlsUnsupportedReason();
+  if (unsupported == nullptr) {
+    GTEST_SKIP() << "kTLS is supported, see KernelTlsOffloadTest.Tls12";
+  }
+  gpr_log(GPR_INFO, "Expecting user-space TLS 1.2: %s", unsupported);
+  ExecCtx exec_ctx;
+  grpc_endpoint_pair pair = RunOffloadHandshakes(grpc_tls_version::TLS1_2);
+  ASSERT_NE(pair.client, nullptr);
+  ASSERT_NE(pair.server, nullptr);
+  EXPECT_FALSE(KernelTlsInstalled(pair.client));
+  EXPECT_FALSE(KernelTlsInstalled(pair.server));
+  ExpectTransfer(pair.client, pair.server, "client to server", false);
+  ExpectTransfer(pair.server, pair.client, "server to client", false);
+  DestroyEndpoints(pair);
+}
+
+// TLS 1.3 sessions stay in user space even where the kernel supports kTLS.
+TEST_F(KernelTlsOffloadTest, FallsBackForTls13) {
+  ExecCtx exec_ctx;
+  grpc_endpoint_pair pair = RunOffloadHandshakes(grpc_tls_version::TLS1_3);
+  ASSERT_NE(pair.client, nullptr);
+  ASSERT_NE(pair.server, nullptr);
+  EXPECT_FALSE(KernelTlsInstalled(pair.client));
+  EXPECT_FALSE(KernelTlsInstalled(pair.server));
+  ExpectTransfer(pair.client, pair.server, "client to server", false);
+  ExpectTransfer(pair.server, pair.client, "server to client", false);
+  DestroyEndpoints(pair);
+}
+
+#endif  // GRPC_LINUX_KTLS
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc::testing::TestEnvironment env(argc, argv);
+  grpc_init();
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
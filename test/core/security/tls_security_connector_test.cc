@@ -28,6 +28,7 @@
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
 
+#include "src/core/lib/channel/handshaker.h"
 #include "src/core/lib/iomgr/load_file.h"
 #include "src/core/lib/security/credentials/tls/grpc_tls_certificate_provider.h"
 #include "src/core/lib/security/credentials/tls/tls_credentials.h"
@@ -165,6 +166,44 @@ TEST_F(TlsSecurityConnectorTest,
   grpc_channel_args_destroy(new_args);
 }
 
+TEST_F(TlsSecurityConnectorTest,
+       HandshakerFactoryRebuiltOnNextHandshakeForChannelSecurityConnector) {
+  RefCountedPtr<grpc_tls_certificate_distributor> distributor =
+      MakeRefCounted<grpc_tls_certificate_distributor>();
+  distributor->SetKeyMaterials(kRootCertName, root_cert_0_, absl::nullopt);
+  RefCountedPtr<::grpc_tls_certificate_provider> provider =
+      MakeRefCounted<TlsTestCertificateProvider>(distributor);
+  RefCountedPtr<grpc_tls_credentials_options> options =
+      MakeRefCounted<grpc_tls_credentials_options>();
+  options->set_certificate_provider(provider);
+  options->set_watch_root_cert(true);
+  options->set_root_cert_name(kRootCertName);
+  RefCountedPtr<TlsCredentials> credential =
+      MakeRefCounted<TlsCredentials>(options);
+  grpc_channel_args* new_args = nullptr;
+  RefCountedPtr<grpc_channel_security_connector> connector =
+      credential->create_security_connector(nullptr, kTargetName, nullptr,
+                                            &new_args);
+  ASSERT_NE(connector, nullptr);
+  TlsChannelSecurityConnector* tls_connector =
+      static_cast<TlsChannelSecurityConnector*>(connector.get());
+  tsi_ssl_client_handshaker_factory* factory =
+      tls_connector->ClientHandshakerFactoryForTesting();
+  ASSERT_NE(factory, nullptr);
+  ExecCtx exec_ctx;
+  // The handshake holds on to the factory it was created from.
+  auto handshake_mgr = MakeRefCounted<HandshakeManager>();
+  connector->add_handshakers(nullptr, nullptr, handshake_mgr.get());
+  distributor->SetKeyMaterials(kRootCertName, root_cert_1_, absl::nullopt);
+  EXPECT_EQ(tls_connector->RootCertsForTesting(), root_cert_1_);
+  EXPECT_EQ(tls_connector->ClientHandshakerFactoryForTesting(), factory);
+  auto next_handshake_mgr = MakeRefCounted<HandshakeManager>();
+  connector->add_handshakers(nullptr, nullptr, next_handshake_mgr.get());
+  EXPECT_NE(tls_connector->ClientHandshakerFactoryForTesting(), factory);
+  EXPECT_NE(tls_connector->ClientHandshakerFactoryForTesting(), nullptr);
+  grpc_channel_args_destroy(new_args);
+}
+
 TEST_F(TlsSecurityConnectorTest,
        SystemRootsWhenCreateChannelSecurityConnector) {
   // Create options watching for no certificates.
@@ -724,6 +763,200 @@ TEST_F(TlsSecurityConnectorTest,
   grpc_channel_args_destroy(new_args);
 }
 
+//
+// Tests for the verification result cache in ChannelSecurityConnector.
+//
+
+// A verifier accepting every peer, which counts how often it was invoked. When
+// asynchronous, each verification is pending until Complete() is called.
+class CountingCertificateVerifier : public grpc_tls_certificate_verifier {
+ public:
+  explicit CountingCertificateVerifier(bool is_async) : is_async_(is_async) {}
+
+  bool Verify(grpc_tls_custom_verification_check_request* /*request*/,
+              std::function<void(absl::Status)> callback,
+              absl::Status* sync_status) override {
+    ++num_verify_calls_;
+    if (is_async_) {
+      callback_ = std::move(callback);
+      return false;
+    }
+    *sync_status = absl::OkStatus();
+    return true;
+  }
+
+  void Cancel(
+      grpc_tls_custom_verification_check_request* /*request*/) override {}
+
+  void Complete() {
+    GPR_ASSERT(callback_ != nullptr);
+    ExecCtx exec_ctx;
+    std::function<void(absl::Status)> callback = std::move(callback_);
+    callback_ = nullptr;
+    callback(absl::OkStatus());
+  }
+
+  int num_verify_calls() const { return num_verify_calls_; }
+
+ private:
+  const bool is_async_;
+  int num_verify_calls_ = 0;
+  std::function<void(absl::Status)> callback_;
+};
+
+// Checks a peer presenting |pem_cert| against |connector|, expecting success.
+void CheckPeerWithCert(grpc_channel_security_connector* connector,
+                       const std::string& pem_cert) {
+  tsi_peer peer;
+  GPR_ASSERT(tsi_construct_peer(2, &peer) == TSI_OK);
+  GPR_ASSERT(tsi_construct_string_peer_property(TSI_SSL_ALPN_SELECTED_PROTOCOL,
+                                                "grpc", strlen("grpc"),
+                                                &peer.properties[0]) == TSI_OK);
+  GPR_ASSERT(tsi_construct_string_peer_property(
+                 TSI_X509_PEM_CERT_PROPERTY, pem_cert.data(), pem_cert.size(),
+                 &peer.properties[1]) == TSI_OK);
+  RefCountedPtr<grpc_auth_context> auth_context;
+  ExecCtx exec_ctx;
+  grpc_closure* on_peer_checked = GRPC_CLOSURE_CREATE(
+      [](void* /*arg*/, grpc_error_handle error) {
+        EXPECT_EQ(error, GRPC_ERROR_NONE);
+      },
+      nullptr, grpc_schedule_on_exec_ctx);
+  connector->check_peer(peer, nullptr, &auth_context, on_peer_checked);
+}
+
+TEST_F(TlsSecurityConnectorTest,
+       ChannelSecurityConnectorServesRepeatedPeersFromCache) {
+  auto verifier = MakeRefCounted<CountingCertificateVerifier>(false);
+  auto options = MakeRefCounted<grpc_tls_credentials_options>();
+  options->set_verify_server_cert(true);
+  options->set_certificate_verifier(verifier);
+  options->set_check_call_host(false);
+  options->set_verification_result_cache_size(8);
+  RefCountedPtr<TlsCredentials> credential =
+      MakeRefCounted<TlsCredentials>(options);
+  grpc_channel_args* new_args = nullptr;
+  RefCountedPtr<grpc_channel_security_connector> connector =
+      credential->create_security_connector(nullptr, kTargetName, nullptr,
+                                            &new_args);
+  ASSERT_NE(connector, nullptr);
+  const std::string& pem_cert_0 = identity_pairs_0_[0].cert_chain();
+  const std::string& pem_cert_1 = identity_pairs_1_[0].cert_chain();
+  CheckPeerWithCert(connector.get(), pem_cert_0);
+  EXPECT_EQ(verifier->num_verify_calls(), 1);
+  CheckPeerWithCert(connector.get(), pem_cert_0);
+  EXPECT_EQ(verifier->num_verify_calls(), 1);
+  // A different peer is verified.
+  CheckPeerWithCert(connector.get(), pem_cert_1);
+  EXPECT_EQ(verifier->num_verify_calls(), 2);
+  grpc_channel_args_destroy(new_args);
+}
+
+TEST_F(TlsSecurityConnectorTest,
+       ChannelSecurityConnectorReverifiesPeersAfterRootRotation) {
+  RefCountedPtr<grpc_tls_certificate_distributor> distributor =
+      MakeRefCounted<grpc_tls_certificate_distributor>();
+  distributor->SetKeyMaterials(kRootCertName, root_cert_0_, absl::nullopt);
+  RefCountedPtr<::grpc_tls_certificate_provider> provider =
+      MakeRefCounted<TlsTestCertificateProvider>(distributor);
+  auto verifier = MakeRefCounted<CountingCertificateVerifier>(false);
+  auto options = MakeRefCounted<grpc_tls_credentials_options>();
+  options->set_certificate_provider(provider);
+  options->set_watch_root_cert(true);
+  options->set_root_cert_name(kRootCertName);
+  options->set_verify_server_cert(true);
+  options->set_certificate_verifier(verifier);
+  options->set_check_call_host(false);
+  options->set_verification_result_cache_size(8);
+  RefCountedPtr<TlsCredentials> credential =
+      MakeRefCounted<TlsCredentials>(options);
+  grpc_channel_args* new_args = nullptr;
+  RefCountedPtr<grpc_channel_security_connector> connector =
+      credential->create_security_connector(nullptr, kTargetName, nullptr,
+                                            &new_args);
+  ASSERT_NE(connector, nullptr);
+  const std::string& pem_cert = identity_pairs_0_[0].cert_chain();
+  CheckPeerWithCert(connector.get(), pem_cert);
+  CheckPeerWithCert(connector.get(), pem_cert);
+  EXPECT_EQ(verifier->num_verify_calls(), 1);
+  distributor->SetKeyMaterials(kRootCertName, root_cert_1_, absl::nullopt);
+  CheckPeerWithCert(connector.get(), pem_cert);
+  EXPECT_EQ(verifier->num_verify_calls(), 2);
+  CheckPeerWithCert(connector.get(), pem_cert);
+  EXPECT_EQ(verifier->num_verify_calls(), 2);
+  grpc_channel_args_destroy(new_args);
+}
+
+TEST_F(TlsSecurityConnectorTest,
+       ChannelSecurityConnectorDoesNotCacheResultsAcrossRootRotation) {
+  RefCountedPtr<grpc_tls_certificate_distributor> distributor =
+      MakeRefCounted<grpc_tls_certificate_distributor>();
+  distributor->SetKeyMaterials(kRootCertName, root_cert_0_, absl::nullopt);
+  RefCountedPtr<::grpc_tls_certificate_provider> provider =
+      MakeRefCounted<TlsTestCertificateProvider>(distributor);
+  auto verifier = MakeRefCounted<CountingCertificateVerifier>(true);
+  auto options = MakeRefCounted<grpc_tls_credentials_options>();
+  options->set_certificate_provider(provider);
+  options->set_watch_root_cert(true);
+  options->set_root_cert_name(kRootCertName);
+  options->set_verify_server_cert(true);
+  options->set_certificate_verifier(verifier);
+  options->set_check_call_host(false);
+  options->set_verification_result_cache_size(8);
+  RefCountedPtr<TlsCredentials> credential =
+      MakeRefCounted<TlsCredentials>(options);
+  grpc_channel_args* new_args = nullptr;
+  RefCountedPtr<grpc_channel_security_connector> connector =
+      credential->create_security_connector(nullptr, kTargetName, nullptr,
+                                            &new_args);
+  ASSERT_NE(connector, nullptr);
+  const std::string& pem_cert = identity_pairs_0_[0].cert_chain();
+  // The roots change while the peer is being verified against the old ones.
+  CheckPeerWithCert(connector.get(), pem_cert);
+  distributor->SetKeyMaterials(kRootCertName, root_cert_1_, absl::nullopt);
+  verifier->Complete();
+  EXPECT_EQ(verifier->num_verify_calls(), 1);
+  CheckPeerWithCert(connector.get(), pem_cert);
+  EXPECT_EQ(verifier->num_verify_calls(), 2);
+  verifier->Complete();
+  // Results obtained with the current roots are cached.
+  CheckPeerWithCert(connector.get(), pem_cert);
+  EXPECT_EQ(verifier->num_verify_calls(), 2);
+  grpc_channel_args_destroy(new_args);
+}
+
+TEST_F(TlsSecurityConnectorTest,
+       ChannelSecurityConnectorDoesNotShareResultsAcrossVerifiers) {
+  auto verifier_a = MakeRefCounted<CountingCertificateVerifier>(false);
+  auto verifier_b = MakeRefCounted<CountingCertificateVerifier>(false);
+  auto options = MakeRefCounted<grpc_tls_credentials_options>();
+  options->set_verify_server_cert(true);
+  options->set_certificate_verifier(verifier_a);
+  options->set_check_call_host(false);
+  options->set_verification_result_cache_size(8);
+  RefCountedPtr<TlsCredentials> credential =
+      MakeRefCounted<TlsCredentials>(options);
+  const std::string& pem_cert = identity_pairs_0_[0].cert_chain();
+  grpc_channel_args* new_args_a = nullptr;
+  RefCountedPtr<grpc_channel_security_connector> connector_a =
+      credential->create_security_connector(nullptr, kTargetName, nullptr,
+                                            &new_args_a);
+  ASSERT_NE(connector_a, nullptr);
+  CheckPeerWithCert(connector_a.get(), pem_cert);
+  EXPECT_EQ(verifier_a->num_verify_calls(), 1);
+  options->set_certificate_verifier(verifier_b);
+  grpc_channel_args* new_args_b = nullptr;
+  RefCountedPtr<grpc_channel_security_connector> connector_b =
+      credential->create_security_connector(nullptr, kTargetName, nullptr,
+                                            &new_args_b);
+  ASSERT_NE(connector_b, nullptr);
+  CheckPeerWithCert(connector_b.get(), pem_cert);
+  EXPECT_EQ(verifier_a->num_verify_calls(), 1);
+  EXPECT_EQ(verifier_b->num_verify_calls(), 1);
+  grpc_channel_args_destroy(new_args_a);
+  grpc_channel_args_destroy(new_args_b);
+}
+
 //
 // Tests for Certificate Providers in ServerSecurityConnector.
 //
@@ -762,6 +995,43 @@ TEST_F(TlsSecurityConnectorTest,
   EXPECT_EQ(tls_connector->KeyCertPairListForTesting(), identity_pairs_1_);
 }
 
+TEST_F(TlsSecurityConnectorTest,
+       HandshakerFactoryRebuiltOnNextHandshakeForServerSecurityConnector) {
+  RefCountedPtr<grpc_tls_certificate_distributor> distributor =
+      MakeRefCounted<grpc_tls_certificate_distributor>();
+  distributor->SetKeyMaterials(kIdentityCertName, absl::nullopt,
+                               identity_pairs_0_);
+  RefCountedPtr<::grpc_tls_certificate_provider> provider =
+      MakeRefCounted<TlsTestCertificateProvider>(distributor);
+  RefCountedPtr<grpc_tls_credentials_options> options =
+      MakeRefCounted<grpc_tls_credentials_options>();
+  options->set_certificate_provider(provider);
+  options->set_watch_identity_pair(true);
+  options->set_identity_cert_name(kIdentityCertName);
+  RefCountedPtr<TlsServerCredentials> credential =
+      MakeRefCounted<TlsServerCredentials>(options);
+  RefCountedPtr<grpc_server_security_connector> connector =
+      credential->create_security_connector(nullptr);
+  ASSERT_NE(connector, nullptr);
+  TlsServerSecurityConnector* tls_connector =
+      static_cast<TlsServerSecurityConnector*>(connector.get());
+  tsi_ssl_server_handshaker_factory* factory =
+      tls_connector->ServerHandshakerFactoryForTesting();
+  ASSERT_NE(factory, nullptr);
+  ExecCtx exec_ctx;
+  // The handshake holds on to the factory it was created from.
+  auto handshake_mgr = MakeRefCounted<HandshakeManager>();
+  connector->add_handshakers(nullptr, nullptr, handshake_mgr.get());
+  distributor->SetKeyMaterials(kIdentityCertName, absl::nullopt,
+                               identity_pairs_1_);
+  EXPECT_EQ(tls_connector->KeyCertPairListForTesting(), identity_pairs_1_);
+  EXPECT_EQ(tls_connector->ServerHandshakerFactoryForTesting(), factory);
+  auto next_handshake_mgr = MakeRefCounted<HandshakeManager>();
+  connector->add_handshakers(nullptr, nullptr, next_handshake_mgr.get());
+  EXPECT_NE(tls_connector->ServerHandshakerFactoryForTesting(), factory);
+  EXPECT_NE(tls_connector->ServerHandshakerFactoryForTesting(), nullptr);
+}
+
 // Note that on server side, we don't have tests watching root certs only,
 // because in TLS, the identity certs should always be presented. If we don't
 // provide, it will try to load certs from some default system locations, and
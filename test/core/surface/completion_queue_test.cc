@@ -166,6 +166,36 @@ static void test_cq_end_op(void) {
   }
 }
 
+static void test_cq_end_op_sharded(void) {
+  grpc_event ev;
+  grpc_completion_queue* cc;
+  grpc_cq_completion completion;
+  grpc_cq_polling_type polling_types[] = {
+      GRPC_CQ_DEFAULT_POLLING, GRPC_CQ_NON_LISTENING, GRPC_CQ_NON_POLLING};
+  void* tag = create_test_tag();
+
+  LOG_TEST("test_cq_end_op_sharded");
+
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(polling_types); i++) {
+    grpc_core::ExecCtx exec_ctx;
+    cc = grpc_completion_queue_create_internal(GRPC_CQ_NEXT, polling_types[i],
+                                               nullptr,
+                                               GRPC_CQ_SHARDED_EVENT_QUEUE);
+
+    GPR_ASSERT(grpc_cq_begin_op(cc, tag));
+    grpc_cq_end_op(cc, tag, GRPC_ERROR_NONE, do_nothing_end_completion, nullptr,
+                   &completion);
+
+    ev = grpc_completion_queue_next(cc, gpr_inf_past(GPR_CLOCK_REALTIME),
+                                    nullptr);
+    GPR_ASSERT(ev.type == GRPC_OP_COMPLETE);
+    GPR_ASSERT(ev.tag == tag);
+    GPR_ASSERT(ev.success);
+
+    shutdown_and_destroy(cc);
+  }
+}
+
 static void test_cq_tls_cache_full(void) {
   grpc_event ev;
   grpc_completion_queue* cc;
@@ -495,6 +525,7 @@ int main(int argc, char** argv) {
   test_shutdown_then_next_polling();
   test_shutdown_then_next_with_timeout();
   test_cq_end_op();
+  test_cq_end_op_sharded();
   test_pluck();
   test_pluck_after_shutdown();
   test_cq_tls_cache_full();
@@ -205,18 +205,23 @@ static void consumer_thread(void* arg) {
   }
 }
 
-static void test_threading(size_t producers, size_t consumers) {
+static void test_threading(size_t producers, size_t consumers,
+                           grpc_cq_event_queue_type event_queue_type) {
   test_thread_options* options = static_cast<test_thread_options*>(
       gpr_malloc((producers + consumers) * sizeof(test_thread_options)));
   gpr_event phase1 = GPR_EVENT_INIT;
   gpr_event phase2 = GPR_EVENT_INIT;
-  grpc_completion_queue* cc = grpc_completion_queue_create_for_next(nullptr);
+  grpc_completion_queue* cc = grpc_completion_queue_create_internal(
+      GRPC_CQ_NEXT, GRPC_CQ_DEFAULT_POLLING, nullptr, event_queue_type);
   size_t i;
   size_t total_consumed = 0;
   static int optid = 101;
 
-  gpr_log(GPR_INFO, "%s: %" PRIuPTR " producers, %" PRIuPTR " consumers",
-          "test_threading", producers, consumers);
+  gpr_log(GPR_INFO,
+          "%s: %" PRIuPTR " producers, %" PRIuPTR " consumers, %s event queue",
+          "test_threading", producers, consumers,
+          event_queue_type == GRPC_CQ_SHARDED_EVENT_QUEUE ? "sharded"
+                                                          : "single");
 
   /* start all threads: they will wait for phase1 */
   grpc_core::Thread* threads = static_cast<grpc_core::Thread*>(
@@ -291,10 +296,14 @@ int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(argc, argv);
   grpc_init();
   test_too_many_plucks();
-  test_threading(1, 1);
-  test_threading(1, 10);
-  test_threading(10, 1);
-  test_threading(10, 10);
+  grpc_cq_event_queue_type event_queue_types[] = {
+      GRPC_CQ_SINGLE_EVENT_QUEUE, GRPC_CQ_SHARDED_EVENT_QUEUE};
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(event_queue_types); i++) {
+    test_threading(1, 1, event_queue_types[i]);
+    test_threading(1, 10, event_queue_types[i]);
+    test_threading(10, 1, event_queue_types[i]);
+    test_threading(10, 10, event_queue_types[i]);
+  }
   grpc_shutdown();
   return 0;
 }
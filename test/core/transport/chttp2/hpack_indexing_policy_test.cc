@@ -0,0 +1,105 @@
+/*
+ *
+ * Copyright 2021 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/impl/codegen/port_platform.h>
+
+#include "src/core/ext/transport/chttp2/transport/hpack_indexing_policy.h"
+
+#include <gtest/gtest.h>
+
+namespace grpc_core {
+namespace testing {
+
+using Mode = HPackIndexingPolicy::Mode;
+
+TEST(HPackIndexingPolicyTest, PopularityModeFollowsFilter) {
+  HPackIndexingPolicy policy;
+  HPackEncoderTable table;
+  EXPECT_EQ(policy.mode(), Mode::kPopularity);
+  bool popular = policy.Observe(1, 100);
+  EXPECT_EQ(policy.ShouldIndex(popular, 1, 100, table), popular);
+  EXPECT_EQ(policy.ShouldIndex(false, 1, 100, table), false);
+  EXPECT_FALSE(policy.ShouldRefresh(1, 100, 1, table));
+}
+
+TEST(HPackIndexingPolicyTest, AdaptiveSkipsFirstOccurrence) {
+  HPackIndexingPolicy policy;
+  policy.set_mode(Mode::kAdaptive);
+  HPackEncoderTable table;
+  policy.Observe(1, 100);
+  EXPECT_FALSE(policy.ShouldIndex(true, 1, 100, table));
+  policy.Observe(1, 100);
+  EXPECT_TRUE(policy.ShouldIndex(false, 1, 100, table));
+}
+
+TEST(HPackIndexingPolicyTest, AdaptiveKeepsValuableEntries) {
+  HPackIndexingPolicy policy;
+  policy.set_mode(Mode::kAdaptive);
+  HPackEncoderTable table;
+  // Fill the (4k) table with two 2000 byte entries from a frequently used
+  // bucket.
+  for (int i = 0; i < 20; i++) policy.Observe(1, 2000);
+  table.AllocateIndex(2000, 1);
+  table.AllocateIndex(2000, 1);
+  // An element seen twice is not worth evicting them for.
+  policy.Observe(2, 200);
+  policy.Observe(2, 200);
+  EXPECT_FALSE(policy.ShouldIndex(true, 2, 200, table));
+  // But with room to spare it would be indexed.
+  HPackEncoderTable empty_table;
+  EXPECT_TRUE(policy.ShouldIndex(true, 2, 200, empty_table));
+}
+
+TEST(HPackIndexingPolicyTest, AdaptiveRefreshesOldestEntries) {
+  HPackIndexingPolicy policy;
+  policy.set_mode(Mode::kAdaptive);
+  HPackEncoderTable table;
+  for (int i = 0; i < 20; i++) policy.Observe(1, 100);
+  uint32_t oldest = table.AllocateIndex(100, 1);
+  uint32_t newest = oldest;
+  for (int i = 0; i < 7; i++) newest = table.AllocateIndex(100, 1);
+  EXPECT_TRUE(policy.ShouldRefresh(1, 100, oldest, table));
+  EXPECT_FALSE(policy.ShouldRefresh(1, 100, newest, table));
+  // Rarely used elements are not worth refreshing.
+  policy.Observe(2, 100);
+  EXPECT_FALSE(policy.ShouldRefresh(2, 100, oldest, table));
+}
+
+TEST(HPackIndexingPolicyTest, TableTracksInsertionsAndEvictions) {
+  HPackEncoderTable table;
+  table.AllocateIndex(2000, 1);
+  table.AllocateIndex(2000, 2);
+  int evicted = 0;
+  table.ForEachEvictedBy(2000, [&evicted](uint8_t tag, uint16_t size) {
+    EXPECT_EQ(tag, 1);
+    EXPECT_EQ(size, 2000);
+    evicted++;
+  });
+  EXPECT_EQ(evicted, 1);
+  table.AllocateIndex(2000);
+  EXPECT_EQ(table.insertions(), 3u);
+  EXPECT_EQ(table.evictions(), 1u);
+}
+
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -289,6 +289,28 @@ INSTANTIATE_TEST_SUITE_P(
                  {"40 09 61 2e 62 2e 63 2d 62 69 6e 0c 62 32 31 6e 4d 6a 41 79 "
                   "4d 51 3d 3d",
                   "a.b.c-bin: omg2021\n"},
+             }},
+        Test{{},
+             {
+                 // Huffman coded values with codes longer than the 11 bits
+                 // the decoder looks up at once, up to 30 bits (0x16).
+                 {"0001 78a1 1fff c8ff ff81 3fff fffe ffff fba4 fff3 ffef ffef"
+                  "f9ff efff 7feb ff3f faff dfff 3f",
+                  "x: a<b\\c\x16\xff"
+                  "d^`{|}~#$@[]\n"},
+                 {"0001 78b1 ba51 d85b 142f acb3 c788 86d4 6fff 9977 70f7 903a"
+                  "4d95 fffb 5fff f7f2 8b63 fe6e 7f21 132d 36e3 af3e 0fe7 ffdf"
+                  "f9ff dfff 3f",
+                  "x: Bearer eyJhbGciOi<JSUzI1NiJ9>."
+                  "{\"sub\":\"1234567890\"}|~^\n"},
+                 // An EOS embedded in a value is skipped.
+                 {"0001 7887 1c7f ffff ff92 4f", "x: abcd\n"},
+                 // Padding that isn't a prefix of EOS, or is longer than 7
+                 // bits, is not rejected: bits that don't make up a whole
+                 // code are dropped, and whole codes are decoded.
+                 {"0001 7881 18", "x: a\n"},
+                 {"0001 7882 1fff", "x: a\n"},
+                 {"0001 7882 1800", "x: a00\n"},
              }}));
 
 int main(int argc, char** argv) {
@@ -155,6 +155,7 @@ static void test_periodic_compaction(uint32_t n) {
 
   grpc_chttp2_stream_map_init(&map, 16);
   GPR_ASSERT(map.capacity == 16);
+  GPR_ASSERT(map.ordered_capacity == 16);
   for (i = 1; i <= n; i++) {
     grpc_chttp2_stream_map_add(&map, i, reinterpret_cast<void*>(i));
     if (i > 8) {
@@ -164,6 +165,38 @@ static void test_periodic_compaction(uint32_t n) {
     }
   }
   GPR_ASSERT(map.capacity == 16);
+  GPR_ASSERT(map.ordered_capacity == 16);
+  grpc_chttp2_stream_map_destroy(&map);
+}
+
+/* delete each entry, and the one after it, from within for_each */
+static void delete_two_for_each(void* user_data, uint32_t stream_id,
+                                void* ptr) {
+  grpc_chttp2_stream_map* map = static_cast<grpc_chttp2_stream_map*>(user_data);
+  GPR_ASSERT((void*)(uintptr_t)stream_id == ptr);
+  GPR_ASSERT(ptr == grpc_chttp2_stream_map_delete(map, stream_id));
+  if (grpc_chttp2_stream_map_find(map, stream_id + 1) != nullptr) {
+    grpc_chttp2_stream_map_delete(map, stream_id + 1);
+  }
+}
+
+/* add a bunch of keys and delete them all while iterating over them */
+static void test_delete_during_for_each(uint32_t n) {
+  grpc_chttp2_stream_map map;
+  uint32_t i;
+
+  LOG_TEST("test_delete_during_for_each");
+  gpr_log(GPR_INFO, "n = %d", n);
+
+  grpc_chttp2_stream_map_init(&map, 8);
+  for (i = 1; i <= n; i++) {
+    grpc_chttp2_stream_map_add(&map, i, reinterpret_cast<void*>(i));
+  }
+  grpc_chttp2_stream_map_for_each(&map, delete_two_for_each, &map);
+  GPR_ASSERT(0 == grpc_chttp2_stream_map_size(&map));
+  for (i = 1; i <= n; i++) {
+    GPR_ASSERT(nullptr == grpc_chttp2_stream_map_find(&map, i));
+  }
   grpc_chttp2_stream_map_destroy(&map);
 }
 
@@ -182,6 +215,7 @@ int main(int argc, char** argv) {
     test_delete_evens_sweep(n);
     test_delete_evens_incremental(n);
     test_periodic_compaction(n);
+    test_delete_during_for_each(n);
 
     tmp = n;
     n += prev;
@@ -0,0 +1,633 @@
+/*
+ *
+ * Copyright 2021 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Checks how the chttp2 transport groups the frames of several streams into
+// endpoint writes when GRPC_ARG_HTTP2_BATCH_WRITES or
+// GRPC_ARG_HTTP2_WRITE_CORK_US is set.
+
+#include <string.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "absl/strings/match.h"
+#include "absl/strings/string_view.h"
+
+#include <grpc/grpc.h>
+
+#include "src/core/ext/transport/chttp2/transport/chttp2_transport.h"
+#include "src/core/ext/transport/chttp2/transport/frame.h"
+#include "src/core/ext/transport/chttp2/transport/internal.h"
+#include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/gprpp/manual_constructor.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/iomgr/combiner.h"
+#include "src/core/lib/resource_quota/api.h"
+#include "src/core/lib/slice/slice_internal.h"
+#include "src/core/lib/transport/byte_stream.h"
+#include "src/core/lib/transport/transport.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+const absl::string_view kClientPreface = "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n";
+
+struct Frame {
+  uint8_t type;
+  uint32_t stream_id;
+
+  bool operator==(const Frame& other) const {
+    return type == other.type && stream_id == other.stream_id;
+  }
+};
+
+std::ostream& operator<<(std::ostream& out, const Frame& frame) {
+  return out << "{type=" << static_cast<int>(frame.type)
+             << ", stream_id=" << frame.stream_id << "}";
+}
+
+// Splits the bytes of one endpoint write into HTTP/2 frames.
+std::vector<Frame> ParseFrames(absl::string_view bytes) {
+  if (absl::StartsWith(bytes, kClientPreface)) {
+    bytes.remove_prefix(kClientPreface.size());
+  }
+  std::vector<Frame> frames;
+  while (!bytes.empty()) {
+    EXPECT_GE(bytes.size(), 9u);
+    if (bytes.size() < 9) break;
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(bytes.data());
+    size_t length = (static_cast<size_t>(p[0]) << 16) |
+                    (static_cast<size_t>(p[1]) << 8) | p[2];
+    Frame frame;
+    frame.type = p[3];
+    frame.stream_id = ((static_cast<uint32_t>(p[5]) & 0x7f) << 24) |
+                      (static_cast<uint32_t>(p[6]) << 16) |
+                      (static_cast<uint32_t>(p[7]) << 8) | p[8];
+    frames.push_back(frame);
+    EXPECT_GE(bytes.size(), 9 + length);
+    bytes.remove_prefix(std::min(bytes.size(), 9 + length));
+  }
+  return frames;
+}
+
+// Frames that carry stream data, in the order they were written.
+std::vector<Frame> StreamFrames(const std::vector<std::string>& writes) {
+  std::vector<Frame> frames;
+  for (const std::string& write : writes) {
+    for (const Frame& frame : ParseFrames(write)) {
+      if (frame.stream_id != 0) frames.push_back(frame);
+    }
+  }
+  return frames;
+}
+
+// An endpoint that records the bytes of every write it is given. Writes
+// complete immediately; reads stay pending until the endpoint is shut down.
+class RecordingEndpoint : public grpc_endpoint {
+ public:
+  RecordingEndpoint() {
+    static const grpc_endpoint_vtable vtable = {Read,
+                                                Write,
+                                                AddToPollset,
+                                                AddToPollsetSet,
+                                                DeleteFromPollsetSet,
+                                                Shutdown,
+                                                Destroy,
+                                                GetPeer,
+                                                GetLocalAddress,
+                                                GetFd,
+                                                CanTrackErr};
+    grpc_endpoint::vtable = &vtable;
+  }
+
+  // Returns the writes issued since the last call.
+  std::vector<std::string> TakeWrites() {
+    MutexLock lock(&mu_);
+    std::vector<std::string> writes;
+    writes.swap(writes_);
+    return writes;
+  }
+
+ private:
+  static void Read(grpc_endpoint* ep, grpc_slice_buffer* /*slices*/,
+                   grpc_closure* cb, bool /*urgent*/) {
+    RecordingEndpoint* self = static_cast<RecordingEndpoint*>(ep);
+    MutexLock lock(&self->mu_);
+    GPR_ASSERT(self->read_cb_ == nullptr);
+    self->read_cb_ = cb;
+  }
+
+  static void Write(grpc_endpoint* ep, grpc_slice_buffer* slices,
+                    grpc_closure* cb, void* /*arg*/) {
+    RecordingEndpoint* self = static_cast<RecordingEndpoint*>(ep);
+    std::string bytes;
+    for (size_t i = 0; i < slices->count; i++) {
+      const grpc_slice& slice = slices->slices[i];
+      bytes.append(reinterpret_cast<const char*>(GRPC_SLICE_START_PTR(slice)),
+                   GRPC_SLICE_LENGTH(slice));
+    }
+    {
+      MutexLock lock(&self->mu_);
+      self->writes_.push_back(std::move(bytes));
+    }
+    ExecCtx::Run(DEBUG_LOCATION, cb, GRPC_ERROR_NONE);
+  }
+
+  static void AddToPollset(grpc_endpoint* /*ep*/, grpc_pollset* /*pollset*/) {}
+
+  static void AddToPollsetSet(grpc_endpoint* /*ep*/,
+                              grpc_pollset_set* /*pollset_set*/) {}
+
+  static void DeleteFromPollsetSet(grpc_endpoint* /*ep*/,
+                                   grpc_pollset_set* /*pollset_set*/) {}
+
+  static void Shutdown(grpc_endpoint* ep, grpc_error_handle why) {
+    RecordingEndpoint* self = static_cast<RecordingEndpoint*>(ep);
+    grpc_closure* read_cb;
+    {
+      MutexLock lock(&self->mu_);
+      read_cb = self->read_cb_;
+      self->read_cb_ = nullptr;
+    }
+    if (read_cb != nullptr) {
+      ExecCtx::Run(DEBUG_LOCATION, read_cb, GRPC_ERROR_REF(why));
+    }
+    GRPC_ERROR_UNREF(why);
+  }
+
+  static void Destroy(grpc_endpoint* ep) {
+    delete static_cast<RecordingEndpoint*>(ep);
+  }
+
+  static absl::string_view GetPeer(grpc_endpoint* /*ep*/) {
+    return "fake:recording_endpoint";
+  }
+
+  static absl::string_view GetLocalAddress(grpc_endpoint* /*ep*/) {
+    return "fake:recording_endpoint";
+  }
+
+  static int GetFd(grpc_endpoint* /*ep*/) { return -1; }
+
+  static bool CanTrackErr(grpc_endpoint* /*ep*/) { return false; }
+
+  Mutex mu_;
+  std::vector<std::string> writes_ ABSL_GUARDED_BY(mu_);
+  grpc_closure* read_cb_ ABSL_GUARDED_BY(mu_) = nullptr;
+};
+
+// A client transport over a RecordingEndpoint.
+class Transport {
+ public:
+  explicit Transport(std::vector<grpc_arg> args) {
+    endpoint_ = new RecordingEndpoint;
+    grpc_channel_args channel_args = {args.size(), args.data()};
+    const grpc_channel_args* final_args =
+        CoreConfiguration::Get()
+            .channel_args_preconditioning()
+            .PreconditionChannelArgs(&channel_args);
+    transport_ = grpc_create_chttp2_transport(final_args, endpoint_, true);
+    grpc_channel_args_destroy(final_args);
+    grpc_chttp2_transport_start_reading(transport_, nullptr, nullptr, nullptr);
+    ExecCtx::Get()->Flush();
+    // Drop the connection preface and initial settings.
+    endpoint_->TakeWrites();
+  }
+
+  ~Transport() {
+    grpc_transport_destroy(transport_);
+    ExecCtx::Get()->Flush();
+  }
+
+  grpc_transport* transport() { return transport_; }
+
+  grpc_chttp2_transport* chttp2_transport() {
+    return reinterpret_cast<grpc_chttp2_transport*>(transport_);
+  }
+
+  std::vector<std::string> TakeWrites() { return endpoint_->TakeWrites(); }
+
+  // Waits up to five seconds for a write to be issued from another thread.
+  std::vector<std::string> WaitForWrites() {
+    gpr_timespec deadline = grpc_timeout_seconds_to_deadline(5);
+    std::vector<std::string> writes;
+    while ((writes = TakeWrites()).empty() &&
+           gpr_time_cmp(gpr_now(GPR_CLOCK_MONOTONIC), deadline) < 0) {
+      gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(1));
+    }
+    return writes;
+  }
+
+  void SendPing() {
+    grpc_transport_op* op = grpc_make_transport_op(nullptr);
+    op->send_ping.on_initiate =
+        GRPC_CLOSURE_INIT(&on_ping_initiated_, DoNothing, nullptr, nullptr);
+    op->send_ping.on_ack =
+        GRPC_CLOSURE_INIT(&on_ping_acked_, DoNothing, nullptr, nullptr);
+    grpc_transport_perform_op(transport_, op);
+  }
+
+  void Close() {
+    grpc_transport_op* op = grpc_make_transport_op(nullptr);
+    op->disconnect_with_error =
+        GRPC_ERROR_CREATE_FROM_STATIC_STRING("test closed transport");
+    grpc_transport_perform_op(transport_, op);
+  }
+
+ private:
+  static void DoNothing(void* /*arg*/, grpc_error_handle /*error*/) {}
+
+  RecordingEndpoint* endpoint_;
+  grpc_transport* transport_;
+  grpc_closure on_ping_initiated_;
+  grpc_closure on_ping_acked_;
+};
+
+void DoNothing(void* /*arg*/, grpc_error_handle /*error*/) {}
+
+// A client stream that sends its initial metadata and one message.
+class Stream {
+ public:
+  explicit Stream(Transport* transport)
+      : transport_(transport),
+        arena_(MakeScopedArena(1024, &memory_allocator_)),
+        initial_metadata_(arena_.get()),
+        stream_(static_cast<grpc_stream*>(
+            gpr_zalloc(grpc_transport_stream_size(transport->transport())))) {
+    GRPC_STREAM_REF_INIT(&refcount_, 1, Destroy, this, "test_stream");
+    grpc_transport_init_stream(transport_->transport(), stream_, &refcount_,
+                               nullptr, arena_.get());
+    initial_metadata_.Set(HttpPathMetadata(),
+                          Slice(StaticSlice::FromStaticString("/foo/bar")));
+  }
+
+  ~Stream() {
+    if (!cancelled_) Cancel();
+    ExecCtx::Get()->Flush();
+#ifndef NDEBUG
+    grpc_stream_unref(&refcount_, "test_stream");
+#else
+    grpc_stream_unref(&refcount_);
+#endif
+    ExecCtx::Get()->Flush();
+    GPR_ASSERT(destroyed_);
+    gpr_free(stream_);
+  }
+
+  // Queues HEADERS and a DATA frame carrying message_size bytes.
+  void Send(size_t message_size) {
+    grpc_slice_buffer buffer;
+    grpc_slice_buffer_init(&buffer);
+    grpc_slice slice = GRPC_SLICE_MALLOC(message_size);
+    memset(GRPC_SLICE_START_PTR(slice), 'a', message_size);
+    grpc_slice_buffer_add(&buffer, slice);
+    message_.Init(&buffer, 0);
+    grpc_slice_buffer_destroy_internal(&buffer);
+    send_op_ = {};
+    send_op_.payload = &send_payload_;
+    send_op_.send_initial_metadata = true;
+    send_payload_.send_initial_metadata.send_initial_metadata =
+        &initial_metadata_;
+    send_op_.send_message = true;
+    send_payload_.send_message.send_message.reset(message_.get());
+    send_op_.on_complete =
+        GRPC_CLOSURE_INIT(&on_send_complete_, DoNothing, nullptr, nullptr);
+    grpc_transport_perform_stream_op(transport_->transport(), stream_,
+                                     &send_op_);
+  }
+
+  void Cancel() {
+    cancelled_ = true;
+    cancel_op_ = {};
+    cancel_op_.payload = &cancel_payload_;
+    cancel_op_.cancel_stream = true;
+    cancel_payload_.cancel_stream.cancel_error = GRPC_ERROR_CANCELLED;
+    cancel_op_.on_complete =
+        GRPC_CLOSURE_INIT(&on_cancel_complete_, DoNothing, nullptr, nullptr);
+    grpc_transport_perform_stream_op(transport_->transport(), stream_,
+                                     &cancel_op_);
+  }
+
+  uint32_t id() const {
+    return reinterpret_cast<grpc_chttp2_stream*>(stream_)->id;
+  }
+
+ private:
+  static void Destroy(void* arg, grpc_error_handle /*error*/) {
+    Stream* self = static_cast<Stream*>(arg);
+    grpc_transport_destroy_stream(
+        self->transport_->transport(), self->stream_,
+        GRPC_CLOSURE_INIT(&self->on_destroyed_, OnDestroyed, self, nullptr));
+  }
+
+  static void OnDestroyed(void* arg, grpc_error_handle /*error*/) {
+    static_cast<Stream*>(arg)->destroyed_ = true;
+  }
+
+  Transport* const transport_;
+  MemoryAllocator memory_allocator_ = MemoryAllocator(
+      ResourceQuota::Default()->memory_quota()->CreateMemoryAllocator("test"));
+  ScopedArenaPtr arena_;
+  grpc_metadata_batch initial_metadata_;
+  grpc_stream* const stream_;
+  grpc_stream_refcount refcount_;
+  ManualConstructor<SliceBufferByteStream> message_;
+  grpc_transport_stream_op_batch send_op_;
+  grpc_transport_stream_op_batch_payload send_payload_{nullptr};
+  grpc_closure on_send_complete_;
+  grpc_transport_stream_op_batch cancel_op_;
+  grpc_transport_stream_op_batch_payload cancel_payload_{nullptr};
+  grpc_closure on_cancel_complete_;
+  bool cancelled_ = false;
+  grpc_closure on_destroyed_;
+  bool destroyed_ = false;
+};
+
+std::vector<grpc_arg> BatchWritesArgs() {
+  return {grpc_channel_arg_integer_create(
+      const_cast<char*>(GRPC_ARG_HTTP2_BATCH_WRITES), 1)};
+}
+
+std::vector<grpc_arg> WriteCorkArgs(int cork_us, int cork_bytes) {
+  return {grpc_channel_arg_integer_create(
+              const_cast<char*>(GRPC_ARG_HTTP2_WRITE_CORK_US), cork_us),
+          grpc_channel_arg_integer_create(
+              const_cast<char*>(GRPC_ARG_HTTP2_WRITE_CORK_BYTES), cork_bytes)};
+}
+
+// Long enough that the cork timer never fires during a test.
+const int kLongCorkUs = 60 * GPR_US_PER_SEC;
+
+bool HasFrameOfType(const std::vector<std::string>& writes, uint8_t type) {
+  for (const std::string& write : writes) {
+    for (const Frame& frame : ParseFrames(write)) {
+      if (frame.type == type) return true;
+    }
+  }
+  return false;
+}
+
+// Starts s1 from one combiner, which then hands over to a second combiner
+// to start s2. Combiners run in the order they became busy, so the second
+// one only runs once the transport's combiner, which became busy when s1 was
+// started, has run out of work.
+void StartStreamsFromCombiners(Stream* s1, Stream* s2) {
+  struct Args {
+    Stream* s1;
+    Stream* s2;
+    Combiner* first;
+    Combiner* second;
+    grpc_closure start_s1;
+    grpc_closure start_s2;
+  } args{s1, s2, grpc_combiner_create(), grpc_combiner_create(), {}, {}};
+  args.first->Run(
+      GRPC_CLOSURE_INIT(
+          &args.start_s1,
+          [](void* arg, grpc_error_handle /*error*/) {
+            Args* args = static_cast<Args*>(arg);
+            args->s1->Send(10);
+            args->second->Run(
+                GRPC_CLOSURE_INIT(
+                    &args->start_s2,
+                    [](void* arg, grpc_error_handle /*error*/) {
+                      static_cast<Args*>(arg)->s2->Send(10);
+                    },
+                    args, nullptr),
+                GRPC_ERROR_NONE);
+          },
+          &args, nullptr),
+      GRPC_ERROR_NONE);
+  ExecCtx::Get()->Flush();
+  GRPC_COMBINER_UNREF(args.first, "test");
+  GRPC_COMBINER_UNREF(args.second, "test");
+}
+
+// Without batching, a write begins as soon as the transport's combiner runs
+// out of work, so streams started later in the same exec_ctx flush end up in
+// writes of their own.
+TEST(WriteBatchingTest, UnbatchedStreamsWriteSeparately) {
+  ExecCtx exec_ctx;
+  Transport t({});
+  Stream s1(&t);
+  Stream s2(&t);
+  StartStreamsFromCombiners(&s1, &s2);
+  std::vector<std::string> writes = t.TakeWrites();
+  ASSERT_EQ(writes.size(), 2u);
+  EXPECT_EQ(StreamFrames({writes[0]}),
+            (std::vector<Frame>{{GRPC_CHTTP2_FRAME_HEADER, s1.id()},
+                                {GRPC_CHTTP2_FRAME_DATA, s1.id()}}));
+  EXPECT_EQ(StreamFrames({writes[1]}),
+            (std::vector<Frame>{{GRPC_CHTTP2_FRAME_HEADER, s2.id()},
+                                {GRPC_CHTTP2_FRAME_DATA, s2.id()}}));
+}
+
+// With batching, the write begins once the flush has drained, and carries
+// the frames of both streams.
+TEST(WriteBatchingTest, StreamsCoalesceIntoOneWrite) {
+  ExecCtx exec_ctx;
+  Transport t(BatchWritesArgs());
+  Stream s1(&t);
+  Stream s2(&t);
+  StartStreamsFromCombiners(&s1, &s2);
+  std::vector<std::string> writes = t.TakeWrites();
+  ASSERT_EQ(writes.size(), 1u);
+  EXPECT_EQ(StreamFrames(writes),
+            (std::vector<Frame>{{GRPC_CHTTP2_FRAME_HEADER, s1.id()},
+                                {GRPC_CHTTP2_FRAME_DATA, s1.id()},
+                                {GRPC_CHTTP2_FRAME_HEADER, s2.id()},
+                                {GRPC_CHTTP2_FRAME_DATA, s2.id()}}));
+}
+
+// Nothing is written before the exec_ctx drains.
+TEST(WriteBatchingTest, WriteWaitsForExecCtxToDrain) {
+  ExecCtx exec_ctx;
+  Transport t(BatchWritesArgs());
+  Stream s1(&t);
+  std::vector<std::string> writes_when_drained;
+  grpc_closure check;
+  struct CheckArgs {
+    Transport* t;
+    std::vector<std::string>* writes;
+  } check_args{&t, &writes_when_drained};
+  // Registered before the transport joins the write batch, so it runs just
+  // before the batch is flushed.
+  exec_ctx.RunWhenDrained(GRPC_CLOSURE_INIT(
+                              &check,
+                              [](void* arg, grpc_error_handle /*error*/) {
+                                CheckArgs* args = static_cast<CheckArgs*>(arg);
+                                *args->writes = args->t->TakeWrites();
+                              },
+                              &check_args, nullptr),
+                          GRPC_ERROR_NONE);
+  s1.Send(10);
+  exec_ctx.Flush();
+  EXPECT_TRUE(writes_when_drained.empty());
+  std::vector<std::string> writes = t.TakeWrites();
+  ASSERT_EQ(writes.size(), 1u);
+  EXPECT_EQ(StreamFrames(writes),
+            (std::vector<Frame>{{GRPC_CHTTP2_FRAME_HEADER, s1.id()},
+                                {GRPC_CHTTP2_FRAME_DATA, s1.id()}}));
+}
+
+// A write initiated under a nested exec_ctx is issued when that exec_ctx
+// goes away, not when the outer one drains.
+TEST(WriteBatchingTest, NestedExecCtxFlushesItsOwnBatch) {
+  ExecCtx exec_ctx;
+  Transport t1(BatchWritesArgs());
+  Transport t2(BatchWritesArgs());
+  Stream s1(&t1);
+  Stream s2(&t2);
+  s1.Send(10);
+  {
+    ExecCtx nested_exec_ctx;
+    s2.Send(10);
+  }
+  EXPECT_TRUE(t1.TakeWrites().empty());
+  std::vector<std::string> writes = t2.TakeWrites();
+  ASSERT_EQ(writes.size(), 1u);
+  EXPECT_EQ(StreamFrames(writes),
+            (std::vector<Frame>{{GRPC_CHTTP2_FRAME_HEADER, s2.id()},
+                                {GRPC_CHTTP2_FRAME_DATA, s2.id()}}));
+  exec_ctx.Flush();
+  writes = t1.TakeWrites();
+  ASSERT_EQ(writes.size(), 1u);
+  EXPECT_EQ(StreamFrames(writes),
+            (std::vector<Frame>{{GRPC_CHTTP2_FRAME_HEADER, s1.id()},
+                                {GRPC_CHTTP2_FRAME_DATA, s1.id()}}));
+}
+
+// A corked write is held until enough message data is pending, and then
+// carries the frames of every stream that was sent meanwhile.
+TEST(WriteCorkTest, PendingBytesReleaseCork) {
+  ExecCtx exec_ctx;
+  Transport t(WriteCorkArgs(kLongCorkUs, 100));
+  Stream s1(&t);
+  Stream s2(&t);
+  Stream s3(&t);
+  s1.Send(10);
+  exec_ctx.Flush();
+  s2.Send(10);
+  exec_ctx.Flush();
+  EXPECT_TRUE(t.TakeWrites().empty());
+  s3.Send(100);
+  exec_ctx.Flush();
+  std::vector<std::string> writes = t.TakeWrites();
+  ASSERT_EQ(writes.size(), 1u);
+  EXPECT_EQ(StreamFrames(writes),
+            (std::vector<Frame>{{GRPC_CHTTP2_FRAME_HEADER, s1.id()},
+                                {GRPC_CHTTP2_FRAME_DATA, s1.id()},
+                                {GRPC_CHTTP2_FRAME_HEADER, s2.id()},
+                                {GRPC_CHTTP2_FRAME_DATA, s2.id()},
+                                {GRPC_CHTTP2_FRAME_HEADER, s3.id()},
+                                {GRPC_CHTTP2_FRAME_DATA, s3.id()}}));
+}
+
+// Control frames are never held back: they take the corked frames along.
+TEST(WriteCorkTest, PingReleasesCork) {
+  ExecCtx exec_ctx;
+  Transport t(WriteCorkArgs(kLongCorkUs, 16384));
+  Stream s1(&t);
+  s1.Send(10);
+  exec_ctx.Flush();
+  EXPECT_TRUE(t.TakeWrites().empty());
+  t.SendPing();
+  exec_ctx.Flush();
+  std::vector<std::string> writes = t.TakeWrites();
+  ASSERT_EQ(writes.size(), 1u);
+  EXPECT_TRUE(HasFrameOfType(writes, GRPC_CHTTP2_FRAME_PING));
+  EXPECT_EQ(StreamFrames(writes),
+            (std::vector<Frame>{{GRPC_CHTTP2_FRAME_HEADER, s1.id()},
+                                {GRPC_CHTTP2_FRAME_DATA, s1.id()}}));
+}
+
+// Closing a stream resets it right away, and flushes the corked frames of
+// the other streams with the reset. Resets go out with the other control
+// frames, ahead of stream data.
+TEST(WriteCorkTest, StreamCloseReleasesCork) {
+  ExecCtx exec_ctx;
+  Transport t(WriteCorkArgs(kLongCorkUs, 16384));
+  Stream s1(&t);
+  Stream s2(&t);
+  s1.Send(10);
+  s2.Send(10);
+  exec_ctx.Flush();
+  EXPECT_TRUE(t.TakeWrites().empty());
+  uint32_t s2_id = s2.id();
+  s2.Cancel();
+  exec_ctx.Flush();
+  std::vector<std::string> writes = t.TakeWrites();
+  ASSERT_EQ(writes.size(), 1u);
+  EXPECT_EQ(StreamFrames(writes),
+            (std::vector<Frame>{{GRPC_CHTTP2_FRAME_RST_STREAM, s2_id},
+                                {GRPC_CHTTP2_FRAME_HEADER, s1.id()},
+                                {GRPC_CHTTP2_FRAME_DATA, s1.id()}}));
+}
+
+// Without anything else to release it, the cork timer does.
+TEST(WriteCorkTest, TimerReleasesCork) {
+  ExecCtx exec_ctx;
+  Transport t(WriteCorkArgs(10 * GPR_US_PER_MS, 16384));
+  Stream s1(&t);
+  s1.Send(10);
+  exec_ctx.Flush();
+  std::vector<std::string> writes = t.WaitForWrites();
+  ASSERT_EQ(writes.size(), 1u);
+  EXPECT_EQ(StreamFrames(writes),
+            (std::vector<Frame>{{GRPC_CHTTP2_FRAME_HEADER, s1.id()},
+                                {GRPC_CHTTP2_FRAME_DATA, s1.id()}}));
+}
+
+// Closing the transport releases the cork and cancels the cork timer, rather
+// than waiting for it: a close is delayed until the write in progress is
+// done, and the timer holds a ref to the transport.
+TEST(WriteCorkTest, TransportCloseReleasesCork) {
+  ExecCtx exec_ctx;
+  Transport t(WriteCorkArgs(kLongCorkUs, 16384));
+  Stream s1(&t);
+  s1.Send(10);
+  exec_ctx.Flush();
+  EXPECT_TRUE(t.chttp2_transport()->write_corked);
+  EXPECT_TRUE(t.chttp2_transport()->write_cork_timer_armed);
+  t.Close();
+  exec_ctx.Flush();
+  EXPECT_FALSE(t.chttp2_transport()->write_corked);
+  EXPECT_FALSE(t.chttp2_transport()->write_cork_timer_armed);
+  EXPECT_NE(t.chttp2_transport()->closed_with_error, GRPC_ERROR_NONE);
+  // The stream was cancelled by the close: its frames are dropped.
+  std::vector<std::string> writes = t.TakeWrites();
+  EXPECT_FALSE(HasFrameOfType(writes, GRPC_CHTTP2_FRAME_HEADER));
+  EXPECT_FALSE(HasFrameOfType(writes, GRPC_CHTTP2_FRAME_DATA));
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc::testing::TestEnvironment env(argc, argv);
+  grpc_init();
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
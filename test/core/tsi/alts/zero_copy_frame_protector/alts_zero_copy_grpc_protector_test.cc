@@ -18,6 +18,8 @@
 
 #include "src/core/tsi/alts/zero_copy_frame_protector/alts_zero_copy_grpc_protector.h"
 
+#include <algorithm>
+
 #include <grpc/slice_buffer.h>
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
@@ -37,6 +39,7 @@ constexpr size_t kSmallBufferSize = 16;
 constexpr size_t kLargeBufferSize = 16384;
 constexpr size_t kChannelMaxSize = 2048;
 constexpr size_t kChannelMinSize = 128;
+constexpr size_t kMaxFragmentSize = 300;
 
 /* Test fixtures for each test cases.  */
 struct alts_zero_copy_grpc_protector_test_fixture {
@@ -67,6 +70,23 @@ static void create_random_slice_buffer(grpc_slice_buffer* sb,
   grpc_slice_buffer_add(dup_sb, slice);
 }
 
+/* Like create_random_slice_buffer(), but spreads the data over many slices of
+ * random sizes so that frames start and end in the middle of slices.  */
+static void create_random_fragmented_slice_buffer(grpc_slice_buffer* sb,
+                                                  grpc_slice_buffer* dup_sb,
+                                                  size_t length) {
+  GPR_ASSERT(sb != nullptr);
+  GPR_ASSERT(dup_sb != nullptr);
+  while (length > 0) {
+    size_t fragment_size = std::min<size_t>(
+        length, gsec_test_bias_random_uint32(
+                    static_cast<uint32_t>(kMaxFragmentSize)) +
+                    1);
+    create_random_slice_buffer(sb, dup_sb, fragment_size);
+    length -= fragment_size;
+  }
+}
+
 static uint8_t* pointer_to_nth_byte(grpc_slice_buffer* sb, size_t index) {
   GPR_ASSERT(sb != nullptr);
   GPR_ASSERT(index < sb->length);
@@ -239,6 +259,42 @@ static void seal_unseal_large_buffer(tsi_zero_copy_grpc_protector* sender,
   grpc_core::ExecCtx::Get()->Flush();
 }
 
+static void seal_unseal_fragmented_buffer(
+    tsi_zero_copy_grpc_protector* sender,
+    tsi_zero_copy_grpc_protector* receiver) {
+  grpc_core::ExecCtx exec_ctx;
+  for (size_t i = 0; i < kSealRepeatTimes; i++) {
+    alts_zero_copy_grpc_protector_test_var* var =
+        alts_zero_copy_grpc_protector_test_var_create();
+    /* Creates a large slice buffer made of many small slices, protects it in
+     * one call, then unprotects it in a single piece.  */
+    create_random_fragmented_slice_buffer(&var->original_sb,
+                                          &var->duplicate_sb, kLargeBufferSize);
+    GPR_ASSERT(tsi_zero_copy_grpc_protector_protect(
+                   sender, &var->original_sb, &var->protected_sb) == TSI_OK);
+    GPR_ASSERT(var->original_sb.length == 0);
+    /* Spreads the protected frames over many small slices as well, so that
+     * frame headers, ciphertext and tags straddle slice boundaries.  */
+    while (var->protected_sb.length > 0) {
+      size_t fragment_size = std::min<size_t>(
+          var->protected_sb.length,
+          gsec_test_bias_random_uint32(
+              static_cast<uint32_t>(kMaxFragmentSize)) +
+              1);
+      grpc_slice_buffer_move_first(&var->protected_sb, fragment_size,
+                                   &var->staging_sb);
+    }
+    GPR_ASSERT(tsi_zero_copy_grpc_protector_unprotect(
+                   receiver, &var->staging_sb, &var->unprotected_sb) ==
+               TSI_OK);
+    GPR_ASSERT(var->staging_sb.length == 0);
+    GPR_ASSERT(
+        are_slice_buffers_equal(&var->unprotected_sb, &var->duplicate_sb));
+    alts_zero_copy_grpc_protector_test_var_destroy(var);
+  }
+  grpc_core::ExecCtx::Get()->Flush();
+}
+
 /* --- Test cases. --- */
 
 static void alts_zero_copy_protector_seal_unseal_small_buffer_tests(
@@ -297,6 +353,28 @@ static void alts_zero_copy_protector_seal_unseal_large_buffer_tests(
   alts_zero_copy_grpc_protector_test_fixture_destroy(fixture);
 }
 
+static void alts_zero_copy_protector_seal_unseal_fragmented_buffer_tests(
+    bool enable_extra_copy) {
+  alts_zero_copy_grpc_protector_test_fixture* fixture =
+      alts_zero_copy_grpc_protector_test_fixture_create(
+          /*rekey=*/false, /*integrity_only=*/true, enable_extra_copy);
+  seal_unseal_fragmented_buffer(fixture->client, fixture->server);
+  seal_unseal_fragmented_buffer(fixture->server, fixture->client);
+  alts_zero_copy_grpc_protector_test_fixture_destroy(fixture);
+
+  fixture = alts_zero_copy_grpc_protector_test_fixture_create(
+      /*rekey=*/false, /*integrity_only=*/false, enable_extra_copy);
+  seal_unseal_fragmented_buffer(fixture->client, fixture->server);
+  seal_unseal_fragmented_buffer(fixture->server, fixture->client);
+  alts_zero_copy_grpc_protector_test_fixture_destroy(fixture);
+
+  fixture = alts_zero_copy_grpc_protector_test_fixture_create(
+      /*rekey=*/true, /*integrity_only=*/false, enable_extra_copy);
+  seal_unseal_fragmented_buffer(fixture->client, fixture->server);
+  seal_unseal_fragmented_buffer(fixture->server, fixture->client);
+  alts_zero_copy_grpc_protector_test_fixture_destroy(fixture);
+}
+
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(argc, argv);
   grpc_init();
@@ -308,6 +386,8 @@ int main(int argc, char** argv) {
       /*enable_extra_copy=*/false);
   alts_zero_copy_protector_seal_unseal_large_buffer_tests(
       /*enable_extra_copy=*/true);
+  alts_zero_copy_protector_seal_unseal_fragmented_buffer_tests(
+      /*enable_extra_copy=*/false);
   grpc_shutdown();
   return 0;
 }
@@ -142,6 +142,37 @@ TEST(SslSessionCacheTest, LruCache) {
   EXPECT_EQ(tracker.AliveCount(), 0);
 }
 
+TEST(SslSessionCacheTest, ShardedCache) {
+  SessionTracker tracker;
+  {
+    // Small caches keep exact LRU semantics in a single shard.
+    EXPECT_EQ(tsi::SslSessionLRUCache::Create(3)->num_shards(), 1);
+    RefCountedPtr<tsi::SslSessionLRUCache> cache =
+        tsi::SslSessionLRUCache::Create(1000);
+    EXPECT_GT(cache->num_shards(), 1);
+    for (long id = 0; id < 4000; id++) {
+      std::string domain = std::to_string(id) + ".random.domain";
+      cache->Put(domain.c_str(), tracker.NewSession(id));
+    }
+    // Every shard is full and the total capacity is never exceeded.
+    EXPECT_EQ(cache->Size(), 1000);
+    EXPECT_EQ(tracker.AliveCount(), 1000);
+    // The most recently added sessions are never evicted.
+    for (long id = 3990; id < 4000; id++) {
+      std::string domain = std::to_string(id) + ".random.domain";
+      EXPECT_TRUE(tracker.IsAlive(id));
+      EXPECT_NE(cache->Get(domain.c_str()), nullptr);
+    }
+    EXPECT_EQ(cache->Get("0.random.domain"), nullptr);
+    // Clearing empties every shard.
+    cache->Clear();
+    EXPECT_EQ(cache->Size(), 0);
+    EXPECT_EQ(tracker.AliveCount(), 0);
+    EXPECT_EQ(cache->Get("3999.random.domain"), nullptr);
+  }
+  EXPECT_EQ(tracker.AliveCount(), 0);
+}
+
 }  // namespace
 }  // namespace grpc_core
 
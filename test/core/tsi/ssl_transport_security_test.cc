@@ -22,6 +22,8 @@
 #include <stdio.h>
 #include <string.h>
 
+#include <string>
+
 #include <grpc/grpc.h>
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
@@ -311,6 +313,33 @@ static void check_client_peer(ssl_tsi_test_fixture* ssl_fixture,
   tsi_peer_destruct(peer);
 }
 
+// Record protection can only be exported for kernel TLS offload from TLS 1.2
+// sessions with BoringSSL. When it is, each direction must be described the
+// same way by both ends.
+static void check_ktls_crypto_info(ssl_tsi_test_fixture* ssl_fixture) {
+  tsi_ktls_crypto_info client_tx;
+  tsi_ktls_crypto_info client_rx;
+  tsi_ktls_crypto_info server_tx;
+  tsi_ktls_crypto_info server_rx;
+  tsi_result client_result = tsi_handshaker_result_get_ktls_crypto_info(
+      ssl_fixture->base.client_result, &client_tx, &client_rx);
+  tsi_result server_result = tsi_handshaker_result_get_ktls_crypto_info(
+      ssl_fixture->base.server_result, &server_tx, &server_rx);
+#if defined(OPENSSL_IS_BORINGSSL)
+  if (test_tls_version == tsi_tls_version::TSI_TLS1_2) {
+    GPR_ASSERT(client_result == TSI_OK);
+    GPR_ASSERT(server_result == TSI_OK);
+    GPR_ASSERT(memcmp(&client_tx, &server_rx, sizeof(client_tx)) == 0);
+    GPR_ASSERT(memcmp(&client_rx, &server_tx, sizeof(client_rx)) == 0);
+    GPR_ASSERT(memcmp(client_tx.key, client_rx.key, sizeof(client_tx.key)) !=
+               0);
+    return;
+  }
+#endif
+  GPR_ASSERT(client_result == TSI_UNIMPLEMENTED);
+  GPR_ASSERT(server_result == TSI_UNIMPLEMENTED);
+}
+
 static void ssl_test_check_handshaker_peers(tsi_test_fixture* fixture) {
   ssl_tsi_test_fixture* ssl_fixture =
       reinterpret_cast<ssl_tsi_test_fixture*>(fixture);
@@ -365,6 +394,9 @@ static void ssl_test_check_handshaker_peers(tsi_test_fixture* fixture) {
   } else {
     GPR_ASSERT(ssl_fixture->base.server_result == nullptr);
   }
+  if (expect_client_success && expect_server_success) {
+    check_ktls_crypto_info(ssl_fixture);
+  }
 }
 
 static void ssl_test_pem_key_cert_pair_destroy(tsi_ssl_pem_key_cert_pair kp) {
@@ -708,6 +740,26 @@ static bool is_slow_build() {
 #endif
 }
 
+void ssl_tsi_test_do_zero_copy_round_trip() {
+  gpr_log(GPR_INFO, "ssl_tsi_test_do_zero_copy_round_trip");
+  // Large messages in slices smaller than a record, large messages in slices
+  // larger than a (small) record, and small messages in tiny slices.
+  const bool use_default_message[] = {true, true, false};
+  const bool use_default_frame_size[] = {true, false, false};
+  for (size_t i = 0; i < sizeof(use_default_message) / sizeof(bool); i++) {
+    tsi_test_fixture* fixture = ssl_tsi_test_fixture_create();
+    ssl_tsi_test_fixture* ssl_fixture =
+        reinterpret_cast<ssl_tsi_test_fixture*>(fixture);
+    tsi_test_frame_protector_config_destroy(ssl_fixture->base.config);
+    ssl_fixture->base.config = tsi_test_frame_protector_config_create(
+        use_default_message[i], use_default_message[i], use_default_message[i],
+        use_default_message[i], use_default_message[i],
+        use_default_frame_size[i], use_default_frame_size[i]);
+    tsi_test_do_zero_copy_round_trip(fixture);
+    tsi_test_fixture_destroy(fixture);
+  }
+}
+
 void ssl_tsi_test_do_round_trip_odd_buffer_size() {
   gpr_log(GPR_INFO, "ssl_tsi_test_do_round_trip_odd_buffer_size");
   const size_t odd_sizes[] = {1025, 2051, 4103, 8207, 16409};
@@ -773,6 +825,46 @@ void ssl_tsi_test_do_handshake_session_cache() {
   tsi_ssl_session_cache_unref(session_cache);
 }
 
+// Clients whose root stores differ must not resume each other's sessions,
+// even when they share a session cache and their PEM roots option.
+void ssl_tsi_test_do_handshake_session_cache_with_root_store() {
+  gpr_log(GPR_INFO, "ssl_tsi_test_do_handshake_session_cache_with_root_store");
+  tsi_ssl_session_cache* session_cache = tsi_ssl_session_cache_create_lru(16);
+  char session_ticket_key[kSessionTicketEncryptionKeySize];
+  memset(session_ticket_key, 'a', sizeof(session_ticket_key));
+  auto do_handshake = [&session_ticket_key, &session_cache](
+                          const char* extra_root_file, bool session_reused) {
+    tsi_test_fixture* fixture = ssl_tsi_test_fixture_create();
+    ssl_tsi_test_fixture* ssl_fixture =
+        reinterpret_cast<ssl_tsi_test_fixture*>(fixture);
+    ssl_key_cert_lib* key_cert_lib = ssl_fixture->key_cert_lib;
+    key_cert_lib->use_root_store = true;
+    if (extra_root_file != nullptr) {
+      char* extra_root = load_file(SSL_TSI_TEST_CREDENTIALS_DIR, extra_root_file);
+      std::string roots = std::string(key_cert_lib->root_cert) + extra_root;
+      gpr_free(extra_root);
+      tsi_ssl_root_certs_store_destroy(key_cert_lib->root_store);
+      key_cert_lib->root_store = tsi_ssl_root_certs_store_create(roots.c_str());
+      GPR_ASSERT(key_cert_lib->root_store != nullptr);
+    }
+    ssl_fixture->server_name_indication =
+        const_cast<char*>("waterzooi.test.google.be");
+    ssl_fixture->session_ticket_key = session_ticket_key;
+    ssl_fixture->session_ticket_key_size = sizeof(session_ticket_key);
+    tsi_ssl_session_cache_ref(session_cache);
+    ssl_fixture->session_cache = session_cache;
+    ssl_fixture->session_reused = session_reused;
+    tsi_test_do_round_trip(&ssl_fixture->base);
+    tsi_test_fixture_destroy(fixture);
+  };
+  do_handshake(nullptr, false);
+  do_handshake(nullptr, true);
+  do_handshake("client.pem", false);
+  do_handshake("client.pem", true);
+  do_handshake(nullptr, true);
+  tsi_ssl_session_cache_unref(session_cache);
+}
+
 static const tsi_ssl_handshaker_factory_vtable* original_vtable;
 static bool handshaker_factory_destructor_called;
 
@@ -1062,9 +1154,13 @@ int main(int argc, char** argv) {
     ssl_tsi_test_do_handshake_alpn_server_no_client();
     ssl_tsi_test_do_handshake_alpn_client_server_ok();
     ssl_tsi_test_do_handshake_session_cache();
+    ssl_tsi_test_do_handshake_session_cache_with_root_store();
     ssl_tsi_test_do_round_trip_for_all_configs();
     ssl_tsi_test_do_round_trip_with_error_on_stack();
     ssl_tsi_test_do_round_trip_odd_buffer_size();
+#if OPENSSL_VERSION_NUMBER >= 0x10100000
+    ssl_tsi_test_do_zero_copy_round_trip();
+#endif
     ssl_tsi_test_handshaker_factory_internals();
     ssl_tsi_test_duplicate_root_certificates();
     ssl_tsi_test_extract_x509_subject_names();
@@ -22,12 +22,17 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <algorithm>
+
 #include <grpc/grpc.h>
+#include <grpc/slice_buffer.h>
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
 #include "src/core/lib/gprpp/memory.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/security/transport/tsi_error.h"
+#include "src/core/tsi/transport_security_grpc.h"
 
 static void notification_signal(tsi_test_fixture* fixture) {
   gpr_mu_lock(&fixture->mu);
@@ -489,6 +494,92 @@ void tsi_test_do_round_trip(tsi_test_fixture* fixture) {
   tsi_frame_protector_destroy(server_frame_protector);
 }
 
+/* Sends message from sender to receiver through zero-copy protectors. Both the
+   unprotected message and the protected bytes are cut into chunk_size
+   pieces. */
+static void tsi_test_zero_copy_send_message_to_peer(
+    tsi_zero_copy_grpc_protector* sender,
+    tsi_zero_copy_grpc_protector* receiver, const unsigned char* message,
+    size_t message_size, size_t chunk_size) {
+  grpc_core::ExecCtx exec_ctx;
+  grpc_slice_buffer unprotected_slices;
+  grpc_slice_buffer protected_slices;
+  grpc_slice_buffer staging_slices;
+  grpc_slice_buffer received_slices;
+  grpc_slice_buffer_init(&unprotected_slices);
+  grpc_slice_buffer_init(&protected_slices);
+  grpc_slice_buffer_init(&staging_slices);
+  grpc_slice_buffer_init(&received_slices);
+  for (size_t offset = 0; offset < message_size; offset += chunk_size) {
+    grpc_slice_buffer_add(
+        &unprotected_slices,
+        grpc_slice_from_copied_buffer(
+            reinterpret_cast<const char*>(message) + offset,
+            std::min(chunk_size, message_size - offset)));
+  }
+  GPR_ASSERT(tsi_zero_copy_grpc_protector_protect(
+                 sender, &unprotected_slices, &protected_slices) == TSI_OK);
+  while (protected_slices.length > 0) {
+    grpc_slice_buffer_move_first(
+        &protected_slices, std::min(chunk_size, protected_slices.length),
+        &staging_slices);
+    GPR_ASSERT(tsi_zero_copy_grpc_protector_unprotect(
+                   receiver, &staging_slices, &received_slices) == TSI_OK);
+  }
+  GPR_ASSERT(received_slices.length == message_size);
+  unsigned char* received_message =
+      static_cast<unsigned char*>(gpr_malloc(message_size));
+  grpc_slice_buffer_move_first_into_buffer(&received_slices, message_size,
+                                           received_message);
+  GPR_ASSERT(memcmp(message, received_message, message_size) == 0);
+  gpr_free(received_message);
+  grpc_slice_buffer_destroy(&unprotected_slices);
+  grpc_slice_buffer_destroy(&protected_slices);
+  grpc_slice_buffer_destroy(&staging_slices);
+  grpc_slice_buffer_destroy(&received_slices);
+}
+
+void tsi_test_do_zero_copy_round_trip(tsi_test_fixture* fixture) {
+  /* Initialization. */
+  GPR_ASSERT(fixture != nullptr);
+  GPR_ASSERT(fixture->config != nullptr);
+  tsi_test_frame_protector_config* config = fixture->config;
+  tsi_zero_copy_grpc_protector* client_protector = nullptr;
+  tsi_zero_copy_grpc_protector* server_protector = nullptr;
+  /* Perform handshake. */
+  tsi_test_do_handshake(fixture);
+  /* Create zero-copy protectors. */
+  size_t client_max_output_protected_frame_size =
+      config->client_max_output_protected_frame_size;
+  GPR_ASSERT(tsi_handshaker_result_create_zero_copy_grpc_protector(
+                 fixture->client_result,
+                 client_max_output_protected_frame_size == 0
+                     ? nullptr
+                     : &client_max_output_protected_frame_size,
+                 &client_protector) == TSI_OK);
+  size_t server_max_output_protected_frame_size =
+      config->server_max_output_protected_frame_size;
+  GPR_ASSERT(tsi_handshaker_result_create_zero_copy_grpc_protector(
+                 fixture->server_result,
+                 server_max_output_protected_frame_size == 0
+                     ? nullptr
+                     : &server_max_output_protected_frame_size,
+                 &server_protector) == TSI_OK);
+  /* Client sends a message to server, then server sends one to client. */
+  tsi_test_zero_copy_send_message_to_peer(
+      client_protector, server_protector, config->client_message,
+      config->client_message_size, config->read_buffer_allocated_size);
+  tsi_test_zero_copy_send_message_to_peer(
+      server_protector, client_protector, config->server_message,
+      config->server_message_size, config->read_buffer_allocated_size);
+  /* Destroy server and client protectors. */
+  {
+    grpc_core::ExecCtx exec_ctx;
+    tsi_zero_copy_grpc_protector_destroy(client_protector);
+    tsi_zero_copy_grpc_protector_destroy(server_protector);
+  }
+}
+
 static unsigned char* generate_random_message(size_t size) {
   size_t i;
   unsigned char chars[] = "abcdefghijklmnopqrstuvwxyz1234567890";
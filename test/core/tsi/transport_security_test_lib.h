@@ -224,6 +224,11 @@ void tsi_test_do_handshake(tsi_test_fixture* fixture);
    the client and server switching its role. */
 void tsi_test_do_round_trip(tsi_test_fixture* fixture);
 
+/* This method performs the above round trip test through zero-copy grpc
+   protectors. Messages are protected from, and unprotected into, slice buffers
+   that are split into many small slices. */
+void tsi_test_do_zero_copy_round_trip(tsi_test_fixture* fixture);
+
 /* This method performs the above round trip test without doing handshakes. */
 void tsi_test_frame_protector_do_round_trip_no_handshake(
     tsi_test_frame_protector_fixture* fixture);
@@ -0,0 +1,144 @@
+//
+//
+// Copyright 2021 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include "src/core/ext/xds/xds_routing.h"
+
+#include <gtest/gtest.h>
+
+#include "src/core/lib/resource_quota/resource_quota.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+class RouteList : public XdsRouting::RouteListIterator {
+ public:
+  size_t Size() const override { return routes_.size(); }
+
+  const XdsRouteConfigResource::Route::Matchers& GetMatchersForRoute(
+      size_t index) const override {
+    return routes_[index];
+  }
+
+  // Adds a route matching path and, if header_value is non-null,
+  // requiring the x-route header to be equal to it.
+  void Add(StringMatcher::Type type, const char* path,
+           const char* header_value = nullptr, bool case_sensitive = true,
+           absl::optional<uint32_t> fraction_per_million = absl::nullopt) {
+    XdsRouteConfigResource::Route::Matchers matchers;
+    matchers.path_matcher =
+        StringMatcher::Create(type, path, case_sensitive).value();
+    if (header_value != nullptr) {
+      matchers.header_matchers.push_back(
+          HeaderMatcher::Create("x-route", HeaderMatcher::Type::kExact,
+                                header_value, 0, 0, false, false)
+              .value());
+    }
+    matchers.fraction_per_million = fraction_per_million;
+    routes_.push_back(std::move(matchers));
+  }
+
+ private:
+  std::vector<XdsRouteConfigResource::Route::Matchers> routes_;
+};
+
+class XdsRoutingTest : public ::testing::Test {
+ protected:
+  XdsRoutingTest() {
+    routes_.Add(StringMatcher::Type::kExact, "/pkg.Svc/Exact", "a");
+    // Never taken.
+    routes_.Add(StringMatcher::Type::kPrefix, "/pkg.Svc/", nullptr, true, 0);
+    routes_.Add(StringMatcher::Type::kSafeRegex, "/pkg\\.Svc/M[a-z]+");
+    routes_.Add(StringMatcher::Type::kPrefix, "/pkg.svc/E", nullptr, false);
+    routes_.Add(StringMatcher::Type::kExact, "/other/exact", "b", false);
+    routes_.Add(StringMatcher::Type::kPrefix, "", "b");
+    routes_.Add(StringMatcher::Type::kPrefix, "/other/");
+    path_matchers_ = XdsRouting::CreatePathMatcherSet(routes_);
+  }
+
+  // Returns the route chosen for path, after checking that both overloads of
+  // GetRouteForRequest() agree on it.
+  absl::optional<size_t> GetRoute(absl::string_view path,
+                                  const char* header_value = nullptr) {
+    auto arena = MakeScopedArena(1024, &allocator_);
+    grpc_metadata_batch metadata(arena.get());
+    if (header_value != nullptr) {
+      metadata.Append("x-route",
+                      Slice(grpc_slice_intern(
+                          grpc_slice_from_static_string(header_value))),
+                      [](absl::string_view, const Slice&) { abort(); });
+    }
+    absl::optional<size_t> route =
+        XdsRouting::GetRouteForRequest(routes_, path, &metadata);
+    EXPECT_EQ(XdsRouting::GetRouteForRequest(routes_, path_matchers_, path,
+                                             &metadata),
+              route)
+        << path;
+    return route;
+  }
+
+  MemoryAllocator allocator_ =
+      ResourceQuota::Default()->memory_quota()->CreateMemoryAllocator(
+          "XdsRoutingTest");
+  RouteList routes_;
+  StringMatcherSet path_matchers_;
+};
+
+TEST_F(XdsRoutingTest, PathMatcherSetHoldsEveryRoute) {
+  EXPECT_EQ(path_matchers_.size(), routes_.Size());
+}
+
+TEST_F(XdsRoutingTest, FirstRouteWhosePathMatches) {
+  EXPECT_EQ(GetRoute("/pkg.Svc/Method"), 2);
+  EXPECT_EQ(GetRoute("/PKG.SVC/Everything"), 3);
+  EXPECT_EQ(GetRoute("/other/method"), 6);
+}
+
+TEST_F(XdsRoutingTest, SkipsRoutesWhoseHeadersDoNotMatch) {
+  EXPECT_EQ(GetRoute("/pkg.Svc/Exact", "a"), 0);
+  EXPECT_EQ(GetRoute("/pkg.Svc/Exact"), 3);
+  EXPECT_EQ(GetRoute("/pkg.Svc/Exact", "b"), 3);
+  EXPECT_EQ(GetRoute("/OTHER/EXACT", "b"), 4);
+  EXPECT_EQ(GetRoute("/other/exact", "a"), 6);
+  EXPECT_EQ(GetRoute("/unknown", "b"), 5);
+}
+
+TEST_F(XdsRoutingTest, SkipsRoutesOutsideTheirFraction) {
+  EXPECT_EQ(GetRoute("/pkg.Svc/Other"), absl::nullopt);
+  EXPECT_EQ(GetRoute("/pkg.Svc/Other", "b"), 5);
+}
+
+TEST_F(XdsRoutingTest, NoRouteMatches) {
+  EXPECT_EQ(GetRoute("/unknown"), absl::nullopt);
+  EXPECT_EQ(GetRoute(""), absl::nullopt);
+  EXPECT_EQ(GetRoute("/other"), absl::nullopt);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc::testing::TestEnvironment env(argc, argv);
+  grpc_init();
+  auto result = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return result;
+}
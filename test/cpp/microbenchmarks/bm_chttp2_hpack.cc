@@ -31,6 +31,7 @@
 
 #include "src/core/ext/transport/chttp2/transport/hpack_encoder.h"
 #include "src/core/ext/transport/chttp2/transport/hpack_parser.h"
+#include "src/core/ext/transport/chttp2/transport/huffsyms.h"
 #include "src/core/lib/resource_quota/resource_quota.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/slice/slice_string_helpers.h"
@@ -740,6 +741,107 @@ class SameDeadline {
   }
 };
 
+// Append s to v as a huffman coded string literal.
+static void AppendHuffmanString(const std::string& s, std::vector<uint8_t>* v) {
+  std::vector<uint8_t> coded;
+  uint64_t bits = 0;
+  int nbits = 0;
+  for (unsigned char c : s) {
+    const grpc_chttp2_huffsym& sym = grpc_chttp2_huffsyms[c];
+    bits = (bits << sym.length) | sym.bits;
+    nbits += sym.length;
+    while (nbits >= 8) {
+      nbits -= 8;
+      coded.push_back(static_cast<uint8_t>(bits >> nbits));
+    }
+  }
+  if (nbits > 0) {
+    // Pad with the most significant bits of EOS (all ones).
+    coded.push_back(
+        static_cast<uint8_t>((bits << (8 - nbits)) | (0xff >> nbits)));
+  }
+  // Length, with a 7 bit prefix and the huffman flag set.
+  size_t length = coded.size();
+  if (length < 0x7f) {
+    v->push_back(0x80 | static_cast<uint8_t>(length));
+  } else {
+    v->push_back(0xff);
+    length -= 0x7f;
+    while (length >= 0x80) {
+      v->push_back(0x80 | static_cast<uint8_t>(length & 0x7f));
+      length >>= 7;
+    }
+    v->push_back(static_cast<uint8_t>(length));
+  }
+  v->insert(v->end(), coded.begin(), coded.end());
+}
+
+// Literal (non-indexed) headers with huffman coded names and values, as sent
+// by most HTTP/2 implementations other than grpc itself (browsers, proxies,
+// meshes).
+template <class Corpus>
+class HuffmanCodedHeaders {
+ public:
+  static std::vector<grpc_slice> GetInitSlices() { return {}; }
+  static std::vector<grpc_slice> GetBenchmarkSlices() {
+    std::vector<uint8_t> v;
+    for (const auto& header : Corpus::Headers()) {
+      v.push_back(0x00);
+      AppendHuffmanString(header.first, &v);
+      AppendHuffmanString(header.second, &v);
+    }
+    return {MakeSlice(v)};
+  }
+};
+
+struct AuthTokenCorpus {
+  static std::vector<std::pair<std::string, std::string>> Headers() {
+    // A JWT sized bearer token: three base64url segments.
+    std::string token = "Bearer eyJhbGciOiJSUzI1NiIsImtpZCI6IjE2In0.";
+    for (int i = 0; i < 600; i++) {
+      token.push_back(
+          "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_"
+              [(i * 37 + 11) % 64]);
+      if (i == 450) token.push_back('.');
+    }
+    return {{"authorization", token}};
+  }
+};
+
+struct TracingCorpus {
+  static std::vector<std::pair<std::string, std::string>> Headers() {
+    return {
+        {"traceparent",
+         "00-0af7651916cd43dd8448eb211c80319c-b7ad6b7169203331-01"},
+        {"tracestate", "rojo=00f067aa0ba902b7,congo=t61rcWkgMzE"},
+        {"x-b3-traceid", "80f198ee56343ba864fe8b2a57d3eff7"},
+        {"x-b3-spanid", "e457b5a2e4d86bd1"},
+        {"x-b3-parentspanid", "05e3ac9a4f6e3b90"},
+        {"x-b3-sampled", "1"},
+        {"x-request-id", "5c8e3b1a-7f2d-4e6b-9a0c-1d2e3f4a5b6c"},
+        {"x-cloud-trace-context", "105445aa7843bc8bf206b12000100000/1;o=1"},
+    };
+  }
+};
+
+struct BrowserRequestCorpus {
+  static std::vector<std::pair<std::string, std::string>> Headers() {
+    return {
+        {"user-agent",
+         "Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like "
+         "Gecko) Chrome/96.0.4664.45 Safari/537.36"},
+        {"accept", "application/grpc-web-text"},
+        {"accept-language", "en-US,en;q=0.9"},
+        {"x-grpc-web", "1"},
+        {"origin", "https://console.example.com"},
+        {"referer", "https://console.example.com/projects/list?page=2"},
+        {"cookie",
+         "SID=G8nq3Bx5c0Bv2hQm_wZ1; HSID=AYhQ5rGdIwXzmB1; "
+         "SSID=AqN2m7oP4hW; _ga=GA1.2.1987315427.1634569820"},
+    };
+  }
+};
+
 BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, EmptyBatch);
 BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, IndexedSingleStaticElem);
 BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, AddIndexedSingleStaticElem);
@@ -773,6 +875,12 @@ BENCHMARK_TEMPLATE(BM_HpackParserParseHeader,
 BENCHMARK_TEMPLATE(BM_HpackParserParseHeader,
                    RepresentativeServerInitialMetadata);
 BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, SameDeadline);
+BENCHMARK_TEMPLATE(BM_HpackParserParseHeader,
+                   HuffmanCodedHeaders<AuthTokenCorpus>);
+BENCHMARK_TEMPLATE(BM_HpackParserParseHeader,
+                   HuffmanCodedHeaders<TracingCorpus>);
+BENCHMARK_TEMPLATE(BM_HpackParserParseHeader,
+                   HuffmanCodedHeaders<BrowserRequestCorpus>);
 
 }  // namespace hpack_parser_fixtures
 
@@ -0,0 +1,125 @@
+/*
+ *
+ * Copyright 2021 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark the chttp2 stream map with many concurrent streams */
+
+#include <stdint.h>
+
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "src/core/ext/transport/chttp2/transport/stream_map.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+static void* StreamValue(uint32_t id) {
+  return reinterpret_cast<void*>(static_cast<uintptr_t>(id));
+}
+
+// Client initiated stream ids: odd, increasing.
+static uint32_t StreamId(size_t n) { return static_cast<uint32_t>(2 * n + 1); }
+
+// Lookup of random live streams, as done for each incoming frame.
+static void BM_StreamMapFind(benchmark::State& state) {
+  const size_t num_streams = state.range(0);
+  grpc_chttp2_stream_map map;
+  grpc_chttp2_stream_map_init(&map, 8);
+  for (size_t i = 0; i < num_streams; i++) {
+    grpc_chttp2_stream_map_add(&map, StreamId(i), StreamValue(StreamId(i)));
+  }
+  std::vector<uint32_t> lookups(4096);
+  std::mt19937 rng(42);
+  for (auto& id : lookups) id = StreamId(rng() % num_streams);
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(grpc_chttp2_stream_map_find(
+        &map, lookups[i++ % lookups.size()]));
+  }
+  grpc_chttp2_stream_map_destroy(&map);
+}
+BENCHMARK(BM_StreamMapFind)->RangeMultiplier(10)->Range(100, 10000);
+
+// Streams finishing out of order while new ones start: each iteration ends a
+// random live stream and starts a new one, keeping the number of concurrent
+// streams constant.
+static void BM_StreamMapChurn(benchmark::State& state) {
+  const size_t num_streams = state.range(0);
+  grpc_chttp2_stream_map map;
+  grpc_chttp2_stream_map_init(&map, 8);
+  std::vector<uint32_t> live;
+  size_t next = 0;
+  for (; next < num_streams; next++) {
+    grpc_chttp2_stream_map_add(&map, StreamId(next),
+                               StreamValue(StreamId(next)));
+    live.push_back(StreamId(next));
+  }
+  std::mt19937 rng(42);
+  for (auto _ : state) {
+    uint32_t& victim = live[rng() % num_streams];
+    grpc_chttp2_stream_map_delete(&map, victim);
+    victim = StreamId(next++);
+    grpc_chttp2_stream_map_add(&map, victim, StreamValue(victim));
+  }
+  grpc_chttp2_stream_map_destroy(&map);
+}
+BENCHMARK(BM_StreamMapChurn)->RangeMultiplier(10)->Range(100, 10000);
+
+// Walk over all live streams, as done when settings change or the transport
+// closes, with a quarter of the streams already finished.
+static void BM_StreamMapForEach(benchmark::State& state) {
+  const size_t num_streams = state.range(0);
+  grpc_chttp2_stream_map map;
+  grpc_chttp2_stream_map_init(&map, 8);
+  for (size_t i = 0; i < num_streams; i++) {
+    grpc_chttp2_stream_map_add(&map, StreamId(i), StreamValue(StreamId(i)));
+  }
+  for (size_t i = 0; i < num_streams; i += 4) {
+    grpc_chttp2_stream_map_delete(&map, StreamId(i));
+  }
+  for (auto _ : state) {
+    size_t visited = 0;
+    grpc_chttp2_stream_map_for_each(
+        &map,
+        [](void* user_data, uint32_t /*key*/, void* /*value*/) {
+          ++*static_cast<size_t*>(user_data);
+        },
+        &visited);
+    benchmark::DoNotOptimize(visited);
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          grpc_chttp2_stream_map_size(&map));
+  grpc_chttp2_stream_map_destroy(&map);
+}
+BENCHMARK(BM_StreamMapForEach)->RangeMultiplier(10)->Range(100, 10000);
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  ::benchmark::Initialize(&argc, argv);
+  ::grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
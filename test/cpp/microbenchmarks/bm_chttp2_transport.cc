@@ -557,7 +557,8 @@ static void BM_TransportStreamRecv(benchmark::State& state) {
   grpc_transport_stream_op_batch_payload op_payload(nullptr);
   grpc_transport_stream_op_batch op;
   grpc_core::OrphanablePtr<grpc_core::ByteStream> recv_stream;
-  grpc_slice incoming_data = CreateIncomingDataSlice(state.range(0), 16384);
+  grpc_slice incoming_data =
+      CreateIncomingDataSlice(state.range(0), state.range(1));
 
   auto reset_op = [&]() {
     op = {};
@@ -671,7 +672,19 @@ static void BM_TransportStreamRecv(benchmark::State& state) {
   track_counters.Finish(state);
   grpc_slice_unref(incoming_data);
 }
-BENCHMARK(BM_TransportStreamRecv)->Range(0, 128 * 1024 * 1024);
+static void StreamRecvArgs(benchmark::internal::Benchmark* b) {
+  // First argument is the message size, second is the size of the HTTP/2
+  // DATA frames it is split into
+  b->Args({0, 16384});
+  for (int i = 1; i <= 128 * 1024 * 1024; i *= 8) {
+    b->Args({i, 16384});
+  }
+  // Many small frames per read: dominated by frame header parsing
+  for (int frame_size = 16; frame_size < 16384; frame_size *= 8) {
+    b->Args({1024 * 1024, frame_size});
+  }
+}
+BENCHMARK(BM_TransportStreamRecv)->Apply(StreamRecvArgs);
 
 // Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
 // and others do not. This allows us to support both modes.
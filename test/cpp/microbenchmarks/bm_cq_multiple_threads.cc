@@ -110,7 +110,7 @@ static const grpc_event_engine_vtable* init_engine_vtable(bool) {
   return &g_vtable;
 }
 
-static void setup() {
+static void setup(grpc_cq_event_queue_type event_queue_type) {
   // This test should only ever be run with a non or any polling engine
   // Override the polling engine for the non-polling engine
   // and add a custom polling engine
@@ -123,7 +123,8 @@ static void setup() {
              strcmp(grpc_get_poll_strategy_name(), "bm_cq_multiple_threads") ==
                  0);
 
-  g_cq = grpc_completion_queue_create_for_next(nullptr);
+  g_cq = grpc_completion_queue_create_internal(
+      GRPC_CQ_NEXT, GRPC_CQ_DEFAULT_POLLING, nullptr, event_queue_type);
 }
 
 static void teardown() {
@@ -160,14 +161,20 @@ static void teardown() {
  and its Finish call must take place before grpc_shutdown so that it can use
  grpc_stats).
 */
-static void BM_Cq_Throughput(benchmark::State& state) {
+/* With complete_before_next, each iteration queues its own completion before
+ calling grpc_completion_queue_next(), the way completions made off the polling
+ thread (e.g. by the executor) reach the queue. Otherwise the completion is
+ made from within pollset_work, while the calling thread waits on the queue. */
+static void CqThroughput(benchmark::State& state,
+                         grpc_cq_event_queue_type event_queue_type,
+                         bool complete_before_next) {
   gpr_timespec deadline = gpr_inf_future(GPR_CLOCK_MONOTONIC);
   auto thd_idx = state.thread_index();
 
   gpr_mu_lock(&g_mu);
   g_threads_active++;
   if (thd_idx == 0) {
-    setup();
+    setup(event_queue_type);
     g_active = true;
     gpr_cv_broadcast(&g_cv);
   } else {
@@ -182,6 +189,14 @@ static void BM_Cq_Throughput(benchmark::State& state) {
   TrackCounters track_counters;
 
   for (auto _ : state) {
+    if (complete_before_next) {
+      grpc_core::ExecCtx exec_ctx;
+      void* tag = reinterpret_cast<void*>(10);  // Some random number
+      GPR_ASSERT(grpc_cq_begin_op(g_cq, tag));
+      grpc_cq_end_op(g_cq, tag, GRPC_ERROR_NONE, cq_done_cb, nullptr,
+                     static_cast<grpc_cq_completion*>(
+                         gpr_malloc(sizeof(grpc_cq_completion))));
+    }
     GPR_ASSERT(grpc_completion_queue_next(g_cq, deadline, nullptr).type ==
                GRPC_OP_COMPLETE);
   }
@@ -206,8 +221,26 @@ static void BM_Cq_Throughput(benchmark::State& state) {
   }
 }
 
+static void BM_Cq_Throughput(benchmark::State& state) {
+  CqThroughput(state, GRPC_CQ_SINGLE_EVENT_QUEUE, false);
+}
 BENCHMARK(BM_Cq_Throughput)->ThreadRange(1, 16)->UseRealTime();
 
+static void BM_Cq_Throughput_Sharded(benchmark::State& state) {
+  CqThroughput(state, GRPC_CQ_SHARDED_EVENT_QUEUE, false);
+}
+BENCHMARK(BM_Cq_Throughput_Sharded)->ThreadRange(1, 16)->UseRealTime();
+
+static void BM_Cq_CompleteThenNext(benchmark::State& state) {
+  CqThroughput(state, GRPC_CQ_SINGLE_EVENT_QUEUE, true);
+}
+BENCHMARK(BM_Cq_CompleteThenNext)->ThreadRange(1, 16)->UseRealTime();
+
+static void BM_Cq_CompleteThenNext_Sharded(benchmark::State& state) {
+  CqThroughput(state, GRPC_CQ_SHARDED_EVENT_QUEUE, true);
+}
+BENCHMARK(BM_Cq_CompleteThenNext_Sharded)->ThreadRange(1, 16)->UseRealTime();
+
 }  // namespace testing
 }  // namespace grpc
 
@@ -0,0 +1,148 @@
+/*
+ *
+ * Copyright 2021 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark the per-call cost of RBAC policy evaluation against policy size */
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_format.h"
+
+#include <grpc/grpc.h>
+
+#include "src/core/lib/security/authorization/grpc_authorization_engine.h"
+#include "src/core/lib/security/authorization/matchers.h"
+#include "test/core/util/evaluate_args_test_util.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+// Policy i allows the methods of service i, restricted to a tenant header,
+// from the /24 of its clients.
+Rbac::Policy MakePolicy(int i) {
+  std::vector<std::unique_ptr<Rbac::Permission>> paths;
+  paths.push_back(absl::make_unique<Rbac::Permission>(
+      Rbac::Permission::RuleType::kPath,
+      StringMatcher::Create(StringMatcher::Type::kExact,
+                            absl::StrFormat("/pkg.Service%d/Unary", i))
+          .value()));
+  paths.push_back(absl::make_unique<Rbac::Permission>(
+      Rbac::Permission::RuleType::kPath,
+      StringMatcher::Create(StringMatcher::Type::kPrefix,
+                            absl::StrFormat("/pkg.Service%d/Stream", i))
+          .value()));
+  std::vector<std::unique_ptr<Rbac::Permission>> permissions;
+  permissions.push_back(absl::make_unique<Rbac::Permission>(
+      Rbac::Permission::RuleType::kOr, std::move(paths)));
+  permissions.push_back(absl::make_unique<Rbac::Permission>(
+      Rbac::Permission::RuleType::kHeader,
+      HeaderMatcher::Create("x-tenant", HeaderMatcher::Type::kExact,
+                            absl::StrFormat("tenant%d", i))
+          .value()));
+  return Rbac::Policy(
+      Rbac::Permission(Rbac::Permission::RuleType::kAnd,
+                       std::move(permissions)),
+      Rbac::Principal(
+          Rbac::Principal::RuleType::kSourceIp,
+          Rbac::CidrRange(absl::StrFormat("10.%d.%d.0", i / 256, i % 256),
+                          24)));
+}
+
+std::string PolicyName(int i) { return absl::StrFormat("policy%06d", i); }
+
+// Request allowed by the last policy checked, the worst case for a linear
+// scan.
+void FillArgs(int num_policies, EvaluateArgsTestUtil* util) {
+  int i = num_policies - 1;
+  util->AddPairToMetadata(
+      ":path", absl::StrFormat("/pkg.Service%d/StreamEvents", i).c_str());
+  util->AddPairToMetadata("x-tenant", absl::StrFormat("tenant%d", i).c_str());
+  util->AddPairToMetadata("user-agent", "grpc-c++");
+  util->AddPairToMetadata("x-request-id", "0123456789");
+  util->SetLocalEndpoint("ipv4:192.168.0.1:443");
+  util->SetPeerEndpoint(
+      absl::StrFormat("ipv4:10.%d.%d.7:5000", i / 256, i % 256));
+}
+
+void BM_RbacCompiledEngine(benchmark::State& state) {
+  const int num_policies = state.range(0);
+  std::map<std::string, Rbac::Policy> policies;
+  for (int i = 0; i < num_policies; ++i) {
+    policies[PolicyName(i)] = MakePolicy(i);
+  }
+  GrpcAuthorizationEngine engine(
+      Rbac(Rbac::Action::kAllow, std::move(policies)));
+  EvaluateArgsTestUtil util;
+  FillArgs(num_policies, &util);
+  EvaluateArgs args = util.MakeEvaluateArgs();
+  for (auto _ : state) {
+    AuthorizationEngine::Decision decision = engine.Evaluate(args);
+    GPR_ASSERT(decision.type == AuthorizationEngine::Decision::Type::kAllow);
+  }
+}
+BENCHMARK(BM_RbacCompiledEngine)->RangeMultiplier(10)->Range(1, 1000);
+
+// The same policies evaluated by walking one matcher tree per policy.
+void BM_RbacMatcherTrees(benchmark::State& state) {
+  const int num_policies = state.range(0);
+  std::vector<std::unique_ptr<AuthorizationMatcher>> matchers;
+  for (int i = 0; i < num_policies; ++i) {
+    matchers.push_back(
+        absl::make_unique<PolicyAuthorizationMatcher>(MakePolicy(i)));
+  }
+  EvaluateArgsTestUtil util;
+  FillArgs(num_policies, &util);
+  EvaluateArgs args = util.MakeEvaluateArgs();
+  for (auto _ : state) {
+    bool matches = false;
+    for (const auto& matcher : matchers) {
+      if (matcher->Matches(args)) {
+        matches = true;
+        break;
+      }
+    }
+    GPR_ASSERT(matches);
+  }
+}
+BENCHMARK(BM_RbacMatcherTrees)->RangeMultiplier(10)->Range(1, 1000);
+
+}  // namespace
+}  // namespace grpc_core
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  ::grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -18,6 +18,7 @@
 
 #include <string.h>
 
+#include <algorithm>
 #include <atomic>
 #include <vector>
 
@@ -28,6 +29,7 @@
 #include <grpc/support/log.h>
 
 #include "src/core/lib/iomgr/timer.h"
+#include "src/core/lib/iomgr/timer_manager.h"
 #include "test/core/util/test_config.h"
 #include "test/cpp/microbenchmarks/helpers.h"
 #include "test/cpp/util/test_config.h"
@@ -104,6 +106,82 @@ BENCHMARK(BM_TimerBatch)
     ->Args({/*check=*/true, /*reverse=*/true})
     ->ThreadRange(1, 128);
 
+// The simulated clock runs ahead of the real one: carry it over to the next
+// run, and the next benchmark, so that it never goes backwards.
+static grpc_millis g_simulated_now = 0;
+
+// Sets and fires one timer after the timer list sat idle for state.range(0)
+// milliseconds, as a connection's keepalive or idle timer does. Timers are
+// only checked from here, on the simulated clock.
+static void BM_TimerAfterIdle(benchmark::State& state) {
+  const grpc_millis idle_ms = state.range(0);
+  TrackCounters track_counters;
+  grpc_timer_manager_set_threading(false);
+  grpc_core::ExecCtx exec_ctx;
+  TimerClosure timer_closure;
+  bool fired;
+  GRPC_CLOSURE_INIT(
+      &timer_closure.closure,
+      [](void* arg, grpc_error_handle /*err*/) {
+        *static_cast<bool*>(arg) = true;
+      },
+      &fired, grpc_schedule_on_exec_ctx);
+  grpc_millis& now = g_simulated_now;
+  now = std::max(now, exec_ctx.Now());
+  for (auto _ : state) {
+    now += idle_ms;
+    exec_ctx.TestOnlySetNow(now);
+    fired = false;
+    grpc_timer_init(&timer_closure.timer, now + 1, &timer_closure.closure);
+    // As the poller kicked by grpc_timer_init() would. The heap may fire
+    // timers up to a millisecond late.
+    grpc_timer_consume_kick();
+    now += 2;
+    exec_ctx.TestOnlySetNow(now);
+    grpc_timer_check(nullptr);
+    exec_ctx.Flush();
+    GPR_ASSERT(fired);
+  }
+  grpc_timer_manager_set_threading(true);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_TimerAfterIdle)->Arg(1)->Arg(1000)->Arg(60000)->Arg(3600000);
+
+// Sets a timer with a given delay, then checks timers only once it is due, as
+// a poller with nothing else to do would. On the timing wheel, the timer is
+// cascaded down from a higher level on the way.
+static void BM_TimerAfterDelay(benchmark::State& state) {
+  const grpc_millis delay_ms = state.range(0);
+  TrackCounters track_counters;
+  grpc_timer_manager_set_threading(false);
+  grpc_core::ExecCtx exec_ctx;
+  TimerClosure timer_closure;
+  bool fired;
+  GRPC_CLOSURE_INIT(
+      &timer_closure.closure,
+      [](void* arg, grpc_error_handle /*err*/) {
+        *static_cast<bool*>(arg) = true;
+      },
+      &fired, grpc_schedule_on_exec_ctx);
+  grpc_millis& now = g_simulated_now;
+  now = std::max(now, exec_ctx.Now());
+  for (auto _ : state) {
+    exec_ctx.TestOnlySetNow(now);
+    fired = false;
+    grpc_timer_init(&timer_closure.timer, now + delay_ms,
+                    &timer_closure.closure);
+    grpc_timer_consume_kick();
+    now += delay_ms + 1;
+    exec_ctx.TestOnlySetNow(now);
+    grpc_timer_check(nullptr);
+    exec_ctx.Flush();
+    GPR_ASSERT(fired);
+  }
+  grpc_timer_manager_set_threading(true);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_TimerAfterDelay)->Arg(100)->Arg(5000)->Arg(60000)->Arg(3600000);
+
 }  // namespace testing
 }  // namespace grpc
 
@@ -0,0 +1,133 @@
+/*
+ *
+ * Copyright 2021 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark the per-call cost of xDS route selection against route table
+   size */
+
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/strings/str_format.h"
+
+#include <grpc/grpc.h>
+
+#include "src/core/ext/xds/xds_routing.h"
+#include "src/core/lib/resource_quota/resource_quota.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+// Even routes match the methods of one service by prefix, odd routes a
+// method name pattern by regex.
+class RouteList : public XdsRouting::RouteListIterator {
+ public:
+  explicit RouteList(int num_routes) {
+    for (int i = 0; i < num_routes; ++i) {
+      XdsRouteConfigResource::Route::Matchers matchers;
+      matchers.path_matcher =
+          (i % 2 == 0
+               ? StringMatcher::Create(StringMatcher::Type::kPrefix,
+                                       absl::StrFormat("/pkg.Service%d/", i))
+               : StringMatcher::Create(
+                     StringMatcher::Type::kSafeRegex,
+                     absl::StrFormat("/pkg\\.Service%d/Get[A-Z][a-z]*", i)))
+              .value();
+      routes_.push_back(std::move(matchers));
+    }
+  }
+
+  size_t Size() const override { return routes_.size(); }
+
+  const XdsRouteConfigResource::Route::Matchers& GetMatchersForRoute(
+      size_t index) const override {
+    return routes_[index];
+  }
+
+ private:
+  std::vector<XdsRouteConfigResource::Route::Matchers> routes_;
+};
+
+// Path matched by the last route only, the worst case for a linear scan.
+std::string LastRoutePath(int num_routes) {
+  int i = num_routes - 1;
+  return i % 2 == 0 ? absl::StrFormat("/pkg.Service%d/Watch", i)
+                    : absl::StrFormat("/pkg.Service%d/GetItem", i);
+}
+
+class Metadata {
+ public:
+  grpc_metadata_batch* batch() { return &batch_; }
+
+ private:
+  MemoryAllocator allocator_ =
+      ResourceQuota::Default()->memory_quota()->CreateMemoryAllocator(
+          "bm_xds_routing");
+  ScopedArenaPtr arena_ = MakeScopedArena(1024, &allocator_);
+  grpc_metadata_batch batch_{arena_.get()};
+};
+
+void BM_XdsRoutingPathMatcherSet(benchmark::State& state) {
+  const int num_routes = state.range(0);
+  RouteList routes(num_routes);
+  StringMatcherSet path_matchers = XdsRouting::CreatePathMatcherSet(routes);
+  std::string path = LastRoutePath(num_routes);
+  Metadata metadata;
+  for (auto _ : state) {
+    absl::optional<size_t> route = XdsRouting::GetRouteForRequest(
+        routes, path_matchers, path, metadata.batch());
+    GPR_ASSERT(route == static_cast<size_t>(num_routes - 1));
+  }
+}
+BENCHMARK(BM_XdsRoutingPathMatcherSet)->RangeMultiplier(10)->Range(10, 1000);
+
+// The same routes checked one path matcher at a time.
+void BM_XdsRoutingLinearScan(benchmark::State& state) {
+  const int num_routes = state.range(0);
+  RouteList routes(num_routes);
+  std::string path = LastRoutePath(num_routes);
+  Metadata metadata;
+  for (auto _ : state) {
+    absl::optional<size_t> route =
+        XdsRouting::GetRouteForRequest(routes, path, metadata.batch());
+    GPR_ASSERT(route == static_cast<size_t>(num_routes - 1));
+  }
+}
+BENCHMARK(BM_XdsRoutingLinearScan)->RangeMultiplier(10)->Range(10, 1000);
+
+}  // namespace
+}  // namespace grpc_core
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  ::grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
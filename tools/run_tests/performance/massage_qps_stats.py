@@ -83,6 +83,18 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_tcp_backup_poller_polls"] = massage_qps_stats_helpers.counter(
                     core_stats, "tcp_backup_poller_polls")
+            stats[
+                "core_tcp_rx_zerocopy_bytes"] = massage_qps_stats_helpers.counter(
+                    core_stats, "tcp_rx_zerocopy_bytes")
+            stats[
+                "core_tcp_rx_copied_bytes"] = massage_qps_stats_helpers.counter(
+                    core_stats, "tcp_rx_copied_bytes")
+            stats[
+                "core_tcp_read_buffer_pool_allocs"] = massage_qps_stats_helpers.counter(
+                    core_stats, "tcp_read_buffer_pool_allocs")
+            stats[
+                "core_tcp_read_buffer_pool_reuses"] = massage_qps_stats_helpers.counter(
+                    core_stats, "tcp_read_buffer_pool_reuses")
             stats["core_http2_op_batches"] = massage_qps_stats_helpers.counter(
                 core_stats, "http2_op_batches")
             stats["core_http2_op_cancel"] = massage_qps_stats_helpers.counter(
@@ -320,6 +332,24 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_cq_ev_queue_transient_pop_failures"] = massage_qps_stats_helpers.counter(
                     core_stats, "cq_ev_queue_transient_pop_failures")
+            stats[
+                "core_tls_handshakes_full"] = massage_qps_stats_helpers.counter(
+                    core_stats, "tls_handshakes_full")
+            stats[
+                "core_tls_handshakes_resumed"] = massage_qps_stats_helpers.counter(
+                    core_stats, "tls_handshakes_resumed")
+            stats[
+                "core_call_creds_token_cache_hits"] = massage_qps_stats_helpers.counter(
+                    core_stats, "call_creds_token_cache_hits")
+            stats[
+                "core_call_creds_token_cache_misses"] = massage_qps_stats_helpers.counter(
+                    core_stats, "call_creds_token_cache_misses")
+            stats[
+                "core_call_creds_token_prefetches"] = massage_qps_stats_helpers.counter(
+                    core_stats, "call_creds_token_prefetches")
+            stats[
+                "core_security_handshake_offloaded_steps"] = massage_qps_stats_helpers.counter(
+                    core_stats, "security_handshake_offloaded_steps")
             h = massage_qps_stats_helpers.histogram(core_stats,
                                                     "call_initial_size")
             stats["core_call_initial_size"] = ",".join(
@@ -497,6 +527,21 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_http2_send_flowctl_per_write_99p"] = massage_qps_stats_helpers.percentile(
                     h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(
+                core_stats, "http2_writes_per_flush")
+            stats["core_http2_writes_per_flush"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_http2_writes_per_flush_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_http2_writes_per_flush_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_http2_writes_per_flush_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_http2_writes_per_flush_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
             h = massage_qps_stats_helpers.histogram(core_stats,
                                                     "server_cqs_checked")
             stats["core_server_cqs_checked"] = ",".join(
@@ -512,3 +557,78 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_server_cqs_checked_99p"] = massage_qps_stats_helpers.percentile(
                     h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(
+                core_stats, "security_handshake_latency_us")
+            stats["core_security_handshake_latency_us"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_security_handshake_latency_us_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_security_handshake_latency_us_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_security_handshake_latency_us_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_security_handshake_latency_us_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(core_stats,
+                                                    "combiner_queue_depth")
+            stats["core_combiner_queue_depth"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_combiner_queue_depth_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_combiner_queue_depth_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_combiner_queue_depth_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_combiner_queue_depth_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(
+                core_stats, "combiner_ownership_time_us")
+            stats["core_combiner_ownership_time_us"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_combiner_ownership_time_us_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_combiner_ownership_time_us_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_combiner_ownership_time_us_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_combiner_ownership_time_us_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(
+                core_stats, "work_serializer_queue_depth")
+            stats["core_work_serializer_queue_depth"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_work_serializer_queue_depth_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_work_serializer_queue_depth_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_work_serializer_queue_depth_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_work_serializer_queue_depth_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(
+                core_stats, "work_serializer_ownership_time_us")
+            stats["core_work_serializer_ownership_time_us"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_work_serializer_ownership_time_us_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_work_serializer_ownership_time_us_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_work_serializer_ownership_time_us_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_work_serializer_ownership_time_us_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)